@@ -0,0 +1,11 @@
+#ifndef BOOT_PROFILER_H
+#define BOOT_PROFILER_H
+
+#include <stdint.h>
+
+void bootPhaseBegin(const char *name);
+void bootPhaseEnd();
+void bootMarkLedsOn();
+void printBootProfile();
+
+#endif
@@ -14,6 +14,10 @@
 // general
 #define DELAY_BEFORE_STARTUP_MS 10
 
+// boot
+#define BOOT_PROFILER_MAX_PHASES 16
+#define BOOT_LEDS_ON_TARGET_MS 200 // saved color should be on LED strip within this time after power-up
+
 // LED strip
 #define LED_STRIP_MAX_LED_COUNT 9999
 #define LED_STRIP_TYPE WS2812B
@@ -37,6 +41,7 @@
 #define PICKER_WIDTH 288 // number should be divisible by 6, or behaviour might vary
 #define MAIN_SCREEN_TIMER_MS 1000 // do not change !!! used by doubledot animation, etc.
 #define ANY_SETTING_SCREEN_TIMER_MS 2000 
+#define FORECAST_SCREEN_TIMER_MS 10000
 
 // encoders
 #define ROTARY_ENCODER_STEPS 30
@@ -60,20 +65,61 @@
 // wifi
 #define WIFI_SSID_MAX_LENGTH 128
 #define WIFI_PWD_MAX_LENGTH 128
-#define WIFI_CONNECT_TIMEOUT_MS 20000 // 20 s
+#define WIFI_CONNECT_TIMEOUT_MS 20000 // 20 s, only for initial connection after boot, then soft AP is enabled
+#define WIFI_CONNECT_ATTEMPT_TIMEOUT_MS 10000 // 10 s
+#define WIFI_RECONNECT_BACKOFF_MIN_MS 1000 // 1 s
+#define WIFI_RECONNECT_BACKOFF_MAX_MS 60000 // 1 min
+#define WIFI_EVENT_QUEUE_LENGTH 8
 #define WIFI_SERVER_PORT 80
 #define MAX_SOFTAP_SSID_LENGTH 64
 #define MAX_SOFTAP_PWD_LENGTH 32
-#define SERVER_CLIENT_TIMEOUT_MS 10000 // 10 s
 #define WIFI_CONNECTION_CHECK_TIMER_MS 1000
-#define INTERNET_CONNECTION_CHECK_TIMER_MS 5000
+
+// network task
+#define NETWORK_TASK_CORE 0 // same core as Wi-Fi driver, UI loop runs on the other one
+#define NETWORK_TASK_PRIORITY 1
+#define NETWORK_TASK_STACK_SIZE 12288
+#define NETWORK_TASK_PERIOD_MS 10
+#define NETWORK_TASK_IDLE_PERIOD_MS 100 // no web server connection open, new one waits at most this long
+#define NETWORK_MESSAGE_QUEUE_LENGTH 16
+#define LIGHT_COMMAND_QUEUE_LENGTH 4 // JSON API -> UI loop
+#define LED_FRAME_PERIOD_MS 20 // 50 fps, live control is applied (and blended) at most this often
+#define LIVE_CONTROL_SAVE_DELAY_MS 5000 // brightness is saved to preferences once live control stops for this long
+
+// internet connectivity (probe is a single ICMP echo, only sent when real traffic did not tell us anything)
+#define CONNECTIVITY_INITIAL_PROBE_DELAY_MS 3000 // after wi-fi connects, give NTP and weather a chance first
+#define CONNECTIVITY_EVIDENCE_MARGIN_MS 120000 // 2 min, weather fetch may come late (slow server, other work of network task)
+#define CONNECTIVITY_EVIDENCE_MAX_AGE_MS (UPDATE_WEATHER_MS + CONNECTIVITY_EVIDENCE_MARGIN_MS) // every weather fetch is evidence, probe only when one is overdue
+#define CONNECTIVITY_PROBE_TIMEOUT_MS 1000
+#define CONNECTIVITY_BACKOFF_MIN_MS 5000 // 5 s
+#define CONNECTIVITY_BACKOFF_MAX_MS 300000 // 5 min
+
+// servers, can be overridden from build flags (see env:esp32-s3-devkitc-1-stand-in in platformio.ini)
+#ifndef OPENWEATHER_SERVER
+#define OPENWEATHER_SERVER "api.openweathermap.org"
+#endif
+#ifndef NTP_SERVER
+#define NTP_SERVER "pool.ntp.org"
+#endif
+
+// HTTP client (weather and forecast, connection is kept open between requests when server allows it)
+#define HTTP_TIMEOUT_MS 1000 // for every wait on server (status line, header line, body data)
+#define HTTP_CONNECT_TIMEOUT_MS 3000
+#define HTTP_DNS_CACHE_TTL_MS 3600000 // 1 hour
+#define HTTP_MAX_HOST_LENGTH 64
+#define HTTP_MAX_LINE_LENGTH 256 // status and header lines, longer ones are cut (we do not need any long header)
+#define HTTP_MAX_DRAIN_SIZE 4096 // unread rest of the body, anything longer is cheaper to drop with the connection
 
 // datetime
 #define YEAR_OFFSET 1900
 #define TIME_ZONE_MAX_LENGTH 64 
-#define SETUP_SYNC_DATE_TIME_TIMEOUT_MS 15000 // 15 s
-#define LOOP_SYNC_DATE_TIME_TIMEOUT_MS 10
-#define DATE_TIME_SYNC_TIMEOUT_MS 604800000 // 1 week
+#define MIN_VALID_EPOCH 1483228800 // 2017-01-01, anything older is considered not synced (same as getLocalTime())
+#define TIME_SYNC_RECORD_MAGIC 0x54535931 // change this when TimeSyncRecord layout changes
+#define TIME_SYNC_FRESH_S 7200 // 2 hours, sntp syncs every hour
+#define TIME_MAX_ERROR_S 60 // clock is not shown once its estimated error gets over this
+#define TIME_DEFAULT_DRIFT_PPM 100 // until measured, gives about a week without NTP
+#define TIME_DRIFT_MARGIN_PPM 10
+#define TIME_DRIFT_MIN_INTERVAL_S 1800 // 30 min, shorter intervals between syncs are not used to measure drift
 
 // weather
 #define CITY_MAX_LENGTH 64
@@ -81,11 +127,76 @@
 #define LAT_LON_MAX_LENGTH 16
 #define API_KEY_MAX_LENGTH 128
 #define UPDATE_WEATHER_MS 600000 // 10 min
-#define MAX_HTTP_PAYLOAD_SIZE 4096
 #define MAX_SERVER_URL_SIZE 512
 #define WEATHER_SYNC_TIMEOUT_MS 1800000 // 30 min
+#define WEATHER_CACHE_MAGIC 0x57434831 // change this when WeatherData layout changes
+
+// forecast
+#define UPDATE_FORECAST_MS 3600000 // 1 hour, forecast itself moves in 3 hour steps
+#define FORECAST_MAX_SAMPLES 40 // 5 days of 3-hourly samples, which is all openweather free API gives
+#define FORECAST_SAMPLE_PERIOD_S 10800 // 3 hours
+#define FORECAST_MAX_DAYS 5 // columns on forecast screen
+#define FORECAST_DAY_WEATHER_HOUR 12 // weather icon of the day is the one from around noon
 
 // soft AP
 #define SOFT_AP_TIMEOUT_MS 3600000 // 1 hour
+#define SETUP_RESTART_DELAY_MS 1000 // after new setup is saved, so the browser gets the confirmation page
+
+// web server (setup page on soft AP)
+#define WEB_SERVER_MAX_CLIENTS 4 // browsers open several connections at once (page, favicon, ...)
+#define WEB_SERVER_MAX_TARGET_LENGTH 2048 // path with query, setup form sends all its fields URL encoded in query
+#define WEB_SERVER_MAX_HEADER_SIZE 256 // of the response, response whose header does not fit gets 500
+#define WEB_SERVER_MAX_HEADER_LINE_LENGTH 128 // of the request, longer lines are cut (headers server reads are short)
+#define WEB_SERVER_MAX_ETAG_LENGTH 64
+#define WEB_SERVER_MAX_REQUEST_BODY_SIZE 512 // JSON API requests are small, anything bigger gets 413
+#define WEB_SERVER_MAX_BODY_SIZE 256 // of formatted responses (JSON API), constant pages are sent straight from flash, large ones are on heap
+#define WEB_SERVER_MAX_ALLOCATED_BODY_SIZE (TRACE_TEXT_MAX_SIZE + 2 * METRICS_TEXT_MAX_SIZE) // large generated bodies on heap, of all responses being sent at once (a trace and two overlapping scrapes)
+#define WEB_SERVER_MAX_READ_PER_POLL 512
+#define WEB_SERVER_MAX_WRITE_PER_POLL 4096
+#define WEB_SERVER_WRITE_CHUNK_SIZE 1436 // lwIP TCP MSS, body goes out in full segments straight from flash
+#define WEB_TEMPLATE_MAX_VALUES 8 // substitutions in one page
+#define SERVER_CLIENT_TIMEOUT_MS 10000 // 10 s without any data in either direction
+#define WEB_SOCKET_KEY_LENGTH 24 // base64 of 16 bytes
+#define WEB_SOCKET_PING_INTERVAL_MS 20000 // 20 s, keeps NAT/phone from dropping idle connection
+#define WEB_SOCKET_TIMEOUT_MS 60000 // 1 min without anything from client (pongs included)
+#define WEB_SOCKET_MAX_SEND_PAYLOAD 125 // server sends only small frames (also the largest control frame), so header is always 2 B
+
+// UI idle, loop() blocks on main screen until next deadline or input (network task included)
+#define UI_IDLE_ENABLED true // false spins as before, to compare input latency
+#define POWER_MAX_CPU_FREQUENCY_MHZ 240
+#define POWER_MIN_CPU_FREQUENCY_MHZ 80 // while idle, only with framework built with power management
+
+// scheduler ("tasks" on serial console)
+#define SCHEDULER_MAX_TASKS 8 // per scheduler (UI loop, network task)
+#define SCHEDULER_MAX_IDLE_MS 1000 // longest next wake-up reported, even with nothing armed
+
+// state store, UI loop state with change notification
+#define STATE_STORE_MAX_SUBSCRIBERS 8
+
+// stall profiler ("stalls" on serial console)
+#define STALL_PROFILER_UI_THRESHOLD_MS 50 // knob turn to visible change feels laggy above this
+#define STALL_PROFILER_NETWORK_THRESHOLD_MS 1000 // HTTP request may take a while, web server clients wait meanwhile
+#define STALL_PROFILER_BUCKETS 10 // <1 ms up to >=256 ms
+#define STALL_PROFILER_MAX_DEPTH 4 // of nested probes
+
+// metrics (GET /metrics, "metrics" on serial console)
+#define METRICS_HISTOGRAM_BUCKETS 8 // plus +Inf
+#define METRICS_TEXT_MAX_SIZE 6144 // whole Prometheus text, it is about 4 kB
+#define SERIAL_COMMAND_MAX_LENGTH 32
+
+// deferred log (LOG_ERROR .. LOG_DEBUG in console.h), formatted and printed by low priority task
+#define LOG_RING_SIZE 64 // records, power of 2, full ring drops new ones
+#define LOG_MAX_ARGUMENTS 4 // per record
+#define LOG_LINE_MAX_LENGTH 128 // formatted, longer is cut
+#define LOG_TASK_CORE 0
+#define LOG_TASK_PRIORITY 0 // same as idle, it never takes time from UI loop or network task
+#define LOG_TASK_STACK_SIZE 3072
+
+// trace (GET /trace, "trace" on serial console), Chrome Trace Event JSON of stall profiler probes and knob events
+#define TRACE_ENABLED true // recording costs a clock read and a few stores per event
+#ifndef TRACE_RING_SIZE
+#define TRACE_RING_SIZE 256 // events, 24 B each, oldest are overwritten
+#endif
+#define TRACE_TEXT_MAX_SIZE 20480 // GET /trace body, event is at most about 70 B
 
 #endif
\ No newline at end of file
@@ -0,0 +1,13 @@
+#ifndef CONNECTIVITY_H
+#define CONNECTIVITY_H
+
+#include <stdint.h>
+
+void beginConnectivityMonitor();
+void resetConnectivityMonitor();
+void reportConnectivitySuccess();
+void reportConnectivityFailure();
+void handleConnectivityMonitor();
+bool getInternetConnection();
+
+#endif
@@ -1,10 +1,50 @@
 #ifndef CONSOLE_H
 #define CONSOLE_H
 
+#include "deferredLog.h"
+
 #define CONSOLE_SERIAL Serial
 #define CONSOLE_BAUDRATE 115200
 
 #define CONSOLE(x) {CONSOLE_SERIAL.print(x);}
 #define CONSOLE_CRLF(x) {CONSOLE_SERIAL.println(x);}
 
-#endif
\ No newline at end of file
+/* Leveled log for hot paths, one line per call, printf format with integer (%lu, %ld, %lx, %c) or string literal (%s) arguments.
+ * Levels above LOG_LEVEL are compiled out, arguments are not even evaluated. Enabled call only stores format address
+ * and arguments (see deferredLog.h), so lines come out a bit later than CONSOLE ones printed around them.
+ */
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARNING 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO // build_flags = -DLOG_LEVEL=4 for debug
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) {deferLog(__VA_ARGS__);}
+#else
+#define LOG_ERROR(...) {}
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARNING
+#define LOG_WARNING(...) {deferLog(__VA_ARGS__);}
+#else
+#define LOG_WARNING(...) {}
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) {deferLog(__VA_ARGS__);}
+#else
+#define LOG_INFO(...) {}
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) {deferLog(__VA_ARGS__);}
+#else
+#define LOG_DEBUG(...) {}
+#endif
+
+#endif
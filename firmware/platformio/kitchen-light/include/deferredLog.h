@@ -0,0 +1,40 @@
+#ifndef DEFERRED_LOG_H
+#define DEFERRED_LOG_H
+
+#include <stdint.h>
+#include <type_traits>
+
+#include "conf.h"
+
+/* Record is format address plus raw arguments, nothing is formatted by the caller.
+ * Format has to be a string literal, %s argument as well (only addresses are kept, they have to outlive the record).
+ */
+template<typename T>
+inline unsigned long logArgument(T value)
+{
+    static_assert(std::is_integral<T>::value || std::is_enum<T>::value, "deferred log takes integers and string literals only");
+
+    return (unsigned long)value; // same width as pointer on both ESP32 and 64-bit host
+}
+
+inline unsigned long logArgument(const char *text)
+{
+    return (unsigned long)(uintptr_t)text;
+}
+
+void pushLogRecord(const char *format, const unsigned long *arguments);
+
+// use LOG_ERROR .. LOG_DEBUG from console.h, they compile out below LOG_LEVEL
+template<typename... Arguments>
+inline void deferLog(const char *format, Arguments... arguments)
+{
+    static_assert(sizeof...(arguments) <= LOG_MAX_ARGUMENTS, "too many arguments for one log record");
+
+    const unsigned long values[LOG_MAX_ARGUMENTS] = {logArgument(arguments)...};
+
+    pushLogRecord(format, values);
+}
+
+void beginDeferredLog();
+
+#endif
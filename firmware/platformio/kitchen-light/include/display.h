@@ -5,6 +5,7 @@
 #include <Adafruit_ST7789.h> // Hardware-specific library for ST7789
 #include <FastLED.h>
 #include "utilities.h"
+#include "forecast.h"
 #include <Preferences.h>
 
 void setupDisplay();
@@ -20,6 +21,7 @@ void loadDisplayColorHue(uint16_t currentColorHueIndex, uint16_t previousColorHu
 void updateDisplayColorHue(uint16_t currentColorHueIndex, uint16_t previousColorHueIndex);
 void loadDisplayColorTemperature(uint16_t currentColorTemperatureIndex, uint16_t previousColorTemperatureIndex);
 void updateDisplayColorTemperature(uint16_t currentColorTemperatureIndex, uint16_t previousColorTemperatureIndex);
+void loadDisplayForecast(const ForecastDay *days, uint8_t numberOfDays);
 void loadAndExecuteFactoryReset(Preferences *preferences);
 void updateMainScreen(bool internetConnection, bool offlineMode, bool validWifiSetup, bool validWeather, bool validDateTime, bool forceAll, uint8_t hour, uint8_t minute, uint8_t day, uint8_t month, uint16_t year, float temperature, uint8_t humidity, float windSpeed, Weather weather, WifiSignal wifiSingal);
 void clearDisplay();
@@ -0,0 +1,44 @@
+#ifndef FORECAST_H
+#define FORECAST_H
+
+#include <Stream.h>
+#include <time.h>
+#include "utilities.h"
+#include "conf.h"
+
+// 5 bytes per 3-hourly sample, whole 5 day forecast fits in about 200 bytes
+struct __attribute__((packed)) ForecastSample
+{
+    int16_t temperature_dC; // 0.1 °C
+    uint8_t humidity; // %
+    uint8_t windSpeed; // m/s, rounded
+    uint8_t weather; // Weather
+};
+
+/* Fixed-size ring of consecutive samples, FORECAST_SAMPLE_PERIOD_S apart.
+ * Only epoch of the oldest sample is stored, when ring is full the oldest sample is overwritten.
+ */
+struct ForecastRing
+{
+    uint32_t firstEpoch;
+    uint8_t head; // index of the oldest sample
+    uint8_t count;
+    ForecastSample samples[FORECAST_MAX_SAMPLES];
+};
+
+// one column of forecast screen
+struct ForecastDay
+{
+    time_t epoch;
+    int16_t minTemperature_dC;
+    int16_t maxTemperature_dC;
+    Weather weather;
+};
+
+void forecastClear(ForecastRing *forecast);
+bool forecastPush(ForecastRing *forecast, uint32_t epoch, const ForecastSample *sample);
+bool forecastGet(const ForecastRing *forecast, uint8_t index, ForecastSample *sample, uint32_t *epoch);
+bool parseForecastJson(Stream &stream, ForecastRing *forecast);
+uint8_t forecastDailySummary(const ForecastRing *forecast, time_t now, ForecastDay *days, uint8_t maxDays);
+
+#endif
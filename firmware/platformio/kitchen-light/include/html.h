@@ -1,8 +1,10 @@
 #ifndef HTML_H
 #define HTML_H
 
-extern const char* htmlWebPageForm;
-extern const char* htmlWebPageCompleteFormatterCityAndCountryCode;
-extern const char* htmlWebPageCompleteFormatterLatAndLon;
+// setup form itself is in web/setup.html, served gzipped (see setupPage.h)
+// pages below are templates, see webTemplate.h
+
+extern const char* htmlWebPageCompleteCityAndCountryCode;
+extern const char* htmlWebPageCompleteLatAndLon;
 
 #endif
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef HTTP_CONNECTION_H
+#define HTTP_CONNECTION_H
+
+#include <Stream.h>
+#include <WiFiClient.h>
+
+// negative results of httpGet(), positive ones are HTTP status codes
+enum HttpError {HTTP_ERROR_URL = -1, HTTP_ERROR_DNS = -2, HTTP_ERROR_CONNECT = -3, HTTP_ERROR_SEND = -4, HTTP_ERROR_TIMEOUT = -5, HTTP_ERROR_PROTOCOL = -6};
+
+enum class HttpBodyEncoding {NONE, CONTENT_LENGTH, CHUNKED, UNTIL_CLOSE};
+
+// where time of the last request went, phases skipped thanks to DNS cache or connection reuse are 0
+struct HttpTiming
+{
+    uint32_t dnsMs;
+    uint32_t connectMs;
+    uint32_t firstByteMs; // request sent until status line arrived
+    uint32_t bodyMs; // headers received until body fully read
+    bool dnsCached;
+    bool connectionReused;
+};
+
+struct HttpStats
+{
+    uint32_t requests;
+    uint32_t failures;
+    uint32_t dnsLookups;
+    uint32_t connectionsOpened;
+    uint32_t connectionsReused;
+    HttpTiming lastTiming;
+};
+
+/* Response body as a stream, with transfer encoding already removed.
+ * Ends (read() returns -1) at the end of the body, so connection can be used for the next request.
+ */
+class HttpBodyStream : public Stream
+{
+    public:
+        void begin(WiFiClient *client, HttpBodyEncoding encoding, uint32_t contentLength);
+        bool finished();
+        bool drain();
+
+        int available() override;
+        int read() override;
+        int peek() override;
+        size_t write(uint8_t) override;
+
+    private:
+        bool nextChunk();
+
+        WiFiClient *client = nullptr;
+        HttpBodyEncoding encoding = HttpBodyEncoding::NONE;
+        uint32_t remaining = 0; // of the whole body or of the current chunk
+        bool chunkStarted = false;
+        bool lastChunk = false;
+        bool error = false;
+};
+
+int httpGet(const char *url);
+Stream& httpBody();
+void httpEnd();
+const HttpStats* getHttpStats();
+
+#endif
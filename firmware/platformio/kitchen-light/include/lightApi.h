@@ -0,0 +1,20 @@
+#ifndef LIGHT_API_H
+#define LIGHT_API_H
+
+#include "webServer.h"
+
+/* JSON API in station mode, for anything else than the two knobs (home automation, phone, ...)
+ *
+ * GET /api/state -> {"brightness":255,"pickerType":"COLOR_HUE","hueIndex":0,"temperatureIndex":0,"ledCount":60}
+ * PUT /api/state with any subset of the same fields -> state as it will be once applied
+ * invalid request -> 400 {"error":"<invalid field or reason>"}
+ *
+ * GET /api/live upgrades to WebSocket for live control, binary messages only:
+ * client -> light: [0x01][brightness][R][G][B][transition ms, uint16 little endian], tens per second are fine, light takes the latest one every LED frame
+ * light -> client: [0x02][brightness][R][G][B], right after connecting and whenever light changes (knobs and JSON API included)
+ */
+void handleLightApiRequest(WebRequest *request, WebResponse *response);
+void handleLightApiWebSocket(WebSocketEvent event, uint8_t client, const uint8_t *data, uint16_t length);
+void handleLightApi();
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <Print.h>
+
+// histograms first, see metricDescriptors in metrics.cpp (same order)
+enum class Metric : uint8_t
+{
+    LOOP_DURATION_US,
+    DISPLAY_UPDATE_US,
+    LED_SHOW_US,
+    HTTP_REQUEST_MS,
+    PING_MS,
+    INPUT_LATENCY_US,
+    HTTP_REQUESTS,
+    HTTP_FAILURES,
+    PING_TIMEOUTS,
+    WEB_REQUESTS,
+    UI_WAKEUPS,
+    NVS_WRITES,
+    LOG_DROPPED,
+    FREE_HEAP_BYTES,
+    MIN_FREE_HEAP_BYTES,
+    LARGEST_FREE_BLOCK_BYTES,
+    COUNT
+};
+
+void metricIncrement(Metric metric, uint32_t value = 1);
+void metricSet(Metric metric, uint32_t value);
+void metricObserve(Metric metric, uint32_t value);
+void printMetrics(Print *out);
+size_t renderMetrics(char *buffer, size_t size);
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef NETWORK_TASK_H
+#define NETWORK_TASK_H
+
+#include <stdint.h>
+#include "utilities.h"
+#include "weather.h"
+#include "forecast.h"
+
+enum class NetworkMessageType {NONE, WEATHER, WIFI_SIGNAL, INTERNET_CONNECTION, WIFI_SETUP, OFFLINE_MODE};
+
+struct WeatherUpdate
+{
+    bool valid;
+    uint32_t syncTimer; // millis() of the fetch, can be in the past when weather was restored from cache
+    WeatherData weatherData;
+};
+
+struct NetworkMessage
+{
+    NetworkMessageType type;
+    union
+    {
+        WeatherUpdate weatherUpdate;
+        WifiSignal wifiSignal;
+        bool internetConnection;
+        bool validWifiSetup;
+        bool offlineMode;
+    };
+};
+
+// what UI loop shows on LED strip, published for JSON API
+struct LightState
+{
+    uint8_t brightness;
+    uint8_t red; // color on LED strip, from picker or from live control
+    uint8_t green;
+    uint8_t blue;
+    ColorPickerType colorPickerType;
+    uint16_t colorHueIndex;
+    uint16_t colorTemperatureIndex;
+    uint16_t numberOfLeds;
+};
+
+// bits of LightCommand.fields
+#define LIGHT_COMMAND_BRIGHTNESS (1 << 0)
+#define LIGHT_COMMAND_COLOR_PICKER_TYPE (1 << 1)
+#define LIGHT_COMMAND_COLOR_HUE_INDEX (1 << 2)
+#define LIGHT_COMMAND_COLOR_TEMPERATURE_INDEX (1 << 3)
+#define LIGHT_COMMAND_NUMBER_OF_LEDS (1 << 4)
+
+// from network task to UI loop, only fields with their bit set are applied (values are already validated)
+struct LightCommand
+{
+    uint8_t fields;
+    LightState state;
+};
+
+// from WebSocket to UI loop, only the latest one matters (values are already validated)
+struct LiveControl
+{
+    uint8_t brightness;
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+    uint16_t transitionMs;
+};
+
+void beginNetworkTask(void (*networkSetup)(), uint32_t (*networkLoop)());
+bool postNetworkMessage(const NetworkMessage *message);
+bool receiveNetworkMessage(NetworkMessage *message);
+void postForecast(const ForecastRing *forecast);
+bool receiveForecast(ForecastRing *forecast);
+void postLightState(const LightState *lightState);
+bool peekLightState(LightState *lightState);
+bool postLightCommand(const LightCommand *command);
+bool receiveLightCommand(LightCommand *command);
+void postLiveControl(const LiveControl *liveControl);
+bool receiveLiveControl(LiveControl *liveControl);
+bool liveControlPending();
+
+#endif
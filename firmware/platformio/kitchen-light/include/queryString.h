@@ -0,0 +1,19 @@
+#ifndef QUERY_STRING_H
+#define QUERY_STRING_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// both point into the tokenized buffer, already decoded and terminated
+struct QueryParameter
+{
+    const char *key;
+    const char *value;
+    uint16_t valueLength;
+};
+
+char* findQueryString(char *target);
+bool nextQueryParameter(char **cursor, QueryParameter *parameter);
+bool copyQueryValue(const QueryParameter *parameter, char *destination, uint16_t maxLength);
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+
+#include "conf.h"
+
+#define SCHEDULER_NO_TASK 0xFF
+
+struct SchedulerTask
+{
+    const char *name;
+    void (*function)();
+    uint32_t periodMs; // 0 for one-shot task
+    uint32_t dueMs; // deadline, task runs in the first runScheduler() at or after it
+    bool armed;
+    uint32_t runs;
+    uint64_t runtimeUs;
+    uint32_t maxRuntimeUs;
+    uint32_t maxLatenessMs; // how long after deadline it ran, at worst
+};
+
+/* One per task (UI loop, network task), never shared between them.
+ * Time is always passed by caller (millis()), so the same code runs on virtual clock as well.
+ */
+struct Scheduler
+{
+    const char *name;
+    SchedulerTask tasks[SCHEDULER_MAX_TASKS];
+    uint8_t taskCount;
+};
+
+void beginScheduler(Scheduler *scheduler, const char *name);
+uint8_t addSchedulerTask(Scheduler *scheduler, const char *name, void (*function)(), uint32_t periodMs, uint32_t delayMs, uint32_t now);
+void scheduleTask(Scheduler *scheduler, uint8_t task, uint32_t delayMs, uint32_t now);
+void cancelTask(Scheduler *scheduler, uint8_t task);
+bool taskArmed(const Scheduler *scheduler, uint8_t task);
+uint32_t nextSchedulerDeadline(const Scheduler *scheduler, uint32_t now);
+uint32_t runScheduler(Scheduler *scheduler, uint32_t now);
+void printSchedulerStats(const Scheduler *scheduler, uint32_t now);
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef SETUP_PAGE_H
+#define SETUP_PAGE_H
+
+#include <stdint.h>
+
+// generated from web/setup.html by scripts/gzipSetupPage.py (on every build), see src/setupPage.cpp
+extern const char *setupPageEtag; // quoted, as sent in ETag header
+extern const uint32_t setupPageGzipLength;
+extern const uint8_t setupPageGzip[];
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef STALL_PROFILER_H
+#define STALL_PROFILER_H
+
+#include <stdint.h>
+
+#include "conf.h"
+
+enum class StallLoop : uint8_t {UI, NETWORK, COUNT};
+
+// every site belongs to one loop, see stallSites in stallProfiler.cpp (same order)
+enum class StallSite : uint8_t
+{
+    NETWORK_MESSAGES,
+    LIGHT_COMMANDS,
+    ENCODERS,
+    FACTORY_RESET,
+    SCREEN_REDRAW,
+    MAIN_SCREEN,
+    LED_SHOW,
+    NVS_WRITE,
+    WIFI,
+    WEB_SERVER,
+    CONNECTIVITY,
+    WEATHER_HTTP,
+    FORECAST_HTTP,
+    COUNT
+};
+
+/* Scoped probe, measures from construction to end of scope:
+ *
+ * {
+ *     StallProbe probe(StallSite::MAIN_SCREEN);
+ *     ...
+ * }
+ *
+ * Probes may nest, site which blocked an iteration is named by its own time (nested probes subtracted).
+ */
+class StallProbe
+{
+    public:
+        StallProbe(StallSite site);
+        ~StallProbe();
+
+    private:
+        StallSite site;
+        uint32_t beginUs;
+};
+
+void stallLoopBegin(StallLoop loop);
+void stallLoopEnd(StallLoop loop);
+void printStallProfile();
+
+#endif
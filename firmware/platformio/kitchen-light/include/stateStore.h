@@ -0,0 +1,70 @@
+#ifndef STATE_STORE_H
+#define STATE_STORE_H
+
+#include <stdint.h>
+#include <FastLED.h>
+
+#include "utilities.h"
+#include "conf.h"
+
+enum class StateField : uint8_t
+{
+    BRIGHTNESS,
+    COLOR_PICKER_TYPE,
+    COLOR_HUE_INDEX,
+    COLOR_TEMPERATURE_INDEX,
+    NUMBER_OF_LEDS,
+    LIVE_COLOR, // liveColorActive or liveColor
+    WIFI_SETUP,
+    OFFLINE_MODE,
+    INTERNET_CONNECTION,
+    WIFI_SIGNAL,
+    WEATHER, // validWeather, or new weather data (kept outside of store), see markStateChanged()
+    COUNT
+};
+
+#define STATE_FIELD(field) (1UL << (uint8_t)(field))
+#define STATE_FIELDS_SETTINGS (STATE_FIELD(StateField::BRIGHTNESS) | STATE_FIELD(StateField::COLOR_PICKER_TYPE) | STATE_FIELD(StateField::COLOR_HUE_INDEX) | STATE_FIELD(StateField::COLOR_TEMPERATURE_INDEX)) // set by knobs and JSON API, saved in preferences
+#define STATE_FIELDS_LIGHT (STATE_FIELDS_SETTINGS | STATE_FIELD(StateField::LIVE_COLOR) | STATE_FIELD(StateField::NUMBER_OF_LEDS)) // everything LED strip shows
+#define STATE_FIELDS_NETWORK (STATE_FIELD(StateField::WIFI_SETUP) | STATE_FIELD(StateField::OFFLINE_MODE) | STATE_FIELD(StateField::INTERNET_CONNECTION) | STATE_FIELD(StateField::WIFI_SIGNAL) | STATE_FIELD(StateField::WEATHER))
+
+// UI loop state, owned by UI loop only (network task sees it through light state mailbox)
+struct UiState
+{
+    uint8_t brightness;
+    ColorPickerType colorPickerType;
+    uint16_t colorHueIndex;
+    uint16_t colorTemperatureIndex;
+    uint16_t numberOfLeds;
+    bool liveColorActive; // color from live control overrides picker color
+    CRGB liveColor;
+    bool validWifiSetup;
+    bool offlineMode;
+    bool internetConnection;
+    WifiSignal wifiSignal;
+    bool validWeather;
+};
+
+/* Subscriber gets state as it is now, state as it was at the previous dispatch and which fields changed in between
+ * (only fields it subscribed to, changed back and forth in between counts as changed).
+ */
+typedef void (*StateSubscriber)(const UiState *state, const UiState *previous, uint32_t changedFields);
+
+void beginStateStore(const UiState *initialState);
+bool subscribeState(uint32_t fields, StateSubscriber subscriber);
+const UiState* uiState();
+void setBrightness(uint8_t brightness);
+void setColorPickerType(ColorPickerType colorPickerType);
+void setColorHueIndex(uint16_t colorHueIndex);
+void setColorTemperatureIndex(uint16_t colorTemperatureIndex);
+void setNumberOfLeds(uint16_t numberOfLeds);
+void setLiveColor(bool liveColorActive, CRGB liveColor);
+void setValidWifiSetup(bool validWifiSetup);
+void setOfflineMode(bool offlineMode);
+void setInternetConnection(bool internetConnection);
+void setWifiSignal(WifiSignal wifiSignal);
+void setValidWeather(bool validWeather);
+void markStateChanged(StateField field);
+void dispatchStateChanges();
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef TIME_SYNC_H
+#define TIME_SYNC_H
+
+#include <stdint.h>
+#include <time.h>
+
+/* NONE - clock is not valid (power-on, never synced, or estimated error too large)
+ * RESTORED - clock carried over restart, no NTP answer since boot yet
+ * SYNCED - NTP answered recently
+ * FREE_RUNNING - no NTP answer for a while, but estimated error is still acceptable
+ */
+enum class TimeQuality {NONE, RESTORED, SYNCED, FREE_RUNNING};
+
+void beginTimeSync(const char *timeZone);
+void startTimeSync();
+TimeQuality getTimeQuality();
+bool getLocalDateTime(struct tm *timeInfo);
+
+extern const char* timeQualityString[];
+
+#endif
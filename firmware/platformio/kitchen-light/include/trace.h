@@ -0,0 +1,17 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <Print.h>
+
+#include "stallProfiler.h"
+
+// name has to be a string literal (only its address is recorded), loop is the thread event shows up on
+void traceBegin(const char *name, StallLoop loop);
+void traceEnd(const char *name, StallLoop loop);
+void traceInstant(const char *name, StallLoop loop);
+void printTrace(Print *out);
+size_t renderTrace(char *buffer, size_t size);
+
+#endif
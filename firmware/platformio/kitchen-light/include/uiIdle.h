@@ -0,0 +1,15 @@
+#ifndef UI_IDLE_H
+#define UI_IDLE_H
+
+#include <stdint.h>
+
+/* UI loop sleeps (blocks) instead of spinning while nothing happens on screen.
+ * Anything that needs its attention wakes it: knob and switch interrupts, network task posting a message.
+ */
+void beginUiIdle();
+void wakeUiLoop();
+void wakeUiLoopFromInput();
+void idleUiLoop(uint32_t timeoutMs);
+bool takeInputTimestamp(uint32_t *inputUs);
+
+#endif
@@ -4,7 +4,7 @@
 #include <FastLED.h>
 #include "conf.h"
 
-enum class ScreenState {NONE, MAIN, BRIGHTNESS, COLOR};
+enum class ScreenState {NONE, MAIN, BRIGHTNESS, COLOR, FORECAST};
 enum class ColorPickerType {NONE, COLOR_TEMPERATURE, COLOR_HUE};
 enum class WifiSignal {NONE, DISCONNECTED, BAD, GOOD, EXCELLENT};
 enum class Weather {    NONE, 
@@ -24,8 +24,11 @@ extern const char* NTP_server_domain;
 extern const IPAddress pingIp;
 extern const char* openWeatherServerUrlformatableCityAndCountryCode;
 extern const char* openWeatherServerUrlformatableLatLon;
+extern const char* openWeatherForecastUrlformatableCityAndCountryCode;
+extern const char* openWeatherForecastUrlformatableLatLon;
 
 extern const char* monthNames[];
+extern const char* dayNames[];
 extern const char* stateString[];
 extern const char* CPT_String[];
 extern const char* wifiSignalString[];
@@ -34,4 +37,6 @@ extern const char* weatherString[];
 extern char defaultSoftAP_ssid[MAX_SOFTAP_SSID_LENGTH];
 extern char defaultSoftAP_pwd[MAX_SOFTAP_PWD_LENGTH];
 
+uint32_t fnv1aHash(const uint8_t *data, size_t length);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,21 @@
+#ifndef WEATHER_H
+#define WEATHER_H
+
+#include <Stream.h>
+#include "utilities.h"
+
+struct WeatherData
+{
+    float temperature_C;
+    uint8_t humidity;
+    float windSpeed;
+    Weather weather;
+};
+
+Weather weatherFromOpenweatherIcon(const char* openweatherIconString);
+bool parseWeatherJson(Stream &stream, WeatherData *weatherData);
+uint32_t weatherLocationHash(const char *serverURL);
+void saveWeatherCache(const WeatherData *weatherData, uint32_t locationHash);
+bool loadWeatherCache(WeatherData *weatherData, uint32_t locationHash, uint32_t *ageMs);
+
+#endif
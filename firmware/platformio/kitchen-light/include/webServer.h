@@ -0,0 +1,62 @@
+#ifndef WEB_SERVER_H
+#define WEB_SERVER_H
+
+#include <stdint.h>
+
+#include "conf.h"
+#include "webTemplate.h"
+
+enum class WebMethod {OTHER, GET, HEAD, POST, PUT};
+
+struct WebRequest
+{
+    WebMethod method;
+    char target[WEB_SERVER_MAX_TARGET_LENGTH + 16]; // path with query, as received (still URL encoded), whole request line while it is read
+    char ifNoneMatch[WEB_SERVER_MAX_ETAG_LENGTH + 1]; // ETag(s) of cached copy browser has, empty if none
+    char body[WEB_SERVER_MAX_REQUEST_BODY_SIZE + 1]; // terminated, only with Content-Length (chunked request body is not supported)
+    uint16_t bodyLength;
+    bool webSocketUpgrade; // "Upgrade: websocket", handler may accept it by webAcceptWebSocket()
+    char webSocketKey[WEB_SOCKET_KEY_LENGTH + 1];
+};
+
+/* Body either points to constant data (pages in flash), to buffer, when it was generated by webRespondFormatted(),
+ * to heap block of webAllocateBody(), which server frees once response is done,
+ * or to template, which is rendered straight to the socket while sending (templateValueCount > 0).
+ * Response is sent after handler returns, in pieces, so body (and template values) has to stay valid until then.
+ * Optional headers (encoding, ETag) are left out when NULL.
+ */
+struct WebResponse
+{
+    uint16_t status;
+    const char *contentType;
+    const char *contentEncoding;
+    const char *etag;
+    const char *body;
+    uint32_t bodyLength;
+    char buffer[WEB_SERVER_MAX_BODY_SIZE + 1];
+    char *allocatedBody; // NULL unless webAllocateBody() was called
+    uint32_t allocatedBodySize;
+    WebTemplateValue templateValues[WEB_TEMPLATE_MAX_VALUES];
+    uint8_t templateValueCount;
+};
+
+enum class WebSocketEvent {OPEN, MESSAGE, CLOSE};
+
+typedef void (*WebRequestHandler)(WebRequest *request, WebResponse *response); // request may be modified, e.g. target tokenized in place
+typedef void (*WebSocketHandler)(WebSocketEvent event, uint8_t client, const uint8_t *data, uint16_t length); // data only with MESSAGE (whole binary message)
+
+void beginWebServer(WebRequestHandler handler, WebSocketHandler webSocketHandler = nullptr);
+void handleWebServer();
+bool webServerIdle();
+void webRespond(WebResponse *response, uint16_t status, const char *contentType, const char *body);
+void webRespondFormatted(WebResponse *response, uint16_t status, const char *contentType, const char *format, ...);
+char* webAllocateBody(WebResponse *response, uint32_t size);
+void webRespondStatic(const WebRequest *request, WebResponse *response, const char *contentType, const char *contentEncoding, const uint8_t *body, uint32_t bodyLength, const char *etag);
+void webRespondTemplate(WebResponse *response, uint16_t status, const char *contentType, const char *text, const WebTemplateValue *values, uint8_t valueCount);
+void webAcceptWebSocket(const WebRequest *request, WebResponse *response);
+bool webSocketSend(uint8_t client, const uint8_t *data, uint16_t length); // at most WEB_SOCKET_MAX_SEND_PAYLOAD, false when not sent (client too slow is closed)
+uint8_t webSocketBroadcast(const uint8_t *data, uint16_t length);
+
+extern const char* webMethodString[];
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef WEB_TEMPLATE_H
+#define WEB_TEMPLATE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <Print.h>
+
+// "{{name}}" in template is replaced by value, HTML escaped
+struct WebTemplateValue
+{
+    const char *name;
+    const char *value;
+};
+
+// where rendering stopped, so it can continue once socket takes more
+struct WebTemplateCursor
+{
+    const char *position; // in template
+    const char *value; // in value being substituted, NULL in literal part
+    uint8_t entityOffset; // part of escape entity already written
+};
+
+uint32_t webTemplateLength(const char *text, const WebTemplateValue *values, uint8_t valueCount);
+void webTemplateBegin(WebTemplateCursor *cursor, const char *text);
+size_t webTemplateWrite(WebTemplateCursor *cursor, const WebTemplateValue *values, uint8_t valueCount, Print *out, size_t maxLength);
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef WIFI_CONNECTION_H
+#define WIFI_CONNECTION_H
+
+#include <stdint.h>
+
+enum class WifiConnectionState {NONE, NO_CREDENTIALS, CONNECTING, CONNECTED, WAITING_FOR_RETRY, FAILED};
+enum class WifiConnectionEvent {NONE, GOT_IP, DISCONNECTED, TICK};
+
+typedef void (*WifiConnectionStateCallback)(WifiConnectionState state);
+
+/* State machine talks to the radio only through this driver and gets time as parameter.
+ * Default driver wraps Arduino WiFi, a scripted one can be passed instead and fed by processWifiConnectionEvent().
+ */
+struct WifiConnectionDriver
+{
+    void (*begin)(const char *ssid, const char *pwd);
+    void (*disconnect)();
+};
+
+void beginWifiConnection(const char *ssid, const char *pwd, WifiConnectionStateCallback callback, const WifiConnectionDriver *driver = nullptr);
+void processWifiConnectionEvent(WifiConnectionEvent event, uint32_t now);
+void handleWifiConnection();
+WifiConnectionState getWifiConnectionState();
+
+extern const char* wifiConnectionStateString[];
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef ZONE_TABLE_H
+#define ZONE_TABLE_H
+
+#include <stdint.h>
+
+// generated from web/countries.json and web/zones.json by scripts/generateZoneTable.py (on every build), see src/zoneTableData.cpp
+extern const char *zoneTableEtag; // quoted, as sent in ETag header
+extern const uint32_t zoneTableLength; // inflated
+extern const uint32_t zoneTableGzipLength;
+extern const uint8_t zoneTableGzip[];
+
+bool zoneTableContains(const char *posixTz, const char *countryCode);
+
+#endif
@@ -0,0 +1,6 @@
+# Builds env:fuzz with clang, libFuzzer comes only with it (gcc of native platform has no -fsanitize=fuzzer).
+# Sanitizers have to be on link line as well, build_flags go only to compiler.
+Import("env")
+
+env.Replace(CC="clang", CXX="clang++", LINK="clang++")
+env.Append(LINKFLAGS=["-fsanitize=fuzzer,address,undefined"])
@@ -0,0 +1,114 @@
+# Packs web/countries.json and web/zones.json into one gzipped binary table in src/zoneTableData.cpp (setup page dropdowns, time zone validation).
+# Runs before every build (extra_scripts in platformio.ini), file is rewritten only when the data changed.
+# Can be run by hand as well: python scripts/generateZoneTable.py
+#
+# Table (little endian, strings are terminated, read in order):
+#   uint16 countryCount, uint8 regionCount, uint8 posixTzCount, uint16 zoneCount
+#   countryCount x {char code[2], name}
+#   regionCount x {name} (zone name without its last part, "America/Argentina", may be empty)
+#   posixTzCount x {posixTz} (every one once, most of them are shared by several zones)
+#   zoneCount x {uint8 region, uint8 posixTz, city} (zone name is region + "/" + city, or just city when region is empty)
+import gzip
+import json
+import os
+import struct
+
+# begin conf
+countriesFileName = os.path.join("web", "countries.json") # from https://gist.github.com/ssskip/5a94bfcd2835bf1dea52
+zonesFileName = os.path.join("web", "zones.json") # from https://github.com/nayarsystems/posix_tz_db/blob/master/zones.json
+outputFileName = os.path.join("src", "zoneTableData.cpp")
+bytesPerLine = 32
+# end conf
+
+try:
+    Import("env") # PlatformIO (SCons) build
+    projectDirectory = env.subst("$PROJECT_DIR")
+except NameError:
+    projectDirectory = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# same as fnv1aHash() in utilities.cpp
+def fnv1a(data):
+    hash = 2166136261
+
+    for byte in data:
+        hash = ((hash ^ byte) * 16777619) & 0xFFFFFFFF
+
+    return hash
+
+# every distinct string once, in order of first use
+def buildStringPool(strings):
+    pool = []
+
+    for string in strings:
+        if string not in pool:
+            pool.append(string)
+
+    if len(pool) > 255:
+        raise ValueError("too many distinct strings for 8 bit index")
+
+    return pool
+
+def encodeString(string):
+    return string.encode("utf-8") + b"\0"
+
+def buildTable(countries, zones):
+    zoneParts = [(name.rpartition("/")[0], name.rpartition("/")[2], posixTz) for name, posixTz in zones.items()]
+    regions = buildStringPool([region for region, city, posixTz in zoneParts])
+    posixTzs = buildStringPool([posixTz for region, city, posixTz in zoneParts])
+
+    table = struct.pack("<HBBH", len(countries), len(regions), len(posixTzs), len(zones))
+
+    for code, name in countries.items():
+        table += code.encode("ascii")[:2].ljust(2, b"\0") + encodeString(name)
+
+    for region in regions:
+        table += encodeString(region)
+
+    for posixTz in posixTzs:
+        table += encodeString(posixTz)
+
+    for region, city, posixTz in zoneParts:
+        table += struct.pack("<BB", regions.index(region), posixTzs.index(posixTz)) + encodeString(city)
+
+    return table
+
+def formatArray(name, data):
+    output = "const uint8_t " + name + "[" + str(len(data)) + "] = {\n"
+
+    for i in range(0, len(data), bytesPerLine):
+        output += "\t" + ",".join("0x%02x" % byte for byte in data[i:i + bytesPerLine]) + ",\n"
+
+    return output + "};\n"
+
+def generate():
+    with open(os.path.join(projectDirectory, countriesFileName), "r", encoding="utf-8") as inputFile:
+        countries = json.load(inputFile)
+
+    with open(os.path.join(projectDirectory, zonesFileName), "r", encoding="utf-8") as inputFile:
+        zones = json.load(inputFile)
+
+    table = buildTable(countries, zones)
+    compressed = gzip.compress(table, compresslevel=9, mtime=0) # no timestamp, same table gives same bytes (and ETag)
+    etag = "%08x" % fnv1a(compressed)
+
+    output = "// generated by scripts/generateZoneTable.py from " + countriesFileName.replace(os.sep, "/") + " and " + zonesFileName.replace(os.sep, "/") + ", do not edit\n"
+    output += "// " + str(len(countries)) + " countries, " + str(len(zones)) + " zones, " + str(len(table)) + " B table, " + str(len(compressed)) + " B gzipped\n"
+    output += "#include \"zoneTable.h\"\n\n"
+    output += "const char *zoneTableEtag = \"\\\"" + etag + "\\\"\";\n"
+    output += "const uint32_t zoneTableLength = " + str(len(table)) + ";\n"
+    output += "const uint32_t zoneTableGzipLength = " + str(len(compressed)) + ";\n"
+    output += formatArray("zoneTableGzip", compressed)
+
+    outputPath = os.path.join(projectDirectory, outputFileName)
+
+    if os.path.exists(outputPath):
+        with open(outputPath, "r", encoding="utf-8") as outputFile:
+            if outputFile.read() == output:
+                return
+
+    with open(outputPath, "w", encoding="utf-8", newline="\n") as outputFile:
+        outputFile.write(output)
+
+    print("Zone table: " + str(len(table)) + " B -> " + str(len(compressed)) + " B gzipped, ETag " + etag)
+
+generate()
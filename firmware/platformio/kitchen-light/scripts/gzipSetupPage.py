@@ -0,0 +1,68 @@
+# Minifies and gzips web/setup.html into src/setupPage.cpp (byte array in flash, ETag, sizes).
+# Runs before every build (extra_scripts in platformio.ini), file is rewritten only when the page changed.
+# Can be run by hand as well: python scripts/gzipSetupPage.py
+import gzip
+import os
+import re
+
+# begin conf
+inputFileName = os.path.join("web", "setup.html")
+outputFileName = os.path.join("src", "setupPage.cpp")
+bytesPerLine = 32
+# end conf
+
+try:
+    Import("env") # PlatformIO (SCons) build
+    projectDirectory = env.subst("$PROJECT_DIR")
+except NameError:
+    projectDirectory = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# only what is safe for inline script too: comments, indentation and empty lines, line breaks stay
+def minify(html):
+    html = re.sub(r"<!--.*?-->", "", html, flags=re.DOTALL)
+    lines = [line.strip() for line in html.splitlines()]
+
+    return "\n".join(line for line in lines if line != "")
+
+# same as fnv1aHash() in utilities.cpp
+def fnv1a(data):
+    hash = 2166136261
+
+    for byte in data:
+        hash = ((hash ^ byte) * 16777619) & 0xFFFFFFFF
+
+    return hash
+
+def generate():
+    with open(os.path.join(projectDirectory, inputFileName), "r", encoding="utf-8") as inputFile:
+        html = inputFile.read()
+
+    minified = minify(html).encode("utf-8")
+    compressed = gzip.compress(minified, compresslevel=9, mtime=0) # no timestamp, same page gives same bytes (and ETag)
+    etag = "%08x" % fnv1a(compressed)
+
+    output = "// generated by scripts/gzipSetupPage.py from " + inputFileName.replace(os.sep, "/") + ", do not edit\n"
+    output += "// " + str(len(html.encode("utf-8"))) + " B original, " + str(len(minified)) + " B minified, " + str(len(compressed)) + " B gzipped\n"
+    output += "#include \"setupPage.h\"\n\n"
+    output += "const char *setupPageEtag = \"\\\"" + etag + "\\\"\";\n"
+    output += "const uint32_t setupPageGzipLength = " + str(len(compressed)) + ";\n"
+    output += "const uint8_t setupPageGzip[" + str(len(compressed)) + "] = {\n"
+
+    for i in range(0, len(compressed), bytesPerLine):
+        output += "\t" + ",".join("0x%02x" % byte for byte in compressed[i:i + bytesPerLine]) + ",\n"
+
+    output += "};\n"
+
+    outputPath = os.path.join(projectDirectory, outputFileName)
+
+    if os.path.exists(outputPath):
+        with open(outputPath, "r", encoding="utf-8") as outputFile:
+            if outputFile.read() == output:
+                return
+
+    with open(outputPath, "w", encoding="utf-8", newline="\n") as outputFile:
+        outputFile.write(output)
+
+    print("Setup page: " + str(len(html.encode("utf-8"))) + " B -> " + str(len(compressed)) + " B gzipped, ETag " + etag)
+
+generate()
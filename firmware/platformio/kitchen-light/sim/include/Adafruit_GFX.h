@@ -0,0 +1,6 @@
+#ifndef SIM_ADAFRUIT_GFX_H
+#define SIM_ADAFRUIT_GFX_H
+
+#include "Arduino.h"
+
+#endif
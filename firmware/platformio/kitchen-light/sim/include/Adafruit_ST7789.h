@@ -0,0 +1,65 @@
+#ifndef SIM_ADAFRUIT_ST7789_H
+#define SIM_ADAFRUIT_ST7789_H
+
+#include "Adafruit_GFX.h"
+
+#define ST77XX_BLACK 0x0000
+#define ST77XX_WHITE 0xFFFF
+#define ST77XX_RED 0xF800
+#define ST77XX_GREEN 0x07E0
+#define ST77XX_BLUE 0x001F
+#define ST77XX_CYAN 0x07FF
+#define ST77XX_MAGENTA 0xF81F
+#define ST77XX_YELLOW 0xFFE0
+#define ST77XX_ORANGE 0xFC00
+
+/* Nothing is rendered, calls are only counted (see report): clears, draw calls and pixels they cover.
+ * Pixel counts are what the panel would be sent, lines and circles estimated from their size.
+ */
+class Adafruit_ST7789 : public Print
+{
+    public:
+        Adafruit_ST7789(int8_t cs, int8_t dc, int8_t rst) {}
+
+        void init(uint16_t width, uint16_t height, uint8_t spiMode = 0);
+        void setRotation(uint8_t rotation);
+        void invertDisplay(bool invert) {}
+        int16_t width() const { return currentWidth; }
+        int16_t height() const { return currentHeight; }
+
+        void startWrite() {}
+        void endWrite() {}
+        void writePixel(int16_t x, int16_t y, uint16_t color) { countDraw(1); }
+        void drawPixel(int16_t x, int16_t y, uint16_t color) { countDraw(1); }
+
+        void fillScreen(uint16_t color);
+        void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) { countDraw((uint32_t)abs(w) * abs(h)); }
+        void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) { countDraw(2 * (uint32_t)(abs(w) + abs(h))); }
+        void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) { countDraw(abs(h)); }
+        void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) { countDraw(abs(w)); }
+        void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) { countDraw(max(abs(x1 - x0), abs(y1 - y0)) + 1); }
+        void drawCircle(int16_t x, int16_t y, int16_t r, uint16_t color) { countDraw(6 * r + 1); }
+        void drawCircleHelper(int16_t x, int16_t y, int16_t r, uint8_t corners, uint16_t color) { countDraw(2 * r + 1); }
+        void fillCircle(int16_t x, int16_t y, int16_t r, uint16_t color) { countDraw(3 * r * r + 1); }
+        void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+
+        void setCursor(int16_t x, int16_t y) {}
+        void setTextColor(uint16_t color) {}
+        void setTextColor(uint16_t color, uint16_t background) {}
+        void setTextSize(uint8_t size) { textSize = size; }
+        void setTextSize(uint8_t sizeX, uint8_t sizeY) { textSize = max(sizeX, sizeY); }
+        void setTextWrap(bool wrap) {}
+
+        size_t write(uint8_t c) override;
+        using Print::write;
+
+    private:
+        void countDraw(uint32_t pixels);
+
+        int16_t currentWidth = 240;
+        int16_t currentHeight = 320;
+        uint8_t textSize = 1;
+        uint8_t rotation = 0;
+};
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef SIM_ARDUINO_H
+#define SIM_ARDUINO_H
+
+/* Host stand-in for the Arduino-ESP32 core, just what firmware uses.
+ * Time is virtual (see sim.h), GPIO, serial console and ESP are driven by the simulator.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <sys/time.h>
+#include <algorithm>
+
+#include "WString.h"
+#include "Print.h"
+#include "Printable.h"
+#include "Stream.h"
+#include "IPAddress.h"
+#include "esp_attr.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+
+using std::min;
+using std::max;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+#define DEC 10
+#define HEX 16
+
+#define MALLOC_CAP_8BIT (1 << 2)
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define digitalPinToInterrupt(p) (p)
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+void setup();
+void loop();
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+void attachInterrupt(uint8_t pin, void (*handler)(), int mode);
+void detachInterrupt(uint8_t pin);
+
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+
+void configTime(long gmtOffsetSec, int daylightOffsetSec, const char *server1, const char *server2 = nullptr, const char *server3 = nullptr);
+void configTzTime(const char *tz, const char *server1, const char *server2 = nullptr, const char *server3 = nullptr);
+bool getLocalTime(struct tm *info, uint32_t ms = 5000);
+
+size_t heap_caps_get_largest_free_block(uint32_t caps);
+uint32_t xPortGetCoreID();
+
+class EspClass
+{
+    public:
+        void restart();
+        uint32_t getHeapSize();
+        uint32_t getFreeHeap();
+        uint32_t getMinFreeHeap();
+        uint32_t getMaxAllocHeap();
+};
+
+extern EspClass ESP;
+
+class HardwareSerial : public Stream
+{
+    public:
+        void begin(unsigned long baud);
+        int available() override;
+        int read() override;
+        int peek() override;
+        size_t write(uint8_t c) override;
+        size_t write(const uint8_t *buffer, size_t size) override;
+        using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+/* System time is virtual as well (device clock, set by settimeofday() and simulated NTP).
+ * Firmware includes Arduino.h before anything that reads the clock, so these reach every call.
+ */
+time_t simTime(time_t *t);
+int simGettimeofday(struct timeval *tv, void *tz);
+int simSettimeofday(const struct timeval *tv, const void *tz);
+
+#ifndef SIM_NO_TIME_MACROS
+#define time(t) simTime(t)
+#define gettimeofday(tv, tz) simGettimeofday(tv, tz)
+#define settimeofday(tv, tz) simSettimeofday(tv, tz)
+#endif
+
+#endif
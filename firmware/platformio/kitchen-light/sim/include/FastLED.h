@@ -0,0 +1,67 @@
+#ifndef SIM_FASTLED_H
+#define SIM_FASTLED_H
+
+#include "Arduino.h"
+
+#define WS2812B 0
+#define GRB 0
+#define LINEARBLEND 1
+#define TypicalLEDStrip 0xFFB0F0
+
+typedef uint8_t fract8;
+
+struct CRGB
+{
+    union
+    {
+        struct
+        {
+            uint8_t r;
+            uint8_t g;
+            uint8_t b;
+        };
+        uint8_t raw[3];
+    };
+
+    enum HTMLColorCode {Black = 0x000000, White = 0xFFFFFF};
+
+    CRGB() : r(0), g(0), b(0) {}
+    CRGB(uint8_t red, uint8_t green, uint8_t blue) : r(red), g(green), b(blue) {}
+    CRGB(uint32_t colorCode) : r((colorCode >> 16) & 0xFF), g((colorCode >> 8) & 0xFF), b(colorCode & 0xFF) {}
+    CRGB(HTMLColorCode colorCode) : CRGB((uint32_t)colorCode) {}
+
+    uint8_t& operator[](uint8_t index) { return raw[index]; }
+    const uint8_t& operator[](uint8_t index) const { return raw[index]; }
+    bool operator==(const CRGB &other) const { return r == other.r && g == other.g && b == other.b; }
+    bool operator!=(const CRGB &other) const { return !(*this == other); }
+};
+
+CRGB blend(const CRGB &first, const CRGB &second, fract8 amountOfSecond);
+
+class CLEDController
+{
+    public:
+        CLEDController& setCorrection(uint32_t correction) { return *this; }
+};
+
+// counts frames pushed to the strip, nothing is drawn
+class CFastLED
+{
+    public:
+        template<int CHIPSET, int DATA_PIN, int RGB_ORDER> CLEDController& addLeds(CRGB *leds, int count) { return addLeds(leds, count); }
+        CLEDController& addLeds(CRGB *leds, int count);
+        void setBrightness(uint8_t scale) { brightness = scale; }
+        uint8_t getBrightness() { return brightness; }
+        void show();
+        void clear(bool writeData = false);
+
+    private:
+        CLEDController controller;
+        CRGB *leds = nullptr;
+        int count = 0;
+        uint8_t brightness = 255;
+};
+
+extern CFastLED FastLED;
+
+#endif
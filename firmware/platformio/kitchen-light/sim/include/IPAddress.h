@@ -0,0 +1,28 @@
+#ifndef SIM_IP_ADDRESS_H
+#define SIM_IP_ADDRESS_H
+
+#include <stdint.h>
+
+#include "Printable.h"
+#include "WString.h"
+
+class IPAddress : public Printable
+{
+    public:
+        IPAddress() {}
+        IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : bytes{a, b, c, d} {}
+        explicit IPAddress(uint32_t address) { for(int i = 0; i < 4; i++) bytes[i] = (address >> (8 * i)) & 0xFF; }
+
+        uint8_t operator[](int index) const { return bytes[index]; }
+        operator uint32_t() const { return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t)bytes[3] << 24); }
+        bool operator==(const IPAddress &other) const { return (uint32_t)*this == (uint32_t)other; }
+
+        bool fromString(const char *text);
+        String toString() const;
+        size_t printTo(Print &p) const override;
+
+    private:
+        uint8_t bytes[4] = {0, 0, 0, 0};
+};
+
+#endif
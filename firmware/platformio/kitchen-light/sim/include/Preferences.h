@@ -0,0 +1,28 @@
+#ifndef SIM_PREFERENCES_H
+#define SIM_PREFERENCES_H
+
+#include "Arduino.h"
+
+// in memory NVS, seeded by scenario, every put counts as a flash write (see report)
+class Preferences
+{
+    public:
+        bool begin(const char *name, bool readOnly = false);
+        void end() {}
+        bool clear();
+        bool isKey(const char *key);
+
+        size_t putUChar(const char *key, uint8_t value);
+        size_t putInt(const char *key, int32_t value);
+        size_t putUInt(const char *key, uint32_t value);
+        size_t putULong64(const char *key, uint64_t value);
+        size_t putBytes(const char *key, const void *value, size_t length);
+
+        uint8_t getUChar(const char *key, uint8_t defaultValue = 0);
+        int32_t getInt(const char *key, int32_t defaultValue = 0);
+        uint32_t getUInt(const char *key, uint32_t defaultValue = 0);
+        uint64_t getULong64(const char *key, uint64_t defaultValue = 0);
+        size_t getBytes(const char *key, void *buffer, size_t maxLength);
+};
+
+#endif
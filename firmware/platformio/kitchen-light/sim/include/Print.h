@@ -0,0 +1,42 @@
+#ifndef SIM_PRINT_H
+#define SIM_PRINT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+class String;
+class Printable;
+
+class Print
+{
+    public:
+        virtual ~Print() {}
+
+        virtual size_t write(uint8_t c) = 0;
+        virtual size_t write(const uint8_t *buffer, size_t size);
+        size_t write(const char *text) { return (text != nullptr) ? write((const uint8_t*)text, strlen(text)) : 0; }
+        size_t write(const char *buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+        virtual void flush() {}
+
+        size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+        size_t print(const char *text);
+        size_t print(char c);
+        size_t print(unsigned char value, int base = 10);
+        size_t print(int value, int base = 10);
+        size_t print(unsigned int value, int base = 10);
+        size_t print(long value, int base = 10);
+        size_t print(unsigned long value, int base = 10);
+        size_t print(long long value, int base = 10);
+        size_t print(unsigned long long value, int base = 10);
+        size_t print(double value, int digits = 2);
+        size_t print(const String &text);
+        size_t print(const Printable &printable);
+
+        size_t println();
+        template<typename T> size_t println(const T &value) { size_t n = print(value); return n + println(); }
+        template<typename T> size_t println(const T &value, int format) { size_t n = print(value, format); return n + println(); }
+};
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef SIM_PRINTABLE_H
+#define SIM_PRINTABLE_H
+
+#include "Print.h"
+
+class Printable
+{
+    public:
+        virtual ~Printable() {}
+        virtual size_t printTo(Print &p) const = 0;
+};
+
+#endif
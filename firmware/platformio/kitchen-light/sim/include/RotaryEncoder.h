@@ -0,0 +1,23 @@
+#ifndef SIM_ROTARY_ENCODER_H
+#define SIM_ROTARY_ENCODER_H
+
+// position is moved by scripted knob turns (see simPeripherals.cpp), tick() has nothing to decode
+class RotaryEncoder
+{
+    public:
+        enum class LatchMode {FOUR3 = 1, FOUR0 = 2, TWO03 = 3};
+        enum class Direction {NOROTATION = 0, CLOCKWISE = 1, COUNTERCLOCKWISE = -1};
+
+        RotaryEncoder(int pin1, int pin2, LatchMode mode = LatchMode::FOUR0);
+
+        void tick() {}
+        long getPosition() { return position; }
+        Direction getDirection();
+        void setPosition(long newPosition) { position = newPosition; reportedPosition = newPosition; }
+
+        int pin1;
+        long position = 0;
+        long reportedPosition = 0;
+};
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef SIM_STREAM_H
+#define SIM_STREAM_H
+
+#include "Print.h"
+
+// reads wait (virtual time) up to timeout, like Arduino
+class Stream : public Print
+{
+    public:
+        virtual int available() = 0;
+        virtual int read() = 0;
+        virtual int peek() = 0;
+
+        void setTimeout(unsigned long timeoutMs) { timeout = timeoutMs; }
+        unsigned long getTimeout() const { return timeout; }
+        bool find(const char *target);
+        bool findUntil(const char *target, const char *terminator);
+        size_t readBytes(char *buffer, size_t length);
+        size_t readBytes(uint8_t *buffer, size_t length) { return readBytes((char*)buffer, length); }
+
+    protected:
+        int timedRead();
+
+        unsigned long timeout = 1000;
+};
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef SIM_WSTRING_H
+#define SIM_WSTRING_H
+
+#include <string>
+
+// only what firmware gets back from WiFi and IPAddress
+class String
+{
+    public:
+        String(const char *text = "") : text(text != nullptr ? text : "") {}
+        String(const std::string &text) : text(text) {}
+
+        const char* c_str() const { return text.c_str(); }
+        unsigned int length() const { return text.length(); }
+        bool isEmpty() const { return text.empty(); }
+        bool operator==(const char *other) const { return text == other; }
+
+        void toCharArray(char *buffer, unsigned int size) const
+        {
+            if(size > 0)
+            {
+                buffer[text.copy(buffer, size - 1)] = '\0';
+            }
+        }
+
+    private:
+        std::string text;
+};
+
+#endif
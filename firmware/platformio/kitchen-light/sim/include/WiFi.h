@@ -0,0 +1,42 @@
+#ifndef SIM_WIFI_H
+#define SIM_WIFI_H
+
+#include "Arduino.h"
+#include "WiFiClient.h"
+#include "WiFiServer.h"
+
+/* Station is connected to the scripted access point (see simNetwork.cpp),
+ * association and its loss come back as events, the same way Arduino-ESP32 reports them.
+ */
+
+typedef enum {WL_IDLE_STATUS = 0, WL_NO_SSID_AVAIL = 1, WL_CONNECTED = 3, WL_CONNECT_FAILED = 4, WL_CONNECTION_LOST = 5, WL_DISCONNECTED = 6} wl_status_t;
+typedef enum {ARDUINO_EVENT_WIFI_STA_CONNECTED, ARDUINO_EVENT_WIFI_STA_GOT_IP, ARDUINO_EVENT_WIFI_STA_LOST_IP, ARDUINO_EVENT_WIFI_STA_DISCONNECTED} arduino_event_id_t;
+typedef enum {WIFI_OFF, WIFI_STA, WIFI_AP, WIFI_AP_STA} wifi_mode_t;
+typedef enum {WIFI_PS_NONE, WIFI_PS_MIN_MODEM, WIFI_PS_MAX_MODEM} wifi_ps_type_t;
+
+typedef arduino_event_id_t WiFiEvent_t;
+typedef struct { int reason; } WiFiEventInfo_t;
+typedef void (*WiFiEventFullCb)(WiFiEvent_t event, WiFiEventInfo_t info);
+
+class WiFiClass
+{
+    public:
+        wl_status_t status();
+        int8_t RSSI();
+        String SSID();
+        IPAddress localIP();
+        IPAddress softAPIP();
+        wl_status_t begin(const char *ssid, const char *password);
+        bool disconnect(bool wifiOff = false);
+        bool mode(wifi_mode_t mode);
+        bool softAP(const char *ssid, const char *password);
+        bool setAutoReconnect(bool autoReconnect);
+        bool setSleep(bool enabled);
+        bool setSleep(wifi_ps_type_t type);
+        int onEvent(WiFiEventFullCb callback);
+        int hostByName(const char *host, IPAddress &result);
+};
+
+extern WiFiClass WiFi;
+
+#endif
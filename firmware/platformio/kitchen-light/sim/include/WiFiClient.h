@@ -0,0 +1,40 @@
+#ifndef SIM_WIFI_CLIENT_H
+#define SIM_WIFI_CLIENT_H
+
+#include <memory>
+
+#include "Arduino.h"
+
+struct SimConnection;
+
+// copies share the connection, as with Arduino-ESP32 (last copy closes it)
+class WiFiClient : public Stream
+{
+    public:
+        WiFiClient();
+        explicit WiFiClient(std::shared_ptr<SimConnection> connection);
+
+        int connect(IPAddress ip, uint16_t port);
+        int connect(IPAddress ip, uint16_t port, int32_t timeoutMs);
+        int connect(const char *host, uint16_t port);
+        uint8_t connected();
+        operator bool();
+        int available() override;
+        int read() override;
+        int read(uint8_t *buffer, size_t size);
+        int peek() override;
+        size_t write(uint8_t c) override;
+        size_t write(const uint8_t *buffer, size_t size) override;
+        using Print::write;
+        void flush() override {}
+        void stop();
+        int setNoDelay(bool noDelay) { return 0; }
+        int setTimeout(uint32_t seconds) { Stream::setTimeout(seconds * 1000); return 0; }
+        int fd() const;
+        IPAddress remoteIP() const;
+
+    private:
+        std::shared_ptr<SimConnection> connection;
+};
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef SIM_WIFI_SERVER_H
+#define SIM_WIFI_SERVER_H
+
+#include "WiFiClient.h"
+
+// clients are scripted web clients (simWebClient.cpp), they wait in backlog until firmware accepts them
+class WiFiServer
+{
+    public:
+        WiFiServer(uint16_t port = 80) : port(port) {}
+
+        void begin();
+        void end();
+        WiFiClient available();
+        WiFiClient accept();
+        bool hasClient();
+        void setNoDelay(bool noDelay) {}
+
+    private:
+        uint16_t port;
+};
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef SIM_ESP_ATTR_H
+#define SIM_ESP_ATTR_H
+
+// every boot of the simulator is a power-on, so RTC memory starts zeroed (invalid)
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef SIM_ESP_SNTP_H
+#define SIM_ESP_SNTP_H
+
+#include <stdint.h>
+#include <sys/time.h>
+
+typedef enum {SNTP_SYNC_STATUS_RESET, SNTP_SYNC_STATUS_COMPLETED, SNTP_SYNC_STATUS_IN_PROGRESS} sntp_sync_status_t;
+
+void sntp_set_time_sync_notification_cb(void (*callback)(struct timeval *tv));
+void sntp_set_sync_interval(uint32_t intervalMs);
+bool sntp_enabled();
+void sntp_restart();
+void sntp_stop();
+sntp_sync_status_t sntp_get_sync_status();
+
+#endif
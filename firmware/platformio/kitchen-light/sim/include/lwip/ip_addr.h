@@ -0,0 +1,13 @@
+#ifndef SIM_LWIP_IP_ADDR_H
+#define SIM_LWIP_IP_ADDR_H
+
+#include <stdint.h>
+
+typedef struct
+{
+    uint32_t addr; // network order, first octet in the lowest byte
+} ip_addr_t;
+
+#define IP_ADDR4(ip, a, b, c, d) ((ip)->addr = ((uint32_t)(a)) | ((uint32_t)(b) << 8) | ((uint32_t)(c) << 16) | ((uint32_t)(d) << 24))
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef SIM_LWIP_SOCKETS_H
+#define SIM_LWIP_SOCKETS_H
+
+#include <errno.h>
+#include <stddef.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+// only send(), it goes to simulated connection with that descriptor (simNetwork.cpp), flags are the host ones
+ssize_t lwip_send(int s, const void *dataptr, size_t size, int flags);
+
+#define send(s, dataptr, size, flags) lwip_send(s, dataptr, size, flags)
+
+#endif
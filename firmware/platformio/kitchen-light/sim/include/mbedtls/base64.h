@@ -0,0 +1,8 @@
+#ifndef SIM_MBEDTLS_BASE64_H
+#define SIM_MBEDTLS_BASE64_H
+
+#include <stddef.h>
+
+int mbedtls_base64_encode(unsigned char *destination, size_t destinationLength, size_t *outputLength, const unsigned char *source, size_t sourceLength);
+
+#endif
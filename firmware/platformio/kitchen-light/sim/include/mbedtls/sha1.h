@@ -0,0 +1,9 @@
+#ifndef SIM_MBEDTLS_SHA1_H
+#define SIM_MBEDTLS_SHA1_H
+
+#include <stddef.h>
+
+// real SHA-1 (simPeripherals.cpp), WebSocket handshake of simulated web clients depends on it
+int mbedtls_sha1(const unsigned char *input, size_t length, unsigned char output[20]);
+
+#endif
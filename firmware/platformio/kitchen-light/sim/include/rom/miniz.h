@@ -0,0 +1,23 @@
+#ifndef SIM_ROM_MINIZ_H
+#define SIM_ROM_MINIZ_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* ROM inflate, on host done by zlib (link with -lz), see simPeripherals.cpp.
+ * Only setup form validation inflates zone table (see zoneTableContains()).
+ */
+typedef struct
+{
+    uint32_t m_state;
+} tinfl_decompressor;
+
+typedef enum {TINFL_STATUS_FAILED = -1, TINFL_STATUS_DONE = 0, TINFL_STATUS_NEEDS_MORE_INPUT = 1, TINFL_STATUS_HAS_MORE_OUTPUT = 2} tinfl_status;
+
+enum {TINFL_FLAG_PARSE_ZLIB_HEADER = 1, TINFL_FLAG_HAS_MORE_INPUT = 2, TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF = 4};
+
+#define tinfl_init(r) do { (r)->m_state = 0; } while(0)
+
+tinfl_status tinfl_decompress(tinfl_decompressor *r, const uint8_t *inBufferNext, size_t *inBufferSize, uint8_t *outBufferStart, uint8_t *outBufferNext, size_t *outBufferSize, const uint32_t flags);
+
+#endif
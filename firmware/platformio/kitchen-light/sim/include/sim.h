@@ -0,0 +1,148 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <functional>
+#include <map>
+#include <string>
+
+/* Host simulation of the whole device (env:sim), see sim/README.txt.
+ *
+ * UI loop (setup() + loop()) and every FreeRTOS task run as cooperative coroutines on one host thread.
+ * Time is virtual: it moves only when a task sleeps (delay, vTaskDelay, notification wait) or charges work
+ * (every millis()/micros() call costs SIM_CLOCK_READ_COST_US, every loop() SIM_LOOP_COST_US),
+ * so a week of device time runs in seconds and every run of the same scenario is identical.
+ *
+ * Scripted events (network drops, NTP and API outages, knob turns, ...) and simulated peripherals
+ * are timers, they run between tasks (like interrupts and driver events on the device) and must not block.
+ */
+
+#define SIM_CLOCK_READ_COST_US 1
+#define SIM_LOOP_COST_US 50
+#define SIM_TASK_STACK_SIZE (1024 * 1024)
+
+#define SIM_US_PER_MS 1000ULL
+#define SIM_US_PER_S 1000000ULL
+#define SIM_FOREVER UINT64_MAX
+
+// kernel (simKernel.cpp)
+uint64_t simNow(); // virtual us since power-up
+void simCharge(uint64_t us); // work done by current task, others get their turn when they are due
+void simSleep(uint64_t us); // blocks current task, SIM_FOREVER until woken
+void simAt(uint64_t timeUs, std::function<void()> action); // timer, same time runs in order of scheduling
+void simAfter(uint64_t delayUs, std::function<void()> action);
+void simStop(const char *reason); // ends the run once current task or timer gives control back
+const char* simStopReason();
+bool simInTask();
+void simRun(uint64_t durationUs); // runs setup() + loop() as loopTask until duration elapses or simStop()
+
+// clocks (simArduino.cpp)
+extern uint32_t simMillisOffset; // added to millis(), to get its wraparound early
+extern uint64_t simTrueEpochUs; // real world time at power-up
+extern double simClockDriftPpm; // device crystal runs this much faster than real world time
+uint64_t simTrueTimeUs(); // real world time now
+void simSetDeviceTimeUs(uint64_t epochUs);
+extern bool simLogConsole; // console output goes to stdout with virtual time stamps
+void simSerialInput(const char *text);
+void simSetPin(uint8_t pin, uint8_t level); // input level, raises its interrupt
+
+// network (simNetwork.cpp)
+struct SimNetworkConditions
+{
+    bool wifi = true; // access point in range, credentials accepted
+    bool internet = true; // beyond access point (DNS, ping, NTP and weather API)
+    bool ntp = true;
+    bool api = true; // weather API answers 200, otherwise 503
+    int8_t rssi = -60;
+};
+
+extern SimNetworkConditions simNetwork;
+void simNetworkChanged(); // applies simNetwork to associated station (drops it, when access point went away)
+
+// web clients (simWebClient.cpp), connect to the device as a browser or app would
+void simWebRequest(const std::string &method, const std::string &target, const std::string &body, uint32_t bytesPerSecond); // 0 reads at link speed
+void simWebSocket(uint32_t messages, uint32_t messagesPerSecond, bool stalled); // live control on /api/live, stalled client never reads
+// raw client for unit tests, bytes go to the device exactly as test splits them, nothing is read until test does, -1 when device does not listen
+int simRawConnect();
+void simRawWrite(int client, const std::string &data);
+std::string simRawRead(int client, size_t maxLength = SIZE_MAX); // takes what device sent so far
+bool simRawDeviceOpen(int client); // device did not close connection
+void simRawClose(int client);
+
+// peripherals (simPeripherals.cpp)
+void simTurnKnob(uint8_t knob, int32_t detents); // knob 1 or 2, detents are 30 ms apart
+void simPressKnob(uint8_t knob, uint32_t durationMs);
+void simRaiseInterrupts(uint8_t pin);
+void simSeedPreferences(const char *key, const std::string &value);
+void simResetPreferences();
+
+// report (simReport.cpp)
+struct SimLatency
+{
+    uint64_t count = 0;
+    uint64_t totalUs = 0;
+    uint64_t maxUs = 0;
+
+    void add(uint64_t us)
+    {
+        count++;
+        totalUs += us;
+        maxUs = (us > maxUs) ? us : maxUs;
+    }
+};
+
+struct SimWebResponseStats
+{
+    SimLatency firstByte; // request sent until first byte of response arrived
+    SimLatency complete; // until the whole response arrived
+};
+
+struct SimWebSocketStats
+{
+    uint64_t clients = 0;
+    uint64_t handshakesFailed = 0;
+    uint64_t messagesSent = 0; // live control messages
+    uint64_t statePushes = 0; // received
+    uint64_t closedByDevice = 0;
+    SimLatency controlToPush; // live control message sent until state push with its brightness arrived
+};
+
+struct SimStats
+{
+    uint64_t loopIterations = 0;
+    uint64_t loopNotifyWakeups = 0;
+    uint64_t taskSwitches = 0;
+    uint64_t displayClears = 0;
+    uint64_t displayDraws = 0;
+    uint64_t displayPixels = 0;
+    uint64_t displayTextCharacters = 0;
+    uint64_t ledShows = 0;
+    uint64_t ledStripResizes = 0;
+    uint64_t wifiBegins = 0;
+    uint64_t wifiAssociations = 0;
+    uint64_t wifiDisconnects = 0;
+    uint64_t dnsLookups = 0;
+    uint64_t tcpConnects = 0;
+    uint64_t tcpConnectFailures = 0;
+    uint64_t pings = 0;
+    uint64_t pingsAnswered = 0;
+    uint64_t ntpRequests = 0;
+    uint64_t ntpSyncs = 0;
+    uint64_t restarts = 0;
+    uint64_t webConnects = 0;
+    uint64_t webConnectFailures = 0;
+    std::map<std::string, uint64_t> httpRequests; // by path and status, "/data/2.5/weather 200"
+    std::map<std::string, SimWebResponseStats> webResponses; // of the device, by request and status, "GET /api/state 200"
+    std::map<std::string, SimWebSocketStats> webSockets; // by client kind, "live" or "live stalled"
+    std::map<std::string, uint64_t> preferenceWrites; // by key, only writes that changed the value
+    std::map<std::string, uint64_t> preferencePuts; // by key, all of them
+    std::map<std::string, uint64_t> transitions; // console lines that report state change, by line
+};
+
+extern SimStats simStats;
+void simReport(const char *title);
+void simConsoleLine(const char *line);
+extern std::function<void(const char *line)> simConsoleListener; // gets every console line as well (unit tests read them)
+std::string formatVirtualTime(uint64_t us); // "1d 03:00:00.000"
+
+#endif
@@ -0,0 +1,564 @@
+// core includes
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <stdarg.h>
+#include <deque>
+#include <map>
+#include <string>
+
+// project includes
+#include "sim.h"
+
+/* Arduino core on virtual time: millis() and micros() are the simulator clock (each read costs a bit of it),
+ * system time is device clock on top of it. Every device clock comes from the same crystal, so drift is applied
+ * the other way around: real world time (NTP and weather API) runs slower by it.
+ */
+
+uint32_t simMillisOffset = 0;
+uint64_t simTrueEpochUs = 1767225600ULL * SIM_US_PER_S; // 2026-01-01 00:00:00 UTC
+double simClockDriftPpm = 0.0;
+bool simLogConsole = false;
+
+// device clock starts at 0 (1970) on power-up, there is no battery backed RTC
+uint64_t deviceClockSetUs = 0; // device time at deviceClockSetAtUs
+uint64_t deviceClockSetAtUs = 0;
+
+std::map<uint8_t, uint8_t> pinLevels;
+std::map<uint8_t, void (*)()> pinInterrupts;
+
+std::deque<char> serialInput;
+std::string serialLine;
+
+uint32_t randomState = 1;
+
+EspClass ESP;
+HardwareSerial Serial;
+
+uint64_t simTrueTimeUs()
+{
+    return simTrueEpochUs + (uint64_t)((double)simNow() * 1000000.0 / (1000000.0 + simClockDriftPpm));
+}
+
+uint64_t deviceTimeUs()
+{
+    return deviceClockSetUs + (simNow() - deviceClockSetAtUs);
+}
+
+void simSetDeviceTimeUs(uint64_t epochUs)
+{
+    deviceClockSetUs = epochUs;
+    deviceClockSetAtUs = simNow();
+}
+
+time_t simTime(time_t *t)
+{
+    time_t now = (time_t)(deviceTimeUs() / SIM_US_PER_S);
+
+    if(t != nullptr)
+    {
+        *t = now;
+    }
+
+    return now;
+}
+
+int simGettimeofday(struct timeval *tv, void *tz)
+{
+    uint64_t now = deviceTimeUs();
+
+    tv->tv_sec = (time_t)(now / SIM_US_PER_S);
+    tv->tv_usec = (suseconds_t)(now % SIM_US_PER_S);
+
+    return 0;
+}
+
+int simSettimeofday(const struct timeval *tv, const void *tz)
+{
+    simSetDeviceTimeUs((uint64_t)tv->tv_sec * SIM_US_PER_S + tv->tv_usec);
+
+    return 0;
+}
+
+int64_t esp_timer_get_time()
+{
+    simCharge(SIM_CLOCK_READ_COST_US);
+
+    return (int64_t)simNow();
+}
+
+uint32_t millis()
+{
+    simCharge(SIM_CLOCK_READ_COST_US);
+
+    return (uint32_t)(simNow() / SIM_US_PER_MS) + simMillisOffset;
+}
+
+uint32_t micros()
+{
+    simCharge(SIM_CLOCK_READ_COST_US);
+
+    return (uint32_t)simNow() + simMillisOffset * 1000;
+}
+
+void delay(uint32_t ms)
+{
+    vTaskDelay(ms);
+}
+
+void delayMicroseconds(uint32_t us)
+{
+    simCharge(us);
+}
+
+void yield()
+{
+    vTaskDelay(0);
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    if(mode == INPUT_PULLUP)
+    {
+        pinLevels[pin] = HIGH;
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+    pinLevels[pin] = value;
+}
+
+int digitalRead(uint8_t pin)
+{
+    simCharge(SIM_CLOCK_READ_COST_US);
+
+    return (pinLevels.count(pin) != 0) ? pinLevels[pin] : LOW;
+}
+
+void simSetPin(uint8_t pin, uint8_t level)
+{
+    pinLevels[pin] = level;
+    simRaiseInterrupts(pin);
+}
+
+uint16_t analogRead(uint8_t pin)
+{
+    return 1234; // floating pin, always the same noise, so runs stay reproducible
+}
+
+void attachInterrupt(uint8_t pin, void (*handler)(), int mode)
+{
+    pinInterrupts[pin] = handler;
+}
+
+void detachInterrupt(uint8_t pin)
+{
+    pinInterrupts.erase(pin);
+}
+
+void simRaiseInterrupts(uint8_t pin)
+{
+    if(pinInterrupts.count(pin) != 0)
+    {
+        pinInterrupts[pin]();
+    }
+}
+
+void randomSeed(unsigned long seed)
+{
+    randomState = (seed != 0) ? seed : 1;
+}
+
+long random(long howBig)
+{
+    // xorshift, platform independent
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+
+    return (howBig > 0) ? (long)(randomState % (uint32_t)howBig) : 0;
+}
+
+long random(long howSmall, long howBig)
+{
+    return (howSmall < howBig) ? howSmall + random(howBig - howSmall) : howSmall;
+}
+
+long map(long x, long inMin, long inMax, long outMin, long outMax)
+{
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+bool getLocalTime(struct tm *info, uint32_t ms)
+{
+    uint32_t start = millis();
+
+    for(;;)
+    {
+        time_t now = time(NULL);
+
+        localtime_r(&now, info);
+
+        if(info->tm_year > (2016 - 1900))
+        {
+            return true;
+        }
+
+        if(millis() - start >= ms)
+        {
+            return false;
+        }
+
+        delay(10);
+    }
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps)
+{
+    return 110 * 1024;
+}
+
+uint32_t xPortGetCoreID()
+{
+    return 1;
+}
+
+void EspClass::restart()
+{
+    simStats.restarts++;
+    simStop("ESP.restart()");
+    simSleep(SIM_FOREVER); // never comes back, the run ends here
+}
+
+uint32_t EspClass::getHeapSize()
+{
+    return 320 * 1024;
+}
+
+uint32_t EspClass::getFreeHeap()
+{
+    return 200 * 1024;
+}
+
+uint32_t EspClass::getMinFreeHeap()
+{
+    return 180 * 1024;
+}
+
+uint32_t EspClass::getMaxAllocHeap()
+{
+    return 110 * 1024;
+}
+
+void HardwareSerial::begin(unsigned long baud)
+{
+}
+
+int HardwareSerial::available()
+{
+    return (int)serialInput.size();
+}
+
+int HardwareSerial::read()
+{
+    if(serialInput.empty())
+    {
+        return -1;
+    }
+
+    char c = serialInput.front();
+    serialInput.pop_front();
+
+    return (uint8_t)c;
+}
+
+int HardwareSerial::peek()
+{
+    return serialInput.empty() ? -1 : (uint8_t)serialInput.front();
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+    if(c == '\n')
+    {
+        if(!serialLine.empty() && serialLine.back() == '\r')
+        {
+            serialLine.pop_back();
+        }
+
+        simConsoleLine(serialLine.c_str());
+        serialLine.clear();
+    }
+    else
+    {
+        serialLine.push_back((char)c);
+    }
+
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size)
+{
+    for(size_t i = 0; i < size; i++)
+    {
+        write(buffer[i]);
+    }
+
+    return size;
+}
+
+void simSerialInput(const char *text)
+{
+    while(*text != '\0')
+    {
+        serialInput.push_back(*text++);
+    }
+
+    serialInput.push_back('\n');
+}
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+    size_t written = 0;
+
+    while(written < size && write(buffer[written]) == 1)
+    {
+        written++;
+    }
+
+    return written;
+}
+
+size_t Print::printf(const char *format, ...)
+{
+    char buffer[512];
+    va_list arguments;
+
+    va_start(arguments, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, arguments);
+    va_end(arguments);
+
+    return (length > 0) ? write((const uint8_t*)buffer, min((size_t)length, sizeof(buffer) - 1)) : 0;
+}
+
+size_t Print::print(const char *text)
+{
+    return write(text);
+}
+
+size_t Print::print(char c)
+{
+    return write((uint8_t)c);
+}
+
+size_t printNumber(Print *p, unsigned long long value, int base, bool negative)
+{
+    char buffer[72];
+    char *position = &buffer[sizeof(buffer) - 1];
+
+    *position = '\0';
+
+    if(base < 2)
+    {
+        base = 10;
+    }
+
+    do
+    {
+        uint8_t digit = value % base;
+        *--position = (digit < 10) ? '0' + digit : 'A' + digit - 10;
+        value /= base;
+    }
+    while(value != 0);
+
+    if(negative)
+    {
+        *--position = '-';
+    }
+
+    return p->write(position);
+}
+
+size_t Print::print(unsigned char value, int base)
+{
+    return printNumber(this, value, base, false);
+}
+
+size_t Print::print(int value, int base)
+{
+    return print((long long)value, base);
+}
+
+size_t Print::print(unsigned int value, int base)
+{
+    return printNumber(this, value, base, false);
+}
+
+size_t Print::print(long value, int base)
+{
+    return print((long long)value, base);
+}
+
+size_t Print::print(unsigned long value, int base)
+{
+    return printNumber(this, value, base, false);
+}
+
+size_t Print::print(long long value, int base)
+{
+    // like Arduino, only decimal numbers are signed
+    if(base == 10 && value < 0)
+    {
+        return printNumber(this, -(unsigned long long)value, base, true);
+    }
+
+    return printNumber(this, (unsigned long long)value, base, false);
+}
+
+size_t Print::print(unsigned long long value, int base)
+{
+    return printNumber(this, value, base, false);
+}
+
+size_t Print::print(double value, int digits)
+{
+    char buffer[64];
+
+    snprintf(buffer, sizeof(buffer), "%.*f", digits, value);
+
+    return write(buffer);
+}
+
+size_t Print::print(const String &text)
+{
+    return write(text.c_str());
+}
+
+size_t Print::print(const Printable &printable)
+{
+    return printable.printTo(*this);
+}
+
+size_t Print::println()
+{
+    return write("\r\n");
+}
+
+// waits on virtual clock, 1 ms at a time, so whoever is going to send data gets to run
+int Stream::timedRead()
+{
+    uint32_t start = millis();
+
+    do
+    {
+        int c = read();
+
+        if(c >= 0)
+        {
+            return c;
+        }
+
+        delay(1);
+    }
+    while(millis() - start < timeout);
+
+    return -1;
+}
+
+bool Stream::find(const char *target)
+{
+    return findUntil(target, nullptr);
+}
+
+bool Stream::findUntil(const char *target, const char *terminator)
+{
+    size_t targetLength = strlen(target);
+    size_t terminatorLength = (terminator != nullptr) ? strlen(terminator) : 0;
+    size_t targetIndex = 0;
+    size_t terminatorIndex = 0;
+    int c;
+
+    if(targetLength == 0)
+    {
+        return true;
+    }
+
+    while((c = timedRead()) >= 0)
+    {
+        // simple restart on mismatch is enough for targets firmware looks for
+        targetIndex = (c == target[targetIndex]) ? targetIndex + 1 : ((c == target[0]) ? 1 : 0);
+
+        if(targetIndex == targetLength)
+        {
+            return true;
+        }
+
+        if(terminatorLength > 0)
+        {
+            terminatorIndex = (c == terminator[terminatorIndex]) ? terminatorIndex + 1 : ((c == terminator[0]) ? 1 : 0);
+
+            if(terminatorIndex == terminatorLength)
+            {
+                return false;
+            }
+        }
+    }
+
+    return false;
+}
+
+size_t Stream::readBytes(char *buffer, size_t length)
+{
+    size_t count = 0;
+
+    while(count < length)
+    {
+        int c = timedRead();
+
+        if(c < 0)
+        {
+            break;
+        }
+
+        buffer[count++] = (char)c;
+    }
+
+    return count;
+}
+
+bool IPAddress::fromString(const char *text)
+{
+    unsigned int parts[4];
+    char end;
+
+    if(sscanf(text, "%u.%u.%u.%u%c", &parts[0], &parts[1], &parts[2], &parts[3], &end) != 4)
+    {
+        return false;
+    }
+
+    for(int i = 0; i < 4; i++)
+    {
+        if(parts[i] > 255)
+        {
+            return false;
+        }
+
+        bytes[i] = (uint8_t)parts[i];
+    }
+
+    return true;
+}
+
+String IPAddress::toString() const
+{
+    char buffer[16];
+
+    snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", bytes[0], bytes[1], bytes[2], bytes[3]);
+
+    return String(buffer);
+}
+
+size_t IPAddress::printTo(Print &p) const
+{
+    return p.print(toString());
+}
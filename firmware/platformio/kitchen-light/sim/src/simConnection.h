@@ -0,0 +1,34 @@
+#ifndef SIM_CONNECTION_H
+#define SIM_CONNECTION_H
+
+#include <Arduino.h>
+#include <deque>
+#include <memory>
+#include <string>
+
+/* TCP connection as both ends see it, shared by simNetwork.cpp (firmware side, servers on the internet)
+ * and simWebClient.cpp (browsers and apps connecting to the device).
+ */
+
+#define SIM_TCP_SEND_BUFFER_SIZE ((size_t)5744) // lwIP TCP_SND_BUF of Arduino-ESP32 (4 segments)
+
+struct SimConnection
+{
+    IPAddress ip; // of the other end
+    uint16_t port;
+    int fd; // socket descriptor firmware sees
+    bool open; // firmware did not close it
+    bool remoteOpen = true; // other end did not close it
+    bool incoming = false; // accepted by web server, made by a web client
+    bool softAp = false; // incoming over soft AP, stays when station drops
+    uint32_t generation; // of Wi-Fi association it was made in
+    uint32_t requests;
+    std::deque<uint8_t> received; // for firmware to read
+    std::string request; // written by firmware, outgoing connections (servers take it all at once)
+    std::deque<uint8_t> sendBuffer; // written by firmware, incoming connections (web client takes it at its own pace)
+};
+
+// web client side (simNetwork.cpp), nullptr when device is not reachable or does not listen
+std::shared_ptr<SimConnection> simConnectToDevice(IPAddress clientIp, uint16_t port);
+
+#endif
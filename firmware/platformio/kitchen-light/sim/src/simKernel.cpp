@@ -0,0 +1,446 @@
+// core includes
+#include <Arduino.h>
+#include <ucontext.h>
+#include <queue>
+#include <string>
+#include <vector>
+
+// project includes
+#include "sim.h"
+
+/* Cooperative scheduler on ucontext, one host thread.
+ * Task runs until it blocks or until its slice (one FreeRTOS tick) is over and someone else is due,
+ * timers run right when they are due, on the stack of whatever task is charging time (like ISRs do), or from scheduler.
+ * Ties are broken by order of waking, so runs are fully deterministic.
+ */
+
+#define SIM_SLICE_US 1000
+
+struct SimTask
+{
+    std::string name;
+    TaskFunction_t function;
+    void *parameter;
+    ucontext_t context;
+    std::vector<uint8_t> stack;
+    uint64_t wakeUs;
+    uint64_t order;
+    uint64_t dispatchUs;
+    uint32_t notifications;
+    bool waitingForNotification;
+    bool finished;
+};
+
+struct SimTimer
+{
+    uint64_t timeUs;
+    uint64_t sequence;
+    std::function<void()> action;
+};
+
+struct SimTimerLater
+{
+    bool operator()(const SimTimer &a, const SimTimer &b) const
+    {
+        return (a.timeUs != b.timeUs) ? a.timeUs > b.timeUs : a.sequence > b.sequence;
+    }
+};
+
+struct SimQueue
+{
+    std::vector<uint8_t> items;
+    UBaseType_t length;
+    UBaseType_t itemSize;
+    UBaseType_t head;
+    UBaseType_t count;
+};
+
+uint64_t nowUs = 0;
+uint64_t runEndUs = SIM_FOREVER;
+const char *stopReason = nullptr;
+
+std::vector<SimTask*> tasks;
+SimTask *currentTask = nullptr;
+ucontext_t schedulerContext;
+uint64_t wakeOrder = 0;
+
+std::priority_queue<SimTimer, std::vector<SimTimer>, SimTimerLater> timers;
+uint64_t timerSequence = 0;
+bool runningTimers = false;
+
+uint64_t simNow()
+{
+    return nowUs;
+}
+
+bool simInTask()
+{
+    return currentTask != nullptr;
+}
+
+void simAt(uint64_t timeUs, std::function<void()> action)
+{
+    timers.push({max(timeUs, nowUs), timerSequence++, std::move(action)});
+}
+
+void simAfter(uint64_t delayUs, std::function<void()> action)
+{
+    simAt(nowUs + delayUs, std::move(action));
+}
+
+void simStop(const char *reason)
+{
+    if(stopReason == nullptr)
+    {
+        stopReason = reason;
+    }
+}
+
+const char* simStopReason()
+{
+    return stopReason;
+}
+
+// timers never nest, the one that is running now has to finish first
+void runDueTimers()
+{
+    if(runningTimers)
+    {
+        return;
+    }
+
+    runningTimers = true;
+
+    while(!timers.empty() && timers.top().timeUs <= nowUs && stopReason == nullptr)
+    {
+        SimTimer timer = timers.top();
+        timers.pop();
+        timer.action();
+    }
+
+    runningTimers = false;
+}
+
+void switchToScheduler()
+{
+    SimTask *task = currentTask;
+
+    swapcontext(&task->context, &schedulerContext);
+}
+
+bool otherTaskDue()
+{
+    for(SimTask *task : tasks)
+    {
+        if(task != currentTask && task->wakeUs <= nowUs)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void simCharge(uint64_t us)
+{
+    nowUs += us;
+    runDueTimers();
+
+    if(currentTask == nullptr || runningTimers)
+    {
+        return;
+    }
+
+    if(stopReason != nullptr || nowUs >= runEndUs || (nowUs - currentTask->dispatchUs >= SIM_SLICE_US && otherTaskDue()))
+    {
+        currentTask->wakeUs = nowUs;
+        currentTask->order = wakeOrder++;
+        switchToScheduler();
+    }
+}
+
+void simSleep(uint64_t us)
+{
+    if(currentTask == nullptr || runningTimers)
+    {
+        nowUs += (us != SIM_FOREVER) ? us : 0; // only from host side, nobody to switch to
+        return;
+    }
+
+    currentTask->wakeUs = (us != SIM_FOREVER) ? nowUs + us : SIM_FOREVER;
+    currentTask->order = wakeOrder++;
+    switchToScheduler();
+}
+
+void wakeTask(SimTask *task)
+{
+    if(task->wakeUs > nowUs)
+    {
+        task->wakeUs = nowUs;
+        task->order = wakeOrder++;
+    }
+}
+
+void taskEntry()
+{
+    SimTask *task = currentTask;
+
+    task->function(task->parameter);
+
+    // FreeRTOS task must never return, here it just does not get scheduled anymore
+    task->finished = true;
+    task->wakeUs = SIM_FOREVER;
+    switchToScheduler();
+}
+
+SimTask* createTask(TaskFunction_t function, const char *name, void *parameter)
+{
+    SimTask *task = new SimTask();
+
+    task->name = name;
+    task->function = function;
+    task->parameter = parameter;
+    task->stack.resize(SIM_TASK_STACK_SIZE);
+    task->wakeUs = nowUs;
+    task->order = wakeOrder++;
+    task->dispatchUs = nowUs;
+    task->notifications = 0;
+    task->waitingForNotification = false;
+    task->finished = false;
+
+    getcontext(&task->context);
+    task->context.uc_stack.ss_sp = task->stack.data();
+    task->context.uc_stack.ss_size = task->stack.size();
+    task->context.uc_link = nullptr;
+    makecontext(&task->context, taskEntry, 0);
+
+    tasks.push_back(task);
+
+    return task;
+}
+
+SimTask* nextTask()
+{
+    SimTask *next = nullptr;
+
+    for(SimTask *task : tasks)
+    {
+        if(!task->finished && (next == nullptr || task->wakeUs < next->wakeUs || (task->wakeUs == next->wakeUs && task->order < next->order)))
+        {
+            next = task;
+        }
+    }
+
+    return next;
+}
+
+// Arduino core runs setup() and loop() in its own task as well
+void loopTask(void *parameter)
+{
+    setup();
+
+    for(;;)
+    {
+        loop();
+        simStats.loopIterations++;
+        simCharge(SIM_LOOP_COST_US);
+    }
+}
+
+void simRun(uint64_t durationUs)
+{
+    runEndUs = nowUs + durationUs;
+
+    if(tasks.empty())
+    {
+        createTask(loopTask, "loopTask", nullptr);
+    }
+
+    while(stopReason == nullptr && nowUs < runEndUs)
+    {
+        SimTask *task = nextTask();
+        uint64_t taskUs = (task != nullptr) ? task->wakeUs : SIM_FOREVER;
+        uint64_t timerUs = !timers.empty() ? timers.top().timeUs : SIM_FOREVER;
+
+        if(taskUs == SIM_FOREVER && timerUs == SIM_FOREVER)
+        {
+            simStop("every task is blocked forever");
+            break;
+        }
+
+        if(min(taskUs, timerUs) >= runEndUs)
+        {
+            nowUs = runEndUs;
+            break;
+        }
+
+        if(timerUs <= taskUs)
+        {
+            nowUs = max(nowUs, timerUs);
+            runDueTimers();
+            continue;
+        }
+
+        nowUs = max(nowUs, taskUs);
+        task->dispatchUs = nowUs;
+        currentTask = task;
+        simStats.taskSwitches++;
+        swapcontext(&schedulerContext, &task->context);
+        currentTask = nullptr;
+    }
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char *name, uint32_t stackDepth, void *parameter, UBaseType_t priority, TaskHandle_t *handle, BaseType_t core)
+{
+    SimTask *task = createTask(function, name, parameter);
+
+    if(handle != nullptr)
+    {
+        *handle = task;
+    }
+
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char *name, uint32_t stackDepth, void *parameter, UBaseType_t priority, TaskHandle_t *handle)
+{
+    return xTaskCreatePinnedToCore(function, name, stackDepth, parameter, priority, handle, 0);
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    simSleep((uint64_t)ticks * SIM_US_PER_MS);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+    return currentTask;
+}
+
+TickType_t xTaskGetTickCount()
+{
+    return (TickType_t)(nowUs / SIM_US_PER_MS);
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticksToWait)
+{
+    SimTask *task = currentTask;
+
+    if(task->notifications == 0 && ticksToWait != 0)
+    {
+        task->waitingForNotification = true;
+        simSleep((ticksToWait == portMAX_DELAY) ? SIM_FOREVER : (uint64_t)ticksToWait * SIM_US_PER_MS);
+        task->waitingForNotification = false;
+
+        if(task->notifications != 0)
+        {
+            simStats.loopNotifyWakeups++;
+        }
+    }
+
+    uint32_t notifications = task->notifications;
+
+    if(notifications != 0)
+    {
+        task->notifications = clearOnExit ? 0 : notifications - 1;
+    }
+
+    return notifications;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    task->notifications++;
+
+    if(task->waitingForNotification)
+    {
+        wakeTask(task);
+    }
+
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higherPriorityTaskWoken)
+{
+    xTaskNotifyGive(task);
+
+    if(higherPriorityTaskWoken != nullptr)
+    {
+        *higherPriorityTaskWoken = pdFALSE;
+    }
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task)
+{
+    return SIM_TASK_STACK_SIZE;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize)
+{
+    SimQueue *queue = new SimQueue();
+
+    queue->items.resize((size_t)length * itemSize);
+    queue->length = length;
+    queue->itemSize = itemSize;
+    queue->head = 0;
+    queue->count = 0;
+
+    return queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticksToWait)
+{
+    if(queue->count == queue->length)
+    {
+        return errQUEUE_FULL;
+    }
+
+    memcpy(&queue->items[((queue->head + queue->count) % queue->length) * queue->itemSize], item, queue->itemSize);
+    queue->count++;
+
+    return pdPASS;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void *item, BaseType_t *higherPriorityTaskWoken)
+{
+    return xQueueSend(queue, item, 0);
+}
+
+// meant for single item queues (mailboxes)
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void *item)
+{
+    queue->head = 0;
+    queue->count = 0;
+
+    return xQueueSend(queue, item, 0);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t queue, void *item, TickType_t ticksToWait)
+{
+    if(queue->count == 0)
+    {
+        return pdFALSE;
+    }
+
+    memcpy(item, &queue->items[queue->head * queue->itemSize], queue->itemSize);
+
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticksToWait)
+{
+    if(xQueuePeek(queue, item, ticksToWait) != pdTRUE)
+    {
+        return pdFALSE;
+    }
+
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count--;
+
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+    return queue->count;
+}
@@ -0,0 +1,356 @@
+// core includes
+#include <Arduino.h>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// project includes
+#include "sim.h"
+#include "conf.h"
+#include "trace.h"
+
+/* Entry point of env:sim: program [--log] [--trace trace.json] [scenario file]
+ * Scenario is a text file, see sim/README.txt for its commands, without one it is a quiet week of a configured device.
+ */
+
+#define SIM_DEFAULT_DURATION_US (7 * 86400 * SIM_US_PER_S)
+
+uint64_t runDurationUs = SIM_DEFAULT_DURATION_US;
+
+// "1d2h", "90s", "250ms", plain number is in seconds
+bool parseDuration(const std::string &text, uint64_t *us)
+{
+    const char *position = text.c_str();
+
+    *us = 0;
+
+    if(*position == '\0')
+    {
+        return false;
+    }
+
+    while(*position != '\0')
+    {
+        char *end;
+        unsigned long long value = strtoull(position, &end, 10);
+
+        if(end == position)
+        {
+            return false;
+        }
+
+        position = end;
+
+        if(strncmp(position, "ms", 2) == 0)
+        {
+            *us += value * SIM_US_PER_MS;
+            position += 2;
+        }
+        else if(*position == 'd' || *position == 'h' || *position == 'm' || *position == 's' || *position == '\0')
+        {
+            uint64_t unit = (*position == 'd') ? 86400 : ((*position == 'h') ? 3600 : ((*position == 'm') ? 60 : 1));
+
+            *us += value * unit * SIM_US_PER_S;
+            position += (*position != '\0') ? 1 : 0;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool parseUpDown(const std::string &text, bool *up)
+{
+    *up = (text == "up");
+
+    return text == "up" || text == "down";
+}
+
+// scripted event, runs as timer at its time
+bool scheduleEvent(uint64_t timeUs, const std::string &command, std::istringstream &arguments)
+{
+    std::string argument;
+    bool up;
+    long number;
+
+    arguments >> argument;
+
+    if(command == "wifi" && parseUpDown(argument, &up))
+    {
+        simAt(timeUs, [up]() { simNetwork.wifi = up; simNetworkChanged(); });
+    }
+    else if(command == "internet" && parseUpDown(argument, &up))
+    {
+        simAt(timeUs, [up]() { simNetwork.internet = up; simNetworkChanged(); });
+    }
+    else if(command == "ntp" && parseUpDown(argument, &up))
+    {
+        simAt(timeUs, [up]() { simNetwork.ntp = up; });
+    }
+    else if(command == "api" && parseUpDown(argument, &up))
+    {
+        simAt(timeUs, [up]() { simNetwork.api = up; });
+    }
+    else if(command == "rssi" && !argument.empty())
+    {
+        number = strtol(argument.c_str(), NULL, 10);
+        simAt(timeUs, [number]() { simNetwork.rssi = (int8_t)number; });
+    }
+    else if(command == "knob" && (argument == "1" || argument == "2") && (arguments >> number))
+    {
+        uint8_t knob = (uint8_t)(argument[0] - '0');
+        simAt(timeUs, [knob, number]() { simTurnKnob(knob, (int32_t)number); });
+    }
+    else if(command == "press" && (argument == "1" || argument == "2"))
+    {
+        uint8_t knob = (uint8_t)(argument[0] - '0');
+        uint64_t durationUs = 100 * SIM_US_PER_MS;
+        std::string duration;
+
+        if((arguments >> duration) && !parseDuration(duration, &durationUs))
+        {
+            return false;
+        }
+
+        simAt(timeUs, [knob, durationUs]() { simPressKnob(knob, (uint32_t)(durationUs / SIM_US_PER_MS)); });
+    }
+    else if(command == "serial" && !argument.empty())
+    {
+        std::string rest;
+
+        std::getline(arguments, rest);
+        argument += rest;
+        simAt(timeUs, [argument]() { simSerialInput(argument.c_str()); });
+    }
+    else if((command == "http" || command == "http-slow") && !argument.empty())
+    {
+        uint32_t bytesPerSecond = 0;
+        std::string method = argument;
+        std::string target;
+        std::string body;
+
+        if(command == "http-slow")
+        {
+            bytesPerSecond = (uint32_t)strtoul(argument.c_str(), NULL, 10);
+
+            if(bytesPerSecond == 0 || !(arguments >> method))
+            {
+                return false;
+            }
+        }
+
+        if(!(arguments >> target))
+        {
+            return false;
+        }
+
+        std::getline(arguments >> std::ws, body);
+        simAt(timeUs, [method, target, body, bytesPerSecond]() { simWebRequest(method, target, body, bytesPerSecond); });
+    }
+    else if(command == "ws" && (arguments >> number) && number > 0)
+    {
+        uint32_t messages = (uint32_t)strtoul(argument.c_str(), NULL, 10);
+        uint32_t perSecond = (uint32_t)number;
+
+        simAt(timeUs, [messages, perSecond]() { simWebSocket(messages, perSecond, false); });
+    }
+    else if(command == "ws-stalled")
+    {
+        simAt(timeUs, []() { simWebSocket(0, 1, true); });
+    }
+    else if(command == "report")
+    {
+        simAt(timeUs, []() { simReport(formatVirtualTime(simNow()).c_str()); });
+    }
+    else if(command == "end")
+    {
+        simAt(timeUs, []() { simStop("end of scenario"); });
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+// trace of the end of the run, same JSON firmware serves on GET /trace
+class FilePrint : public Print
+{
+    public:
+        FilePrint(FILE *file) : file(file) {}
+
+        size_t write(uint8_t c) override
+        {
+            return fwrite(&c, 1, 1, file);
+        }
+
+        size_t write(const uint8_t *data, size_t length) override
+        {
+            return fwrite(data, 1, length, file);
+        }
+
+    private:
+        FILE *file;
+};
+
+bool writeTraceFile(const char *path)
+{
+    FILE *file = fopen(path, "w");
+
+    if(file == nullptr)
+    {
+        fprintf(stderr, "sim: can not write %s\n", path);
+        return false;
+    }
+
+    FilePrint out(file);
+    printTrace(&out);
+    fclose(file);
+
+    return true;
+}
+
+// configured device, as if setup page was submitted before
+void seedConfiguredDevice()
+{
+    simSeedPreferences("firstRun", std::to_string(DEFAULT_PREFERENCES_ID));
+    simSeedPreferences("CPT", "1");
+    simSeedPreferences("color-hue", "0");
+    simSeedPreferences("color-t", "40");
+    simSeedPreferences("brightness", "128");
+    simSeedPreferences("wifi_ssid", "home");
+    simSeedPreferences("wifi_pwd", "password");
+    simSeedPreferences("time-zone", "CET-1CEST,M3.5.0,M10.5.0/3");
+    simSeedPreferences("city", "Bratislava");
+    simSeedPreferences("country-c", "SK");
+    simSeedPreferences("lat", INVALID_LAT_LON);
+    simSeedPreferences("lon", INVALID_LAT_LON);
+    simSeedPreferences("api-key", "0123456789abcdef0123456789abcdef");
+    simSeedPreferences("rng-id", "1234");
+    simSeedPreferences("rng-pwd", "12345678");
+    simSeedPreferences("n-leds", "60");
+}
+
+bool loadScenario(const char *path)
+{
+    std::ifstream file(path);
+    std::string line;
+    uint64_t previousUs = 0;
+    uint32_t lineNumber = 0;
+
+    if(!file)
+    {
+        fprintf(stderr, "sim: can not open %s\n", path);
+        return false;
+    }
+
+    while(std::getline(file, line))
+    {
+        std::istringstream words(line);
+        std::string first;
+        std::string value;
+        uint64_t timeUs;
+
+        lineNumber++;
+
+        if(!(words >> first) || first[0] == '#')
+        {
+            continue;
+        }
+
+        bool valid = true;
+
+        if(first == "duration")
+        {
+            valid = (words >> value) && parseDuration(value, &runDurationUs);
+        }
+        else if(first == "epoch")
+        {
+            unsigned long long epoch;
+            valid = (bool)(words >> epoch);
+            simTrueEpochUs = epoch * SIM_US_PER_S;
+        }
+        else if(first == "millis-offset")
+        {
+            unsigned long offset;
+            valid = (bool)(words >> offset);
+            simMillisOffset = (uint32_t)offset;
+        }
+        else if(first == "drift")
+        {
+            valid = (bool)(words >> simClockDriftPpm);
+        }
+        else if(first == "unconfigured")
+        {
+            simResetPreferences();
+        }
+        else if(first == "pref")
+        {
+            std::string key;
+            valid = (words >> key) && (words >> value);
+            simSeedPreferences(key.c_str(), value);
+        }
+        else
+        {
+            bool relative = (first[0] == '+');
+
+            if(!parseDuration(first.substr(relative ? 1 : 0), &timeUs))
+            {
+                valid = false;
+            }
+            else
+            {
+                timeUs += relative ? previousUs : 0;
+                previousUs = timeUs;
+                valid = (words >> value) && scheduleEvent(timeUs, value, words);
+            }
+        }
+
+        if(!valid)
+        {
+            fprintf(stderr, "sim: %s:%u: invalid line: %s\n", path, lineNumber, line.c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    const char *scenario = nullptr;
+    const char *tracePath = nullptr;
+
+    seedConfiguredDevice();
+
+    for(int i = 1; i < argc; i++)
+    {
+        if(strcmp(argv[i], "--log") == 0)
+        {
+            simLogConsole = true;
+        }
+        else if(strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+        {
+            tracePath = argv[++i];
+        }
+        else
+        {
+            scenario = argv[i];
+        }
+    }
+
+    if(scenario != nullptr && !loadScenario(scenario))
+    {
+        return 1;
+    }
+
+    simRun(runDurationUs);
+    simReport((scenario != nullptr) ? scenario : "default week");
+
+    return (tracePath != nullptr && !writeTraceFile(tracePath)) ? 1 : 0;
+}
@@ -0,0 +1,889 @@
+// core includes
+#include <Arduino.h>
+#include <WiFi.h>
+#include <WiFiServer.h>
+#include <esp_sntp.h>
+#include <lwip/sockets.h>
+#include <math.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// project includes
+#include "sim.h"
+#include "simConnection.h"
+#include "ping/ping_sock.h"
+
+/* Network as the firmware sees it: one access point, internet behind it with DNS, ping, NTP and weather API.
+ * Whatever is up or down is scripted (simNetwork, see scenario commands), delays are fixed so runs repeat exactly.
+ * Every private address is on the local network, so it needs only Wi-Fi (stand-in server builds use that).
+ */
+
+#define SIM_WIFI_ASSOCIATE_MS 1500
+#define SIM_WIFI_ASSOCIATE_FAIL_MS 3000
+#define SIM_DNS_MS 20
+#define SIM_DNS_TIMEOUT_MS 4000
+#define SIM_TCP_CONNECT_MS 30
+#define SIM_HTTP_RESPONSE_MS 80
+#define SIM_HTTP_KEEP_ALIVE_MS 5000
+#define SIM_PING_MS 25
+#define SIM_NTP_MS 50
+#define SIM_NTP_RETRY_MIN_MS 15000
+#define SIM_NTP_RETRY_MAX_MS 150000
+#define SIM_WRITE_RETRIES 10 // Arduino-ESP32 WiFiClient::write(), select() with 1 s timeout, again after every progress
+#define SIM_WRITE_SELECT_MS 1000
+#define SIM_WRITE_POLL_MS 10
+#define SIM_FIRST_FD 48 // LWIP_SOCKET_OFFSET
+
+SimNetworkConditions simNetwork;
+
+WiFiClass WiFi;
+
+wifi_mode_t wifiMode = WIFI_OFF;
+bool wifiAssociated = false;
+uint32_t wifiGeneration = 0; // every begin/disconnect/drop, events of older attempts are ignored
+std::string wifiSsid;
+std::vector<WiFiEventFullCb> wifiEventCallbacks;
+std::vector<std::weak_ptr<SimConnection>> connections;
+std::map<int, std::weak_ptr<SimConnection>> descriptors; // open sockets, by fd
+int nextFd = SIM_FIRST_FD;
+uint16_t listeningPort = 0; // of web server, 0 when it does not listen
+std::deque<std::shared_ptr<SimConnection>> serverBacklog; // connected, not accepted by firmware yet
+
+struct SimPing
+{
+    esp_ping_config_t config;
+    esp_ping_callbacks_t callbacks;
+    uint32_t timeGapMs;
+};
+
+void (*sntpCallback)(struct timeval *tv) = nullptr;
+bool sntpRunning = false;
+uint32_t sntpGeneration = 0;
+uint32_t sntpIntervalMs = 3600000;
+uint32_t sntpRetryMs = SIM_NTP_RETRY_MIN_MS;
+sntp_sync_status_t sntpStatus = SNTP_SYNC_STATUS_RESET;
+
+// Arduino-ESP32 delivers them from its event task, here from timer
+void fireWifiEvent(arduino_event_id_t event)
+{
+    WiFiEventInfo_t info = {0};
+
+    for(WiFiEventFullCb callback : wifiEventCallbacks)
+    {
+        callback(event, info);
+    }
+}
+
+bool isLocalAddress(IPAddress ip)
+{
+    return ip[0] == 10 || (ip[0] == 172 && (ip[1] & 0xF0) == 16) || (ip[0] == 192 && ip[1] == 168);
+}
+
+bool reachable(IPAddress ip)
+{
+    return wifiAssociated && (isLocalAddress(ip) || simNetwork.internet);
+}
+
+void dropConnections()
+{
+    for(std::weak_ptr<SimConnection> &weak : connections)
+    {
+        std::shared_ptr<SimConnection> connection = weak.lock();
+
+        if(connection != nullptr && !connection->softAp && connection->generation != wifiGeneration)
+        {
+            connection->open = false;
+        }
+    }
+}
+
+void dropAssociation()
+{
+    if(!wifiAssociated)
+    {
+        return;
+    }
+
+    wifiAssociated = false;
+    wifiGeneration++;
+    simStats.wifiDisconnects++;
+    dropConnections();
+    fireWifiEvent(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+}
+
+void simNetworkChanged()
+{
+    if(!simNetwork.wifi)
+    {
+        dropAssociation();
+    }
+}
+
+wl_status_t WiFiClass::status()
+{
+    return wifiAssociated ? WL_CONNECTED : WL_DISCONNECTED;
+}
+
+int8_t WiFiClass::RSSI()
+{
+    return wifiAssociated ? simNetwork.rssi : 0;
+}
+
+String WiFiClass::SSID()
+{
+    return String(wifiAssociated ? wifiSsid : std::string());
+}
+
+IPAddress WiFiClass::localIP()
+{
+    return wifiAssociated ? IPAddress(192, 168, 1, 50) : IPAddress();
+}
+
+IPAddress WiFiClass::softAPIP()
+{
+    return (wifiMode == WIFI_AP || wifiMode == WIFI_AP_STA) ? IPAddress(192, 168, 4, 1) : IPAddress();
+}
+
+wl_status_t WiFiClass::begin(const char *ssid, const char *password)
+{
+    dropAssociation();
+
+    uint32_t generation = ++wifiGeneration;
+
+    wifiSsid = ssid;
+    simStats.wifiBegins++;
+
+    if(wifiMode == WIFI_OFF)
+    {
+        wifiMode = WIFI_STA;
+    }
+
+    simAfter(simNetwork.wifi ? SIM_WIFI_ASSOCIATE_MS * SIM_US_PER_MS : SIM_WIFI_ASSOCIATE_FAIL_MS * SIM_US_PER_MS, [generation]()
+    {
+        if(generation != wifiGeneration)
+        {
+            return;
+        }
+
+        if(simNetwork.wifi)
+        {
+            wifiAssociated = true;
+            simStats.wifiAssociations++;
+            fireWifiEvent(ARDUINO_EVENT_WIFI_STA_GOT_IP);
+        }
+        else
+        {
+            wifiGeneration++;
+            fireWifiEvent(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+        }
+    });
+
+    return WL_DISCONNECTED;
+}
+
+bool WiFiClass::disconnect(bool wifiOff)
+{
+    wifiGeneration++; // cancels association in progress as well
+
+    if(wifiAssociated)
+    {
+        wifiAssociated = false;
+        simStats.wifiDisconnects++;
+        dropConnections();
+        simAfter(0, []() { fireWifiEvent(ARDUINO_EVENT_WIFI_STA_DISCONNECTED); });
+    }
+
+    if(wifiOff)
+    {
+        wifiMode = WIFI_OFF;
+    }
+
+    return true;
+}
+
+bool WiFiClass::mode(wifi_mode_t mode)
+{
+    if(mode == WIFI_OFF || mode == WIFI_AP)
+    {
+        disconnect(false);
+    }
+
+    wifiMode = mode;
+
+    return true;
+}
+
+bool WiFiClass::softAP(const char *ssid, const char *password)
+{
+    wifiMode = (wifiMode == WIFI_STA) ? WIFI_AP_STA : WIFI_AP;
+
+    return true;
+}
+
+bool WiFiClass::setAutoReconnect(bool autoReconnect)
+{
+    return true;
+}
+
+bool WiFiClass::setSleep(bool enabled)
+{
+    return true;
+}
+
+bool WiFiClass::setSleep(wifi_ps_type_t type)
+{
+    return true;
+}
+
+int WiFiClass::onEvent(WiFiEventFullCb callback)
+{
+    wifiEventCallbacks.push_back(callback);
+
+    return (int)wifiEventCallbacks.size();
+}
+
+// every host gets its own stable public address
+int WiFiClass::hostByName(const char *host, IPAddress &result)
+{
+    uint32_t hash = 2166136261u;
+
+    simStats.dnsLookups++;
+
+    if(!wifiAssociated)
+    {
+        return 0;
+    }
+
+    if(!simNetwork.internet)
+    {
+        delay(SIM_DNS_TIMEOUT_MS);
+        return 0;
+    }
+
+    delay(SIM_DNS_MS);
+
+    for(const char *c = host; *c != '\0'; c++)
+    {
+        hash = (hash ^ (uint8_t)*c) * 16777619u;
+    }
+
+    result = IPAddress(93, (hash >> 16) & 0x7F, (hash >> 8) & 0xFF, (hash & 0xFD) + 1);
+
+    return 1;
+}
+
+// the same every time for the same moment, changes slowly during the day
+double simTemperature(uint64_t epoch)
+{
+    return 12.0 + 8.0 * sin((double)(epoch % 86400) / 86400.0 * 2.0 * M_PI - M_PI / 2.0) + 3.0 * sin((double)epoch / 604800.0 * 2.0 * M_PI);
+}
+
+const char* simWeatherIcon(uint64_t epoch)
+{
+    static const char *icons[] = {"01", "02", "03", "04", "09", "10", "11", "13", "50"};
+    static char icon[4];
+    uint32_t hour = (epoch % 86400) / 3600;
+
+    snprintf(icon, sizeof(icon), "%s%c", icons[(epoch / 10800) % 9], (hour >= 6 && hour < 20) ? 'd' : 'n');
+
+    return icon;
+}
+
+std::string weatherBody(uint64_t epoch)
+{
+    char body[512];
+
+    snprintf(body, sizeof(body),
+        "{\"coord\":{\"lon\":17.1067,\"lat\":48.1482},\"weather\":[{\"id\":800,\"main\":\"Clear\",\"description\":\"clear sky\",\"icon\":\"%s\"}],"
+        "\"base\":\"stations\",\"main\":{\"temp\":%.2f,\"feels_like\":%.2f,\"pressure\":1016,\"humidity\":%u},\"visibility\":10000,"
+        "\"wind\":{\"speed\":%.2f,\"deg\":230},\"clouds\":{\"all\":0},\"dt\":%llu,\"sys\":{\"country\":\"SK\"},\"timezone\":3600,\"id\":3060972,\"name\":\"Bratislava\",\"cod\":200}",
+        simWeatherIcon(epoch), simTemperature(epoch), simTemperature(epoch) - 1.0, (unsigned)(40 + (epoch / 3600) % 50), 1.0 + (double)((epoch / 3600) % 7), (unsigned long long)epoch);
+
+    return body;
+}
+
+// 40 samples, 3 hours apart, first one is the next 3 hour step (as openweather sends it)
+std::string forecastBody(uint64_t epoch)
+{
+    uint64_t first = (epoch / 10800 + 1) * 10800;
+    std::string body = "{\"cod\":\"200\",\"message\":0,\"cnt\":40,\"list\":[";
+    char sample[512];
+
+    for(int i = 0; i < 40; i++)
+    {
+        uint64_t dt = first + (uint64_t)i * 10800;
+
+        snprintf(sample, sizeof(sample),
+            "%s{\"dt\":%llu,\"main\":{\"temp\":%.2f,\"feels_like\":%.2f,\"temp_min\":%.2f,\"temp_max\":%.2f,\"pressure\":1016,\"humidity\":%u},"
+            "\"weather\":[{\"id\":800,\"main\":\"Clear\",\"description\":\"clear sky\",\"icon\":\"%s\"}],\"clouds\":{\"all\":0},"
+            "\"wind\":{\"speed\":%.2f,\"deg\":230,\"gust\":5.1},\"visibility\":10000,\"pop\":0,\"sys\":{\"pod\":\"d\"},\"dt_txt\":\"\"}",
+            (i == 0) ? "" : ",", (unsigned long long)dt, simTemperature(dt), simTemperature(dt) - 1.0, simTemperature(dt) - 0.5, simTemperature(dt) + 0.5,
+            (unsigned)(40 + (dt / 3600) % 50), simWeatherIcon(dt), 1.0 + (double)((dt / 3600) % 7));
+
+        body += sample;
+    }
+
+    body += "],\"city\":{\"id\":3060972,\"name\":\"Bratislava\",\"country\":\"SK\",\"timezone\":3600}}";
+
+    return body;
+}
+
+void respond(std::shared_ptr<SimConnection> connection, const std::string &request)
+{
+    char path[256] = "";
+    char header[256];
+    std::string body;
+    int status = 404;
+
+    sscanf(request.c_str(), "GET %255s", path);
+
+    std::string resource(path, strcspn(path, "?"));
+
+    if(!simNetwork.api)
+    {
+        status = 503;
+        body = "{\"cod\":503,\"message\":\"service unavailable\"}";
+    }
+    else if(resource == "/data/2.5/weather")
+    {
+        status = 200;
+        body = weatherBody(simTrueTimeUs() / SIM_US_PER_S);
+    }
+    else if(resource == "/data/2.5/forecast")
+    {
+        status = 200;
+        body = forecastBody(simTrueTimeUs() / SIM_US_PER_S);
+    }
+    else
+    {
+        body = "{\"cod\":\"404\",\"message\":\"Internal error\"}";
+    }
+
+    simStats.httpRequests[resource + " " + std::to_string(status)]++;
+
+    snprintf(header, sizeof(header), "HTTP/1.1 %d %s\r\nContent-Type: application/json; charset=utf-8\r\nContent-Length: %u\r\nConnection: keep-alive\r\n\r\n",
+        status, (status == 200) ? "OK" : ((status == 503) ? "Service Unavailable" : "Not Found"), (unsigned)body.size());
+
+    connection->received.insert(connection->received.end(), header, header + strlen(header));
+    connection->received.insert(connection->received.end(), body.begin(), body.end());
+
+    // idle connection is closed by server, unless another request comes in meantime
+    uint32_t requests = ++connection->requests;
+    std::weak_ptr<SimConnection> weak = connection;
+
+    simAfter(SIM_HTTP_KEEP_ALIVE_MS * SIM_US_PER_MS, [weak, requests]()
+    {
+        std::shared_ptr<SimConnection> idle = weak.lock();
+
+        if(idle != nullptr && idle->requests == requests)
+        {
+            idle->open = false;
+        }
+    });
+}
+
+// request is complete with the empty line (firmware sends only GET, without body)
+void receiveRequest(std::shared_ptr<SimConnection> connection)
+{
+    size_t end = connection->request.find("\r\n\r\n");
+
+    if(end == std::string::npos)
+    {
+        return;
+    }
+
+    std::string request = connection->request.substr(0, end);
+    std::weak_ptr<SimConnection> weak = connection;
+
+    connection->request.erase(0, end + 4);
+
+    simAfter(SIM_HTTP_RESPONSE_MS * SIM_US_PER_MS, [weak, request]()
+    {
+        std::shared_ptr<SimConnection> target = weak.lock();
+
+        // lost on the way, when network went down meanwhile
+        if(target != nullptr && target->open && reachable(target->ip))
+        {
+            respond(target, request);
+        }
+    });
+}
+
+std::shared_ptr<SimConnection> newConnection(IPAddress ip, uint16_t port)
+{
+    std::shared_ptr<SimConnection> connection = std::make_shared<SimConnection>();
+
+    connection->ip = ip;
+    connection->port = port;
+    connection->fd = nextFd++;
+    connection->open = true;
+    connection->generation = wifiGeneration;
+    connection->requests = 0;
+    connections.push_back(connection);
+    descriptors[connection->fd] = connection;
+
+    return connection;
+}
+
+// station clients come over access point, setup page clients over soft AP
+std::shared_ptr<SimConnection> simConnectToDevice(IPAddress clientIp, uint16_t port)
+{
+    bool softAp = !wifiAssociated && (wifiMode == WIFI_AP || wifiMode == WIFI_AP_STA);
+
+    simStats.webConnects++;
+
+    if(port != listeningPort || (!wifiAssociated && !softAp))
+    {
+        simStats.webConnectFailures++;
+        return nullptr;
+    }
+
+    std::shared_ptr<SimConnection> connection = newConnection(clientIp, port);
+
+    connection->incoming = true;
+    connection->softAp = softAp;
+    serverBacklog.push_back(connection);
+
+    return connection;
+}
+
+// socket API of lwIP, web server writes with it (never waits with MSG_DONTWAIT), outgoing connections take everything
+ssize_t lwip_send(int s, const void *dataptr, size_t size, int flags)
+{
+    auto descriptor = descriptors.find(s);
+    std::shared_ptr<SimConnection> connection = (descriptor != descriptors.end()) ? descriptor->second.lock() : nullptr;
+
+    if(connection == nullptr || !connection->open)
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    if(!connection->remoteOpen || (!connection->softAp && connection->generation != wifiGeneration))
+    {
+        errno = ECONNRESET;
+        return -1;
+    }
+
+    if(!connection->incoming)
+    {
+        connection->request.append((const char*)dataptr, size);
+        receiveRequest(connection);
+        return size;
+    }
+
+    size_t length = std::min(size, SIM_TCP_SEND_BUFFER_SIZE - connection->sendBuffer.size());
+
+    while(length == 0 && (flags & MSG_DONTWAIT) == 0)
+    {
+        delay(SIM_WRITE_POLL_MS);
+
+        if(!connection->open || !connection->remoteOpen)
+        {
+            errno = ECONNRESET;
+            return -1;
+        }
+
+        length = std::min(size, SIM_TCP_SEND_BUFFER_SIZE - connection->sendBuffer.size());
+    }
+
+    if(length == 0)
+    {
+        errno = EAGAIN;
+        return -1;
+    }
+
+    connection->sendBuffer.insert(connection->sendBuffer.end(), (const uint8_t*)dataptr, (const uint8_t*)dataptr + length);
+
+    return length;
+}
+
+void WiFiServer::begin()
+{
+    listeningPort = port;
+}
+
+void WiFiServer::end()
+{
+    listeningPort = 0;
+}
+
+WiFiClient WiFiServer::available()
+{
+    return accept();
+}
+
+WiFiClient WiFiServer::accept()
+{
+    while(!serverBacklog.empty())
+    {
+        std::shared_ptr<SimConnection> connection = serverBacklog.front();
+
+        serverBacklog.pop_front();
+
+        // gave up waiting meanwhile
+        if(connection->remoteOpen || !connection->received.empty())
+        {
+            return WiFiClient(connection);
+        }
+
+        connection->open = false;
+    }
+
+    return WiFiClient();
+}
+
+bool WiFiServer::hasClient()
+{
+    return !serverBacklog.empty();
+}
+
+WiFiClient::WiFiClient()
+{
+}
+
+WiFiClient::WiFiClient(std::shared_ptr<SimConnection> connection) : connection(connection)
+{
+}
+
+int WiFiClient::connect(IPAddress ip, uint16_t port, int32_t timeoutMs)
+{
+    stop();
+    simStats.tcpConnects++;
+
+    if(!wifiAssociated)
+    {
+        simStats.tcpConnectFailures++;
+        return 0;
+    }
+
+    if(!reachable(ip))
+    {
+        delay(timeoutMs);
+        simStats.tcpConnectFailures++;
+        return 0;
+    }
+
+    delay(SIM_TCP_CONNECT_MS);
+
+    if(!reachable(ip))
+    {
+        simStats.tcpConnectFailures++;
+        return 0;
+    }
+
+    connection = newConnection(ip, port);
+
+    return 1;
+}
+
+int WiFiClient::connect(IPAddress ip, uint16_t port)
+{
+    return connect(ip, port, 3000);
+}
+
+int WiFiClient::connect(const char *host, uint16_t port)
+{
+    IPAddress ip;
+
+    if(!ip.fromString(host) && WiFi.hostByName(host, ip) != 1)
+    {
+        return 0;
+    }
+
+    return connect(ip, port);
+}
+
+uint8_t WiFiClient::connected()
+{
+    return connection != nullptr && ((connection->open && connection->remoteOpen) || !connection->received.empty());
+}
+
+WiFiClient::operator bool()
+{
+    return connected();
+}
+
+int WiFiClient::available()
+{
+    return (connection != nullptr) ? (int)connection->received.size() : 0;
+}
+
+int WiFiClient::read()
+{
+    if(connection == nullptr || connection->received.empty())
+    {
+        return -1;
+    }
+
+    uint8_t c = connection->received.front();
+    connection->received.pop_front();
+
+    return c;
+}
+
+int WiFiClient::read(uint8_t *buffer, size_t size)
+{
+    size_t count = 0;
+
+    while(count < size && available() > 0)
+    {
+        buffer[count++] = (uint8_t)read();
+    }
+
+    return (count > 0) ? (int)count : -1;
+}
+
+int WiFiClient::peek()
+{
+    return (connection != nullptr && !connection->received.empty()) ? connection->received.front() : -1;
+}
+
+size_t WiFiClient::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+/* As Arduino-ESP32 does it: waits until socket takes everything, gives up after SIM_WRITE_RETRIES selects of SIM_WRITE_SELECT_MS
+ * without any progress, so a client which reads slowly holds the writing task.
+ */
+size_t WiFiClient::write(const uint8_t *buffer, size_t size)
+{
+    size_t written = 0;
+    uint32_t retries = SIM_WRITE_RETRIES;
+    uint32_t waitedMs = 0;
+
+    if(connection == nullptr || !connection->open)
+    {
+        return 0;
+    }
+
+    while(written < size && retries > 0)
+    {
+        ssize_t result = lwip_send(connection->fd, buffer + written, size - written, MSG_DONTWAIT);
+
+        if(result > 0)
+        {
+            written += result;
+            retries = SIM_WRITE_RETRIES;
+            waitedMs = 0;
+        }
+        else if(errno != EAGAIN)
+        {
+            break;
+        }
+        else
+        {
+            delay(SIM_WRITE_POLL_MS);
+            waitedMs += SIM_WRITE_POLL_MS;
+
+            if(waitedMs >= SIM_WRITE_SELECT_MS)
+            {
+                retries--;
+                waitedMs = 0;
+            }
+        }
+    }
+
+    return written;
+}
+
+void WiFiClient::stop()
+{
+    if(connection != nullptr)
+    {
+        connection->open = false;
+        connection->received.clear();
+        descriptors.erase(connection->fd);
+        connection = nullptr;
+    }
+}
+
+int WiFiClient::fd() const
+{
+    return (connection != nullptr && connection->open) ? connection->fd : -1;
+}
+
+IPAddress WiFiClient::remoteIP() const
+{
+    return (connection != nullptr) ? connection->ip : IPAddress();
+}
+
+esp_err_t esp_ping_new_session(const esp_ping_config_t *config, const esp_ping_callbacks_t *callbacks, esp_ping_handle_t *handle)
+{
+    SimPing *ping = new SimPing();
+
+    ping->config = *config;
+    ping->callbacks = *callbacks;
+    ping->timeGapMs = 0;
+    *handle = ping;
+
+    return ESP_OK;
+}
+
+// one echo request per start (firmware uses count 1), callbacks come from timer as they would from ping task
+esp_err_t esp_ping_start(esp_ping_handle_t handle)
+{
+    IPAddress target(handle->config.target_addr.addr);
+    bool answered = reachable(target);
+
+    simStats.pings++;
+
+    simAfter((answered ? SIM_PING_MS : handle->config.timeout_ms) * SIM_US_PER_MS, [handle, answered]()
+    {
+        if(answered)
+        {
+            simStats.pingsAnswered++;
+            handle->timeGapMs = SIM_PING_MS;
+
+            if(handle->callbacks.on_ping_success != nullptr)
+            {
+                handle->callbacks.on_ping_success(handle, handle->callbacks.cb_args);
+            }
+        }
+        else if(handle->callbacks.on_ping_timeout != nullptr)
+        {
+            handle->callbacks.on_ping_timeout(handle, handle->callbacks.cb_args);
+        }
+
+        if(handle->callbacks.on_ping_end != nullptr)
+        {
+            handle->callbacks.on_ping_end(handle, handle->callbacks.cb_args);
+        }
+    });
+
+    return ESP_OK;
+}
+
+esp_err_t esp_ping_stop(esp_ping_handle_t handle)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_ping_delete_session(esp_ping_handle_t handle)
+{
+    delete handle;
+
+    return ESP_OK;
+}
+
+esp_err_t esp_ping_get_profile(esp_ping_handle_t handle, esp_ping_profile_t profile, void *data, uint32_t size)
+{
+    if(profile != ESP_PING_PROF_TIMEGAP || size < sizeof(uint32_t))
+    {
+        return ESP_FAIL;
+    }
+
+    memcpy(data, &handle->timeGapMs, sizeof(uint32_t));
+
+    return ESP_OK;
+}
+
+/* lwIP SNTP: request right after start, then every sync interval, failed request is retried with backoff.
+ * Answer sets device clock to real world time, so clock drift is undone at every sync.
+ */
+void sntpRequest(uint32_t generation)
+{
+    if(!sntpRunning || generation != sntpGeneration)
+    {
+        return;
+    }
+
+    simStats.ntpRequests++;
+
+    if(wifiAssociated && simNetwork.internet && simNetwork.ntp)
+    {
+        simAfter(SIM_NTP_MS * SIM_US_PER_MS, [generation]()
+        {
+            if(!sntpRunning || generation != sntpGeneration)
+            {
+                return;
+            }
+
+            struct timeval tv;
+            uint64_t now = simTrueTimeUs();
+
+            tv.tv_sec = (time_t)(now / SIM_US_PER_S);
+            tv.tv_usec = (suseconds_t)(now % SIM_US_PER_S);
+            settimeofday(&tv, NULL);
+
+            simStats.ntpSyncs++;
+            sntpStatus = SNTP_SYNC_STATUS_COMPLETED;
+            sntpRetryMs = SIM_NTP_RETRY_MIN_MS;
+
+            if(sntpCallback != nullptr)
+            {
+                sntpCallback(&tv);
+            }
+
+            simAfter((uint64_t)sntpIntervalMs * SIM_US_PER_MS, [generation]() { sntpRequest(generation); });
+        });
+    }
+    else
+    {
+        simAfter((uint64_t)sntpRetryMs * SIM_US_PER_MS, [generation]() { sntpRequest(generation); });
+        sntpRetryMs = min(sntpRetryMs * 2, (uint32_t)SIM_NTP_RETRY_MAX_MS);
+    }
+}
+
+void sntpStart()
+{
+    uint32_t generation = ++sntpGeneration;
+
+    sntpRunning = true;
+    sntpRetryMs = SIM_NTP_RETRY_MIN_MS;
+    sntpStatus = SNTP_SYNC_STATUS_RESET;
+    simAfter(0, [generation]() { sntpRequest(generation); });
+}
+
+void configTime(long gmtOffsetSec, int daylightOffsetSec, const char *server1, const char *server2, const char *server3)
+{
+    char tz[32];
+
+    // the same POSIX TZ Arduino-ESP32 builds (sign is inverted in POSIX)
+    snprintf(tz, sizeof(tz), "UTC%+ld", -(gmtOffsetSec / 3600));
+    configTzTime(tz, server1, server2, server3);
+}
+
+void configTzTime(const char *tz, const char *server1, const char *server2, const char *server3)
+{
+    setenv("TZ", tz, 1);
+    tzset();
+    sntpStart();
+}
+
+void sntp_set_time_sync_notification_cb(void (*callback)(struct timeval *tv))
+{
+    sntpCallback = callback;
+}
+
+void sntp_set_sync_interval(uint32_t intervalMs)
+{
+    sntpIntervalMs = max(intervalMs, (uint32_t)15000);
+}
+
+bool sntp_enabled()
+{
+    return sntpRunning;
+}
+
+void sntp_restart()
+{
+    if(sntpRunning)
+    {
+        sntpStart();
+    }
+}
+
+void sntp_stop()
+{
+    sntpRunning = false;
+    sntpGeneration++;
+}
+
+sntp_sync_status_t sntp_get_sync_status()
+{
+    return sntpStatus;
+}
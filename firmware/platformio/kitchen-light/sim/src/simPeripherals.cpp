@@ -0,0 +1,476 @@
+// core includes
+#include <Arduino.h>
+#include <Adafruit_ST7789.h>
+#include <FastLED.h>
+#include <Preferences.h>
+#include <RotaryEncoder.h>
+#include <esp_pm.h>
+#include <mbedtls/base64.h>
+#include <mbedtls/sha1.h>
+#include <rom/miniz.h>
+#include <zlib.h>
+#include <map>
+#include <string>
+#include <vector>
+
+// project includes
+#include "sim.h"
+#include "pinout.h"
+
+/* Display, LED strip, knobs and NVS, only counted or kept in memory.
+ * Knob turns and presses are played as pin changes would be: position moves, then interrupt handlers run.
+ */
+
+#define SIM_KNOB_DETENT_MS 30
+
+CFastLED FastLED;
+
+// encoders are globals of the firmware, they register before any global of this file might be constructed
+std::vector<RotaryEncoder*>& encoders()
+{
+    static std::vector<RotaryEncoder*> registry;
+
+    return registry;
+}
+
+std::map<std::string, std::vector<uint8_t>> preferenceStore;
+
+// UCHAR and UINT keys of the firmware, everything else is stored as bytes (strings including terminator)
+const char *preferenceUCharKeys[] = {"CPT", "brightness"};
+const char *preferenceUIntKeys[] = {"firstRun", "color-hue", "color-t", "rng-id", "rng-pwd", "n-leds"};
+
+void Adafruit_ST7789::init(uint16_t width, uint16_t height, uint8_t spiMode)
+{
+    currentWidth = width;
+    currentHeight = height;
+}
+
+void Adafruit_ST7789::setRotation(uint8_t newRotation)
+{
+    bool swapped = ((newRotation ^ rotation) & 1) != 0;
+
+    rotation = newRotation;
+
+    if(swapped)
+    {
+        int16_t width = currentWidth;
+
+        currentWidth = currentHeight;
+        currentHeight = width;
+    }
+}
+
+void Adafruit_ST7789::countDraw(uint32_t pixels)
+{
+    simStats.displayDraws++;
+    simStats.displayPixels += pixels;
+}
+
+void Adafruit_ST7789::fillScreen(uint16_t color)
+{
+    simStats.displayClears++;
+    countDraw((uint32_t)currentWidth * currentHeight);
+}
+
+void Adafruit_ST7789::fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color)
+{
+    countDraw(abs((x1 - x0) * (y2 - y0) - (x2 - x0) * (y1 - y0)) / 2 + 1);
+}
+
+// built-in 5x7 font in 6x8 cell, scaled
+size_t Adafruit_ST7789::write(uint8_t c)
+{
+    if(c != '\n' && c != '\r')
+    {
+        simStats.displayTextCharacters++;
+        countDraw(48 * textSize * textSize);
+    }
+
+    return 1;
+}
+
+CRGB blend(const CRGB &first, const CRGB &second, fract8 amountOfSecond)
+{
+    CRGB result;
+
+    for(uint8_t i = 0; i < 3; i++)
+    {
+        result[i] = first[i] + (((int)second[i] - first[i]) * amountOfSecond) / 256;
+    }
+
+    return result;
+}
+
+CLEDController& CFastLED::addLeds(CRGB *newLeds, int newCount)
+{
+    if(newCount != count)
+    {
+        simStats.ledStripResizes++;
+    }
+
+    leds = newLeds;
+    count = newCount;
+
+    return controller;
+}
+
+void CFastLED::show()
+{
+    simStats.ledShows++;
+}
+
+void CFastLED::clear(bool writeData)
+{
+    for(int i = 0; i < count; i++)
+    {
+        leds[i] = CRGB::Black;
+    }
+
+    if(writeData)
+    {
+        show();
+    }
+}
+
+RotaryEncoder::RotaryEncoder(int pin1, int pin2, LatchMode mode) : pin1(pin1)
+{
+    encoders().push_back(this);
+}
+
+RotaryEncoder::Direction RotaryEncoder::getDirection()
+{
+    long moved = position - reportedPosition;
+
+    reportedPosition = position;
+
+    return (moved > 0) ? Direction::CLOCKWISE : ((moved < 0) ? Direction::COUNTERCLOCKWISE : Direction::NOROTATION);
+}
+
+RotaryEncoder* knobEncoder(uint8_t knob)
+{
+    uint8_t pin = (knob == 1) ? RE_1_IN1_PIN : RE_2_IN1_PIN;
+
+    for(RotaryEncoder *encoder : encoders())
+    {
+        if(encoder->pin1 == pin)
+        {
+            return encoder;
+        }
+    }
+
+    return nullptr;
+}
+
+// clockwise is positive, the way encoder library counts it
+void simTurnKnob(uint8_t knob, int32_t detents)
+{
+    RotaryEncoder *encoder = knobEncoder(knob);
+    int8_t step = (detents > 0) ? 1 : -1;
+
+    if(encoder == nullptr)
+    {
+        return;
+    }
+
+    for(int32_t i = 0; i < abs(detents); i++)
+    {
+        simAfter((uint64_t)i * SIM_KNOB_DETENT_MS * SIM_US_PER_MS, [encoder, step]()
+        {
+            encoder->position += step;
+            simRaiseInterrupts(encoder->pin1);
+        });
+    }
+}
+
+void simPressKnob(uint8_t knob, uint32_t durationMs)
+{
+    uint8_t pin = (knob == 1) ? RE_1_SW_PIN : RE_2_SW_PIN;
+
+    simSetPin(pin, LOW);
+    simAfter((uint64_t)durationMs * SIM_US_PER_MS, [pin]() { simSetPin(pin, HIGH); });
+}
+
+bool keyIn(const char *key, const char **keys, size_t count)
+{
+    for(size_t i = 0; i < count; i++)
+    {
+        if(strcmp(key, keys[i]) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// NVS skips writing value that is already stored, so only real changes wear the flash
+size_t putPreference(const char *key, const void *value, size_t length)
+{
+    std::vector<uint8_t> bytes((const uint8_t*)value, (const uint8_t*)value + length);
+
+    simStats.preferencePuts[key]++;
+
+    if(preferenceStore.count(key) == 0 || preferenceStore[key] != bytes)
+    {
+        simStats.preferenceWrites[key]++;
+        preferenceStore[key] = bytes;
+    }
+
+    return length;
+}
+
+bool getPreference(const char *key, void *value, size_t length)
+{
+    if(preferenceStore.count(key) == 0 || preferenceStore[key].size() != length)
+    {
+        return false;
+    }
+
+    memcpy(value, preferenceStore[key].data(), length);
+
+    return true;
+}
+
+void simSeedPreferences(const char *key, const std::string &value)
+{
+    if(keyIn(key, preferenceUCharKeys, sizeof(preferenceUCharKeys) / sizeof(preferenceUCharKeys[0])))
+    {
+        uint8_t number = (uint8_t)strtoul(value.c_str(), NULL, 10);
+        preferenceStore[key] = std::vector<uint8_t>(&number, &number + 1);
+    }
+    else if(keyIn(key, preferenceUIntKeys, sizeof(preferenceUIntKeys) / sizeof(preferenceUIntKeys[0])))
+    {
+        uint32_t number = (uint32_t)strtoul(value.c_str(), NULL, 10);
+        preferenceStore[key] = std::vector<uint8_t>((uint8_t*)&number, (uint8_t*)&number + sizeof(number));
+    }
+    else
+    {
+        preferenceStore[key] = std::vector<uint8_t>(value.c_str(), value.c_str() + value.size() + 1);
+    }
+}
+
+void simResetPreferences()
+{
+    preferenceStore.clear();
+}
+
+bool Preferences::begin(const char *name, bool readOnly)
+{
+    return true;
+}
+
+bool Preferences::clear()
+{
+    preferenceStore.clear();
+
+    return true;
+}
+
+bool Preferences::isKey(const char *key)
+{
+    return preferenceStore.count(key) != 0;
+}
+
+size_t Preferences::putUChar(const char *key, uint8_t value)
+{
+    return putPreference(key, &value, sizeof(value));
+}
+
+size_t Preferences::putInt(const char *key, int32_t value)
+{
+    return putPreference(key, &value, sizeof(value));
+}
+
+size_t Preferences::putUInt(const char *key, uint32_t value)
+{
+    return putPreference(key, &value, sizeof(value));
+}
+
+size_t Preferences::putULong64(const char *key, uint64_t value)
+{
+    return putPreference(key, &value, sizeof(value));
+}
+
+size_t Preferences::putBytes(const char *key, const void *value, size_t length)
+{
+    return putPreference(key, value, length);
+}
+
+uint8_t Preferences::getUChar(const char *key, uint8_t defaultValue)
+{
+    uint8_t value;
+
+    return getPreference(key, &value, sizeof(value)) ? value : defaultValue;
+}
+
+int32_t Preferences::getInt(const char *key, int32_t defaultValue)
+{
+    int32_t value;
+
+    return getPreference(key, &value, sizeof(value)) ? value : defaultValue;
+}
+
+uint32_t Preferences::getUInt(const char *key, uint32_t defaultValue)
+{
+    uint32_t value;
+
+    return getPreference(key, &value, sizeof(value)) ? value : defaultValue;
+}
+
+uint64_t Preferences::getULong64(const char *key, uint64_t defaultValue)
+{
+    uint64_t value;
+
+    return getPreference(key, &value, sizeof(value)) ? value : defaultValue;
+}
+
+// like NVS, nothing is copied when stored blob does not fit
+size_t Preferences::getBytes(const char *key, void *buffer, size_t maxLength)
+{
+    if(preferenceStore.count(key) == 0 || preferenceStore[key].size() > maxLength)
+    {
+        return 0;
+    }
+
+    memcpy(buffer, preferenceStore[key].data(), preferenceStore[key].size());
+
+    return preferenceStore[key].size();
+}
+
+// only dynamic frequency scaling is asked for, host has none
+esp_err_t esp_pm_configure(const void *config)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+uint32_t rotateLeft(uint32_t value, uint8_t bits)
+{
+    return (value << bits) | (value >> (32 - bits));
+}
+
+// FIPS 180-4, only WebSocket handshake uses it (web clients check Sec-WebSocket-Accept)
+int mbedtls_sha1(const unsigned char *input, size_t length, unsigned char output[20])
+{
+    uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    std::vector<uint8_t> message(input, input + length);
+    uint64_t bits = (uint64_t)length * 8;
+
+    message.push_back(0x80);
+
+    while(message.size() % 64 != 56)
+    {
+        message.push_back(0);
+    }
+
+    for(int i = 7; i >= 0; i--)
+    {
+        message.push_back((uint8_t)(bits >> (i * 8)));
+    }
+
+    for(size_t block = 0; block < message.size(); block += 64)
+    {
+        uint32_t w[80];
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+
+        for(int i = 0; i < 16; i++)
+        {
+            w[i] = (message[block + i * 4] << 24) | (message[block + i * 4 + 1] << 16) | (message[block + i * 4 + 2] << 8) | message[block + i * 4 + 3];
+        }
+
+        for(int i = 16; i < 80; i++)
+        {
+            w[i] = rotateLeft(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+
+        for(int i = 0; i < 80; i++)
+        {
+            uint32_t f = (i < 20) ? ((b & c) | (~b & d)) : ((i < 40 || i >= 60) ? (b ^ c ^ d) : ((b & c) | (b & d) | (c & d)));
+            uint32_t k = (i < 20) ? 0x5A827999 : ((i < 40) ? 0x6ED9EBA1 : ((i < 60) ? 0x8F1BBCDC : 0xCA62C1D6));
+            uint32_t temp = rotateLeft(a, 5) + f + e + k + w[i];
+
+            e = d;
+            d = c;
+            c = rotateLeft(b, 30);
+            b = a;
+            a = temp;
+        }
+
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+
+    for(int i = 0; i < 20; i++)
+    {
+        output[i] = (uint8_t)(h[i / 4] >> (24 - (i % 4) * 8));
+    }
+
+    return 0;
+}
+
+// same contract as mbedtls: output is NUL terminated, outputLength without it, -0x002A when destination is too small
+int mbedtls_base64_encode(unsigned char *destination, size_t destinationLength, size_t *outputLength, const unsigned char *source, size_t sourceLength)
+{
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t length = (sourceLength + 2) / 3 * 4;
+
+    *outputLength = length + 1;
+
+    if(destinationLength < length + 1)
+    {
+        return -0x002A;
+    }
+
+    for(size_t i = 0, j = 0; i < sourceLength; i += 3, j += 4)
+    {
+        uint32_t triple = (source[i] << 16) | ((i + 1 < sourceLength) ? source[i + 1] << 8 : 0) | ((i + 2 < sourceLength) ? source[i + 2] : 0);
+
+        destination[j] = alphabet[(triple >> 18) & 0x3F];
+        destination[j + 1] = alphabet[(triple >> 12) & 0x3F];
+        destination[j + 2] = (i + 1 < sourceLength) ? alphabet[(triple >> 6) & 0x3F] : '=';
+        destination[j + 3] = (i + 2 < sourceLength) ? alphabet[triple & 0x3F] : '=';
+    }
+
+    destination[length] = '\0';
+    *outputLength = length;
+
+    return 0;
+}
+
+// host zlib, whole stream in one call (the way firmware calls it), decompressor keeps no state between calls
+tinfl_status tinfl_decompress(tinfl_decompressor *r, const uint8_t *inBufferNext, size_t *inBufferSize, uint8_t *outBufferStart, uint8_t *outBufferNext, size_t *outBufferSize, const uint32_t flags)
+{
+    z_stream stream = {};
+    int result;
+
+    stream.next_in = (Bytef*)inBufferNext;
+    stream.avail_in = (uInt)*inBufferSize;
+    stream.next_out = outBufferNext;
+    stream.avail_out = (uInt)*outBufferSize;
+
+    if(inflateInit2(&stream, (flags & TINFL_FLAG_PARSE_ZLIB_HEADER) ? MAX_WBITS : -MAX_WBITS) != Z_OK)
+    {
+        *inBufferSize = 0;
+        *outBufferSize = 0;
+        return TINFL_STATUS_FAILED;
+    }
+
+    result = inflate(&stream, Z_FINISH);
+    *inBufferSize -= stream.avail_in;
+    *outBufferSize -= stream.avail_out;
+    inflateEnd(&stream);
+
+    if(result == Z_STREAM_END)
+    {
+        return TINFL_STATUS_DONE;
+    }
+
+    if(result == Z_BUF_ERROR)
+    {
+        return (stream.avail_out == 0) ? TINFL_STATUS_HAS_MORE_OUTPUT : TINFL_STATUS_NEEDS_MORE_INPUT;
+    }
+
+    return TINFL_STATUS_FAILED;
+}
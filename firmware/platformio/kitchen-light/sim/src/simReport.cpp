@@ -0,0 +1,166 @@
+// core includes
+#include <Arduino.h>
+#include <chrono>
+#include <string>
+
+// project includes
+#include "sim.h"
+
+/* Counters of the run and their report.
+ * Kept apart from entry point (simMain.cpp), so unit tests (env:native) link the simulator without it.
+ */
+
+SimStats simStats;
+std::function<void(const char *line)> simConsoleListener;
+
+std::chrono::steady_clock::time_point hostStart = std::chrono::steady_clock::now();
+
+// console lines that report a state change, counted by their whole text
+const char *transitionPrefixes[] = {"SCREENSTATE CHANGE: ", "WIFI STATUS: ", "INTERNET CONNECTION: ", "NTP SYNC: ", "HTTP GET: "};
+
+std::string formatVirtualTime(uint64_t us)
+{
+    char text[32];
+    uint64_t ms = us / SIM_US_PER_MS;
+
+    snprintf(text, sizeof(text), "%llud %02llu:%02llu:%02llu.%03llu", (unsigned long long)(ms / 86400000), (unsigned long long)(ms / 3600000 % 24),
+        (unsigned long long)(ms / 60000 % 60), (unsigned long long)(ms / 1000 % 60), (unsigned long long)(ms % 1000));
+
+    return text;
+}
+
+void simConsoleLine(const char *line)
+{
+    if(simLogConsole)
+    {
+        printf("[%s] %s\n", formatVirtualTime(simNow()).c_str(), line);
+    }
+
+    if(simConsoleListener)
+    {
+        simConsoleListener(line);
+    }
+
+    for(const char *prefix : transitionPrefixes)
+    {
+        if(strncmp(line, prefix, strlen(prefix)) == 0)
+        {
+            simStats.transitions[line]++;
+            break;
+        }
+    }
+}
+
+void printCount(const char *name, uint64_t count, double days)
+{
+    printf("  |-- %s: %llu", name, (unsigned long long)count);
+
+    if(days > 0.0)
+    {
+        printf(" (%.1f / day)", (double)count / days);
+    }
+
+    printf("\n");
+}
+
+void printCounts(const char *title, const std::map<std::string, uint64_t> &counts, double days)
+{
+    printf("%s:\n", title);
+
+    if(counts.empty())
+    {
+        printf("  |-- none\n");
+    }
+
+    for(const auto &count : counts)
+    {
+        printCount(count.first.c_str(), count.second, days);
+    }
+}
+
+void printLatency(const char *name, const SimLatency &latency)
+{
+    printf("%s avg %.1f ms max %.1f ms", name, (latency.count > 0) ? (double)latency.totalUs / latency.count / SIM_US_PER_MS : 0.0, (double)latency.maxUs / SIM_US_PER_MS);
+}
+
+void printWebResponses()
+{
+    printf("Web server responses (as clients see them):\n");
+
+    if(simStats.webResponses.empty() && simStats.webSockets.empty())
+    {
+        printf("  |-- none\n");
+    }
+
+    for(const auto &response : simStats.webResponses)
+    {
+        printf("  |-- %s: %llu, ", response.first.c_str(), (unsigned long long)response.second.complete.count);
+        printLatency("first byte", response.second.firstByte);
+        printLatency(", complete", response.second.complete);
+        printf("\n");
+    }
+
+    for(const auto &webSocket : simStats.webSockets)
+    {
+        const SimWebSocketStats &stats = webSocket.second;
+
+        printf("  |-- WebSocket %s: %llu clients, %llu handshakes failed, %llu closed by device, %llu messages sent, %llu state pushes received, ",
+            webSocket.first.c_str(), (unsigned long long)stats.clients, (unsigned long long)stats.handshakesFailed, (unsigned long long)stats.closedByDevice,
+            (unsigned long long)stats.messagesSent, (unsigned long long)stats.statePushes);
+        printLatency("message to push", stats.controlToPush);
+        printf("\n");
+    }
+}
+
+void simReport(const char *title)
+{
+    double hostS = std::chrono::duration<double>(std::chrono::steady_clock::now() - hostStart).count();
+    double days = (double)simNow() / (86400.0 * SIM_US_PER_S);
+
+    printf("\nSIM REPORT: %s\n", title);
+    printf("  |-- virtual time: %s\n", formatVirtualTime(simNow()).c_str());
+    printf("  |-- host time: %.2f s (%.0fx)\n", hostS, (hostS > 0.0) ? (double)simNow() / SIM_US_PER_S / hostS : 0.0);
+
+    if(simStopReason() != nullptr)
+    {
+        printf("  |-- stopped by: %s\n", simStopReason());
+    }
+
+    printf("Loops:\n");
+    printCount("UI loop iterations", simStats.loopIterations, days);
+    printCount("notification wakeups", simStats.loopNotifyWakeups, days);
+    printCount("task switches", simStats.taskSwitches, days);
+
+    printf("Display:\n");
+    printCount("clears", simStats.displayClears, days);
+    printCount("draw calls", simStats.displayDraws, days);
+    printCount("pixels", simStats.displayPixels, days);
+    printCount("text characters", simStats.displayTextCharacters, days);
+
+    printf("LED strip:\n");
+    printCount("frames shown", simStats.ledShows, days);
+    printCount("resizes", simStats.ledStripResizes, days);
+
+    printf("Network:\n");
+    printCount("Wi-Fi begins", simStats.wifiBegins, days);
+    printCount("Wi-Fi associations", simStats.wifiAssociations, days);
+    printCount("Wi-Fi disconnects", simStats.wifiDisconnects, days);
+    printCount("DNS lookups", simStats.dnsLookups, days);
+    printCount("TCP connects", simStats.tcpConnects, days);
+    printCount("TCP connect failures", simStats.tcpConnectFailures, days);
+    printCount("pings", simStats.pings, days);
+    printCount("pings answered", simStats.pingsAnswered, days);
+    printCount("NTP requests", simStats.ntpRequests, days);
+    printCount("NTP syncs", simStats.ntpSyncs, days);
+    printCount("web client connects", simStats.webConnects, days);
+    printCount("web client connects refused", simStats.webConnectFailures, days);
+
+    printCounts("HTTP requests", simStats.httpRequests, days);
+    printWebResponses();
+    printCounts("NVS writes (value changed)", simStats.preferenceWrites, days);
+    printCounts("NVS puts", simStats.preferencePuts, days);
+    printCounts("Transitions", simStats.transitions, days);
+
+    printf("\n");
+    fflush(stdout);
+}
@@ -0,0 +1,422 @@
+// core includes
+#include <Arduino.h>
+#include <mbedtls/base64.h>
+#include <mbedtls/sha1.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// project includes
+#include "sim.h"
+#include "simConnection.h"
+
+/* Web clients of the device (browser, phone app). Every one connects to the web server, sends its request at once
+ * and reads response at its own pace: at link speed, or slowly as a phone on bad signal does, which fills socket
+ * send buffer on the device. Times are measured by the client, so they include waiting for network task.
+ */
+
+#define SIM_WEB_SERVER_PORT 80
+#define SIM_WEB_LINK_BYTES_PER_MS 2000 // about 16 Mbit/s of Wi-Fi
+#define SIM_WEB_SOCKET_KEY "dGhlIHNhbXBsZSBub25jZQ==" // RFC 6455 example, any key does
+#define SIM_WEB_SOCKET_GUID "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+#define SIM_WEB_SOCKET_CLOSE_AFTER_MS 1000 // after the last message, late state pushes still come in
+#define SIM_WEB_SOCKET_STALLED_CHECK_MS 1000
+#define SIM_LIVE_CONTROL 0x01 // lightApi.cpp protocol
+#define SIM_LIVE_STATE 0x02
+
+struct SimWebClient
+{
+    std::string name; // method and target, for report
+    std::string method;
+    std::shared_ptr<SimConnection> connection;
+    uint32_t bytesPerSecond; // 0 is link speed
+    uint64_t startUs;
+    uint64_t firstByteUs = 0;
+    std::string response;
+    // WebSocket only
+    bool handshakeDone = false;
+    bool closing = false; // close frame sent by client
+    bool stalled = false; // stops reading once handshake is done, as a frozen browser tab
+    uint32_t messagesLeft = 0;
+    uint64_t messageIntervalUs = 0;
+    uint8_t nextBrightness = 1;
+    std::map<uint8_t, uint64_t> sentBrightness; // control message waiting for its state push, by brightness it asked for
+};
+
+uint8_t nextClientAddress = 100;
+std::vector<std::shared_ptr<SimConnection>> rawClients; // by number simRawConnect() returned
+
+// slow client takes a byte at a time, fast one a chunk every ms
+uint64_t readIntervalUs(uint32_t bytesPerSecond)
+{
+    return (bytesPerSecond == 0 || bytesPerSecond >= 1000) ? SIM_US_PER_MS : SIM_US_PER_S / bytesPerSecond;
+}
+
+size_t readChunk(uint32_t bytesPerSecond)
+{
+    return (bytesPerSecond == 0) ? SIM_WEB_LINK_BYTES_PER_MS : ((bytesPerSecond >= 1000) ? bytesPerSecond / 1000 : 1);
+}
+
+// takes what device sent so far (up to its pace), returns false when nothing more is coming
+bool readConnection(SimConnection *connection, uint32_t bytesPerSecond, std::string *data)
+{
+    size_t chunk = readChunk(bytesPerSecond);
+
+    while(chunk-- > 0 && !connection->sendBuffer.empty())
+    {
+        *data += (char)connection->sendBuffer.front();
+        connection->sendBuffer.pop_front();
+    }
+
+    return connection->open || !connection->sendBuffer.empty();
+}
+
+// whole header and Content-Length of body (none for HEAD), or device closed connection
+bool responseComplete(const SimWebClient *client, bool open)
+{
+    size_t headerEnd = client->response.find("\r\n\r\n");
+
+    if(!open)
+    {
+        return true;
+    }
+
+    if(headerEnd == std::string::npos)
+    {
+        return false;
+    }
+
+    size_t contentLength = 0;
+    size_t field = client->response.find("Content-Length: ");
+
+    if(field != std::string::npos && field < headerEnd && client->method != "HEAD")
+    {
+        contentLength = strtoul(client->response.c_str() + field + 16, NULL, 10);
+    }
+
+    return client->response.size() >= headerEnd + 4 + contentLength;
+}
+
+void finishRequest(std::shared_ptr<SimWebClient> client)
+{
+    int status = 0;
+    std::string key = client->name;
+
+    if(sscanf(client->response.c_str(), "HTTP/1.1 %d", &status) == 1)
+    {
+        key += " " + std::to_string(status);
+    }
+    else
+    {
+        key += " no response";
+    }
+
+    SimWebResponseStats &stats = simStats.webResponses[key];
+
+    if(client->firstByteUs != 0)
+    {
+        stats.firstByte.add(client->firstByteUs - client->startUs);
+    }
+
+    stats.complete.add(simNow() - client->startUs);
+    client->connection->remoteOpen = false;
+}
+
+void readResponse(std::shared_ptr<SimWebClient> client)
+{
+    size_t before = client->response.size();
+    bool open = readConnection(client->connection.get(), client->bytesPerSecond, &client->response);
+
+    if(before == 0 && !client->response.empty())
+    {
+        client->firstByteUs = simNow();
+    }
+
+    if(responseComplete(client.get(), open))
+    {
+        finishRequest(client);
+        return;
+    }
+
+    simAfter(readIntervalUs(client->bytesPerSecond), [client]() { readResponse(client); });
+}
+
+std::shared_ptr<SimWebClient> connectWebClient(const std::string &name, uint32_t bytesPerSecond)
+{
+    std::shared_ptr<SimConnection> connection = simConnectToDevice(IPAddress(192, 168, 1, nextClientAddress++), SIM_WEB_SERVER_PORT);
+
+    if(connection == nullptr)
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<SimWebClient> client = std::make_shared<SimWebClient>();
+
+    client->name = name;
+    client->connection = connection;
+    client->bytesPerSecond = bytesPerSecond;
+    client->startUs = simNow();
+
+    return client;
+}
+
+void sendToDevice(SimConnection *connection, const std::string &data)
+{
+    connection->received.insert(connection->received.end(), data.begin(), data.end());
+}
+
+// one request per connection, as web server closes it after response
+void simWebRequest(const std::string &method, const std::string &target, const std::string &body, uint32_t bytesPerSecond)
+{
+    std::shared_ptr<SimWebClient> client = connectWebClient(method + " " + target, bytesPerSecond);
+    std::string request = method + " " + target + " HTTP/1.1\r\nHost: 192.168.1.50\r\nConnection: close\r\n";
+
+    if(client == nullptr)
+    {
+        return;
+    }
+
+    if(!body.empty())
+    {
+        request += "Content-Type: application/json\r\nContent-Length: " + std::to_string(body.size()) + "\r\n";
+    }
+
+    client->method = method;
+    sendToDevice(client->connection.get(), request + "\r\n" + body);
+    readResponse(client);
+}
+
+// client frames are masked (RFC 6455, 5.3), payloads are small
+void sendWebSocketFrame(SimWebClient *client, uint8_t opcode, const std::string &payload)
+{
+    const uint8_t mask[4] = {0x12, 0x34, 0x56, 0x78};
+    std::string frame;
+
+    frame += (char)(0x80 | opcode);
+    frame += (char)(0x80 | payload.size());
+    frame.append((const char*)mask, sizeof(mask));
+
+    for(size_t i = 0; i < payload.size(); i++)
+    {
+        frame += (char)(payload[i] ^ mask[i % 4]);
+    }
+
+    sendToDevice(client->connection.get(), frame);
+}
+
+std::string webSocketAccept()
+{
+    std::string keyWithGuid = std::string(SIM_WEB_SOCKET_KEY) + SIM_WEB_SOCKET_GUID;
+    unsigned char hash[20];
+    unsigned char accept[32];
+    size_t length;
+
+    mbedtls_sha1((const unsigned char*)keyWithGuid.data(), keyWithGuid.size(), hash);
+    mbedtls_base64_encode(accept, sizeof(accept), &length, hash, sizeof(hash));
+
+    return std::string((const char*)accept, length);
+}
+
+// 101 with the right accept value, anything else fails the client
+bool completeHandshake(SimWebClient *client)
+{
+    size_t headerEnd = client->response.find("\r\n\r\n");
+
+    if(headerEnd == std::string::npos)
+    {
+        return false;
+    }
+
+    std::string header = client->response.substr(0, headerEnd);
+
+    client->response.erase(0, headerEnd + 4);
+
+    if(header.compare(0, 12, "HTTP/1.1 101") != 0 || header.find("Sec-WebSocket-Accept: " + webSocketAccept()) == std::string::npos)
+    {
+        simStats.webSockets[client->name].handshakesFailed++;
+        client->connection->remoteOpen = false;
+        return false;
+    }
+
+    client->handshakeDone = true;
+
+    return true;
+}
+
+// live control message, brightness tells which state push answers it (transition 0, so state takes it right away)
+void sendLiveControl(std::shared_ptr<SimWebClient> client)
+{
+    SimWebSocketStats &stats = simStats.webSockets[client->name];
+
+    if(client->closing || !client->connection->remoteOpen || !client->connection->open)
+    {
+        return;
+    }
+
+    if(client->messagesLeft == 0)
+    {
+        client->closing = true;
+        sendWebSocketFrame(client.get(), 0x8, std::string("\x03\xE8", 2)); // 1000, normal closure
+        return;
+    }
+
+    uint8_t brightness = client->nextBrightness;
+    const uint8_t message[7] = {SIM_LIVE_CONTROL, brightness, 255, (uint8_t)(brightness * 3), (uint8_t)(brightness * 7), 0, 0};
+
+    client->nextBrightness = (brightness == 255) ? 1 : brightness + 1;
+    client->sentBrightness[brightness] = simNow();
+    client->messagesLeft--;
+    stats.messagesSent++;
+    sendWebSocketFrame(client.get(), 0x2, std::string((const char*)message, sizeof(message)));
+
+    simAfter((client->messagesLeft > 0) ? client->messageIntervalUs : SIM_WEB_SOCKET_CLOSE_AFTER_MS * SIM_US_PER_MS, [client]() { sendLiveControl(client); });
+}
+
+// whole frames from what was read so far, false when connection is done
+bool receiveWebSocketFrames(SimWebClient *client)
+{
+    SimWebSocketStats &stats = simStats.webSockets[client->name];
+
+    while(client->response.size() >= 2)
+    {
+        uint8_t opcode = client->response[0] & 0x0F;
+        size_t length = client->response[1] & 0x7F;
+
+        if(client->response.size() < 2 + length)
+        {
+            break;
+        }
+
+        std::string payload = client->response.substr(2, length);
+
+        client->response.erase(0, 2 + length);
+
+        if(opcode == 0x2 && length == 5 && payload[0] == SIM_LIVE_STATE)
+        {
+            auto sent = client->sentBrightness.find((uint8_t)payload[1]);
+
+            stats.statePushes++;
+
+            if(sent != client->sentBrightness.end())
+            {
+                stats.controlToPush.add(simNow() - sent->second);
+                client->sentBrightness.erase(sent);
+            }
+        }
+        else if(opcode == 0x9)
+        {
+            sendWebSocketFrame(client, 0xA, payload);
+        }
+        else if(opcode == 0x8)
+        {
+            if(!client->closing)
+            {
+                stats.closedByDevice++;
+            }
+
+            client->connection->remoteOpen = false;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void readWebSocket(std::shared_ptr<SimWebClient> client)
+{
+    SimConnection *connection = client->connection.get();
+    bool reading = !(client->handshakeDone && client->stalled);
+    bool open = reading ? readConnection(connection, 0, &client->response) : connection->open;
+
+    if(!open || !connection->remoteOpen)
+    {
+        if(!client->closing && connection->remoteOpen)
+        {
+            simStats.webSockets[client->name].closedByDevice++;
+        }
+
+        connection->remoteOpen = false;
+        return;
+    }
+
+    if(!client->handshakeDone && completeHandshake(client.get()) && !client->stalled)
+    {
+        simAfter(client->messageIntervalUs, [client]() { sendLiveControl(client); });
+    }
+
+    if(client->handshakeDone && !receiveWebSocketFrames(client.get()))
+    {
+        return;
+    }
+
+    if(!connection->remoteOpen)
+    {
+        return;
+    }
+
+    simAfter(reading ? SIM_US_PER_MS : SIM_WEB_SOCKET_STALLED_CHECK_MS * SIM_US_PER_MS, [client]() { readWebSocket(client); });
+}
+
+// live control client of /api/live, stalled one only opens it and then stops reading (and answering pings)
+void simWebSocket(uint32_t messages, uint32_t messagesPerSecond, bool stalled)
+{
+    std::shared_ptr<SimWebClient> client = connectWebClient(stalled ? "live stalled" : "live", 0);
+
+    if(client == nullptr)
+    {
+        return;
+    }
+
+    client->stalled = stalled;
+    client->messagesLeft = messages;
+    client->messageIntervalUs = SIM_US_PER_S / max(messagesPerSecond, 1u);
+    simStats.webSockets[client->name].clients++;
+
+    sendToDevice(client->connection.get(), "GET /api/live HTTP/1.1\r\nHost: 192.168.1.50\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+        "Sec-WebSocket-Key: " SIM_WEB_SOCKET_KEY "\r\nSec-WebSocket-Version: 13\r\n\r\n");
+    readWebSocket(client);
+}
+
+int simRawConnect()
+{
+    std::shared_ptr<SimConnection> connection = simConnectToDevice(IPAddress(192, 168, 1, nextClientAddress++), SIM_WEB_SERVER_PORT);
+
+    if(connection == nullptr)
+    {
+        return -1;
+    }
+
+    rawClients.push_back(connection);
+
+    return rawClients.size() - 1;
+}
+
+void simRawWrite(int client, const std::string &data)
+{
+    sendToDevice(rawClients[client].get(), data);
+}
+
+std::string simRawRead(int client, size_t maxLength)
+{
+    SimConnection *connection = rawClients[client].get();
+    std::string data;
+
+    while(data.size() < maxLength && !connection->sendBuffer.empty())
+    {
+        data += (char)connection->sendBuffer.front();
+        connection->sendBuffer.pop_front();
+    }
+
+    return data;
+}
+
+bool simRawDeviceOpen(int client)
+{
+    return rawClients[client]->open;
+}
+
+void simRawClose(int client)
+{
+    rawClients[client]->remoteOpen = false;
+}
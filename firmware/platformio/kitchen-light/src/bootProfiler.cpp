@@ -0,0 +1,86 @@
+// core includes
+#include <Arduino.h>
+
+// project includes
+#include "bootProfiler.h"
+#include "console.h"
+#include "conf.h"
+
+struct BootPhase
+{
+    const char *name;
+    uint32_t beginUs;
+    uint32_t endUs;
+};
+
+BootPhase bootPhases[BOOT_PROFILER_MAX_PHASES];
+uint8_t bootPhaseCount = 0;
+uint32_t bootLedsOnUs = 0;
+
+/* Phases are expected to be sequential (setup() is single threaded), so only the last one can be open.
+ * Phases over BOOT_PROFILER_MAX_PHASES are silently dropped, profiler must never affect boot itself.
+ */
+void bootPhaseBegin(const char *name)
+{
+    if(bootPhaseCount >= BOOT_PROFILER_MAX_PHASES)
+    {
+        return;
+    }
+
+    bootPhases[bootPhaseCount].name = name;
+    bootPhases[bootPhaseCount].beginUs = micros();
+    bootPhases[bootPhaseCount].endUs = 0;
+    bootPhaseCount++;
+}
+
+void bootPhaseEnd()
+{
+    if(bootPhaseCount == 0 || bootPhases[bootPhaseCount - 1].endUs != 0)
+    {
+        return;
+    }
+
+    bootPhases[bootPhaseCount - 1].endUs = micros();
+}
+
+void bootMarkLedsOn()
+{
+    if(bootLedsOnUs == 0)
+    {
+        bootLedsOnUs = micros();
+    }
+}
+
+void printBootProfile()
+{
+    CONSOLE_CRLF("BOOT PROFILE")
+
+    for(uint8_t i = 0; i < bootPhaseCount; i++)
+    {
+        CONSOLE("  |-- ")
+        CONSOLE(bootPhases[i].name)
+        CONSOLE(": ")
+        CONSOLE((bootPhases[i].endUs - bootPhases[i].beginUs) / 1000.0)
+        CONSOLE(" ms (started at ")
+        CONSOLE(bootPhases[i].beginUs / 1000)
+        CONSOLE_CRLF(" ms)")
+    }
+
+    CONSOLE("  |-- LEDs on at: ")
+
+    if(bootLedsOnUs == 0)
+    {
+        CONSOLE_CRLF("NEVER")
+    }
+    else
+    {
+        CONSOLE(bootLedsOnUs / 1000)
+        CONSOLE(" ms (target ")
+        CONSOLE(BOOT_LEDS_ON_TARGET_MS)
+        CONSOLE_CRLF(bootLedsOnUs / 1000 <= BOOT_LEDS_ON_TARGET_MS ? " ms, OK)" : " ms, MISSED)")
+    }
+
+    CONSOLE("  |-- total: ")
+    CONSOLE(micros() / 1000)
+    CONSOLE_CRLF(" ms")
+}
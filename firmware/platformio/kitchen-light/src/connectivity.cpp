@@ -0,0 +1,157 @@
+// core includes
+#include <Arduino.h>
+#include "ping/ping_sock.h"
+#include "lwip/ip_addr.h"
+
+// project includes
+#include "connectivity.h"
+#include "utilities.h"
+#include "metrics.h"
+#include "console.h"
+#include "conf.h"
+
+enum class ProbeState {IDLE, RUNNING, SUCCESS, TIMEOUT};
+
+esp_ping_handle_t pingSession = NULL;
+volatile ProbeState probeState = ProbeState::IDLE;
+volatile bool successReported = false; // NTP callback reports from sntp task
+volatile bool failureReported = false;
+bool internetConnectionState = false;
+uint32_t probeTimer = 0;
+uint32_t probeDelayMs = CONNECTIVITY_INITIAL_PROBE_DELAY_MS;
+uint32_t probeBackoffMs = CONNECTIVITY_BACKOFF_MIN_MS;
+
+// ping callbacks run in ping task, only pass result to handleConnectivityMonitor()
+void onPingSuccess(esp_ping_handle_t session, void *args)
+{
+    uint32_t timeGapMs = 0;
+
+    if(esp_ping_get_profile(session, ESP_PING_PROF_TIMEGAP, &timeGapMs, sizeof(timeGapMs)) == ESP_OK)
+    {
+        metricObserve(Metric::PING_MS, timeGapMs);
+    }
+
+    probeState = ProbeState::SUCCESS;
+}
+
+void onPingTimeout(esp_ping_handle_t session, void *args)
+{
+    metricIncrement(Metric::PING_TIMEOUTS);
+    probeState = ProbeState::TIMEOUT;
+}
+
+void beginConnectivityMonitor()
+{
+    ip_addr_t target;
+    esp_ping_config_t config = ESP_PING_DEFAULT_CONFIG();
+    esp_ping_callbacks_t callbacks = {};
+
+    IP_ADDR4(&target, pingIp[0], pingIp[1], pingIp[2], pingIp[3]);
+    config.target_addr = target;
+    config.count = 1;
+    config.timeout_ms = CONNECTIVITY_PROBE_TIMEOUT_MS;
+
+    callbacks.on_ping_success = onPingSuccess;
+    callbacks.on_ping_timeout = onPingTimeout;
+
+    CONSOLE("Connectivity monitor: ")
+    CONSOLE_CRLF(esp_ping_new_session(&config, &callbacks, &pingSession) == ESP_OK ? "OK" : "ERROR")
+}
+
+// to be called whenever Wi-Fi (re)connects or drops, nothing is known about internet at that point
+void resetConnectivityMonitor()
+{
+    internetConnectionState = false;
+    successReported = false;
+    failureReported = false;
+    probeTimer = millis();
+    probeDelayMs = CONNECTIVITY_INITIAL_PROBE_DELAY_MS;
+    probeBackoffMs = CONNECTIVITY_BACKOFF_MIN_MS;
+}
+
+// any real traffic that reached internet (HTTP response, NTP sync) is as good as a probe
+void reportConnectivitySuccess()
+{
+    successReported = true;
+}
+
+// real traffic failed, which does not have to mean no internet, let the probe confirm it
+void reportConnectivityFailure()
+{
+    failureReported = true;
+}
+
+void connectivityChanged(bool connected)
+{
+    if(internetConnectionState != connected)
+    {
+        internetConnectionState = connected;
+
+        CONSOLE("INTERNET CONNECTION: ")
+        CONSOLE_CRLF(connected ? "OK" : "ERROR")
+    }
+}
+
+/* Never blocks. Probe (single ICMP echo) runs in its own task and is sent only when real traffic failed,
+ * or when there was none for CONNECTIVITY_EVIDENCE_MAX_AGE_MS, which is longer than weather update period,
+ * so a device fetching weather successfully does not probe at all.
+ * While offline, probes are repeated with exponential backoff.
+ */
+void handleConnectivityMonitor()
+{
+    uint32_t now = millis();
+
+    if(successReported)
+    {
+        successReported = false;
+        failureReported = false;
+        connectivityChanged(true);
+        probeTimer = now;
+        probeDelayMs = CONNECTIVITY_EVIDENCE_MAX_AGE_MS;
+        probeBackoffMs = CONNECTIVITY_BACKOFF_MIN_MS;
+    }
+
+    if(failureReported)
+    {
+        failureReported = false;
+
+        // when already offline, keep the backoff going
+        if(internetConnectionState)
+        {
+            probeDelayMs = 0;
+        }
+    }
+
+    if(probeState == ProbeState::SUCCESS)
+    {
+        probeState = ProbeState::IDLE;
+        connectivityChanged(true);
+        probeTimer = now;
+        probeDelayMs = CONNECTIVITY_EVIDENCE_MAX_AGE_MS;
+        probeBackoffMs = CONNECTIVITY_BACKOFF_MIN_MS;
+    }
+    else if(probeState == ProbeState::TIMEOUT)
+    {
+        probeState = ProbeState::IDLE;
+        connectivityChanged(false);
+        probeTimer = now;
+        probeDelayMs = probeBackoffMs;
+        probeBackoffMs = min((uint32_t)(probeBackoffMs * 2), (uint32_t)CONNECTIVITY_BACKOFF_MAX_MS);
+    }
+
+    if(probeState == ProbeState::IDLE && pingSession != NULL && now - probeTimer >= probeDelayMs)
+    {
+        probeState = ProbeState::RUNNING;
+        probeTimer = now;
+
+        if(esp_ping_start(pingSession) != ESP_OK)
+        {
+            probeState = ProbeState::TIMEOUT;
+        }
+    }
+}
+
+bool getInternetConnection()
+{
+    return internetConnectionState;
+}
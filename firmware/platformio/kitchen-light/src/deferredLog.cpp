@@ -0,0 +1,153 @@
+// core includes
+#include <Arduino.h>
+#include <atomic>
+
+// project includes
+#include "deferredLog.h"
+#include "metrics.h"
+#include "console.h"
+#include "conf.h"
+
+/* Bounded lock free ring, any task may push (UI loop, network task, callbacks), only log task takes records out.
+ * Slot sequence says whose turn it is: lap (position rounded down to ring size) when free for that position,
+ * lap + 1 once written, next lap after it was printed. Zero initialized ring is free for the first lap,
+ * so records pushed before beginDeferredLog() are kept and printed once log task runs.
+ * Log task is woken only by the record which finds ring empty, hot path is a compare exchange and a few stores.
+ * Not for ISRs (task notification), records still in ring are lost on reset.
+ */
+
+static_assert((LOG_RING_SIZE & (LOG_RING_SIZE - 1)) == 0, "LOG_RING_SIZE has to be power of 2");
+static_assert(LOG_MAX_ARGUMENTS == 4, "printLogRecords() passes exactly 4 arguments to snprintf()");
+
+struct LogRecord
+{
+    std::atomic<uint32_t> sequence;
+    const char *format;
+    unsigned long arguments[LOG_MAX_ARGUMENTS];
+};
+
+LogRecord logRing[LOG_RING_SIZE];
+std::atomic<uint32_t> logHead(0); // next position to write
+uint32_t logTail = 0; // next position to print, log task only
+std::atomic<int32_t> logPending(0); // written but not yet printed, goes below zero for a moment when record is printed before it is counted
+std::atomic<uint32_t> logDropped(0);
+TaskHandle_t logTask = NULL;
+
+void pushLogRecord(const char *format, const unsigned long *arguments)
+{
+    uint32_t position = logHead.load(std::memory_order_relaxed);
+    LogRecord *record;
+    uint32_t lap;
+
+    for(;;)
+    {
+        record = &logRing[position & (LOG_RING_SIZE - 1)];
+        lap = position & ~(uint32_t)(LOG_RING_SIZE - 1);
+        int32_t turn = (int32_t)(record->sequence.load(std::memory_order_acquire) - lap);
+
+        if(turn == 0)
+        {
+            if(logHead.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if(turn < 0)
+        {
+            // slot still holds record from previous lap, ring is full
+            logDropped.fetch_add(1, std::memory_order_relaxed);
+            metricIncrement(Metric::LOG_DROPPED);
+            return;
+        }
+        else
+        {
+            position = logHead.load(std::memory_order_relaxed); // someone else took it
+        }
+    }
+
+    record->format = format;
+
+    for(uint8_t i = 0; i < LOG_MAX_ARGUMENTS; i++)
+    {
+        record->arguments[i] = arguments[i];
+    }
+
+    record->sequence.store(lap + 1, std::memory_order_release);
+
+    if(logPending.fetch_add(1, std::memory_order_acq_rel) == 0 && logTask != NULL)
+    {
+        xTaskNotifyGive(logTask);
+    }
+}
+
+// prints records in order until the first one not written yet, returns how many
+int32_t printLogRecords()
+{
+    char line[LOG_LINE_MAX_LENGTH];
+    int32_t printed = 0;
+
+    for(;;)
+    {
+        LogRecord *record = &logRing[logTail & (LOG_RING_SIZE - 1)];
+        uint32_t lap = logTail & ~(uint32_t)(LOG_RING_SIZE - 1);
+
+        if(record->sequence.load(std::memory_order_acquire) != lap + 1)
+        {
+            break;
+        }
+
+        const unsigned long *arguments = record->arguments;
+        snprintf(line, sizeof(line), record->format, arguments[0], arguments[1], arguments[2], arguments[3]);
+
+        record->sequence.store(lap + LOG_RING_SIZE, std::memory_order_release);
+        logTail++;
+        printed++;
+
+        CONSOLE_CRLF(line)
+    }
+
+    uint32_t dropped = logDropped.exchange(0, std::memory_order_relaxed);
+
+    if(dropped != 0)
+    {
+        CONSOLE("LOG: DROPPED ")
+        CONSOLE_CRLF(dropped)
+    }
+
+    return printed;
+}
+
+void deferredLogTask(void *parameters)
+{
+    for(;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        for(;;)
+        {
+            int32_t printed = printLogRecords();
+
+            if(logPending.fetch_sub(printed, std::memory_order_acq_rel) - printed <= 0)
+            {
+                break;
+            }
+
+            if(printed == 0)
+            {
+                vTaskDelay(1); // next record is counted, but its writer was interrupted before it finished
+            }
+        }
+    }
+}
+
+void beginDeferredLog()
+{
+    CONSOLE("Log task: ")
+    CONSOLE_CRLF(xTaskCreatePinnedToCore(deferredLogTask, "log", LOG_TASK_STACK_SIZE, NULL, LOG_TASK_PRIORITY, &logTask, LOG_TASK_CORE) == pdPASS ? "OK" : "ERROR")
+
+    // records pushed before there was anyone to wake
+    if(logPending.load(std::memory_order_acquire) > 0)
+    {
+        xTaskNotifyGive(logTask);
+    }
+}
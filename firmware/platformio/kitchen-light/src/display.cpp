@@ -648,89 +648,94 @@ void drawRGB565_filtered(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const u
     display.endWrite();  
 }
 
+void drawWeatherImage(uint16_t x, uint16_t y, Weather weather)
+{
+    switch(weather)
+    {
+        case Weather::CLEAR_SKY_DAY:
+            drawRGB565_filtered(x, y, IMAGE_WIDTH, IMAGE_HEIGHT, image_01d, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
+            break;
+
+        case Weather::CLEAR_SKY_NIGHT:
+            drawRGB565_filtered(x, y, IMAGE_WIDTH, IMAGE_HEIGHT, image_01n, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
+            break;
+        
+        case Weather::FEW_CLOUDS_DAY:
+            drawRGB565_filtered(x, y, IMAGE_WIDTH, IMAGE_HEIGHT, image_02d, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
+            break;
+
+        case Weather::FEW_CLOUDS_NIGHT:
+            drawRGB565_filtered(x, y, IMAGE_WIDTH, IMAGE_HEIGHT, image_02n, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
+            break;
+            
+        case Weather::SCATTERED_CLOUDS_DAY:
+            drawRGB565_filtered(x, y, IMAGE_WIDTH, IMAGE_HEIGHT, image_03d, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
+            break;
+
+        case Weather::SCATTERED_CLOUDS_NIGHT:
+            drawRGB565_filtered(x, y, IMAGE_WIDTH, IMAGE_HEIGHT, image_03n, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
+            break;
+            
+        case Weather::BROKEN_CLOUDS_DAY:
+            drawRGB565_filtered(x, y, IMAGE_WIDTH, IMAGE_HEIGHT, image_04d, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
+            break;
+
+        case Weather::BROKEN_CLOUDS_NIGHT:
+            drawRGB565_filtered(x, y, IMAGE_WIDTH, IMAGE_HEIGHT, image_04n, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
+            break;
+            
+        case Weather::SHOWER_RAIN_DAY:
+            drawRGB565_filtered(x, y, IMAGE_WIDTH, IMAGE_HEIGHT, image_09d, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
+            break;
+
+        case Weather::SHOWER_RAIN_NIGHT:
+            drawRGB565_filtered(x, y, IMAGE_WIDTH, IMAGE_HEIGHT, image_09n, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
+            break;
+            
+        case Weather::RAIN_DAY:
+            drawRGB565_filtered(x, y, IMAGE_WIDTH, IMAGE_HEIGHT, image_10d, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
+            break;
+
+        case Weather::RAIN_NIGHT:
+            drawRGB565_filtered(x, y, IMAGE_WIDTH, IMAGE_HEIGHT, image_10n, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
+            break;
+            
+        case Weather::THUNDERSTORM_DAY:
+            drawRGB565_filtered(x, y, IMAGE_WIDTH, IMAGE_HEIGHT, image_11d, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
+            break;
+
+        case Weather::THUNDERSTORM_NIGHT:
+            drawRGB565_filtered(x, y, IMAGE_WIDTH, IMAGE_HEIGHT, image_11n, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
+            break;
+            
+        case Weather::SNOW_DAY:
+            drawRGB565_filtered(x, y, IMAGE_WIDTH, IMAGE_HEIGHT, image_13d, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
+            break;
+
+        case Weather::SNOW_NIGHT:
+            drawRGB565_filtered(x, y, IMAGE_WIDTH, IMAGE_HEIGHT, image_13n, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
+            break;
+            
+        case Weather::MIST_DAY:
+            drawRGB565_filtered(x, y, IMAGE_WIDTH, IMAGE_HEIGHT, image_50d, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
+            break;
+
+        case Weather::MIST_NIGHT:
+            drawRGB565_filtered(x, y, IMAGE_WIDTH, IMAGE_HEIGHT, image_50n, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
+            break;
+
+        default:
+            break;
+    }
+}
+
 void updateWeather(Weather weather, bool invalid = false)
 {
     display.fillRect(display.width() * 3/4 + 1, display.height() - 39, display.width() - 1, 39, COLOR_RGB565_DISPLAY_BACKGROUND); 
 
     if(!invalid)
     {
-        switch(weather)
-        {
-            case Weather::CLEAR_SKY_DAY:
-                drawRGB565_filtered(display.width() * 3/4 + 9, display.height() - 35, IMAGE_WIDTH, IMAGE_HEIGHT, image_01d, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
-                break;
-
-            case Weather::CLEAR_SKY_NIGHT:
-                drawRGB565_filtered(display.width() * 3/4 + 9, display.height() - 35, IMAGE_WIDTH, IMAGE_HEIGHT, image_01n, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
-                break;
-            
-            case Weather::FEW_CLOUDS_DAY:
-                drawRGB565_filtered(display.width() * 3/4 + 9, display.height() - 35, IMAGE_WIDTH, IMAGE_HEIGHT, image_02d, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
-                break;
-
-            case Weather::FEW_CLOUDS_NIGHT:
-                drawRGB565_filtered(display.width() * 3/4 + 9, display.height() - 35, IMAGE_WIDTH, IMAGE_HEIGHT, image_02n, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
-                break;
-                
-            case Weather::SCATTERED_CLOUDS_DAY:
-                drawRGB565_filtered(display.width() * 3/4 + 9, display.height() - 35, IMAGE_WIDTH, IMAGE_HEIGHT, image_03d, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
-                break;
-
-            case Weather::SCATTERED_CLOUDS_NIGHT:
-                drawRGB565_filtered(display.width() * 3/4 + 9, display.height() - 35, IMAGE_WIDTH, IMAGE_HEIGHT, image_03n, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
-                break;
-                
-            case Weather::BROKEN_CLOUDS_DAY:
-                drawRGB565_filtered(display.width() * 3/4 + 9, display.height() - 35, IMAGE_WIDTH, IMAGE_HEIGHT, image_04d, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
-                break;
-
-            case Weather::BROKEN_CLOUDS_NIGHT:
-                drawRGB565_filtered(display.width() * 3/4 + 9, display.height() - 35, IMAGE_WIDTH, IMAGE_HEIGHT, image_04n, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
-                break;
-                
-            case Weather::SHOWER_RAIN_DAY:
-                drawRGB565_filtered(display.width() * 3/4 + 9, display.height() - 35, IMAGE_WIDTH, IMAGE_HEIGHT, image_09d, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
-                break;
-
-            case Weather::SHOWER_RAIN_NIGHT:
-                drawRGB565_filtered(display.width() * 3/4 + 9, display.height() - 35, IMAGE_WIDTH, IMAGE_HEIGHT, image_09n, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
-                break;
-                
-            case Weather::RAIN_DAY:
-                drawRGB565_filtered(display.width() * 3/4 + 9, display.height() - 35, IMAGE_WIDTH, IMAGE_HEIGHT, image_10d, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
-                break;
-
-            case Weather::RAIN_NIGHT:
-                drawRGB565_filtered(display.width() * 3/4 + 9, display.height() - 35, IMAGE_WIDTH, IMAGE_HEIGHT, image_10n, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
-                break;
-                
-            case Weather::THUNDERSTORM_DAY:
-                drawRGB565_filtered(display.width() * 3/4 + 9, display.height() - 35, IMAGE_WIDTH, IMAGE_HEIGHT, image_11d, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
-                break;
-
-            case Weather::THUNDERSTORM_NIGHT:
-                drawRGB565_filtered(display.width() * 3/4 + 9, display.height() - 35, IMAGE_WIDTH, IMAGE_HEIGHT, image_11n, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
-                break;
-                
-            case Weather::SNOW_DAY:
-                drawRGB565_filtered(display.width() * 3/4 + 9, display.height() - 35, IMAGE_WIDTH, IMAGE_HEIGHT, image_13d, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
-                break;
-
-            case Weather::SNOW_NIGHT:
-                drawRGB565_filtered(display.width() * 3/4 + 9, display.height() - 35, IMAGE_WIDTH, IMAGE_HEIGHT, image_13n, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
-                break;
-                
-            case Weather::MIST_DAY:
-                drawRGB565_filtered(display.width() * 3/4 + 9, display.height() - 35, IMAGE_WIDTH, IMAGE_HEIGHT, image_50d, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
-                break;
-
-            case Weather::MIST_NIGHT:
-                drawRGB565_filtered(display.width() * 3/4 + 9, display.height() - 35, IMAGE_WIDTH, IMAGE_HEIGHT, image_50n, COLOR_RGB565_IGNORE_IN_BMP_PICTURES);
-                break;
-
-            default:
-                break;
-        }
+        drawWeatherImage(display.width() * 3/4 + 9, display.height() - 35, weather);
     }
 }
 
@@ -803,6 +808,60 @@ void drawOfflineMode()
     display.print("Reset device to enter\r\nconfiguration mode again.\r\n"); 
 }
 
+void loadDisplayForecast(const ForecastDay *days, uint8_t numberOfDays)
+{
+    uint16_t columnWidth = display.width() / FORECAST_MAX_DAYS;
+    struct tm timeInfo;
+
+    display.setCursor(5, 6);
+    display.setTextColor(COLOR_RGB565_DISPLAY_FOREGROUND);
+    display.setTextSize(3, 3);
+    display.setTextWrap(false);
+    display.print("FORECAST");
+
+    display.drawFastHLine(0, 40, display.width(), COLOR_RGB565_DISPLAY_FOREGROUND);
+
+    if(numberOfDays == 0)
+    {
+        display.setCursor(0, 47);
+        display.setTextSize(2, 2);
+        display.setTextWrap(true);
+        display.print("Forecast not available.");
+
+        CONSOLE_CRLF("DISPLAY: FORECAST LOADED (EMPTY)")
+        return;
+    }
+
+    for(uint8_t i = 0; i < numberOfDays; i++)
+    {
+        uint16_t x = i * columnWidth;
+
+        if(i != 0)
+        {
+            display.drawFastVLine(x, 40, display.height() - 40, COLOR_RGB565_DISPLAY_FOREGROUND);
+        }
+
+        localtime_r(&days[i].epoch, &timeInfo);
+
+        display.setCursor(x + 6, 52);
+        display.setTextSize(3, 3);
+        display.print(dayNames[timeInfo.tm_wday]);
+
+        drawWeatherImage(x, 92, days[i].weather);
+
+        // max temperature big, min temperature small below
+        display.setCursor(x + 6, 144);
+        display.setTextSize(3, 3);
+        display.print((int32_t)lround(days[i].maxTemperature_dC / 10.0));
+
+        display.setCursor(x + 6, 184);
+        display.setTextSize(2, 2);
+        display.print((int32_t)lround(days[i].minTemperature_dC / 10.0));
+    }
+
+    CONSOLE_CRLF("DISPLAY: FORECAST LOADED")
+}
+
 void loadAndExecuteFactoryReset(Preferences *preferences)
 {
     display.drawRect(PICKER_OFFSET_X, PICKER_OFFSET_Y, PICKER_WIDTH, PICKER_HEIGHT, COLOR_RGB565_DISPLAY_FOREGROUND);
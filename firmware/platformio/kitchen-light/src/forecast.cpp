@@ -0,0 +1,179 @@
+// core includes
+#include <Arduino.h>
+#include <time.h>
+
+// project includes
+#include "forecast.h"
+#include "weather.h"
+#include "console.h"
+#include "conf.h"
+
+// lib includes
+#include <ArduinoJson.h>
+
+void forecastClear(ForecastRing *forecast)
+{
+    forecast->firstEpoch = 0;
+    forecast->head = 0;
+    forecast->count = 0;
+}
+
+// samples must come in order and without gaps, anything else is refused
+bool forecastPush(ForecastRing *forecast, uint32_t epoch, const ForecastSample *sample)
+{
+    if(forecast->count == 0)
+    {
+        forecast->firstEpoch = epoch;
+        forecast->head = 0;
+    }
+    else if(epoch != forecast->firstEpoch + (uint32_t)forecast->count * FORECAST_SAMPLE_PERIOD_S)
+    {
+        return false;
+    }
+
+    if(forecast->count < FORECAST_MAX_SAMPLES)
+    {
+        forecast->samples[(forecast->head + forecast->count) % FORECAST_MAX_SAMPLES] = *sample;
+        forecast->count++;
+    }
+    else
+    {
+        // full, overwrite the oldest one
+        forecast->samples[forecast->head] = *sample;
+        forecast->head = (forecast->head + 1) % FORECAST_MAX_SAMPLES;
+        forecast->firstEpoch += FORECAST_SAMPLE_PERIOD_S;
+    }
+
+    return true;
+}
+
+// index 0 is the oldest sample
+bool forecastGet(const ForecastRing *forecast, uint8_t index, ForecastSample *sample, uint32_t *epoch)
+{
+    if(index >= forecast->count)
+    {
+        return false;
+    }
+
+    *sample = forecast->samples[(forecast->head + index) % FORECAST_MAX_SAMPLES];
+    *epoch = forecast->firstEpoch + (uint32_t)index * FORECAST_SAMPLE_PERIOD_S;
+
+    return true;
+}
+
+/* Forecast response is way too large to be deserialized at once (~16 kB for 5 days).
+ * Stream is skipped up to "list" array and then every element is deserialized on its own into the same small document,
+ * filtered down to the few values we keep. Memory used does not depend on number of elements.
+ */
+bool parseForecastJson(Stream &stream, ForecastRing *forecast)
+{
+    JsonDocument filter;
+    JsonDocument doc;
+    ForecastSample sample;
+
+    filter["dt"] = true;
+    filter["main"]["temp"] = true;
+    filter["main"]["humidity"] = true;
+    filter["wind"]["speed"] = true;
+    filter["weather"][0]["icon"] = true;
+
+    forecastClear(forecast);
+
+    CONSOLE("FORECAST JSON DESERIALIZATON: ")
+
+    if(!stream.find("\"list\":["))
+    {
+        CONSOLE_CRLF("ERROR")
+        return false;
+    }
+
+    do
+    {
+        DeserializationError error = deserializeJson(doc, stream, DeserializationOption::Filter(filter));
+
+        if(error || !doc["dt"].is<uint32_t>() || !doc["main"]["temp"].is<float>() || !doc["weather"][0]["icon"].is<const char*>())
+        {
+            CONSOLE_CRLF("ERROR")
+            forecastClear(forecast);
+            return false;
+        }
+
+        sample.temperature_dC = (int16_t)lroundf(doc["main"]["temp"].as<float>() * 10.0f);
+        sample.humidity = doc["main"]["humidity"].as<uint8_t>();
+        sample.windSpeed = (uint8_t)min(lroundf(doc["wind"]["speed"].as<float>()), 255L);
+        sample.weather = (uint8_t)weatherFromOpenweatherIcon(doc["weather"][0]["icon"].as<const char*>());
+
+        if(!forecastPush(forecast, doc["dt"].as<uint32_t>(), &sample))
+        {
+            CONSOLE_CRLF("ERROR")
+            CONSOLE_CRLF("  |-- samples not 3 hours apart")
+            forecastClear(forecast);
+            return false;
+        }
+    }
+    while(stream.findUntil(",", "]")); // elements are separated by ',', array ends with ']'
+
+    CONSOLE_CRLF("OK")
+    CONSOLE("  |-- samples: ")
+    CONSOLE_CRLF(forecast->count)
+
+    return forecast->count != 0;
+}
+
+/* Groups samples by local day (time zone has to be set), samples that are already over are skipped.
+ * Weather of the day is taken from the sample closest to FORECAST_DAY_WEATHER_HOUR.
+ */
+uint8_t forecastDailySummary(const ForecastRing *forecast, time_t now, ForecastDay *days, uint8_t maxDays)
+{
+    ForecastSample sample;
+    uint32_t epoch;
+    struct tm timeInfo;
+    int lastYearDay = -1;
+    int weatherHourDistance = 24;
+    uint8_t count = 0;
+
+    for(uint8_t i = 0; i < forecast->count; i++)
+    {
+        forecastGet(forecast, i, &sample, &epoch);
+
+        if((time_t)epoch + FORECAST_SAMPLE_PERIOD_S <= now)
+        {
+            continue;
+        }
+
+        time_t sampleTime = (time_t)epoch;
+        localtime_r(&sampleTime, &timeInfo);
+
+        if(timeInfo.tm_yday != lastYearDay)
+        {
+            if(count == maxDays)
+            {
+                break;
+            }
+
+            lastYearDay = timeInfo.tm_yday;
+            weatherHourDistance = abs(timeInfo.tm_hour - FORECAST_DAY_WEATHER_HOUR);
+
+            days[count].epoch = sampleTime;
+            days[count].minTemperature_dC = sample.temperature_dC;
+            days[count].maxTemperature_dC = sample.temperature_dC;
+            days[count].weather = (Weather)sample.weather;
+            count++;
+
+            continue;
+        }
+
+        ForecastDay *day = &days[count - 1];
+
+        day->minTemperature_dC = min(day->minTemperature_dC, sample.temperature_dC);
+        day->maxTemperature_dC = max(day->maxTemperature_dC, sample.temperature_dC);
+
+        if(abs(timeInfo.tm_hour - FORECAST_DAY_WEATHER_HOUR) < weatherHourDistance)
+        {
+            weatherHourDistance = abs(timeInfo.tm_hour - FORECAST_DAY_WEATHER_HOUR);
+            day->weather = (Weather)sample.weather;
+        }
+    }
+
+    return count;
+}
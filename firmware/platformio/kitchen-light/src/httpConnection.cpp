@@ -0,0 +1,535 @@
+// core includes
+#include <Arduino.h>
+#include <WiFi.h>
+
+// project includes
+#include "httpConnection.h"
+#include "metrics.h"
+#include "console.h"
+#include "conf.h"
+
+/* Everything here is used only by network task.
+ * Weather and forecast go to the same server, so single connection and single DNS cache entry are enough.
+ */
+WiFiClient httpClient; // kept open between requests when server allows it (HTTP/1.1 keep-alive)
+HttpBodyStream httpBodyStream;
+HttpStats httpStats;
+char connectedHost[HTTP_MAX_HOST_LENGTH + 1] = "";
+uint16_t connectedPort = 0;
+bool keepAlive = false;
+bool responseActive = false;
+uint32_t bodyTimer = 0;
+
+char cachedHost[HTTP_MAX_HOST_LENGTH + 1] = "";
+IPAddress cachedIp;
+uint32_t cachedIpTimer = 0;
+
+// returns length of the line without CRLF, or -1 on timeout or closed connection, too long lines are cut
+int readHttpLine(WiFiClient *client, char *line, size_t lineSize, uint32_t timeoutMs)
+{
+    uint32_t timer = millis();
+    size_t length = 0;
+
+    while(true)
+    {
+        int c = client->read();
+
+        if(c < 0)
+        {
+            if(millis() - timer > timeoutMs || (!client->connected() && client->available() == 0))
+            {
+                return -1;
+            }
+
+            delay(1);
+            continue;
+        }
+
+        if(c == '\n')
+        {
+            line[length] = '\0';
+            return length;
+        }
+
+        if(c != '\r' && length < lineSize - 1)
+        {
+            line[length++] = (char)c;
+        }
+    }
+}
+
+void HttpBodyStream::begin(WiFiClient *client, HttpBodyEncoding encoding, uint32_t contentLength)
+{
+    this->client = client;
+    this->encoding = encoding;
+    remaining = (encoding == HttpBodyEncoding::CONTENT_LENGTH) ? contentLength : 0;
+    chunkStarted = false;
+    lastChunk = false;
+    error = false;
+    setTimeout(HTTP_TIMEOUT_MS);
+}
+
+bool HttpBodyStream::finished()
+{
+    switch(encoding)
+    {
+        case HttpBodyEncoding::CONTENT_LENGTH:
+            return remaining == 0;
+
+        case HttpBodyEncoding::CHUNKED:
+            return lastChunk;
+
+        case HttpBodyEncoding::UNTIL_CLOSE:
+            return !client->connected() && client->available() == 0;
+
+        default:
+            return true;
+    }
+}
+
+// reads out whatever parser did not need, true if connection is ready for the next request
+bool HttpBodyStream::drain()
+{
+    uint32_t timer = millis();
+    uint32_t drained = 0;
+
+    if(encoding == HttpBodyEncoding::UNTIL_CLOSE)
+    {
+        return false;
+    }
+
+    while(!finished())
+    {
+        if(error || drained > HTTP_MAX_DRAIN_SIZE || millis() - timer > HTTP_TIMEOUT_MS)
+        {
+            return false;
+        }
+
+        if(read() >= 0)
+        {
+            drained++;
+            timer = millis();
+        }
+        else if(!lastChunk)
+        {
+            delay(1);
+        }
+    }
+
+    return !error;
+}
+
+// chunk size line (hex), data, CRLF, ..., zero size chunk, optional trailers, empty line
+bool HttpBodyStream::nextChunk()
+{
+    char line[HTTP_MAX_LINE_LENGTH];
+    int length;
+
+    if(lastChunk || error)
+    {
+        return false;
+    }
+
+    if(chunkStarted && readHttpLine(client, line, sizeof(line), HTTP_TIMEOUT_MS) != 0)
+    {
+        error = true;
+        return false;
+    }
+
+    if(readHttpLine(client, line, sizeof(line), HTTP_TIMEOUT_MS) <= 0)
+    {
+        error = true;
+        return false;
+    }
+
+    chunkStarted = true;
+    remaining = strtoul(line, NULL, 16);
+
+    if(remaining == 0)
+    {
+        do
+        {
+            length = readHttpLine(client, line, sizeof(line), HTTP_TIMEOUT_MS);
+        }
+        while(length > 0);
+
+        error = (length < 0);
+        lastChunk = true;
+        return false;
+    }
+
+    return true;
+}
+
+int HttpBodyStream::available()
+{
+    switch(encoding)
+    {
+        case HttpBodyEncoding::CONTENT_LENGTH:
+        case HttpBodyEncoding::CHUNKED:
+            return min((uint32_t)client->available(), remaining);
+
+        case HttpBodyEncoding::UNTIL_CLOSE:
+            return client->available();
+
+        default:
+            return 0;
+    }
+}
+
+int HttpBodyStream::read()
+{
+    int c;
+
+    switch(encoding)
+    {
+        case HttpBodyEncoding::CONTENT_LENGTH:
+        case HttpBodyEncoding::CHUNKED:
+            if(remaining == 0 && (encoding == HttpBodyEncoding::CONTENT_LENGTH || !nextChunk()))
+            {
+                return -1;
+            }
+
+            c = client->read();
+
+            if(c >= 0)
+            {
+                remaining--;
+            }
+
+            return c;
+
+        case HttpBodyEncoding::UNTIL_CLOSE:
+            return client->read();
+
+        default:
+            return -1;
+    }
+}
+
+int HttpBodyStream::peek()
+{
+    switch(encoding)
+    {
+        case HttpBodyEncoding::CONTENT_LENGTH:
+        case HttpBodyEncoding::CHUNKED:
+            if(remaining == 0 && (encoding == HttpBodyEncoding::CONTENT_LENGTH || !nextChunk()))
+            {
+                return -1;
+            }
+
+            return client->peek();
+
+        case HttpBodyEncoding::UNTIL_CLOSE:
+            return client->peek();
+
+        default:
+            return -1;
+    }
+}
+
+size_t HttpBodyStream::write(uint8_t)
+{
+    return 0;
+}
+
+// only "http://host[:port][/path]"
+bool parseHttpUrl(const char *url, char *host, uint16_t *port, const char **path)
+{
+    const char *hostStart, *hostEnd, *portStart;
+
+    if(strncmp(url, "http://", 7) != 0)
+    {
+        return false;
+    }
+
+    hostStart = url + 7;
+    *path = strchr(hostStart, '/');
+    hostEnd = (*path != NULL) ? *path : hostStart + strlen(hostStart);
+    portStart = (const char*)memchr(hostStart, ':', hostEnd - hostStart);
+
+    if(portStart != NULL)
+    {
+        *port = (uint16_t)atoi(portStart + 1);
+        hostEnd = portStart;
+    }
+    else
+    {
+        *port = 80;
+    }
+
+    if(hostEnd == hostStart || hostEnd - hostStart > HTTP_MAX_HOST_LENGTH || *port == 0)
+    {
+        return false;
+    }
+
+    memcpy(host, hostStart, hostEnd - hostStart);
+    host[hostEnd - hostStart] = '\0';
+
+    if(*path == NULL)
+    {
+        *path = "/";
+    }
+
+    return true;
+}
+
+bool resolveHttpHost(const char *host, IPAddress *ip, HttpTiming *timing)
+{
+    uint32_t timer = millis();
+
+    if(cachedHost[0] != '\0' && strcmp(host, cachedHost) == 0 && millis() - cachedIpTimer < HTTP_DNS_CACHE_TTL_MS)
+    {
+        *ip = cachedIp;
+        timing->dnsCached = true;
+        return true;
+    }
+
+    // IP address in URL (e.g. local stand-in server) needs no lookup
+    if(!ip->fromString(host))
+    {
+        httpStats.dnsLookups++;
+
+        if(WiFi.hostByName(host, *ip) != 1)
+        {
+            return false;
+        }
+    }
+
+    timing->dnsMs = millis() - timer;
+
+    strcpy(cachedHost, host);
+    cachedIp = *ip;
+    cachedIpTimer = millis();
+
+    return true;
+}
+
+int httpFailed(int error)
+{
+    httpClient.stop();
+    httpStats.failures++;
+    metricIncrement(Metric::HTTP_FAILURES);
+    responseActive = false;
+
+    return error;
+}
+
+// status line and headers, body is left in the stream
+int sendHttpRequest(const char *host, const char *path, HttpTiming *timing)
+{
+    char line[HTTP_MAX_LINE_LENGTH];
+    uint32_t contentLength = 0;
+    bool contentLengthKnown = false;
+    bool chunked = false;
+    int status = 0;
+    int length;
+
+    int requestLength = snprintf(line, sizeof(line), "GET ");
+
+    // path might be longer than line buffer, send it on its own
+    if(httpClient.print(line) != (size_t)requestLength || httpClient.print(path) != strlen(path))
+    {
+        return HTTP_ERROR_SEND;
+    }
+
+    requestLength = snprintf(line, sizeof(line), " HTTP/1.1\r\nHost: %s\r\nUser-Agent: kitchen-light/" FW_VERSION "\r\nConnection: keep-alive\r\n\r\n", host);
+
+    if(httpClient.print(line) != (size_t)requestLength)
+    {
+        return HTTP_ERROR_SEND;
+    }
+
+    uint32_t timer = millis();
+
+    if(readHttpLine(&httpClient, line, sizeof(line), HTTP_TIMEOUT_MS) < 0)
+    {
+        return HTTP_ERROR_TIMEOUT;
+    }
+
+    timing->firstByteMs = millis() - timer;
+
+    if(sscanf(line, "HTTP/%*d.%*d %d", &status) != 1 || status <= 0)
+    {
+        return HTTP_ERROR_PROTOCOL;
+    }
+
+    keepAlive = (strncmp(line, "HTTP/1.1", 8) == 0);
+
+    while((length = readHttpLine(&httpClient, line, sizeof(line), HTTP_TIMEOUT_MS)) > 0)
+    {
+        if(strncasecmp(line, "Content-Length:", 15) == 0)
+        {
+            contentLength = strtoul(line + 15, NULL, 10);
+            contentLengthKnown = true;
+        }
+        else if(strncasecmp(line, "Transfer-Encoding:", 18) == 0 && strstr(line + 18, "chunked") != NULL)
+        {
+            chunked = true;
+        }
+        else if(strncasecmp(line, "Connection:", 11) == 0 && strstr(line + 11, "close") != NULL)
+        {
+            keepAlive = false;
+        }
+    }
+
+    if(length < 0)
+    {
+        return HTTP_ERROR_TIMEOUT;
+    }
+
+    if(chunked)
+    {
+        httpBodyStream.begin(&httpClient, HttpBodyEncoding::CHUNKED, 0);
+    }
+    else if(contentLengthKnown)
+    {
+        httpBodyStream.begin(&httpClient, HttpBodyEncoding::CONTENT_LENGTH, contentLength);
+    }
+    else
+    {
+        keepAlive = false;
+        httpBodyStream.begin(&httpClient, HttpBodyEncoding::UNTIL_CLOSE, 0);
+    }
+
+    return status;
+}
+
+/* Connection is reused when it is still open to the same server, DNS result is cached for HTTP_DNS_CACHE_TTL_MS.
+ * Server might have closed idle connection meanwhile, in that case request is sent once more over a new one.
+ * Every call needs to be followed by httpEnd(), body is available through httpBody() in between.
+ */
+int httpGet(const char *url)
+{
+    char host[HTTP_MAX_HOST_LENGTH + 1];
+    const char *path;
+    uint16_t port;
+    IPAddress ip;
+    HttpTiming *timing = &httpStats.lastTiming;
+    int result;
+
+    memset(timing, 0, sizeof(HttpTiming));
+    httpStats.requests++;
+    metricIncrement(Metric::HTTP_REQUESTS);
+    responseActive = false;
+
+    if(!parseHttpUrl(url, host, &port, &path))
+    {
+        return httpFailed(HTTP_ERROR_URL);
+    }
+
+    if(httpClient.connected() && (strcmp(host, connectedHost) != 0 || port != connectedPort))
+    {
+        httpClient.stop();
+    }
+
+    while(true)
+    {
+        bool reused = httpClient.connected();
+
+        if(reused)
+        {
+            timing->connectionReused = true;
+            httpStats.connectionsReused++;
+        }
+        else
+        {
+            if(!resolveHttpHost(host, &ip, timing))
+            {
+                return httpFailed(HTTP_ERROR_DNS);
+            }
+
+            uint32_t timer = millis();
+
+            if(!httpClient.connect(ip, port, HTTP_CONNECT_TIMEOUT_MS))
+            {
+                cachedHost[0] = '\0'; // server might have moved
+                return httpFailed(HTTP_ERROR_CONNECT);
+            }
+
+            timing->connectMs = millis() - timer;
+            httpStats.connectionsOpened++;
+            strcpy(connectedHost, host);
+            connectedPort = port;
+        }
+
+        result = sendHttpRequest(host, path, timing);
+
+        if(result < 0 && reused)
+        {
+            httpClient.stop();
+            timing->connectionReused = false;
+            continue;
+        }
+
+        break;
+    }
+
+    if(result < 0)
+    {
+        return httpFailed(result);
+    }
+
+    responseActive = true;
+    bodyTimer = millis();
+
+    return result;
+}
+
+Stream& httpBody()
+{
+    return httpBodyStream;
+}
+
+void httpEnd()
+{
+    HttpTiming *timing = &httpStats.lastTiming;
+
+    if(!responseActive)
+    {
+        return;
+    }
+
+    responseActive = false;
+
+    if(!httpBodyStream.drain() || !keepAlive)
+    {
+        httpClient.stop();
+    }
+
+    timing->bodyMs = millis() - bodyTimer;
+    metricObserve(Metric::HTTP_REQUEST_MS, timing->dnsMs + timing->connectMs + timing->firstByteMs + timing->bodyMs);
+
+    CONSOLE("  |-- connection: ")
+    CONSOLE_CRLF(timing->connectionReused ? "REUSED" : "NEW")
+
+    CONSOLE("  |-- DNS: ")
+
+    if(timing->dnsCached || timing->connectionReused)
+    {
+        CONSOLE_CRLF(timing->connectionReused ? "-" : "CACHED")
+    }
+    else
+    {
+        CONSOLE(timing->dnsMs)
+        CONSOLE_CRLF(" ms")
+    }
+
+    CONSOLE("  |-- connect: ")
+    CONSOLE(timing->connectMs)
+    CONSOLE_CRLF(" ms")
+    CONSOLE("  |-- first byte: ")
+    CONSOLE(timing->firstByteMs)
+    CONSOLE_CRLF(" ms")
+    CONSOLE("  |-- body: ")
+    CONSOLE(timing->bodyMs)
+    CONSOLE_CRLF(" ms")
+    CONSOLE("  |-- lowest free heap: ")
+    CONSOLE(ESP.getMinFreeHeap())
+    CONSOLE_CRLF(" B")
+}
+
+const HttpStats* getHttpStats()
+{
+    return &httpStats;
+}
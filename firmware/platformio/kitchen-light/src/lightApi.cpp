@@ -0,0 +1,274 @@
+// core includes
+#include <Arduino.h>
+
+// project includes
+#include "lightApi.h"
+#include "networkTask.h"
+#include "utilities.h"
+#include "console.h"
+#include "conf.h"
+
+// lib includes
+#include <ArduinoJson.h>
+
+/* Runs in network task, light itself is owned by UI loop.
+ * State is read from light state mailbox, changes go to UI loop as light commands and are applied same way as from encoders.
+ * Live control goes through its own single slot mailbox, so a stream of messages never fills light command queue.
+ */
+
+#define LIVE_MESSAGE_CONTROL 0x01
+#define LIVE_MESSAGE_CONTROL_LENGTH 7
+#define LIVE_MESSAGE_STATE 0x02
+#define LIVE_MESSAGE_STATE_LENGTH 5
+
+uint8_t pushedLiveState[LIVE_MESSAGE_STATE_LENGTH] = {0}; // last state message sent to WebSocket clients, type 0 until the first one
+
+void respondLightState(WebResponse *response, uint16_t status, const LightState *lightState)
+{
+    webRespondFormatted(response, status, "application/json", "{\"brightness\":%u,\"pickerType\":\"%s\",\"hueIndex\":%u,\"temperatureIndex\":%u,\"ledCount\":%u}",
+        lightState->brightness, CPT_String[(uint8_t)lightState->colorPickerType], lightState->colorHueIndex, lightState->colorTemperatureIndex, lightState->numberOfLeds);
+}
+
+void respondApiError(WebResponse *response, uint16_t status, const char *message)
+{
+    webRespondFormatted(response, status, "application/json", "{\"error\":\"%s\"}", message);
+}
+
+// integer field in [min, max], false with error message when present but invalid
+bool parseLightField(JsonDocument &doc, const char *key, int32_t min, int32_t max, int32_t *value, bool *present, const char **error)
+{
+    *present = !doc[key].isNull();
+
+    if(!*present)
+    {
+        return true;
+    }
+
+    if(!doc[key].is<int32_t>() || doc[key].as<int32_t>() < min || doc[key].as<int32_t>() > max)
+    {
+        *error = key;
+        return false;
+    }
+
+    *value = doc[key].as<int32_t>();
+
+    return true;
+}
+
+// validated against the same limits encoders have, on top of current state (so response shows the result)
+bool parseLightCommand(const WebRequest *request, LightCommand *command, const char **error)
+{
+    JsonDocument doc;
+    int32_t value = 0;
+    bool present;
+
+    if(deserializeJson(doc, request->body, request->bodyLength) || !doc.is<JsonObject>())
+    {
+        *error = "invalid JSON";
+        return false;
+    }
+
+    if(!parseLightField(doc, "brightness", 0, 255, &value, &present, error))
+    {
+        return false;
+    }
+
+    if(present)
+    {
+        command->fields |= LIGHT_COMMAND_BRIGHTNESS;
+        command->state.brightness = (uint8_t)value;
+    }
+
+    if(!parseLightField(doc, "hueIndex", 0, PICKER_WIDTH - 1, &value, &present, error))
+    {
+        return false;
+    }
+
+    if(present)
+    {
+        command->fields |= LIGHT_COMMAND_COLOR_HUE_INDEX;
+        command->state.colorHueIndex = (uint16_t)value;
+    }
+
+    if(!parseLightField(doc, "temperatureIndex", 0, PICKER_WIDTH - 1, &value, &present, error))
+    {
+        return false;
+    }
+
+    if(present)
+    {
+        command->fields |= LIGHT_COMMAND_COLOR_TEMPERATURE_INDEX;
+        command->state.colorTemperatureIndex = (uint16_t)value;
+    }
+
+    if(!parseLightField(doc, "ledCount", 1, LED_STRIP_MAX_LED_COUNT, &value, &present, error))
+    {
+        return false;
+    }
+
+    if(present)
+    {
+        command->fields |= LIGHT_COMMAND_NUMBER_OF_LEDS;
+        command->state.numberOfLeds = (uint16_t)value;
+    }
+
+    if(!doc["pickerType"].isNull())
+    {
+        const char *pickerType = doc["pickerType"].is<const char*>() ? doc["pickerType"].as<const char*>() : "";
+
+        if(strcmp(pickerType, CPT_String[(uint8_t)ColorPickerType::COLOR_HUE]) == 0)
+        {
+            command->state.colorPickerType = ColorPickerType::COLOR_HUE;
+        }
+        else if(strcmp(pickerType, CPT_String[(uint8_t)ColorPickerType::COLOR_TEMPERATURE]) == 0)
+        {
+            command->state.colorPickerType = ColorPickerType::COLOR_TEMPERATURE;
+        }
+        else
+        {
+            *error = "pickerType";
+            return false;
+        }
+
+        command->fields |= LIGHT_COMMAND_COLOR_PICKER_TYPE;
+    }
+
+    if(command->fields == 0)
+    {
+        *error = "no known field";
+        return false;
+    }
+
+    return true;
+}
+
+void handleLightApiRequest(WebRequest *request, WebResponse *response)
+{
+    const char *target = request->target;
+    LightCommand command;
+    const char *error = "";
+
+    if(strncmp(target, "/api/", 5) != 0)
+    {
+        webRespond(response, 404, "text/plain", "");
+        return;
+    }
+
+    if(strncmp(target, "/api/live", 9) == 0 && (target[9] == '\0' || target[9] == '?'))
+    {
+        if(!request->webSocketUpgrade)
+        {
+            respondApiError(response, 426, "WebSocket only");
+            return;
+        }
+
+        webAcceptWebSocket(request, response);
+        return;
+    }
+
+    if(strncmp(target, "/api/state", 10) != 0 || (target[10] != '\0' && target[10] != '?'))
+    {
+        respondApiError(response, 404, "unknown resource");
+        return;
+    }
+
+    // UI loop posts state right after start, so this is only a moment after boot
+    if(!peekLightState(&command.state))
+    {
+        respondApiError(response, 503, "not ready");
+        return;
+    }
+
+    if(request->method == WebMethod::GET || request->method == WebMethod::HEAD)
+    {
+        respondLightState(response, 200, &command.state);
+    }
+    else if(request->method == WebMethod::PUT)
+    {
+        command.fields = 0;
+
+        if(!parseLightCommand(request, &command, &error))
+        {
+            respondApiError(response, 400, error);
+        }
+        else if(!postLightCommand(&command))
+        {
+            respondApiError(response, 503, "busy");
+        }
+        else
+        {
+            LOG_INFO("API: LIGHT COMMAND %lu", command.fields)
+
+            respondLightState(response, 200, &command.state);
+        }
+    }
+    else
+    {
+        respondApiError(response, 405, "method not allowed");
+    }
+}
+
+void encodeLiveState(const LightState *lightState, uint8_t *message)
+{
+    message[0] = LIVE_MESSAGE_STATE;
+    message[1] = lightState->brightness;
+    message[2] = lightState->red;
+    message[3] = lightState->green;
+    message[4] = lightState->blue;
+}
+
+// called by web server (network task) for every connection upgraded on /api/live
+void handleLightApiWebSocket(WebSocketEvent event, uint8_t client, const uint8_t *data, uint16_t length)
+{
+    if(event == WebSocketEvent::OPEN)
+    {
+        LightState lightState;
+        uint8_t message[LIVE_MESSAGE_STATE_LENGTH];
+
+        // new client starts from current state, later ones come with broadcast from handleLightApi()
+        if(peekLightState(&lightState))
+        {
+            encodeLiveState(&lightState, message);
+            webSocketSend(client, message, sizeof(message));
+        }
+    }
+    else if(event == WebSocketEvent::MESSAGE)
+    {
+        LiveControl liveControl;
+
+        // anything else is ignored, connection stays open
+        if(length != LIVE_MESSAGE_CONTROL_LENGTH || data[0] != LIVE_MESSAGE_CONTROL)
+        {
+            LOG_WARNING("API: INVALID LIVE MESSAGE FROM #%lu", client)
+            return;
+        }
+
+        liveControl.brightness = data[1];
+        liveControl.red = data[2];
+        liveControl.green = data[3];
+        liveControl.blue = data[4];
+        liveControl.transitionMs = data[5] | (data[6] << 8);
+
+        postLiveControl(&liveControl);
+    }
+}
+
+// network loop, pushes light state to WebSocket clients whenever UI loop published a different one (only what live state message carries)
+void handleLightApi()
+{
+    LightState lightState;
+    uint8_t message[LIVE_MESSAGE_STATE_LENGTH];
+
+    if(!peekLightState(&lightState))
+    {
+        return;
+    }
+
+    encodeLiveState(&lightState, message);
+
+    if(memcmp(message, pushedLiveState, sizeof(message)) != 0)
+    {
+        memcpy(pushedLiveState, message, sizeof(message));
+        webSocketBroadcast(message, sizeof(message));
+    }
+}
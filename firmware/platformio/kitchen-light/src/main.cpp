@@ -2,8 +2,6 @@
 #include <Arduino.h>
 #include <Preferences.h>
 #include <WiFi.h>
-#include <HTTPClient.h>
-#include "esp_sntp.h"
 
 // project includes
 #include "console.h"
@@ -14,27 +12,65 @@
 #include "utilities.h"
 #include "html.h"
 #include "colors.h"
+#include "bootProfiler.h"
+#include "wifiConnection.h"
+#include "weather.h"
+#include "forecast.h"
+#include "connectivity.h"
+#include "networkTask.h"
+#include "timeSync.h"
+#include "httpConnection.h"
+#include "webServer.h"
+#include "setupPage.h"
+#include "zoneTable.h"
+#include "queryString.h"
+#include "lightApi.h"
+#include "metrics.h"
+#include "scheduler.h"
+#include "stallProfiler.h"
+#include "trace.h"
+#include "uiIdle.h"
+#include "stateStore.h"
 
 // lib includes
 #include <RotaryEncoder.h>
 #include <FastLED.h>
-#include <ArduinoJson.h>
-#include <ESP32Ping.h>
+
+// Preferences counting writes into metrics (every put is a flash write), used exactly like Preferences
+class MeteredPreferences : public Preferences
+{
+    public:
+        size_t putUChar(const char *key, uint8_t value)
+        {
+            metricIncrement(Metric::NVS_WRITES);
+            return Preferences::putUChar(key, value);
+        }
+
+        size_t putUInt(const char *key, uint32_t value)
+        {
+            metricIncrement(Metric::NVS_WRITES);
+            return Preferences::putUInt(key, value);
+        }
+
+        size_t putBytes(const char *key, const void *value, size_t length)
+        {
+            metricIncrement(Metric::NVS_WRITES);
+            return Preferences::putBytes(key, value, length);
+        }
+};
 
 // core globals
 ScreenState state = ScreenState::MAIN; 
 ScreenState previousState = ScreenState::NONE;
-bool validWifiSetup = false; // true if connected to wi-fi, internet connection does not matter here
-Preferences preferences;
+MeteredPreferences preferences;
 
-// TODO: all this and other stuff to structs
 // TODO: move shit away from main.cpp, ideally keep only setup() and loop()
 
+/* Light and network state shown by UI loop lives in state store (see stateStore.h), loaded in setup -> loadPreferences().
+ * Consumers subscribe to the fields they care about, see setupStateSubscribers().
+ */
+
 // preferences globals: will be loaded in setup -> loadPreferences();
-ColorPickerType current_CPT, previous_CPT;
-uint16_t currentColorHueIndex, previousColorHueIndex;
-uint16_t currentColorTemperatureIndex, previousColorTemperatureIndex;
-uint8_t currentBrightness, previousBrightness;
 uint16_t rng_id;
 uint32_t rng_pwd;  
 char wifi_ssid[WIFI_SSID_MAX_LENGTH + 1] = "";
@@ -45,8 +81,6 @@ char countryCode[COUNTRY_CODE_MAX_LENGTH + 1] = "";
 char lat[LAT_LON_MAX_LENGTH + 1] = "";
 char lon[LAT_LON_MAX_LENGTH + 1] = "";
 char openWeatherAPI_key[API_KEY_MAX_LENGTH + 1] = "";
-uint16_t numberOfLeds;
-uint16_t previousNumberOfLeds;
 
 // encoder globals
 RotaryEncoder encoder_1 = RotaryEncoder(RE_1_IN1_PIN, RE_1_IN2_PIN, RotaryEncoder::LatchMode::TWO03);
@@ -60,23 +94,56 @@ uint32_t encoder_2_switch_debounce_timer = 0;
 float temperature_C = -273.15;
 uint8_t humidity = 255;
 float windSpeed = -1.0;
-WifiSignal wifiSignal = WifiSignal::DISCONNECTED;
 Weather weather = Weather::NONE;
-bool validWeather = false;
 uint32_t weatherSyncTimer = 0; // value does not matter
 bool weatherValidOnce = false;
-bool forceWeatherUpdate = false;
 
-// time sync globals
+// forecast globals
+ForecastRing forecast; // empty until network task sends first one
+bool forecastChanged = false;
+
+// time globals, see timeSync.h for time quality
 bool validDateTime = false;
 struct tm timeInfo;
-volatile uint32_t dateTimeSyncTimer = 0;
-bool dateTimeValidOnce = false;
 
 // other globals
-bool internetConnection = false;
-WiFiServer server(WIFI_SERVER_PORT); 
+uint32_t unsavedStateFields = 0; // changed since last time they were written into preferences
 CRGB LED_stripArray[LED_STRIP_MAX_LED_COUNT];
+
+// live control globals: color from WebSocket overrides picker color (live color in state store) until knob or JSON API sets color again
+CRGB liveStartColor, liveTargetColor;
+uint8_t liveStartBrightness, liveTargetBrightness;
+bool liveTransitionRunning = false;
+uint32_t liveTransitionTimer = 0;
+uint16_t liveTransitionMs = 0;
+bool liveSavePending = false; // brightness changed by live control, not yet in preferences
+uint32_t liveControlTimer = 0; // last live control message
+
+// UI loop scheduler, see setup() for its tasks
+Scheduler uiScheduler;
+uint8_t ledFrameTask = SCHEDULER_NO_TASK;
+uint8_t mainScreenTask = SCHEDULER_NO_TASK;
+
+/* Network task globals: touched only by network task (and setup() before the task is started).
+ * UI loop gets these only through network messages, see handleNetworkMessages().
+ */
+bool networkValidWifiSetup = false;
+bool networkOfflineMode = false;
+bool networkInternetConnection = false;
+WifiSignal networkWifiSignal = WifiSignal::DISCONNECTED;
+bool networkValidWeather = false;
+uint32_t networkWeatherSyncTimer = 0; // value does not matter
+WeatherUpdate pendingWeatherUpdate;
+bool weatherUpdatePending = false;
+ForecastRing networkForecast;
+bool networkValidForecast = false;
+
+// network task scheduler, see networkSetup() for its tasks
+Scheduler networkScheduler;
+uint8_t weatherTask = SCHEDULER_NO_TASK;
+uint8_t forecastTask = SCHEDULER_NO_TASK;
+uint8_t softApTimeoutTask = SCHEDULER_NO_TASK;
+uint8_t restartTask = SCHEDULER_NO_TASK;
  
 void loadPreferences()
 {
@@ -113,14 +180,12 @@ void loadPreferences()
         preferences.putUInt("n-leds", 0);
     }
 
-    current_CPT = (ColorPickerType)preferences.getUChar("CPT", (uint8_t)ColorPickerType::NONE);  
-    previous_CPT = current_CPT;
-    currentColorHueIndex = preferences.getUInt("color-hue", 0); 
-    previousColorHueIndex = currentColorHueIndex;
-    currentColorTemperatureIndex = preferences.getUInt("color-t", 0); 
-    previousColorTemperatureIndex = currentColorTemperatureIndex;
-    currentBrightness = preferences.getUChar("brightness", DEFAULT_BRIGHTNESS);
-    previousBrightness = currentBrightness;    
+    UiState initialState;
+
+    initialState.colorPickerType = (ColorPickerType)preferences.getUChar("CPT", (uint8_t)ColorPickerType::NONE);  
+    initialState.colorHueIndex = preferences.getUInt("color-hue", 0); 
+    initialState.colorTemperatureIndex = preferences.getUInt("color-t", 0); 
+    initialState.brightness = preferences.getUChar("brightness", DEFAULT_BRIGHTNESS);
 
     preferences.getBytes("wifi_ssid", wifi_ssid, WIFI_SSID_MAX_LENGTH + 1);
     preferences.getBytes("wifi_pwd", wifi_pwd, WIFI_PWD_MAX_LENGTH + 1);
@@ -134,8 +199,16 @@ void loadPreferences()
     rng_id = preferences.getUInt("rng-id", 1234);
     rng_pwd = preferences.getUInt("rng-pwd", 12345678);
 
-    numberOfLeds = preferences.getUInt("n-leds", 0);
-    previousNumberOfLeds = numberOfLeds;
+    initialState.numberOfLeds = preferences.getUInt("n-leds", 0);
+    initialState.liveColorActive = false;
+    initialState.liveColor = CRGB::Black;
+    initialState.validWifiSetup = false; // true if wi-fi is configured and initial connection did not fail, actual connection state is in wifiConnection.h
+    initialState.offlineMode = false;
+    initialState.internetConnection = false;
+    initialState.wifiSignal = WifiSignal::DISCONNECTED;
+    initialState.validWeather = false;
+
+    beginStateStore(&initialState);
 
     sprintf(defaultSoftAP_ssid, "Kitchen light #%d", rng_id);
     sprintf(defaultSoftAP_pwd, "%d", rng_pwd);
@@ -146,13 +219,13 @@ void loadPreferences()
     CONSOLE_CRLF(firstTimeRun ? "Yes" : "No")
 
     CONSOLE("  |-- current color picker type: ") 
-    CONSOLE_CRLF(CPT_String[(uint8_t)current_CPT])
+    CONSOLE_CRLF(CPT_String[(uint8_t)initialState.colorPickerType])
 
     CONSOLE("  |-- current color hue index: ") 
-    CONSOLE_CRLF(currentColorHueIndex)
+    CONSOLE_CRLF(initialState.colorHueIndex)
 
     CONSOLE("  |-- current color temperature index: ") 
-    CONSOLE_CRLF(currentColorTemperatureIndex)
+    CONSOLE_CRLF(initialState.colorTemperatureIndex)
 
     CONSOLE("  |-- wifi ssid: ");
     CONSOLE_CRLF(wifi_ssid)
@@ -185,55 +258,88 @@ void loadPreferences()
     CONSOLE_CRLF(rng_pwd)
 
     CONSOLE("  |-- number of LEDs: ")
-    CONSOLE_CRLF(numberOfLeds)
+    CONSOLE_CRLF(initialState.numberOfLeds)
+}
+
+CRGB pickerColor()
+{
+    const UiState *s = uiState();
+
+    return (s->colorPickerType == ColorPickerType::COLOR_HUE) ? calculateColorHueFromPickerPosition(s->colorHueIndex) : calculateColorTemperatureFromPickerPosition(s->colorTemperatureIndex);
+}
+
+CRGB currentLightColor()
+{
+    return uiState()->liveColorActive ? uiState()->liveColor : pickerColor();
+}
+
+// picker (or anything else) takes over from live control, running transition is dropped where it is
+void stopLiveControl(bool releaseColor)
+{
+    liveTransitionRunning = false;
+
+    if(releaseColor)
+    {
+        setLiveColor(false, CRGB::Black);
+    }
+}
+
+// every LED strip refresh goes through here, so its time ends up in metrics
+void showLedStrip()
+{
+    StallProbe probe(StallSite::LED_SHOW);
+    uint32_t timer = micros();
+
+    FastLED.show();
+    metricObserve(Metric::LED_SHOW_US, micros() - timer);
 }
 
 void update_LED_strip()
 {
-    CRGB color = (current_CPT == ColorPickerType::COLOR_HUE) ? calculateColorHueFromPickerPosition(currentColorHueIndex) : calculateColorTemperatureFromPickerPosition(currentColorTemperatureIndex);
+    CRGB color = currentLightColor();
     
-    for(uint16_t i = 0; i < numberOfLeds; i++)
+    for(uint16_t i = 0; i < uiState()->numberOfLeds; i++)
     {
         LED_stripArray[i] = color;     
     }
 
-    FastLED.show();
+    showLedStrip();
 }
 
+// only in setup_LED_strip(), loop() is not running yet, so display is updated right here instead of by subscriber
 void updateNumberOfLeds(long direction, bool valueLocked, uint8_t multiplier)
 {
-    int32_t tempNumberOfLeds = numberOfLeds + (direction * multiplier);
+    uint16_t previousNumberOfLeds = uiState()->numberOfLeds;
+    int32_t tempNumberOfLeds = previousNumberOfLeds + (direction * multiplier);
 
     if(tempNumberOfLeds < 0)
     {
-        numberOfLeds = 0;
+        setNumberOfLeds(0);
     }
     else if(tempNumberOfLeds > LED_STRIP_MAX_LED_COUNT)
     {
-        numberOfLeds = LED_STRIP_MAX_LED_COUNT;
+        setNumberOfLeds(LED_STRIP_MAX_LED_COUNT);
     }
     else 
     {
-        numberOfLeds = (uint16_t)tempNumberOfLeds;     
+        setNumberOfLeds((uint16_t)tempNumberOfLeds);     
     }
 
-    CONSOLE_CRLF("NUMBER OF LEDS UPDATE")
-    CONSOLE("  |-- previous value: ")
-    CONSOLE_CRLF(previousNumberOfLeds)
-    CONSOLE("  |-- new value: ")
-    CONSOLE_CRLF(numberOfLeds)
+    LOG_INFO("NUMBER OF LEDS UPDATE")
+    LOG_INFO("  |-- previous value: %lu", previousNumberOfLeds)
+    LOG_INFO("  |-- new value: %lu", uiState()->numberOfLeds)
 
-    if(previousNumberOfLeds != numberOfLeds)
+    if(previousNumberOfLeds != uiState()->numberOfLeds)
     {
-        updateDisplayNumberOfLeds(numberOfLeds, valueLocked);
+        updateDisplayNumberOfLeds(uiState()->numberOfLeds, valueLocked);
     }
-
-    previousNumberOfLeds = numberOfLeds;
 }
 
 void setup_LED_strip()
 {
-    if(numberOfLeds == 0)
+    const UiState *s = uiState(); // numberOfLeds follows updateNumberOfLeds()
+
+    if(s->numberOfLeds == 0)
     {
         FastLED.addLeds<LED_STRIP_TYPE, LED_STRIP_PIN, COLOR_ORDER>(LED_stripArray, LED_STRIP_MAX_LED_COUNT).setCorrection(TypicalLEDStrip);
 
@@ -243,10 +349,10 @@ void setup_LED_strip()
         }
 
         FastLED.setBrightness(DEFAULT_BRIGHTNESS);
-        FastLED.show();
+        showLedStrip();
 
         loadDisplayNumberOfLeds();
-        updateDisplayNumberOfLeds(numberOfLeds, false);
+        updateDisplayNumberOfLeds(s->numberOfLeds, false);
 
         while(digitalRead(RE_1_SW_PIN) == HIGH && digitalRead(RE_2_SW_PIN) == HIGH)
         {
@@ -263,18 +369,16 @@ void setup_LED_strip()
                 previous_encoder_1_position = encoder_1_position;
                 encoder_1_direction = (int)(encoder_1.getDirection());
 
-                CONSOLE_CRLF("ROTARY ENCODER 1 CHANGE")
-                CONSOLE("  |-- position: ")
-                CONSOLE_CRLF(encoder_1_position)
-                CONSOLE("  |-- direction: ")
-                CONSOLE_CRLF(encoder_1_direction)
+                LOG_DEBUG("ROTARY ENCODER 1 CHANGE")
+                LOG_DEBUG("  |-- position: %ld", encoder_1_position)
+                LOG_DEBUG("  |-- direction: %ld", encoder_1_direction)
 
                 updateNumberOfLeds(encoder_1_direction, false, 1);
 
                 // in case we decrease value, we first need to pass the numberOfLeds + 1, so we can set last LED from previous numberOfLeds to black
-                FastLED.addLeds<LED_STRIP_TYPE, LED_STRIP_PIN, COLOR_ORDER>(LED_stripArray, encoder_1_direction == -1 ? numberOfLeds + 1 : numberOfLeds).setCorrection(TypicalLEDStrip);
+                FastLED.addLeds<LED_STRIP_TYPE, LED_STRIP_PIN, COLOR_ORDER>(LED_stripArray, encoder_1_direction == -1 ? s->numberOfLeds + 1 : s->numberOfLeds).setCorrection(TypicalLEDStrip);
 
-                for(uint16_t i = 0; i < numberOfLeds; i++)
+                for(uint16_t i = 0; i < s->numberOfLeds; i++)
                 {
                     LED_stripArray[i] = COLOR_RGB888_SELECT_N_LEDS;    
                 }
@@ -282,15 +386,15 @@ void setup_LED_strip()
                 // in case we decrease value, make sure we set the last LED from previous numberOfLeds to black
                 if(encoder_1_direction == -1)
                 {
-                    LED_stripArray[numberOfLeds] = CRGB::Black;    
+                    LED_stripArray[s->numberOfLeds] = CRGB::Black;    
                 }
 
-                FastLED.show();
+                showLedStrip();
 
                 // in case we decrease value, make sure we pass the proper numberOfLeds
                 if(encoder_1_direction == -1)
                 {
-                    FastLED.addLeds<LED_STRIP_TYPE, LED_STRIP_PIN, COLOR_ORDER>(LED_stripArray, numberOfLeds).setCorrection(TypicalLEDStrip);
+                    FastLED.addLeds<LED_STRIP_TYPE, LED_STRIP_PIN, COLOR_ORDER>(LED_stripArray, s->numberOfLeds).setCorrection(TypicalLEDStrip);
                 }
             }
         
@@ -299,18 +403,16 @@ void setup_LED_strip()
                 previous_encoder_2_position = encoder_2_position;
                 encoder_2_direction = (int)(encoder_2.getDirection());
 
-                CONSOLE_CRLF("ROTARY ENCODER 2 CHANGE")
-                CONSOLE("  |-- position: ")
-                CONSOLE_CRLF(encoder_2_position)
-                CONSOLE("  |-- direction: ")
-                CONSOLE_CRLF(encoder_2_direction)
+                LOG_DEBUG("ROTARY ENCODER 2 CHANGE")
+                LOG_DEBUG("  |-- position: %ld", encoder_2_position)
+                LOG_DEBUG("  |-- direction: %ld", encoder_2_direction)
 
                 updateNumberOfLeds(encoder_2_direction, false, 10);
 
                 // in case we decrease value, we first need to pass the size numberOfLeds + 10, so we can set last 10 LEDs from previous numberOfLeds to black
-                FastLED.addLeds<LED_STRIP_TYPE, LED_STRIP_PIN, COLOR_ORDER>(LED_stripArray, encoder_2_direction == -1 ? numberOfLeds + 10 : numberOfLeds).setCorrection(TypicalLEDStrip);
+                FastLED.addLeds<LED_STRIP_TYPE, LED_STRIP_PIN, COLOR_ORDER>(LED_stripArray, encoder_2_direction == -1 ? s->numberOfLeds + 10 : s->numberOfLeds).setCorrection(TypicalLEDStrip);
 
-                for(uint16_t i = 0; i < numberOfLeds; i++)
+                for(uint16_t i = 0; i < s->numberOfLeds; i++)
                 {
                     LED_stripArray[i] = COLOR_RGB888_SELECT_N_LEDS;    
                 }
@@ -320,31 +422,32 @@ void setup_LED_strip()
                 {
                     for(uint8_t i = 0; i < 10; i++)
                     {
-                        LED_stripArray[numberOfLeds + i] = CRGB::Black; 
+                        LED_stripArray[s->numberOfLeds + i] = CRGB::Black; 
                     }    
                 }
 
-                FastLED.show();
+                showLedStrip();
 
                 // in case we decrease value, make sure we pass the proper size
                 if(encoder_2_direction == -1)
                 {
-                    FastLED.addLeds<LED_STRIP_TYPE, LED_STRIP_PIN, COLOR_ORDER>(LED_stripArray, numberOfLeds).setCorrection(TypicalLEDStrip);
+                    FastLED.addLeds<LED_STRIP_TYPE, LED_STRIP_PIN, COLOR_ORDER>(LED_stripArray, s->numberOfLeds).setCorrection(TypicalLEDStrip);
                 }
             }   
         }
 
         clearDisplay();
-        updateDisplayNumberOfLeds(numberOfLeds, true);
+        updateDisplayNumberOfLeds(s->numberOfLeds, true);
         delay(2000);
 
-        preferences.putUInt("n-leds", numberOfLeds); // make change persistent
+        // persistence subscriber makes change persistent, first thing in loop()
     }
 
     CONSOLE("LED strip: ")
-    FastLED.addLeds<LED_STRIP_TYPE, LED_STRIP_PIN, COLOR_ORDER>(LED_stripArray, numberOfLeds).setCorrection(TypicalLEDStrip);
-    FastLED.setBrightness(currentBrightness);
+    FastLED.addLeds<LED_STRIP_TYPE, LED_STRIP_PIN, COLOR_ORDER>(LED_stripArray, s->numberOfLeds).setCorrection(TypicalLEDStrip);
+    FastLED.setBrightness(s->brightness);
     update_LED_strip();
+    bootMarkLedsOn();
 
     CONSOLE_CRLF("OK")
 }
@@ -352,11 +455,19 @@ void setup_LED_strip()
 void checkRotaryEncoderPosition_1()
 {
     encoder_1.tick();
+    wakeUiLoopFromInput();
 }
 
 void checkRotaryEncoderPosition_2()
 {
     encoder_2.tick();
+    wakeUiLoopFromInput();
+}
+
+// switches are read by loop, interrupt only wakes it
+void onEncoderSwitchChange()
+{
+    wakeUiLoopFromInput();
 }
 
 void setupRotaryEncoders()
@@ -365,156 +476,108 @@ void setupRotaryEncoders()
     attachInterrupt(digitalPinToInterrupt(RE_1_IN1_PIN), checkRotaryEncoderPosition_1, CHANGE);
     attachInterrupt(digitalPinToInterrupt(RE_1_IN2_PIN), checkRotaryEncoderPosition_1, CHANGE);
     pinMode(RE_1_SW_PIN, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(RE_1_SW_PIN), onEncoderSwitchChange, CHANGE);
     CONSOLE_CRLF("OK")
 
     CONSOLE("Rotary encoder #2: ")
     attachInterrupt(digitalPinToInterrupt(RE_2_IN1_PIN), checkRotaryEncoderPosition_2, CHANGE);
     attachInterrupt(digitalPinToInterrupt(RE_2_IN2_PIN), checkRotaryEncoderPosition_2, CHANGE);
     pinMode(RE_2_SW_PIN, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(RE_2_SW_PIN), onEncoderSwitchChange, CHANGE);
     CONSOLE_CRLF("OK")
 }
 
 void updateBrightness(int direction)
 {
-    int32_t tempBrightness = currentBrightness + (direction * BRIGHTNESS_STEP);
+    stopLiveControl(false);
+
+    uint8_t previousBrightness = uiState()->brightness;
+    int32_t tempBrightness = previousBrightness + (direction * BRIGHTNESS_STEP);
 
     if(tempBrightness < 0)
     {
-        currentBrightness = 0;
+        setBrightness(0);
     }
     else if(tempBrightness > 255)
     {
-        currentBrightness = 255;
+        setBrightness(255);
     }
     else 
     {
-        currentBrightness = (uint8_t)tempBrightness;     
-    }
-
-    CONSOLE_CRLF("BRIGHTNESS UPDATE")
-    CONSOLE("  |-- previous value: ")
-    CONSOLE_CRLF(previousBrightness)
-    CONSOLE("  |-- new value: ")
-    CONSOLE_CRLF(currentBrightness)
-
-    FastLED.setBrightness(currentBrightness);
-    FastLED.show();
-
-    if(previousBrightness != currentBrightness)
-    {
-        updateDisplayBrightness(currentBrightness);
+        setBrightness((uint8_t)tempBrightness);     
     }
 
-    previousBrightness = currentBrightness;
+    LOG_INFO("BRIGHTNESS UPDATE")
+    LOG_INFO("  |-- previous value: %lu", previousBrightness)
+    LOG_INFO("  |-- new value: %lu", uiState()->brightness)
 }
 
 void updateColorHue(int direction)
 {   
-    int32_t tempColorHueIndex = currentColorHueIndex + (direction * COLOR_HUE_INDEX_STEP);
+    stopLiveControl(true);
+
+    uint16_t previousColorHueIndex = uiState()->colorHueIndex;
+    int32_t tempColorHueIndex = previousColorHueIndex + (direction * COLOR_HUE_INDEX_STEP);
 
     if(tempColorHueIndex < 0)
     {
-        currentColorHueIndex = PICKER_WIDTH - 1;
+        setColorHueIndex(PICKER_WIDTH - 1);
     }
     else if(tempColorHueIndex >= PICKER_WIDTH)
     {
-        currentColorHueIndex = 0;
+        setColorHueIndex(0);
     }
     else 
     {
-        currentColorHueIndex = (uint16_t)tempColorHueIndex;     
+        setColorHueIndex((uint16_t)tempColorHueIndex);     
     }
 
+    uint16_t currentColorHueIndex = uiState()->colorHueIndex;
     CRGB currentColor = calculateColorHueFromPickerPosition(currentColorHueIndex);
     CRGB previousColor = calculateColorHueFromPickerPosition(previousColorHueIndex);
     
 
-    CONSOLE_CRLF("COLOR HUE UPDATE")
-    CONSOLE("  |-- previous picker value: ")
-    CONSOLE_CRLF(previousColorHueIndex)
-    CONSOLE("  |-- previous color value: ")
-    CONSOLE("[R: ")
-    CONSOLE(previousColor.r)
-    CONSOLE("| G: ")
-    CONSOLE(previousColor.g)
-    CONSOLE("| B: ")
-    CONSOLE(previousColor.b)
-    CONSOLE_CRLF("]")
-    CONSOLE("  |-- new picker value: ")
-    CONSOLE_CRLF(currentColorHueIndex)
-    CONSOLE("  |-- new color value: ")
-    CONSOLE("[R: ")
-    CONSOLE(currentColor.r)
-    CONSOLE("| G: ")
-    CONSOLE(currentColor.g)
-    CONSOLE("| B: ")
-    CONSOLE(currentColor.b)
-    CONSOLE_CRLF("]")
-
-    update_LED_strip();
-
-    if(previousColorHueIndex != currentColorHueIndex)
-    {
-        updateDisplayColorHue(currentColorHueIndex, previousColorHueIndex); 
-    }
-     
-    previousColorHueIndex = currentColorHueIndex;
+    LOG_INFO("COLOR HUE UPDATE")
+    LOG_INFO("  |-- previous picker value: %lu", previousColorHueIndex)
+    LOG_INFO("  |-- previous color value: [R: %lu| G: %lu| B: %lu]", previousColor.r, previousColor.g, previousColor.b)
+    LOG_INFO("  |-- new picker value: %lu", currentColorHueIndex)
+    LOG_INFO("  |-- new color value: [R: %lu| G: %lu| B: %lu]", currentColor.r, currentColor.g, currentColor.b)
 }
 
 void updateColorTemperature(int direction)
 {   
-    int32_t tempColorTemperatureIndex = currentColorTemperatureIndex + (direction * COLOR_TEMPERATURE_INDEX_STEP);
+    stopLiveControl(true);
+
+    uint16_t previousColorTemperatureIndex = uiState()->colorTemperatureIndex;
+    int32_t tempColorTemperatureIndex = previousColorTemperatureIndex + (direction * COLOR_TEMPERATURE_INDEX_STEP);
 
     if(tempColorTemperatureIndex < 0)
     {
-        currentColorTemperatureIndex = 0;
+        setColorTemperatureIndex(0);
     }
     else if(tempColorTemperatureIndex >= PICKER_WIDTH)
     {
-        currentColorTemperatureIndex = PICKER_WIDTH - 1;
+        setColorTemperatureIndex(PICKER_WIDTH - 1);
     }
     else 
     {
-        currentColorTemperatureIndex = (uint16_t)tempColorTemperatureIndex;     
+        setColorTemperatureIndex((uint16_t)tempColorTemperatureIndex);     
     }
 
+    uint16_t currentColorTemperatureIndex = uiState()->colorTemperatureIndex;
     CRGB currentColor = calculateColorTemperatureFromPickerPosition(currentColorTemperatureIndex);
     CRGB previousColor = calculateColorTemperatureFromPickerPosition(previousColorTemperatureIndex);
     
-    CONSOLE_CRLF("COLOR TEMPERATURE UPDATE")
-    CONSOLE("  |-- previous picker value: ")
-    CONSOLE_CRLF(previousColorTemperatureIndex)
-    CONSOLE("  |-- previous color value: ")
-    CONSOLE("[R: ")
-    CONSOLE(previousColor.r)
-    CONSOLE("| G: ")
-    CONSOLE(previousColor.g)
-    CONSOLE("| B: ")
-    CONSOLE(previousColor.b)
-    CONSOLE_CRLF("]")
-    CONSOLE("  |-- new picker value: ")
-    CONSOLE_CRLF(currentColorTemperatureIndex)
-    CONSOLE("  |-- new color value: ")
-    CONSOLE("[R: ")
-    CONSOLE(currentColor.r)
-    CONSOLE("| G: ")
-    CONSOLE(currentColor.g)
-    CONSOLE("| B: ")
-    CONSOLE(currentColor.b)
-    CONSOLE_CRLF("]")
-
-    update_LED_strip();
-
-    if(previousColorTemperatureIndex != currentColorTemperatureIndex)
-    {
-        updateDisplayColorTemperature(currentColorTemperatureIndex, previousColorTemperatureIndex); 
-    }
-     
-    previousColorTemperatureIndex = currentColorTemperatureIndex;
+    LOG_INFO("COLOR TEMPERATURE UPDATE")
+    LOG_INFO("  |-- previous picker value: %lu", previousColorTemperatureIndex)
+    LOG_INFO("  |-- previous color value: [R: %lu| G: %lu| B: %lu]", previousColor.r, previousColor.g, previousColor.b)
+    LOG_INFO("  |-- new picker value: %lu", currentColorTemperatureIndex)
+    LOG_INFO("  |-- new color value: [R: %lu| G: %lu| B: %lu]", currentColor.r, currentColor.g, currentColor.b)
 }
 
 void checkRotaryEncoders(uint32_t *rotary_encoder_timer)
 {
+    StallProbe probe(StallSite::ENCODERS);
     int8_t encoder_1_direction, encoder_2_direction;
 
     encoder_1.tick();
@@ -532,11 +595,10 @@ void checkRotaryEncoders(uint32_t *rotary_encoder_timer)
         previous_encoder_1_position = encoder_1_position;
         encoder_1_direction = (int)(encoder_1.getDirection());
 
-        CONSOLE_CRLF("ROTARY ENCODER 1 CHANGE")
-        CONSOLE("  |-- position: ")
-        CONSOLE_CRLF(encoder_1_position)
-        CONSOLE("  |-- direction: ")
-        CONSOLE_CRLF(encoder_1_direction)
+        traceInstant("knob 1 turn", StallLoop::UI);
+        LOG_DEBUG("ROTARY ENCODER 1 CHANGE")
+        LOG_DEBUG("  |-- position: %ld", encoder_1_position)
+        LOG_DEBUG("  |-- direction: %ld", encoder_1_direction)
 
         if(state != ScreenState::BRIGHTNESS)
         {
@@ -554,11 +616,10 @@ void checkRotaryEncoders(uint32_t *rotary_encoder_timer)
         previous_encoder_2_position = encoder_2_position;
         encoder_2_direction = (int)(encoder_2.getDirection());
 
-        CONSOLE_CRLF("ROTARY ENCODER 2 CHANGE")
-        CONSOLE("  |-- position: ")
-        CONSOLE_CRLF(encoder_2_position)
-        CONSOLE("  |-- direction: ")
-        CONSOLE_CRLF(encoder_2_direction)
+        traceInstant("knob 2 turn", StallLoop::UI);
+        LOG_DEBUG("ROTARY ENCODER 2 CHANGE")
+        LOG_DEBUG("  |-- position: %ld", encoder_2_position)
+        LOG_DEBUG("  |-- direction: %ld", encoder_2_direction)
 
         if(state != ScreenState::COLOR)
         {
@@ -566,11 +627,11 @@ void checkRotaryEncoders(uint32_t *rotary_encoder_timer)
         } 
         else
         {
-            if(current_CPT == ColorPickerType::COLOR_TEMPERATURE)
+            if(uiState()->colorPickerType == ColorPickerType::COLOR_TEMPERATURE)
             {
                 updateColorTemperature(encoder_2_direction);
             }
-            else if(current_CPT == ColorPickerType::COLOR_HUE)
+            else if(uiState()->colorPickerType == ColorPickerType::COLOR_HUE)
             {
                 updateColorHue(encoder_2_direction);
             }
@@ -579,6 +640,8 @@ void checkRotaryEncoders(uint32_t *rotary_encoder_timer)
 
     if(encoder_1_switch == LOW && encoder_2_switch == LOW)
     {
+        StallProbe factoryResetProbe(StallSite::FACTORY_RESET);
+
         clearDisplay();
         loadAndExecuteFactoryReset(&preferences); // this function is blocking, either ends up in reset or continue to main state
 
@@ -591,12 +654,17 @@ void checkRotaryEncoders(uint32_t *rotary_encoder_timer)
     {
         if(encoder_1_switch == LOW && millis() - encoder_1_switch_debounce_timer > ENCODER_SWITCH_DEBOUNCE_TIMER_MS)
         {
+            traceInstant("knob 1 press", StallLoop::UI);
             encoder_1_switch_debounce_timer = millis();
             *rotary_encoder_timer = millis();
 
             if(state == ScreenState::BRIGHTNESS)
             {
-                // unused - reserved
+                state = ScreenState::FORECAST;
+            }
+            else if(state == ScreenState::FORECAST)
+            {
+                state = ScreenState::MAIN;
             }
             else if(state == ScreenState::MAIN || state == ScreenState::COLOR)
             {
@@ -606,16 +674,17 @@ void checkRotaryEncoders(uint32_t *rotary_encoder_timer)
 
         if(encoder_2_switch == LOW && millis() - encoder_2_switch_debounce_timer > ENCODER_SWITCH_DEBOUNCE_TIMER_MS)
         {
+            traceInstant("knob 2 press", StallLoop::UI);
             encoder_2_switch_debounce_timer = millis();
             *rotary_encoder_timer = millis();
 
             if(state == ScreenState::COLOR)
             {
-                current_CPT = (current_CPT == ColorPickerType::COLOR_TEMPERATURE) ? ColorPickerType::COLOR_HUE : ColorPickerType::COLOR_TEMPERATURE;  
-                CONSOLE("COLOR PICKER TYPE CHANGE: ")  
-                CONSOLE_CRLF(CPT_String[(uint8_t)current_CPT])  
+                stopLiveControl(true); // picker color takes over
+                setColorPickerType((uiState()->colorPickerType == ColorPickerType::COLOR_TEMPERATURE) ? ColorPickerType::COLOR_HUE : ColorPickerType::COLOR_TEMPERATURE);  
+                LOG_INFO("COLOR PICKER TYPE CHANGE: %s", CPT_String[(uint8_t)uiState()->colorPickerType])
             }  
-            else if(state == ScreenState::MAIN || state == ScreenState::BRIGHTNESS)
+            else if(state == ScreenState::MAIN || state == ScreenState::BRIGHTNESS || state == ScreenState::FORECAST)
             {
                 state = ScreenState::COLOR;
             }   
@@ -623,301 +692,618 @@ void checkRotaryEncoders(uint32_t *rotary_encoder_timer)
     }
 }
 
-void updateColorAndBrightnessPreferences()
+/* Light command from JSON API has the same effect as turning the knobs: LED strip changes right away (state subscribers),
+ * matching setting screen is shown for a while and preferences are saved once back on main screen.
+ */
+void applyLightCommand(const LightCommand *command, uint32_t *rotary_encoder_timer)
 {
-    if(current_CPT != (ColorPickerType)preferences.getUChar("CPT"))
+    LOG_INFO("LIGHT COMMAND")
+
+    if(command->fields & (LIGHT_COMMAND_BRIGHTNESS | LIGHT_COMMAND_COLOR_PICKER_TYPE | LIGHT_COMMAND_COLOR_HUE_INDEX | LIGHT_COMMAND_COLOR_TEMPERATURE_INDEX))
     {
-        preferences.putUChar("CPT", (uint8_t)current_CPT);
+        stopLiveControl(command->fields & (LIGHT_COMMAND_COLOR_PICKER_TYPE | LIGHT_COMMAND_COLOR_HUE_INDEX | LIGHT_COMMAND_COLOR_TEMPERATURE_INDEX));
     }
 
-    if(currentColorHueIndex != preferences.getUInt("color-hue"))
+    if(command->fields & LIGHT_COMMAND_NUMBER_OF_LEDS)
     {
-        preferences.putUInt("color-hue", currentColorHueIndex);
+        setNumberOfLeds(command->state.numberOfLeds);
+
+        LOG_INFO("  |-- number of LEDs: %lu", uiState()->numberOfLeds)
     }
 
-    if(currentColorTemperatureIndex != preferences.getUInt("color-t"))
+    if(command->fields & LIGHT_COMMAND_BRIGHTNESS)
     {
-        preferences.putUInt("color-t", currentColorTemperatureIndex);
+        setBrightness(command->state.brightness);
+        state = ScreenState::BRIGHTNESS;
+
+        LOG_INFO("  |-- brightness: %lu", uiState()->brightness)
     }
 
-    if(currentBrightness != preferences.getUChar("brightness"))
+    if(command->fields & LIGHT_COMMAND_COLOR_PICKER_TYPE)
     {
-        preferences.putUChar("brightness", currentBrightness);
+        setColorPickerType(command->state.colorPickerType);
+        state = ScreenState::COLOR;
+
+        LOG_INFO("  |-- CPT: %s", CPT_String[(uint8_t)uiState()->colorPickerType])
     }
-}
 
-void updateWifiSignal()
-{
-    int8_t rssi = WiFi.RSSI();
-    wl_status_t wifiStatus = WiFi.status();
+    if(command->fields & LIGHT_COMMAND_COLOR_HUE_INDEX)
+    {
+        setColorHueIndex(command->state.colorHueIndex);
+        state = ScreenState::COLOR;
 
-    CONSOLE("UPDATING WIFI SIGNAL: ")
+        LOG_INFO("  |-- color hue index: %lu", uiState()->colorHueIndex)
+    }
 
-    if(wifiStatus == WL_DISCONNECTED || !validWifiSetup)
+    if(command->fields & LIGHT_COMMAND_COLOR_TEMPERATURE_INDEX)
     {
-        wifiSignal = WifiSignal::DISCONNECTED;    
+        setColorTemperatureIndex(command->state.colorTemperatureIndex);
+        state = ScreenState::COLOR;
+
+        LOG_INFO("  |-- color temperature index: %lu", uiState()->colorTemperatureIndex)
     }
-    else if(rssi < -75)
-    {
-        wifiSignal = WifiSignal::BAD;
-    } 
-    else if(rssi >= -75 && rssi < -55) 
+
+    // setting screen is (re)loaded with new values, even when it is already shown, and times out as after encoder change
+    if(state == ScreenState::BRIGHTNESS || state == ScreenState::COLOR)
     {
-        wifiSignal = WifiSignal::GOOD;    
+        previousState = ScreenState::NONE;
+        *rotary_encoder_timer = millis();
     }
-    else if(rssi >= -55 && rssi != 0)
-    {
-        wifiSignal = WifiSignal::EXCELLENT;
-    } 
-
-    CONSOLE_CRLF("OK")
+}
 
-    CONSOLE("  |-- RSSI: ")
-    CONSOLE_CRLF(rssi)
+void handleLightCommands(uint32_t *rotary_encoder_timer)
+{
+    StallProbe probe(StallSite::LIGHT_COMMANDS);
+    LightCommand command;
 
-    CONSOLE("  |-- Wi-Fi signal: ")
-    CONSOLE_CRLF(wifiSignalString[(uint8_t)wifiSignal])
+    while(receiveLightCommand(&command))
+    {
+        applyLightCommand(&command, rotary_encoder_timer);
+    }
 }
 
-bool setupWifi()
+// only fields changed since last time (see onPersistentStateChange()), still compared with flash, initial state counts as changed
+void updateColorAndBrightnessPreferences()
 {
-    int8_t rssi;
-    uint32_t timeout = millis();
+    const UiState *s = uiState();
 
-    if(strcmp(wifi_ssid, INVALID_WIFI_SSID) == 0 && strcmp(wifi_pwd, INVALID_WIFI_PWD) == 0)
+    if(unsavedStateFields == 0)
     {
-        CONSOLE("WIFI STATUS: ")
-        CONSOLE_CRLF("CREDENTIALS NOT SET")
+        return;
+    }
+
+    StallProbe probe(StallSite::NVS_WRITE);
 
-        return false;    
+    if((unsavedStateFields & STATE_FIELD(StateField::COLOR_PICKER_TYPE)) && s->colorPickerType != (ColorPickerType)preferences.getUChar("CPT"))
+    {
+        preferences.putUChar("CPT", (uint8_t)s->colorPickerType);
     }
 
-    WiFi.begin(wifi_ssid, wifi_pwd);
+    if((unsavedStateFields & STATE_FIELD(StateField::COLOR_HUE_INDEX)) && s->colorHueIndex != preferences.getUInt("color-hue"))
+    {
+        preferences.putUInt("color-hue", s->colorHueIndex);
+    }
 
-    while(WiFi.status() != WL_CONNECTED)
+    if((unsavedStateFields & STATE_FIELD(StateField::COLOR_TEMPERATURE_INDEX)) && s->colorTemperatureIndex != preferences.getUInt("color-t"))
     {
-        if(millis() > WIFI_CONNECT_TIMEOUT_MS)
-        {
-            CONSOLE("WIFI STATUS: ")
-            CONSOLE_CRLF("ERROR")
+        preferences.putUInt("color-t", s->colorTemperatureIndex);
+    }
 
-            WiFi.disconnect();
+    if((unsavedStateFields & STATE_FIELD(StateField::BRIGHTNESS)) && s->brightness != preferences.getUChar("brightness"))
+    {
+        preferences.putUChar("brightness", s->brightness);
+    }
 
-            wifiSignal = WifiSignal::DISCONNECTED;
-            return false;
-        }
+    unsavedStateFields = 0;
+}
 
-        CONSOLE("WIFI STATUS: ")
-        CONSOLE_CRLF("CONNECTING")
+/* Live control (WebSocket) may send tens of messages per second, so it skips logging.
+ * Once per LED frame (scheduler task) the latest message is taken (older ones were already replaced in mailbox)
+ * and LED strip is blended from where it is towards it, over transition time of the message (LED strip follows state store).
+ */
+void handleLiveControl()
+{
+    LiveControl liveControl;
 
-        delay(1000);
+    if(receiveLiveControl(&liveControl))
+    {
+        liveStartColor = currentLightColor();
+        liveStartBrightness = uiState()->brightness;
+        liveTargetColor = CRGB(liveControl.red, liveControl.green, liveControl.blue);
+        liveTargetBrightness = liveControl.brightness;
+        liveTransitionMs = liveControl.transitionMs;
+        liveTransitionTimer = millis();
+        liveTransitionRunning = true;
+        setLiveColor(true, liveStartColor);
+        liveSavePending = true;
+        liveControlTimer = millis();
     }
 
-    rssi = WiFi.RSSI();
+    if(liveTransitionRunning)
+    {
+        uint32_t elapsed = millis() - liveTransitionTimer;
+        uint8_t amount = (elapsed >= liveTransitionMs) ? 255 : (uint8_t)((elapsed * 255) / liveTransitionMs);
 
-    CONSOLE("WIFI STATUS: ")
-    CONSOLE_CRLF("OK")
-    CONSOLE("  |-- AP name: ")
-    CONSOLE_CRLF(WiFi.SSID())
-    CONSOLE("  |-- IP: ")
-    CONSOLE_CRLF(WiFi.localIP())
+        setLiveColor(true, blend(liveStartColor, liveTargetColor, amount));
+        setBrightness(liveStartBrightness + (((int16_t)liveTargetBrightness - liveStartBrightness) * amount) / 255);
 
-    validWifiSetup = true;
-    updateWifiSignal();
+        liveTransitionRunning = (amount < 255);
+    }
+    else if(liveSavePending && millis() - liveControlTimer > LIVE_CONTROL_SAVE_DELAY_MS)
+    {
+        // color from live control is not a picker position, so only brightness survives restart
+        liveSavePending = false;
+        updateColorAndBrightnessPreferences();
+    }
 
-    return true;
+    // nothing to blend or save, LED frames stop until the next message (see loop()), so UI loop may idle
+    if(!liveTransitionRunning && !liveSavePending)
+    {
+        cancelTask(&uiScheduler, ledFrameTask);
+    }
 }
 
-bool syncDateTime(bool waitForSync, uint32_t syncTimeoutMs)
+
+void updateWifiSignal()
 {
-    bool success;
+    int8_t rssi = WiFi.RSSI();
 
-    CONSOLE("SYNCING LOCAL TIME: ")
+    if(getWifiConnectionState() != WifiConnectionState::CONNECTED || !networkValidWifiSetup)
+    {
+        networkWifiSignal = WifiSignal::DISCONNECTED;    
+    }
+    else if(rssi < -75)
+    {
+        networkWifiSignal = WifiSignal::BAD;
+    } 
+    else if(rssi >= -75 && rssi < -55) 
+    {
+        networkWifiSignal = WifiSignal::GOOD;    
+    }
+    else if(rssi >= -55 && rssi != 0)
+    {
+        networkWifiSignal = WifiSignal::EXCELLENT;
+    } 
 
-    configTime(0, 0, NTP_server_domain); // sync datetime, not setting gmt or daylight saving offset here
+    LOG_DEBUG("UPDATING WIFI SIGNAL: OK")
+    LOG_DEBUG("  |-- RSSI: %ld", rssi)
+    LOG_DEBUG("  |-- Wi-Fi signal: %s", wifiSignalString[(uint8_t)networkWifiSignal])
+}
 
-    if(!waitForSync)
+// same location is used for current weather and forecast, only endpoint differs
+bool buildWeatherServerUrl(char *serverURL, size_t serverURLSize, const char *cityAndCountryCodeFormat, const char *latLonFormat)
+{
+    if(strcmp(city, INVALID_CITY) != 0 && strcmp(countryCode, INVALID_COUNTRY_CODE))
+    {
+        snprintf(serverURL, serverURLSize, cityAndCountryCodeFormat, city, countryCode, openWeatherAPI_key);
+    }
+    else if(strcmp(lat, INVALID_LAT_LON) != 0 && strcmp(lon, INVALID_LAT_LON) != 0)
+    {
+        snprintf(serverURL, serverURLSize, latLonFormat, lat, lon, openWeatherAPI_key);   
+    }
+    else
     {
-        CONSOLE_CRLF("SKIPPED WAIT FOR SYNC")
         return false;
     }
 
-    success = getLocalTime(&timeInfo, syncTimeoutMs);
-    CONSOLE_CRLF(success ? "OK" : "ERROR")
-
-    return success;
+    return true;
 }
 
-void setTimezone()
+void applyWeatherData(const WeatherData *weatherData)
 {
-    CONSOLE("SETTING TIME ZONE: ")
-
-    setenv("TZ", timeZone, 1);
-    tzset();
-
-    CONSOLE_CRLF("OK")
-    CONSOLE("  |-- timezone: ")
-    CONSOLE_CRLF(timeZone)
+    temperature_C = weatherData->temperature_C;
+    humidity = weatherData->humidity;
+    windSpeed = weatherData->windSpeed;
+    weather = weatherData->weather;
 }
 
-void httpGETRequest(char* serverName, char *payload) {
-    WiFiClient client;
-    HTTPClient http;
+// weather is still fresh enough (cache or last update), no need to ask openweather again
+bool weatherUpdateNeeded()
+{
+    return !networkValidWeather || millis() - networkWeatherSyncTimer > UPDATE_WEATHER_MS;
+}
 
-    http.begin(client, serverName);
-    http.setTimeout(1000);
+/* Needs to be called after beginTimeSync(), system time survives ESP.restart() and tells us cache age.
+ * Next weather update is then scheduled as if cached weather was fetched by this run.
+ */
+void restoreWeatherFromCache()
+{
+    char serverURL[MAX_SERVER_URL_SIZE + 1] = "";
+    WeatherData weatherData;
+    uint32_t ageMs;
 
-    if (http.GET() > 0) 
+    if(!buildWeatherServerUrl(serverURL, sizeof(serverURL), openWeatherServerUrlformatableCityAndCountryCode, openWeatherServerUrlformatableLatLon) || !loadWeatherCache(&weatherData, weatherLocationHash(serverURL), &ageMs))
     {
-        http.getString().toCharArray(payload, MAX_HTTP_PAYLOAD_SIZE + 1);
+        return;
     }
-    
-    http.end();
+
+    applyWeatherData(&weatherData);
+
+    setValidWeather(true);
+    weatherValidOnce = true;
+    weatherSyncTimer = millis() - ageMs;
+
+    networkValidWeather = true;
+    networkWeatherSyncTimer = weatherSyncTimer;
 }
 
-/* Instead of analyzing description parameter of weather, we simply save icon parameter, which
- * exactly describes what kind of picture shall we use for given weather.
- * https://openweathermap.org/weather-conditions
- */
-void updateWeather(const char* openweatherIconString)
+bool updateWeatherTelemetry(WeatherData *weatherData)
 {
-    if(strcmp(openweatherIconString, "01d") == 0)
+    StallProbe probe(StallSite::WEATHER_HTTP);
+    char serverURL[MAX_SERVER_URL_SIZE + 1] = "";  
+    
+    if(!buildWeatherServerUrl(serverURL, sizeof(serverURL), openWeatherServerUrlformatableCityAndCountryCode, openWeatherServerUrlformatableLatLon))
     {
-        weather = Weather::CLEAR_SKY_DAY;
+        CONSOLE_CRLF("WEATHER: LOCATION NOT SET")
+        return false;
     }
-    else if(strcmp(openweatherIconString, "01n") == 0)
+
+    int httpCode = httpGet(serverURL); // JSON is parsed straight from the body stream
+
+    CONSOLE("HTTP GET: ")
+    CONSOLE_CRLF(httpCode)
+
+    // any HTTP response means we reached the internet, negative codes are connection errors
+    if(httpCode > 0)
     {
-        weather = Weather::CLEAR_SKY_NIGHT;
+        reportConnectivitySuccess();
     }
-    else if(strcmp(openweatherIconString, "02d") == 0)
+    else
     {
-        weather = Weather::FEW_CLOUDS_DAY;
+        reportConnectivityFailure();
     }
-    else if(strcmp(openweatherIconString, "02n") == 0)
+
+    if(httpCode != 200)
     {
-        weather = Weather::FEW_CLOUDS_NIGHT;
+        httpEnd();
+        return false;
     }
-    else if(strcmp(openweatherIconString, "03d") == 0)
+
+    bool success = parseWeatherJson(httpBody(), weatherData);
+    httpEnd();
+
+    if(!success)
     {
-        weather = Weather::SCATTERED_CLOUDS_DAY;
+        return false;
     }
-    else if(strcmp(openweatherIconString, "03n") == 0)
+
+    saveWeatherCache(weatherData, weatherLocationHash(serverURL));
+
+    CONSOLE_CRLF("WEATHER UPDATED");
+    CONSOLE("  |-- temperature: ");
+    CONSOLE_CRLF(weatherData->temperature_C);
+    CONSOLE("  |-- humidity: ");
+    CONSOLE_CRLF(weatherData->humidity);
+    CONSOLE("  |-- wind speed: ");
+    CONSOLE_CRLF(weatherData->windSpeed);
+    CONSOLE("  |-- weather string: ");
+    CONSOLE_CRLF(weatherString[(uint8_t)weatherData->weather]);
+
+    return true;
+}
+
+bool updateForecast(ForecastRing *forecast)
+{
+    StallProbe probe(StallSite::FORECAST_HTTP);
+    char serverURL[MAX_SERVER_URL_SIZE + 1] = "";  
+    
+    if(!buildWeatherServerUrl(serverURL, sizeof(serverURL), openWeatherForecastUrlformatableCityAndCountryCode, openWeatherForecastUrlformatableLatLon))
     {
-        weather = Weather::SCATTERED_CLOUDS_NIGHT;
+        CONSOLE_CRLF("FORECAST: LOCATION NOT SET")
+        return false;
     }
-    else if(strcmp(openweatherIconString, "04d") == 0)
+
+    int httpCode = httpGet(serverURL);
+
+    CONSOLE("HTTP GET (FORECAST): ")
+    CONSOLE_CRLF(httpCode)
+
+    if(httpCode > 0)
     {
-        weather = Weather::BROKEN_CLOUDS_DAY;
+        reportConnectivitySuccess();
     }
-    else if(strcmp(openweatherIconString, "04n") == 0)
+    else
     {
-        weather = Weather::BROKEN_CLOUDS_NIGHT;
+        reportConnectivityFailure();
     }
-    else if(strcmp(openweatherIconString, "09d") == 0)
+
+    if(httpCode != 200)
     {
-        weather = Weather::SHOWER_RAIN_DAY;
+        httpEnd();
+        return false;
+    }
+
+    bool success = parseForecastJson(httpBody(), forecast);
+    httpEnd();
+
+    return success;
+}
+
+// submitted setup form, nothing is applied until the whole form is parsed and valid
+struct SetupForm
+{
+    char ssid[WIFI_SSID_MAX_LENGTH + 1];
+    char pwd[WIFI_PWD_MAX_LENGTH + 1];
+    char location[32];
+    char city[CITY_MAX_LENGTH + 1];
+    char countryCode[COUNTRY_CODE_MAX_LENGTH + 1];
+    char lat[LAT_LON_MAX_LENGTH + 1];
+    char lon[LAT_LON_MAX_LENGTH + 1];
+    char timeZone[TIME_ZONE_MAX_LENGTH + 1];
+    char apiKey[API_KEY_MAX_LENGTH + 1];
+};
+
+enum class SetupFormResult {NOT_FORM, INCOMPLETE, TOO_LONG, UNKNOWN_ZONE, OK};
+
+/* One pass over query string of the request (tokenized and decoded in place), every value is checked against its destination.
+ * Unknown parameters are ignored, location specific ones are required only for selected location.
+ */
+SetupFormResult parseSetupForm(char *target, SetupForm *form, WeatherLocationType *weatherLocationType)
+{
+    enum {SSID, PWD, LOCATION, CITY, COUNTRY_CODE, LAT, LON, TIME_ZONE, API_KEY, FIELD_COUNT};
+
+    struct
+    {
+        const char *key;
+        char *destination;
+        uint16_t maxLength;
+    } fields[FIELD_COUNT] = {
+        {"ssid", form->ssid, WIFI_SSID_MAX_LENGTH},
+        {"pwd", form->pwd, WIFI_PWD_MAX_LENGTH},
+        {"location", form->location, sizeof(form->location) - 1},
+        {"city", form->city, CITY_MAX_LENGTH},
+        {"country-code", form->countryCode, COUNTRY_CODE_MAX_LENGTH},
+        {"lat", form->lat, LAT_LON_MAX_LENGTH},
+        {"lon", form->lon, LAT_LON_MAX_LENGTH},
+        {"timezone", form->timeZone, TIME_ZONE_MAX_LENGTH},
+        {"api-key", form->apiKey, API_KEY_MAX_LENGTH}
+    };
+
+    char *cursor = findQueryString(target);
+    QueryParameter parameter;
+    uint16_t found = 0; // bit per field
+    bool anyField = false;
+
+    memset(form, 0, sizeof(SetupForm));
+
+    while(nextQueryParameter(&cursor, &parameter))
+    {
+        for(uint8_t i = 0; i < FIELD_COUNT; i++)
+        {
+            if(strcmp(parameter.key, fields[i].key) != 0)
+            {
+                continue;
+            }
+
+            anyField = true;
+
+            if(!copyQueryValue(&parameter, fields[i].destination, fields[i].maxLength))
+            {
+                CONSOLE("PARSING PARAMETER: OVERFLOW ")
+                CONSOLE_CRLF(fields[i].key)
+                return SetupFormResult::TOO_LONG;
+            }
+
+            found |= (1 << i);
+            break;
+        }
     }
-    else if(strcmp(openweatherIconString, "09n") == 0)
+
+    if(!anyField)
     {
-        weather = Weather::SHOWER_RAIN_NIGHT;
+        return SetupFormResult::NOT_FORM;
     }
-    else if(strcmp(openweatherIconString, "10d") == 0)
+
+    if(strcmp(form->location, "cityAndCountryCode") == 0)
     {
-        weather = Weather::RAIN_DAY;
+        *weatherLocationType = WeatherLocationType::CITY_AND_COUNTRY_CODE;
     }
-    else if(strcmp(openweatherIconString, "10n") == 0)
+    else if(strcmp(form->location, "latLon") == 0)
     {
-        weather = Weather::RAIN_NIGHT;
+        *weatherLocationType = WeatherLocationType::LAT_LON;
     }
-    else if(strcmp(openweatherIconString, "11d") == 0)
+    else
     {
-        weather = Weather::THUNDERSTORM_DAY;
+        return SetupFormResult::INCOMPLETE;
     }
-    else if(strcmp(openweatherIconString, "11n") == 0)
+
+    uint16_t required = (1 << SSID) | (1 << PWD) | (1 << LOCATION) | (1 << TIME_ZONE) | (1 << API_KEY);
+    required |= (*weatherLocationType == WeatherLocationType::CITY_AND_COUNTRY_CODE) ? ((1 << CITY) | (1 << COUNTRY_CODE)) : ((1 << LAT) | (1 << LON));
+
+    if((found & required) != required)
     {
-        weather = Weather::THUNDERSTORM_NIGHT;
+        return SetupFormResult::INCOMPLETE;
     }
-    else if(strcmp(openweatherIconString, "13d") == 0)
+
+    // only what setup page offers, anything else would end up as wrong local time or unknown weather location
+    if(!zoneTableContains(form->timeZone, (*weatherLocationType == WeatherLocationType::CITY_AND_COUNTRY_CODE) ? form->countryCode : NULL))
     {
-        weather = Weather::SNOW_DAY;
+        CONSOLE("PARSING PARAMETER: UNKNOWN TIME ZONE OR COUNTRY CODE ")
+        CONSOLE_CRLF(form->timeZone)
+        return SetupFormResult::UNKNOWN_ZONE;
     }
-    else if(strcmp(openweatherIconString, "13n") == 0)
+
+    return SetupFormResult::OK;
+}
+
+void applySetupForm(const SetupForm *form, WeatherLocationType weatherLocationType)
+{
+    strcpy(wifi_ssid, form->ssid);
+    strcpy(wifi_pwd, form->pwd);
+
+    if(weatherLocationType == WeatherLocationType::CITY_AND_COUNTRY_CODE)
     {
-        weather = Weather::SNOW_DAY;
+        strcpy(city, form->city);
+        strcpy(countryCode, form->countryCode);
     }
-    else if(strcmp(openweatherIconString, "50d") == 0)
+    else if(weatherLocationType == WeatherLocationType::LAT_LON)
     {
-        weather = Weather::MIST_DAY;
+        strcpy(lat, form->lat);
+        strcpy(lon, form->lon);
     }
-    else if(strcmp(openweatherIconString, "50n") == 0)
+
+    strcpy(timeZone, form->timeZone);
+    strcpy(openWeatherAPI_key, form->apiKey);
+}
+
+void saveParsedParamsToPreferences(WeatherLocationType weatherLocationType)
+{
+    preferences.putBytes("wifi_ssid", wifi_ssid, WIFI_SSID_MAX_LENGTH + 1);
+    preferences.putBytes("wifi_pwd", wifi_pwd, WIFI_PWD_MAX_LENGTH + 1);
+    
+    if(weatherLocationType == WeatherLocationType::CITY_AND_COUNTRY_CODE)
     {
-        weather = Weather::MIST_NIGHT;
+        preferences.putBytes("city", city, CITY_MAX_LENGTH + 1);
+        preferences.putBytes("country-c", countryCode, COUNTRY_CODE_MAX_LENGTH + 1);
     }
-    else
+    else if(weatherLocationType == WeatherLocationType::LAT_LON)
     {
-        weather = Weather::NONE;
+        preferences.putBytes("lat", lat, LAT_LON_MAX_LENGTH + 1);
+        preferences.putBytes("lon", lon, LAT_LON_MAX_LENGTH + 1);    
     }
+    
+    preferences.putBytes("time-zone", timeZone, TIME_ZONE_MAX_LENGTH + 1);
+    preferences.putBytes("api-key", openWeatherAPI_key, API_KEY_MAX_LENGTH + 1);
 }
 
-bool updateWeatherTelemetry()
+// confirmation page, values are rendered (HTML escaped) straight from globals while sending, they do not change until restart
+void respondSetupComplete(WebResponse *response, WeatherLocationType weatherLocationType)
 {
-    char payloadJSON[MAX_HTTP_PAYLOAD_SIZE + 1] = "";
-    char serverURL[MAX_SERVER_URL_SIZE + 1] = "";  
-    JsonDocument doc;
-    
-    if(strcmp(city, INVALID_CITY) != 0 && strcmp(countryCode, INVALID_COUNTRY_CODE))
+    const WebTemplateValue values[] = {
+        {"ssid", wifi_ssid},
+        {"password", wifi_pwd},
+        {"city", city},
+        {"countryCode", countryCode},
+        {"lat", lat},
+        {"lon", lon},
+        {"timeZone", timeZone},
+        {"apiKey", openWeatherAPI_key}};
+
+    if(weatherLocationType == WeatherLocationType::CITY_AND_COUNTRY_CODE)
     {
-        sprintf(serverURL, openWeatherServerUrlformatableCityAndCountryCode, city, countryCode, openWeatherAPI_key);
+        webRespondTemplate(response, 200, "text/html", htmlWebPageCompleteCityAndCountryCode, values, sizeof(values) / sizeof(values[0]));
     }
-    else if(strcmp(lat, INVALID_LAT_LON) != 0 && strcmp(lon, INVALID_LAT_LON) != 0)
+    else
     {
-        sprintf(serverURL, openWeatherServerUrlformatableLatLon, lat, lon, openWeatherAPI_key);   
+        webRespondTemplate(response, 200, "text/html", htmlWebPageCompleteLatAndLon, values, sizeof(values) / sizeof(values[0]));
     }
+}
 
-    httpGETRequest(serverURL, payloadJSON);
+// runs in network task, called by web server for every request (several clients can be served at once)
+void handleSetupRequest(WebRequest *request, WebResponse *response)
+{
+    SetupForm form;
+    WeatherLocationType weatherLocationType = WeatherLocationType::NONE;
 
-    CONSOLE("JSON RESPONSE: ");
-    CONSOLE_CRLF(payloadJSON)
+    if(request->method != WebMethod::GET && request->method != WebMethod::HEAD)
+    {
+        webRespond(response, 405, "text/plain", "");
+        return;
+    }
 
-    CONSOLE("JSON DESERIALIZATON: ")
-    DeserializationError error = deserializeJson(doc, payloadJSON);
+    // favicon is checked first, parsing below tokenizes target
+    if(strstr(request->target, "favicon") != NULL)
+    {
+        webRespond(response, 404, "text/plain", "");
+        return;
+    }
 
-    if(error)
+    // countries and time zones for setup page dropdowns, cached by browser
+    if(strcmp(request->target, "/zones.bin") == 0)
     {
-        CONSOLE_CRLF("ERROR");
-        return false;
+        webRespondStatic(request, response, "application/octet-stream", "gzip", zoneTableGzip, zoneTableGzipLength, zoneTableEtag);
+        return;
     }
-    
-    CONSOLE_CRLF("OK");
 
-    temperature_C = doc["main"]["temp"].as<float>();
-    humidity = doc["main"]["humidity"].as<uint8_t>();
-    windSpeed = doc["wind"]["speed"].as<float>();
-    const char *openweatherIconString = doc["weather"][0]["icon"].as<const char*>();
+    switch(parseSetupForm(request->target, &form, &weatherLocationType))
+    {
+        // if request contains whole form, save it, send back ack html page and reboot
+        case SetupFormResult::OK:
+            CONSOLE_CRLF("SERVER: SETUP PACKET RECEIVED")
+            CONSOLE_CRLF("  |-- received all required parameters")
 
-    updateWeather(openweatherIconString);
+            CONSOLE_CRLF("SERVER: SAVING NEW PARAMETERS TO PREFERENCES")
 
-    CONSOLE_CRLF("WEATHER UPDATED");
-    CONSOLE("  |-- temperature: ");
-    CONSOLE_CRLF(temperature_C);
-    CONSOLE("  |-- humidity: ");
-    CONSOLE_CRLF(humidity);
-    CONSOLE("  |-- wind speed: ");
-    CONSOLE_CRLF(windSpeed);
-    CONSOLE("  |-- openweather icon string: ");
-    CONSOLE_CRLF(openweatherIconString);
-    CONSOLE("  |-- weather string: ");
-    CONSOLE_CRLF(weatherString[(uint8_t)weather]);
+            applySetupForm(&form, weatherLocationType);
+            saveParsedParamsToPreferences(weatherLocationType);
 
-    weatherValidOnce = true;
+            respondSetupComplete(response, weatherLocationType);
 
-    return true;
+            // restart is done by network scheduler, once response had time to get out
+            scheduleTask(&networkScheduler, restartTask, SETUP_RESTART_DELAY_MS, millis());
+            break;
+
+        case SetupFormResult::TOO_LONG:
+            webRespond(response, 400, "text/plain", "Parameter too long");
+            break;
+
+        case SetupFormResult::UNKNOWN_ZONE:
+            webRespond(response, 400, "text/plain", "Unknown time zone or country code");
+            break;
+
+        // for anything else, send HTML form (basically index.html), gzipped at build time
+        default:
+            webRespondStatic(request, response, "text/html", "gzip", setupPageGzip, setupPageGzipLength, setupPageEtag);
+            break;
+    }
+}
+
+/* Metrics are in both modes. Text is rendered into a buffer of this response, on heap only until it is sent,
+ * so DRAM is not held between scrapes and an overlapping scrape gets its own text. 503 when there is no room for it.
+ */
+void respondMetrics(WebResponse *response)
+{
+    char *metricsText = webAllocateBody(response, METRICS_TEXT_MAX_SIZE);
+
+    if(metricsText == NULL)
+    {
+        webRespond(response, 503, "text/plain", "");
+        return;
+    }
+
+    renderMetrics(metricsText, METRICS_TEXT_MAX_SIZE);
+    webRespond(response, 200, "text/plain; version=0.0.4", metricsText);
+}
+
+// same as metrics, open in chrome://tracing or ui.perfetto.dev, the largest body of all, so a second download at once gets 503
+void respondTrace(WebResponse *response)
+{
+    char *traceText = webAllocateBody(response, TRACE_TEXT_MAX_SIZE);
+
+    if(traceText == NULL)
+    {
+        webRespond(response, 503, "text/plain", "");
+        return;
+    }
+
+    renderTrace(traceText, TRACE_TEXT_MAX_SIZE);
+    webRespond(response, 200, "application/json", traceText);
+}
+
+// setup form on soft AP, JSON API once Wi-Fi is configured
+void handleWebRequest(WebRequest *request, WebResponse *response)
+{
+    if(strncmp(request->target, "/metrics", 8) == 0 && (request->target[8] == '\0' || request->target[8] == '?'))
+    {
+        respondMetrics(response);
+    }
+    else if(strncmp(request->target, "/trace", 6) == 0 && (request->target[6] == '\0' || request->target[6] == '?'))
+    {
+        respondTrace(response);
+    }
+    else if(networkValidWifiSetup)
+    {
+        handleLightApiRequest(request, response);
+    }
+    else
+    {
+        handleSetupRequest(request, response);
+    }
 }
 
 void enableAP()
 {
     WiFi.softAP(defaultSoftAP_ssid, defaultSoftAP_pwd);
-    server.begin();
 
     CONSOLE_CRLF("SOFT AP INFO")
     CONSOLE("  |-- IP: ")
@@ -928,234 +1314,534 @@ void enableAP()
     CONSOLE_CRLF(defaultSoftAP_pwd)
 }
 
-void decodeUrlCodes(char *valBuffFiltered, char *valBuff)
+void onWifiConnectionStateChange(WifiConnectionState connectionState)
 {
-    uint16_t index = 0;
-    char buff[3] = "";
-    char c;
-    char *ptr;
-    
-    for(uint16_t i = 0; i < strlen(valBuff); i++)
+    if(connectionState == WifiConnectionState::CONNECTED)
     {
-        c = valBuff[i];
+        CONSOLE("  |-- AP name: ")
+        CONSOLE_CRLF(WiFi.SSID())
+        CONSOLE("  |-- IP: ")
+        CONSOLE_CRLF(WiFi.localIP())
 
-        if(c == '%')
-        {
-            buff[0] = valBuff[i + 1];      
-            buff[1] = valBuff[i + 2]; 
+        startTimeSync(); // runs in background
+        resetConnectivityMonitor();
 
-            valBuffFiltered[index++] = (char)strtol(buff, &ptr, 16); 
-            i += 2; // skip the bytes we just stored
-            continue;
+        if(weatherUpdateNeeded())
+        {
+            scheduleTask(&networkScheduler, weatherTask, 0, millis());
         }
-        else
+
+        if(!networkValidForecast)
         {
-            valBuffFiltered[index++] = c; 
-        }                       
-    }           
+            scheduleTask(&networkScheduler, forecastTask, 0, millis());
+        }
+    }
+    else if(connectionState == WifiConnectionState::NO_CREDENTIALS || connectionState == WifiConnectionState::FAILED)
+    {
+        networkValidWifiSetup = false;
+        enableAP();
+    }
+    else
+    {
+        resetConnectivityMonitor();
+    }
+
+    networkInternetConnection = getInternetConnection();
+    updateWifiSignal();
 }
 
-void parseParameter(char *buff, const char *param, char *saveToParam, uint16_t paramMaxLength)
+// network task side, post whatever changed since last time (anything not posted because of full queue is posted next time)
+void publishNetworkState()
 {
-    char valBuff[MAX_PREFERENCE_LENGTH + 1] = "";
-    char c = '\0';
-    uint16_t index = 0;
-    char *ptr = strstr(buff, param);
+    static bool postedValidWifiSetup = true; // UI starts with true, see setup()
+    static bool postedOfflineMode = false;
+    static bool postedInternetConnection = false;
+    static WifiSignal postedWifiSignal = WifiSignal::DISCONNECTED;
+    NetworkMessage message;
 
-    while(index < MAX_PREFERENCE_LENGTH)
+    if(postedValidWifiSetup != networkValidWifiSetup)
     {
-        char c = ptr[index + (strlen(param))]; // '=' already in param 
+        message.type = NetworkMessageType::WIFI_SETUP;
+        message.validWifiSetup = networkValidWifiSetup;
 
-        // param value is usually terminated with &, but if it is last param value in header, it is simply terminated with ' '
-        if(c == '&' || c == ' ' )
+        if(postNetworkMessage(&message))
         {
-            char valBuffFiltered[MAX_PREFERENCE_LENGTH + 1] = "";
-            decodeUrlCodes(valBuffFiltered, valBuff); // for example '/' is encoded into %2F, put it back to '/'
-            strcpy(saveToParam, valBuffFiltered);
-            break;
+            postedValidWifiSetup = networkValidWifiSetup;
+        }
+    }
+
+    if(postedOfflineMode != networkOfflineMode)
+    {
+        message.type = NetworkMessageType::OFFLINE_MODE;
+        message.offlineMode = networkOfflineMode;
+
+        if(postNetworkMessage(&message))
+        {
+            postedOfflineMode = networkOfflineMode;
         }
-       
-        valBuff[index++] = c;
+    }
 
-        if(index > paramMaxLength)  
+    if(postedInternetConnection != networkInternetConnection)
+    {
+        message.type = NetworkMessageType::INTERNET_CONNECTION;
+        message.internetConnection = networkInternetConnection;
+
+        if(postNetworkMessage(&message))
         {
-            CONSOLE_CRLF("PARSING PARAMETER: OVERFLOW")
-            break;
-        }     
+            postedInternetConnection = networkInternetConnection;
+        }
+    }
+
+    if(postedWifiSignal != networkWifiSignal)
+    {
+        message.type = NetworkMessageType::WIFI_SIGNAL;
+        message.wifiSignal = networkWifiSignal;
+
+        if(postNetworkMessage(&message))
+        {
+            postedWifiSignal = networkWifiSignal;
+        }
+    }
+
+    if(weatherUpdatePending)
+    {
+        message.type = NetworkMessageType::WEATHER;
+        message.weatherUpdate = pendingWeatherUpdate;
+
+        if(postNetworkMessage(&message))
+        {
+            weatherUpdatePending = false;
+        }
     }
 }
 
-void parseNewParams(char *buff, WeatherLocationType weatherLocationType)
+// network scheduler task, Wi-Fi signal strength for display
+void checkWifiSignal()
 {
-    // including '=' to param search, so we do not mistake for example "city=" for "city" in "cityAndCountryCode"
+    if(networkValidWifiSetup)
+    {
+        updateWifiSignal();
+    }
+}
 
-    parseParameter(buff, "ssid=", wifi_ssid, WIFI_SSID_MAX_LENGTH);
-    parseParameter(buff, "pwd=", wifi_pwd, WIFI_PWD_MAX_LENGTH);
+// network scheduler task, every UPDATE_WEATHER_MS or right away when needed (connected, internet restored)
+void updateWeather()
+{
+    if(!networkValidWifiSetup)
+    {
+        return;
+    }
 
-    if(weatherLocationType == WeatherLocationType::CITY_AND_COUNTRY_CODE)
+    if(getWifiConnectionState() == WifiConnectionState::CONNECTED)
     {
-        parseParameter(buff, "city=", city, CITY_MAX_LENGTH);
-        parseParameter(buff, "country-code=", countryCode, COUNTRY_CODE_MAX_LENGTH);
+        networkValidWeather = updateWeatherTelemetry(&pendingWeatherUpdate.weatherData);
+
+        if(networkValidWeather)
+        {
+            networkWeatherSyncTimer = millis();
+        }
     }
-    else if(weatherLocationType == WeatherLocationType::LAT_LON)
+    else
     {
-        parseParameter(buff, "lat=", lat, LAT_LON_MAX_LENGTH);
-        parseParameter(buff, "lon=", lon, LAT_LON_MAX_LENGTH);   
+        networkValidWeather = false;
     }
 
-    parseParameter(buff, "timezone=", timeZone, TIME_ZONE_MAX_LENGTH); 
-    parseParameter(buff, "api-key=", openWeatherAPI_key, API_KEY_MAX_LENGTH); // last parameter in form terminates in space in HTTP header
+    pendingWeatherUpdate.valid = networkValidWeather;
+    pendingWeatherUpdate.syncTimer = networkWeatherSyncTimer;
+    weatherUpdatePending = true;
 }
 
-void saveParsedParamsToPreferences(char *buff, WeatherLocationType weatherLocationType)
+// network scheduler task, failed update is not posted so UI keeps the last good one (and skips samples that are over)
+void updateForecastTask()
 {
-    preferences.putBytes("wifi_ssid", wifi_ssid, WIFI_SSID_MAX_LENGTH + 1);
-    preferences.putBytes("wifi_pwd", wifi_pwd, WIFI_PWD_MAX_LENGTH + 1);
-    
-    if(weatherLocationType == WeatherLocationType::CITY_AND_COUNTRY_CODE)
+    if(!networkValidWifiSetup)
     {
-        preferences.putBytes("city", city, CITY_MAX_LENGTH + 1);
-        preferences.putBytes("country-c", countryCode, COUNTRY_CODE_MAX_LENGTH + 1);
+        return;
     }
-    else if(weatherLocationType == WeatherLocationType::LAT_LON)
+
+    // overdue until connected, tried again shortly instead of waiting whole period
+    if(getWifiConnectionState() != WifiConnectionState::CONNECTED)
     {
-        preferences.putBytes("lat", lat, LAT_LON_MAX_LENGTH + 1);
-        preferences.putBytes("lon", lon, LAT_LON_MAX_LENGTH + 1);    
+        scheduleTask(&networkScheduler, forecastTask, WIFI_CONNECTION_CHECK_TIMER_MS, millis());
+        return;
+    }
+
+    if(updateForecast(&networkForecast))
+    {
+        networkValidForecast = true;
+        postForecast(&networkForecast);
     }
-    
-    preferences.putBytes("time-zone", timeZone, TIME_ZONE_MAX_LENGTH + 1);
-    preferences.putBytes("api-key", openWeatherAPI_key, API_KEY_MAX_LENGTH + 1);
 }
 
-void handleServerClients()
+// network scheduler task, nobody configured device over soft AP in time, so it goes offline for good (until restart)
+void softApTimeout()
 {
-    WiFiClient client = server.available();   // Listen for incoming clients
-    char buff[MAX_HTTP_PAYLOAD_SIZE] = "";
-    uint16_t index = 0;
-    uint32_t timeout = 0;
-    WeatherLocationType weatherLocationType = WeatherLocationType::NONE;
-    
-    if(client)
+    // Wi-Fi setup may still turn out invalid later (soft AP is enabled then), so keep watching
+    if(networkValidWifiSetup)
     {
-        CONSOLE_CRLF("SERVER: NEW CLIENT") 
-        CONSOLE_CRLF("PACKET:") 
-        CONSOLE_CRLF("- - - - - - - - -")
+        scheduleTask(&networkScheduler, softApTimeoutTask, WIFI_CONNECTION_CHECK_TIMER_MS, millis());
+        return;
+    }
+
+    networkOfflineMode = true;
+
+    WiFi.disconnect();
+    WiFi.mode(WIFI_OFF);
+}
 
-        timeout = millis();
+// network scheduler task, armed only once new setup is saved
+void restartAfterSetup()
+{
+    CONSOLE_CRLF("ESP32: RESTART")  
+    ESP.restart();   
+}
+
+// runs in network task, after setup() started it
+void networkSetup()
+{
+    uint32_t now = millis();
+    uint32_t weatherAgeMs = networkValidWeather ? now - networkWeatherSyncTimer : 0; // restored from cache or start counting now
+
+    // before Wi-Fi, its callbacks reschedule these
+    beginScheduler(&networkScheduler, "network");
+    addSchedulerTask(&networkScheduler, "wifi signal", checkWifiSignal, WIFI_CONNECTION_CHECK_TIMER_MS, 0, now);
+    weatherTask = addSchedulerTask(&networkScheduler, "weather", updateWeather, UPDATE_WEATHER_MS, (weatherAgeMs < UPDATE_WEATHER_MS) ? UPDATE_WEATHER_MS - weatherAgeMs : 0, now);
+    forecastTask = addSchedulerTask(&networkScheduler, "forecast", updateForecastTask, UPDATE_FORECAST_MS, UPDATE_FORECAST_MS, now); // first one is forced once connected
+    softApTimeoutTask = addSchedulerTask(&networkScheduler, "soft AP timeout", softApTimeout, 0, SOFT_AP_TIMEOUT_MS, now);
+    restartTask = addSchedulerTask(&networkScheduler, "restart", restartAfterSetup, 0, 0, now);
+    cancelTask(&networkScheduler, restartTask);
+
+    networkValidWifiSetup = true; // until proven otherwise by onWifiConnectionStateChange()
+    beginWifiConnection(wifi_ssid, wifi_pwd, onWifiConnectionStateChange);
+    beginConnectivityMonitor(); // needs network stack, which is started by beginWifiConnection()
+    beginWebServer(handleWebRequest, handleLightApiWebSocket); // listens on both station and soft AP interface
+}
 
-        while(client.connected())
+/* Runs in network task, so it may take its time (HTTP request, soft AP clients, ...) without UI loop noticing.
+ * Everything periodic (weather, forecast, timeouts, ...) is a scheduler task, see networkSetup().
+ * Everything UI needs to know is passed by publishNetworkState().
+ * Returns how long network task may sleep, web server is polled, so that is short while any connection is open.
+ */
+uint32_t networkLoop()
+{
+    uint32_t idleMs = NETWORK_TASK_IDLE_PERIOD_MS;
+
+    stallLoopBegin(StallLoop::NETWORK);
+
+    // handle wi-fi connection events, (re)connecting happens in background
+    {
+        StallProbe probe(StallSite::WIFI);
+        handleWifiConnection();
+    }
+
+    if(!networkOfflineMode)
+    {
+        // setup form or JSON API, see handleWebRequest()
+        {
+            StallProbe probe(StallSite::WEB_SERVER);
+            handleWebServer();
+            handleLightApi();
+        }
+
+        // check internet connectivity - passive, from weather and NTP results, probes only when needed and never blocks
+        if(networkValidWifiSetup && getWifiConnectionState() == WifiConnectionState::CONNECTED)
         {
-            if(millis() - timeout > SERVER_CLIENT_TIMEOUT_MS)
             {
-                CONSOLE_CRLF("- - - - - - - - -")
-                CONSOLE_CRLF("SERVER: CLIENT TIMEOUT") 
-                break;
+                StallProbe probe(StallSite::CONNECTIVITY);
+                handleConnectivityMonitor();
             }
 
-            while(client.available() > 0)
+            // if internet connection was restored, update weather (and missing forecast) asap
+            if(!networkInternetConnection && getInternetConnection() && weatherUpdateNeeded())
             {
-                char c = client.read();
-                CONSOLE(c)   
-                buff[index++] = c; 
+                scheduleTask(&networkScheduler, weatherTask, 0, millis());
             }
 
-            // look for end of header of any request
-            if(strstr(buff, "\r\n\r\n") != NULL)
+            if(!networkInternetConnection && getInternetConnection() && !networkValidForecast)
             {
-                CONSOLE_CRLF("- - - - - - - - -")
-                CONSOLE_CRLF("SERVER: HTTP REQUEST RECEIVED")
-
-                // if request contains form data in URL, parse it, save it, send back ack html page and reboot
-                if(  
-                    strstr(buff, "ssid=") != NULL &&
-                    strstr(buff, "pwd=") != NULL &&
-                    strstr(buff, "location=") != NULL &&
-                    strstr(buff, "timezone=") != NULL &&
-                    strstr(buff, "api-key=") != NULL
-                )
-                {
-                    CONSOLE_CRLF("SERVER: SETUP PACKET RECEIVED")
-                    CONSOLE_CRLF("  |-- received all required parameters")
+                scheduleTask(&networkScheduler, forecastTask, 0, millis());
+            }
 
-                    CONSOLE_CRLF("SERVER: SAVING NEW PARAMETERS TO PREFERENCES")
+            networkInternetConnection = getInternetConnection();
+        }
 
-                    if(strstr(buff, "location=cityAndCountryCode") != NULL)
-                    {
-                        weatherLocationType = WeatherLocationType::CITY_AND_COUNTRY_CODE;
-                    }
-                    else if(strstr(buff, "location=latLon") != NULL)
-                    {
-                        weatherLocationType = WeatherLocationType::LAT_LON;
-                    }
+        idleMs = runScheduler(&networkScheduler, millis());
+    }
 
-                    parseNewParams(buff, weatherLocationType);   
-                    saveParsedParamsToPreferences(buff, weatherLocationType);
+    publishNetworkState();
 
-                    if(weatherLocationType == WeatherLocationType::CITY_AND_COUNTRY_CODE)
-                    {
-                        sprintf(buff, htmlWebPageCompleteFormatterCityAndCountryCode, wifi_ssid, wifi_pwd, city, countryCode, timeZone, openWeatherAPI_key);
-                    }
-                    else if(weatherLocationType == WeatherLocationType::LAT_LON)
-                    {
-                        sprintf(buff, htmlWebPageCompleteFormatterLatAndLon, wifi_ssid, wifi_pwd, lat, lon, timeZone, openWeatherAPI_key);
-                    }
-                    
-                    client.print(buff);  
-                    client.flush();
-                    delay(1000); // sometimes flush was not enaugh
+    stallLoopEnd(StallLoop::NETWORK);
 
-                    client.stop(); 
+    return webServerIdle() ? constrain(idleMs, NETWORK_TASK_PERIOD_MS, NETWORK_TASK_IDLE_PERIOD_MS) : NETWORK_TASK_PERIOD_MS;
+}
 
-                    CONSOLE_CRLF("ESP32: RESTART")  
-                    ESP.restart();   
-                }
-                // for any request except favicon request, send HTML form (basically index.html)
-                else if(strstr(buff, "favicon") == NULL)
-                {
-                    client.print(htmlWebPageForm); 
-                }
-                else
+// UI loop side, apply results from network task
+void handleNetworkMessages()
+{
+    StallProbe probe(StallSite::NETWORK_MESSAGES);
+    NetworkMessage message;
+
+    while(receiveNetworkMessage(&message))
+    {
+        switch(message.type)
+        {
+            case NetworkMessageType::WEATHER:
+                setValidWeather(message.weatherUpdate.valid);
+
+                if(message.weatherUpdate.valid)
                 {
-                    // if favicon request, do nothing       
+                    applyWeatherData(&message.weatherUpdate.weatherData);
+                    weatherSyncTimer = message.weatherUpdate.syncTimer;
+                    weatherValidOnce = true;
+                    markStateChanged(StateField::WEATHER); // weather data itself is not in state store
                 }
+                break;
 
+            case NetworkMessageType::WIFI_SIGNAL:
+                setWifiSignal(message.wifiSignal);
                 break;
-            }
-        }  
+
+            case NetworkMessageType::INTERNET_CONNECTION:
+                setInternetConnection(message.internetConnection);
+                break;
+
+            case NetworkMessageType::WIFI_SETUP:
+                setValidWifiSetup(message.validWifiSetup);
+                break;
+
+            case NetworkMessageType::OFFLINE_MODE:
+                setOfflineMode(message.offlineMode);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if(receiveForecast(&forecast))
+    {
+        forecastChanged = true;
     }
 }
-/* To make sure date and time is always synced, reset it to some invalid value (basically any year <2015).
- * Alternatively we could enable user to use datetime even in offline mode, but to set it manually with knobs.
- * However for now I have decided to make datetime work only in online mode.
- */
-void resetDatetime()
+
+void showForecast()
+{
+    ForecastDay days[FORECAST_MAX_DAYS];
+
+    loadDisplayForecast(days, forecastDailySummary(&forecast, time(NULL), days, FORECAST_MAX_DAYS));
+}
+
+// UI scheduler task, once a second update local datetime and main screen (if anything needs update), network state changes come right away (subscriber)
+void refreshMainScreen()
 {
-    struct timeval tv;
-    tv.tv_sec = 0;
-    settimeofday(&tv, NULL);
+    if(state != ScreenState::MAIN)
+    {
+        return;
+    }
+
+    StallProbe probe(StallSite::MAIN_SCREEN);
+    const UiState *s = uiState();
+    uint32_t timer = micros();
+
+    validDateTime = getLocalDateTime(&timeInfo);
+
+    updateMainScreen(
+            s->internetConnection,
+            s->offlineMode, 
+            s->validWifiSetup, 
+            (s->validWeather && weatherValidOnce) ? s->validWeather : ((millis() - weatherSyncTimer < WEATHER_SYNC_TIMEOUT_MS && s->validWifiSetup && weatherValidOnce) ? true : false), // keep displaying weather up to WEATHER_SYNC_TIMEOUT_MS even if not updated
+            validDateTime, // also when NTP is not reachable, for as long as time quality allows
+            false, 
+            timeInfo.tm_hour, 
+            timeInfo.tm_min, 
+            timeInfo.tm_mday, 
+            timeInfo.tm_mon, 
+            timeInfo.tm_year + YEAR_OFFSET, 
+            temperature_C, 
+            humidity, 
+            windSpeed, 
+            weather, 
+            s->wifiSignal); 
+
+    metricObserve(Metric::DISPLAY_UPDATE_US, micros() - timer);
 }
 
-void callbackSyncDateTime(struct timeval *tv)
+// picker of current type, with arrow at current position, on cleared display
+void loadDisplayColorPicker()
 {
-    dateTimeSyncTimer = millis();
-    dateTimeValidOnce = true;
-    CONSOLE_CRLF("NTP SYNC: OK")
+    const UiState *s = uiState();
+
+    if(s->colorPickerType == ColorPickerType::COLOR_TEMPERATURE)
+    {
+        loadDisplayColorTemperature(s->colorTemperatureIndex, s->colorTemperatureIndex);
+    }
+    else if(s->colorPickerType == ColorPickerType::COLOR_HUE)
+    {
+        loadDisplayColorHue(s->colorHueIndex, s->colorHueIndex);
+    }
 }
 
-bool checkInternetConnection()
+// LED pipeline, strip follows light state (picker or live color, brightness, number of LEDs)
+void onLightStateChange(const UiState *s, const UiState *previous, uint32_t changedFields)
 {
-    bool ret = Ping.ping(pingIp, 1); // if error, timeout is 1s, but should not be an issue
+    // LEDs past the new end are turned off while they are still part of the strip
+    if((changedFields & STATE_FIELD(StateField::NUMBER_OF_LEDS)) && s->numberOfLeds != previous->numberOfLeds)
+    {
+        for(uint16_t i = s->numberOfLeds; i < previous->numberOfLeds; i++)
+        {
+            LED_stripArray[i] = CRGB::Black;
+        }
+
+        showLedStrip();
+        FastLED.addLeds<LED_STRIP_TYPE, LED_STRIP_PIN, COLOR_ORDER>(LED_stripArray, s->numberOfLeds).setCorrection(TypicalLEDStrip);
+    }
 
-    CONSOLE("INTERNET CONNECTION: ")
-    CONSOLE_CRLF(ret ? "OK" : "ERROR")
+    FastLED.setBrightness(s->brightness);
+    update_LED_strip();
+}
+
+/* Setting screens, only the part that changed is redrawn (arrow, bar).
+ * Screen that is not drawn yet (or is about to be reloaded, see applyLightCommand()) is drawn whole with current state by loop().
+ */
+void onSettingStateChange(const UiState *s, const UiState *previous, uint32_t changedFields)
+{
+    if(state != previousState)
+    {
+        return;
+    }
 
-    // if internet connection was restored, update weather asap
-    if(!internetConnection && ret)
+    if(state == ScreenState::BRIGHTNESS && (changedFields & STATE_FIELD(StateField::BRIGHTNESS)))
     {
-        forceWeatherUpdate = true;
+        updateDisplayBrightness(s->brightness);
     }
+    else if(state == ScreenState::COLOR)
+    {
+        if((changedFields & STATE_FIELD(StateField::COLOR_PICKER_TYPE)) && s->colorPickerType != previous->colorPickerType)
+        {
+            StallProbe probe(StallSite::SCREEN_REDRAW);
+            uint32_t timer = micros();
 
-    return ret;
+            LOG_INFO("CPT CHANGE: %s", CPT_String[(uint8_t)s->colorPickerType])
+
+            clearDisplay();
+            loadDisplayColorPicker();
+
+            metricObserve(Metric::DISPLAY_UPDATE_US, micros() - timer);
+        }
+        else if(s->colorPickerType == ColorPickerType::COLOR_HUE && (changedFields & STATE_FIELD(StateField::COLOR_HUE_INDEX)))
+        {
+            updateDisplayColorHue(s->colorHueIndex, previous->colorHueIndex);
+        }
+        else if(s->colorPickerType == ColorPickerType::COLOR_TEMPERATURE && (changedFields & STATE_FIELD(StateField::COLOR_TEMPERATURE_INDEX)))
+        {
+            updateDisplayColorTemperature(s->colorTemperatureIndex, previous->colorTemperatureIndex);
+        }
+    }
+}
+
+// number of LEDs is saved right away, color and brightness once back on main screen (or after live control), see updateColorAndBrightnessPreferences()
+void onPersistentStateChange(const UiState *s, const UiState *previous, uint32_t changedFields)
+{
+    if((changedFields & STATE_FIELD(StateField::NUMBER_OF_LEDS)) && s->numberOfLeds != preferences.getUInt("n-leds"))
+    {
+        StallProbe probe(StallSite::NVS_WRITE);
+
+        preferences.putUInt("n-leds", s->numberOfLeds);
+    }
+
+    unsavedStateFields |= changedFields & ~STATE_FIELD(StateField::NUMBER_OF_LEDS);
+}
+
+// for JSON API and live control in network task
+void onApiStateChange(const UiState *s, const UiState *previous, uint32_t changedFields)
+{
+    LightState lightState;
+    CRGB color = currentLightColor();
+
+    memset(&lightState, 0, sizeof(LightState));
+    lightState.brightness = s->brightness;
+    lightState.red = color.r;
+    lightState.green = color.g;
+    lightState.blue = color.b;
+    lightState.colorPickerType = s->colorPickerType;
+    lightState.colorHueIndex = s->colorHueIndex;
+    lightState.colorTemperatureIndex = s->colorTemperatureIndex;
+    lightState.numberOfLeds = s->numberOfLeds;
+
+    postLightState(&lightState);
+}
+
+// main screen status (icons, weather) is redrawn as soon as network task reports a change, not with the next clock tick
+void onNetworkStateChange(const UiState *s, const UiState *previous, uint32_t changedFields)
+{
+    if(state == ScreenState::MAIN && previousState == ScreenState::MAIN)
+    {
+        refreshMainScreen();
+    }
+}
+
+void setupStateSubscribers()
+{
+    subscribeState(STATE_FIELDS_LIGHT, onLightStateChange);
+    subscribeState(STATE_FIELDS_SETTINGS, onSettingStateChange);
+    subscribeState(STATE_FIELDS_SETTINGS | STATE_FIELD(StateField::NUMBER_OF_LEDS), onPersistentStateChange);
+    subscribeState(STATE_FIELDS_LIGHT, onApiStateChange);
+    subscribeState(STATE_FIELDS_NETWORK, onNetworkStateChange);
+}
+
+// commands typed into serial console, one per line, read without waiting
+void handleSerialCommands()
+{
+    static char command[SERIAL_COMMAND_MAX_LENGTH + 1];
+    static uint8_t commandLength = 0;
+
+    while(CONSOLE_SERIAL.available() > 0)
+    {
+        char c = (char)CONSOLE_SERIAL.read();
+
+        if(c != '\r' && c != '\n')
+        {
+            // too long line is cut, ends up as unknown command
+            if(commandLength < SERIAL_COMMAND_MAX_LENGTH)
+            {
+                command[commandLength++] = c;
+            }
+
+            continue;
+        }
+
+        if(commandLength == 0) // CR LF, empty line
+        {
+            continue;
+        }
+
+        command[commandLength] = '\0';
+        commandLength = 0;
+
+        if(strcmp(command, "metrics") == 0)
+        {
+            printMetrics(&CONSOLE_SERIAL);
+        }
+        else if(strcmp(command, "trace") == 0)
+        {
+            printTrace(&CONSOLE_SERIAL);
+        }
+        else if(strcmp(command, "stalls") == 0)
+        {
+            printStallProfile();
+        }
+        else if(strcmp(command, "tasks") == 0)
+        {
+            // network one is read while network task runs, statistics may be off by a run
+            printSchedulerStats(&uiScheduler, millis());
+            printSchedulerStats(&networkScheduler, millis());
+        }
+        else
+        {
+            CONSOLE("UNKNOWN COMMAND: ")
+            CONSOLE_CRLF(command)
+        }
+    }
 }
 
 void setup()
@@ -1163,47 +1849,58 @@ void setup()
     // first thing, make sure to blackout display
     displayLedControl(false, true);
 
-    /* Default sync period is 1h (i think)
-     * This can be changed by including "esp_sntp.h" and calling sntp_set_sync_interval(ms)
-     */
-    sntp_set_time_sync_notification_cb(callbackSyncDateTime);
-
     CONSOLE_SERIAL.begin(CONSOLE_BAUDRATE);
     CONSOLE_CRLF("~~~ SETUP ~~~")
     CONSOLE("FW version: ")
     CONSOLE_CRLF(FW_VERSION)
+    beginDeferredLog();
 
+    /* Boot order matters here. LED strip goes first so the saved color is on as soon as possible,
+     * Wi-Fi association runs in background while display is being initialized.
+     * LED strip setup needs the display only when number of LEDs is not configured yet.
+     */
+    bootPhaseBegin("preferences");
     loadPreferences();
-    resetDatetime();
+    beginTimeSync(timeZone);
+    restoreWeatherFromCache();
+    bootPhaseEnd();
+
+    bootPhaseBegin("network task");
+    setValidWifiSetup(true); // until network task says otherwise
+    beginNetworkTask(networkSetup, networkLoop);
+    bootPhaseEnd();
+
+    bootPhaseBegin("rotary encoders");
     setupRotaryEncoders();
-    setupDisplay();
-    setup_LED_strip();
+    bootPhaseEnd();
 
-    if(setupWifi())
+    if(uiState()->numberOfLeds != 0)
     {
-        validDateTime = syncDateTime(true, SETUP_SYNC_DATE_TIME_TIMEOUT_MS);
-        setTimezone(); // we can set timezone if we failed to NTP sync
-        validWeather = updateWeatherTelemetry();
-
-        // in setup we can retry telemetry request
-        if(!validWeather)
-        {
-            delay(2000);
-            validWeather = updateWeatherTelemetry();   
-        }
+        bootPhaseBegin("LED strip");
+        setup_LED_strip();
+        bootPhaseEnd();
+    }
 
-        if(validWeather)
-        {
-            weatherSyncTimer = millis();
-        }
+    bootPhaseBegin("display");
+    setupDisplay();
+    bootPhaseEnd();
 
-        internetConnection = checkInternetConnection(); // sometimes returns false, if called too soon after setupWifi(), make less sense after weather and datetime sync, but at least will be true always if internet is available
-    }
-    else
+    if(uiState()->numberOfLeds == 0)
     {
-        enableAP();
+        bootPhaseBegin("LED strip (number of LEDs setup)");
+        setup_LED_strip();
+        bootPhaseEnd();
     }
 
+    printBootProfile();
+
+    beginScheduler(&uiScheduler, "UI");
+    ledFrameTask = addSchedulerTask(&uiScheduler, "LED frame", handleLiveControl, LED_FRAME_PERIOD_MS, 0, millis());
+    mainScreenTask = addSchedulerTask(&uiScheduler, "main screen", refreshMainScreen, MAIN_SCREEN_TIMER_MS, MAIN_SCREEN_TIMER_MS, millis());
+
+    beginUiIdle();
+    setupStateSubscribers();
+
     state = ScreenState::MAIN;
     
     CONSOLE_CRLF("~~~ LOOP ~~~")
@@ -1211,51 +1908,76 @@ void setup()
 
 void loop() 
 {
-    static uint32_t mainScreenTimer = 0; // force screen refresh immediately after enetering loop
-    static uint32_t wifiConnectionCheckTimer = 0; // force wifi check immediately after enetering loop
-    static uint32_t internetConnectionCheckTimer = 0; // force internet check immediately after enetering loop
-    static uint32_t wifiConnectionCheckTimeoutSuccess = 0; // value does not matter
-    static uint32_t weatherTimer = millis(); // start counting timer to weather sync after entering loop
     static uint32_t rotary_encoder_timer = 0; // value does not matter
-    static uint32_t softApTimeout = millis(); // start counting timer to soft AP timeout after entering loop
-    static bool offlineMode = false;
+    uint32_t loopTimer = micros();
+    uint32_t inputTimestampUs;
+    bool inputTaken;
+    uint32_t displayTimer;
+    bool displayUpdated = false; // anything drawn below, encoder feedback above and main screen refresh (own metric) are not included
+
+    stallLoopBegin(StallLoop::UI);
+
+    // results from network task, never waits
+    handleNetworkMessages();
+    handleLightCommands(&rotary_encoder_timer);
+
+    // LED frames run only while live control has something to do
+    if(liveControlPending() && !taskArmed(&uiScheduler, ledFrameTask))
+    {
+        scheduleTask(&uiScheduler, ledFrameTask, 0, millis());
+    }
+
+    // LED frame (live control), main screen refresh
+    runScheduler(&uiScheduler, millis());
 
-    // handle inputs
+    // handle inputs, anything that came since last time is handled (and drawn) in this iteration
+    inputTaken = takeInputTimestamp(&inputTimestampUs);
     checkRotaryEncoders(&rotary_encoder_timer);
 
+    // everything changed so far (network messages, light commands, live control, inputs) goes to its subscribers at once
+    dispatchStateChanges();
+
     // auto state change to main after period of time
     if((state == ScreenState::BRIGHTNESS || state == ScreenState::COLOR) && millis() - rotary_encoder_timer > ANY_SETTING_SCREEN_TIMER_MS)
     {
         state = ScreenState::MAIN;
     }
 
+    if(state == ScreenState::FORECAST && millis() - rotary_encoder_timer > FORECAST_SCREEN_TIMER_MS)
+    {
+        state = ScreenState::MAIN;
+    }
+
+    displayTimer = micros();
+
     // handle state change
     if(state != previousState)
     {
+        StallProbe probe(StallSite::SCREEN_REDRAW);
+
         previousState = state;
+        displayUpdated = true;
 
         CONSOLE("SCREENSTATE CHANGE: ");
         CONSOLE_CRLF(stateString[(uint8_t)state])
 
         if(state == ScreenState::MAIN)
         {
+            const UiState *s = uiState();
+
             // in case there has been any changes to preferences
             updateColorAndBrightnessPreferences();
 
-            mainScreenTimer = millis();
-            validDateTime = getLocalTime(&timeInfo, LOOP_SYNC_DATE_TIME_TIMEOUT_MS);
+            scheduleTask(&uiScheduler, mainScreenTask, MAIN_SCREEN_TIMER_MS, millis()); // just drawn whole
+            validDateTime = getLocalDateTime(&timeInfo);
 
-            /* TODO: not sure if "sntp_set_time_sync_notification_cb()" is called only on success or even on fail, needs verification
-             *
-             * Idea is to override validDateTime from getLocalTime() return after long period of time.
-             */
             clearDisplay();
             updateMainScreen(
-                internetConnection,
-                offlineMode, 
-                validWifiSetup, 
-                (validWeather && weatherValidOnce) ? validWeather : ((millis() - weatherSyncTimer < WEATHER_SYNC_TIMEOUT_MS && validWifiSetup && weatherValidOnce) ? true : false), // keep displaying weather up to WEATHER_SYNC_TIMEOUT_MS even if not updated
-                (validDateTime && dateTimeValidOnce) ? validDateTime : ((millis() - dateTimeSyncTimer < DATE_TIME_SYNC_TIMEOUT_MS && validWifiSetup && dateTimeValidOnce) ? true : false), // keep displaying date and time up to DATE_TIME_SYNC_TIMEOUT_MS even if not synced with NTP
+                s->internetConnection,
+                s->offlineMode, 
+                s->validWifiSetup, 
+                (s->validWeather && weatherValidOnce) ? s->validWeather : ((millis() - weatherSyncTimer < WEATHER_SYNC_TIMEOUT_MS && s->validWifiSetup && weatherValidOnce) ? true : false), // keep displaying weather up to WEATHER_SYNC_TIMEOUT_MS even if not updated
+                validDateTime, // also when NTP is not reachable, for as long as time quality allows
                 true, 
                 timeInfo.tm_hour, 
                 timeInfo.tm_min, 
@@ -1266,141 +1988,60 @@ void loop()
                 humidity, 
                 windSpeed, 
                 weather, 
-                wifiSignal);  
+                s->wifiSignal);  
         }
         else if(state == ScreenState::BRIGHTNESS)
         {
             clearDisplay();
-            loadDisplayBrightness(currentBrightness);  
+            loadDisplayBrightness(uiState()->brightness);  
         }
         else if(state == ScreenState::COLOR)
         {
             CONSOLE("  |-- CPT: ")
-            CONSOLE_CRLF(CPT_String[(uint8_t)current_CPT]);
+            CONSOLE_CRLF(CPT_String[(uint8_t)uiState()->colorPickerType]);
 
             clearDisplay();
+            loadDisplayColorPicker();
+        }
+        else if(state == ScreenState::FORECAST)
+        {
+            forecastChanged = false;
 
-            if(current_CPT == ColorPickerType::COLOR_TEMPERATURE)
-            {
-                loadDisplayColorTemperature(currentColorTemperatureIndex, previousColorTemperatureIndex);
-            }
-            else if(current_CPT == ColorPickerType::COLOR_HUE)
-            {
-                loadDisplayColorHue(currentColorHueIndex, previousColorHueIndex);  
-            }
+            clearDisplay();
+            showForecast();
         }
     }
 
-    // handle CPT change (state remains ScreenState::COLOR)
-    if(current_CPT != previous_CPT && state == ScreenState::COLOR) 
+    // new forecast arrived while it is on display
+    if(forecastChanged && state == ScreenState::FORECAST)
     {
-        previous_CPT = current_CPT;
+        StallProbe probe(StallSite::SCREEN_REDRAW);
 
-        CONSOLE("CPT CHANGE: ");
-        CONSOLE_CRLF(CPT_String[(uint8_t)current_CPT])
+        forecastChanged = false;
+        displayUpdated = true;
 
-        clearDisplay(); 
-
-        if(current_CPT == ColorPickerType::COLOR_TEMPERATURE)
-        {
-            loadDisplayColorTemperature(currentColorTemperatureIndex, previousColorTemperatureIndex);
-            updateColorTemperature(0); // force color change without direction from encoder
-        }
-        else if(current_CPT == ColorPickerType::COLOR_HUE)
-        {
-            loadDisplayColorHue(currentColorHueIndex, previousColorHueIndex);
-            updateColorHue(0); // force color change without direction from encoder  
-        }                
+        clearDisplay();
+        showForecast();
     }
 
-    if(!offlineMode)
+    if(displayUpdated)
     {
-        // allow clients to connect to soft AP and configure device
-        if(!validWifiSetup)
-        {
-            handleServerClients();
-    
-            if(millis() - softApTimeout > SOFT_AP_TIMEOUT_MS)
-            {
-                offlineMode = true;
-
-                WiFi.disconnect();
-                WiFi.mode(WIFI_OFF);
-            }
-        }
-        else if(validWifiSetup)
-        {
-            // check wifi connection
-            if(millis() - wifiConnectionCheckTimer > WIFI_CONNECTION_CHECK_TIMER_MS)
-            {
-                wifiConnectionCheckTimer = millis();
-
-                updateWifiSignal();
-            }
+        metricObserve(Metric::DISPLAY_UPDATE_US, micros() - displayTimer);
+    }
 
-            // check internet connectivity - this costs us roughly 16MB/month when interval is 5s
-            if(millis() - internetConnectionCheckTimer > INTERNET_CONNECTION_CHECK_TIMER_MS)
-            {
-                internetConnectionCheckTimer = millis();   
-                internetConnection = checkInternetConnection();
-            }
-            
-            if(state == ScreenState::MAIN)
-            {
-                // once a second update local datetime and main screen (if anything needs update)
-                if(millis() - mainScreenTimer > MAIN_SCREEN_TIMER_MS)
-                {
-                    mainScreenTimer = millis();
-                    validDateTime = getLocalTime(&timeInfo, LOOP_SYNC_DATE_TIME_TIMEOUT_MS);
-
-                    /* TODO: not sure if "sntp_set_time_sync_notification_cb()" is called only on success, needs verification
-                     *
-                     * Idea is to override validDateTime from getLocalTime() return after long period of time.
-                     */
-                    updateMainScreen(
-                            internetConnection,
-                            offlineMode, 
-                            validWifiSetup, 
-                            (validWeather && weatherValidOnce) ? validWeather : ((millis() - weatherSyncTimer < WEATHER_SYNC_TIMEOUT_MS && validWifiSetup && weatherValidOnce) ? true : false), // keep displaying weather up to WEATHER_SYNC_TIMEOUT_MS even if not updated
-                            (validDateTime && dateTimeValidOnce) ? validDateTime : ((millis() - dateTimeSyncTimer < DATE_TIME_SYNC_TIMEOUT_MS && validWifiSetup && dateTimeValidOnce) ? true : false), // keep displaying date and time up to DATE_TIME_SYNC_TIMEOUT_MS even if not synced with NTP
-                            false, 
-                            timeInfo.tm_hour, 
-                            timeInfo.tm_min, 
-                            timeInfo.tm_mday, 
-                            timeInfo.tm_mon, 
-                            timeInfo.tm_year + YEAR_OFFSET, 
-                            temperature_C, 
-                            humidity, 
-                            windSpeed, 
-                            weather, 
-                            wifiSignal); 
-                }
+    handleSerialCommands();
 
-                // update weather
-                if(millis() - weatherTimer > UPDATE_WEATHER_MS || forceWeatherUpdate)
-                {
-                    weatherTimer = millis();
+    stallLoopEnd(StallLoop::UI);
+    metricObserve(Metric::LOOP_DURATION_US, micros() - loopTimer);
 
-                    if(forceWeatherUpdate)
-                    {
-                        forceWeatherUpdate = false;
-                    }
+    if(inputTaken)
+    {
+        metricObserve(Metric::INPUT_LATENCY_US, micros() - inputTimestampUs);
+    }
 
-                    if(WiFi.status() == WL_CONNECTED)
-                    {
-                        validWeather = updateWeatherTelemetry();
-
-                        if(validWeather)
-                        {
-                            weatherSyncTimer = millis();
-                        }
-                    }
-                    else
-                    {
-                        validWeather = false;
-                    }
-                }
-            }
-        }
+    // nothing changes on main screen until next deadline (clock tick, LED frame) or until woken (knob, switch, network task), held switch keeps it awake
+    if(UI_IDLE_ENABLED && state == ScreenState::MAIN && digitalRead(RE_1_SW_PIN) == HIGH && digitalRead(RE_2_SW_PIN) == HIGH)
+    {
+        idleUiLoop(nextSchedulerDeadline(&uiScheduler, millis()));
     }
 }
\ No newline at end of file
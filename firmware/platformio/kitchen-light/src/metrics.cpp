@@ -0,0 +1,161 @@
+// core includes
+#include <Arduino.h>
+#include <atomic>
+
+// project includes
+#include "metrics.h"
+#include "conf.h"
+
+/* Recording is lock free (relaxed atomics), so it may be called from any task or callback: UI loop, network task, ping task.
+ * Counter and gauge is a single value, histogram is count per bucket, total count and sum (all of them wrap at 32 bits,
+ * which Prometheus takes as counter reset). Buckets are cumulated only when metrics are printed.
+ */
+
+enum class MetricType {COUNTER, GAUGE, HISTOGRAM};
+
+struct MetricDescriptor
+{
+    const char *name;
+    const char *help;
+    MetricType type;
+    uint32_t bounds[METRICS_HISTOGRAM_BUCKETS]; // upper bounds (inclusive), ascending, histogram only
+};
+
+struct MetricValue
+{
+    std::atomic<uint32_t> value; // counter or gauge, count of histogram
+    std::atomic<uint32_t> sum;
+    std::atomic<uint32_t> buckets[METRICS_HISTOGRAM_BUCKETS + 1]; // last one is +Inf
+};
+
+const MetricDescriptor metricDescriptors[(uint8_t)Metric::COUNT] = {
+    {"light_loop_duration_us", "loop() iteration time", MetricType::HISTOGRAM, {250, 500, 1000, 2000, 5000, 10000, 50000, 100000}},
+    {"light_display_update_us", "loop() time spent drawing on display", MetricType::HISTOGRAM, {1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000}},
+    {"light_led_show_us", "FastLED.show() time", MetricType::HISTOGRAM, {100, 250, 500, 1000, 2000, 5000, 10000, 20000}},
+    {"light_http_request_ms", "weather and forecast request time, DNS to end of body", MetricType::HISTOGRAM, {50, 100, 200, 500, 1000, 2000, 5000, 10000}},
+    {"light_ping_ms", "connectivity probe round trip time", MetricType::HISTOGRAM, {10, 20, 50, 100, 200, 300, 500, 1000}},
+    {"light_input_latency_us", "knob or switch edge to the end of loop() iteration which handled it", MetricType::HISTOGRAM, {1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000}},
+    {"light_http_requests_total", "weather and forecast requests", MetricType::COUNTER, {}},
+    {"light_http_failures_total", "weather and forecast requests which failed", MetricType::COUNTER, {}},
+    {"light_ping_timeouts_total", "connectivity probes without answer", MetricType::COUNTER, {}},
+    {"light_web_requests_total", "requests served by web server", MetricType::COUNTER, {}},
+    {"light_ui_wakeups_total", "UI loop wake-ups from idle", MetricType::COUNTER, {}},
+    {"light_nvs_writes_total", "preferences writes", MetricType::COUNTER, {}},
+    {"light_log_dropped_total", "deferred log records dropped, ring was full", MetricType::COUNTER, {}},
+    {"light_free_heap_bytes", "free heap", MetricType::GAUGE, {}},
+    {"light_min_free_heap_bytes", "lowest free heap since boot", MetricType::GAUGE, {}},
+    {"light_largest_free_block_bytes", "largest free heap block", MetricType::GAUGE, {}}
+};
+
+MetricValue metricValues[(uint8_t)Metric::COUNT];
+
+void metricIncrement(Metric metric, uint32_t value)
+{
+    metricValues[(uint8_t)metric].value.fetch_add(value, std::memory_order_relaxed);
+}
+
+void metricSet(Metric metric, uint32_t value)
+{
+    metricValues[(uint8_t)metric].value.store(value, std::memory_order_relaxed);
+}
+
+void metricObserve(Metric metric, uint32_t value)
+{
+    const uint32_t *bounds = metricDescriptors[(uint8_t)metric].bounds;
+    MetricValue *metricValue = &metricValues[(uint8_t)metric];
+    uint8_t bucket = 0;
+
+    while(bucket < METRICS_HISTOGRAM_BUCKETS && value > bounds[bucket])
+    {
+        bucket++;
+    }
+
+    metricValue->buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    metricValue->sum.fetch_add(value, std::memory_order_relaxed);
+    metricValue->value.fetch_add(1, std::memory_order_relaxed);
+}
+
+// heap is sampled when metrics are read, not recorded
+void updateHeapMetrics()
+{
+    metricSet(Metric::FREE_HEAP_BYTES, ESP.getFreeHeap());
+    metricSet(Metric::MIN_FREE_HEAP_BYTES, ESP.getMinFreeHeap());
+    metricSet(Metric::LARGEST_FREE_BLOCK_BYTES, heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+}
+
+// Prometheus text format (version 0.0.4)
+void printMetrics(Print *out)
+{
+    updateHeapMetrics();
+
+    for(uint8_t i = 0; i < (uint8_t)Metric::COUNT; i++)
+    {
+        const MetricDescriptor *descriptor = &metricDescriptors[i];
+        MetricValue *metricValue = &metricValues[i];
+
+        out->printf("# HELP %s %s\n", descriptor->name, descriptor->help);
+
+        if(descriptor->type == MetricType::HISTOGRAM)
+        {
+            uint32_t cumulative = 0;
+
+            out->printf("# TYPE %s histogram\n", descriptor->name);
+
+            // buckets are read one by one while they may still change, so count is their total (not the value itself), to keep it consistent
+            for(uint8_t bucket = 0; bucket < METRICS_HISTOGRAM_BUCKETS; bucket++)
+            {
+                cumulative += metricValue->buckets[bucket].load(std::memory_order_relaxed);
+                out->printf("%s_bucket{le=\"%lu\"} %lu\n", descriptor->name, (unsigned long)descriptor->bounds[bucket], (unsigned long)cumulative);
+            }
+
+            cumulative += metricValue->buckets[METRICS_HISTOGRAM_BUCKETS].load(std::memory_order_relaxed);
+            out->printf("%s_bucket{le=\"+Inf\"} %lu\n", descriptor->name, (unsigned long)cumulative);
+            out->printf("%s_sum %lu\n", descriptor->name, (unsigned long)metricValue->sum.load(std::memory_order_relaxed));
+            out->printf("%s_count %lu\n", descriptor->name, (unsigned long)cumulative);
+        }
+        else
+        {
+            out->printf("# TYPE %s %s\n", descriptor->name, (descriptor->type == MetricType::COUNTER) ? "counter" : "gauge");
+            out->printf("%s %lu\n", descriptor->name, (unsigned long)metricValue->value.load(std::memory_order_relaxed));
+        }
+    }
+}
+
+// fills buffer as far as it goes, what does not fit is cut
+class MetricsBuffer : public Print
+{
+    public:
+        MetricsBuffer(char *buffer, size_t size) : buffer(buffer), size(size) {}
+
+        size_t write(uint8_t c) override
+        {
+            return write(&c, 1);
+        }
+
+        size_t write(const uint8_t *data, size_t length) override
+        {
+            length = min(length, size - 1 - used);
+            memcpy(buffer + used, data, length);
+            used += length;
+            buffer[used] = '\0';
+
+            return length;
+        }
+
+        size_t used = 0;
+
+    private:
+        char *buffer;
+        size_t size;
+};
+
+// for web server, which sends body after handler returns, returns text length
+size_t renderMetrics(char *buffer, size_t size)
+{
+    MetricsBuffer metricsBuffer(buffer, size);
+
+    buffer[0] = '\0';
+    printMetrics(&metricsBuffer);
+
+    return metricsBuffer.used;
+}
@@ -0,0 +1,125 @@
+// core includes
+#include <Arduino.h>
+
+// project includes
+#include "networkTask.h"
+#include "uiIdle.h"
+#include "console.h"
+#include "conf.h"
+
+QueueHandle_t networkMessageQueue = NULL;
+QueueHandle_t forecastMailbox = NULL; // single slot, too large to be part of every network message
+QueueHandle_t lightStateMailbox = NULL; // single slot, UI loop -> network task
+QueueHandle_t lightCommandQueue = NULL; // network task -> UI loop
+QueueHandle_t liveControlMailbox = NULL; // single slot, network task -> UI loop
+void (*networkTaskSetup)() = nullptr;
+uint32_t (*networkTaskLoop)() = nullptr;
+
+void networkTask(void *parameters)
+{
+    networkTaskSetup();
+
+    for(;;)
+    {
+        uint32_t delayMs = networkTaskLoop(); // NETWORK_TASK_PERIOD_MS, or longer when there is nothing to poll
+        vTaskDelay(pdMS_TO_TICKS(delayMs));
+    }
+}
+
+/* All network work (Wi-Fi, HTTP, soft AP server, ...) runs in its own task pinned to the same core as Wi-Fi driver,
+ * so loop() never waits on network. Results are passed to loop() only through network messages.
+ */
+void beginNetworkTask(void (*networkSetup)(), uint32_t (*networkLoop)())
+{
+    networkTaskSetup = networkSetup;
+    networkTaskLoop = networkLoop;
+    networkMessageQueue = xQueueCreate(NETWORK_MESSAGE_QUEUE_LENGTH, sizeof(NetworkMessage));
+    forecastMailbox = xQueueCreate(1, sizeof(ForecastRing));
+    lightStateMailbox = xQueueCreate(1, sizeof(LightState));
+    lightCommandQueue = xQueueCreate(LIGHT_COMMAND_QUEUE_LENGTH, sizeof(LightCommand));
+    liveControlMailbox = xQueueCreate(1, sizeof(LiveControl));
+
+    CONSOLE("Network task: ")
+    CONSOLE_CRLF(xTaskCreatePinnedToCore(networkTask, "network", NETWORK_TASK_STACK_SIZE, NULL, NETWORK_TASK_PRIORITY, NULL, NETWORK_TASK_CORE) == pdPASS ? "OK" : "ERROR")
+}
+
+// never blocks, when queue is full false is returned and caller is expected to post again later
+bool postNetworkMessage(const NetworkMessage *message)
+{
+    if(xQueueSend(networkMessageQueue, message, 0) != pdTRUE)
+    {
+        return false;
+    }
+
+    wakeUiLoop();
+
+    return true;
+}
+
+bool receiveNetworkMessage(NetworkMessage *message)
+{
+    return networkMessageQueue != NULL && xQueueReceive(networkMessageQueue, message, 0) == pdTRUE;
+}
+
+// never blocks, forecast not yet picked up by loop() is simply replaced by the newer one
+void postForecast(const ForecastRing *forecast)
+{
+    xQueueOverwrite(forecastMailbox, forecast);
+    wakeUiLoop();
+}
+
+bool receiveForecast(ForecastRing *forecast)
+{
+    return forecastMailbox != NULL && xQueueReceive(forecastMailbox, forecast, 0) == pdTRUE;
+}
+
+// UI loop side, called whenever light changes, network task always sees the latest state
+void postLightState(const LightState *lightState)
+{
+    if(lightStateMailbox != NULL)
+    {
+        xQueueOverwrite(lightStateMailbox, lightState);
+    }
+}
+
+// network task side, state stays in mailbox (false only before UI loop posted anything)
+bool peekLightState(LightState *lightState)
+{
+    return lightStateMailbox != NULL && xQueuePeek(lightStateMailbox, lightState, 0) == pdTRUE;
+}
+
+// never blocks, false when UI loop did not keep up (caller answers 503)
+bool postLightCommand(const LightCommand *command)
+{
+    if(xQueueSend(lightCommandQueue, command, 0) != pdTRUE)
+    {
+        return false;
+    }
+
+    wakeUiLoop();
+
+    return true;
+}
+
+bool receiveLightCommand(LightCommand *command)
+{
+    return lightCommandQueue != NULL && xQueueReceive(lightCommandQueue, command, 0) == pdTRUE;
+}
+
+// never blocks, messages coming faster than UI loop takes them (once per LED frame) are coalesced to the latest one
+void postLiveControl(const LiveControl *liveControl)
+{
+    xQueueOverwrite(liveControlMailbox, liveControl);
+    wakeUiLoop();
+}
+
+bool receiveLiveControl(LiveControl *liveControl)
+{
+    return liveControlMailbox != NULL && xQueueReceive(liveControlMailbox, liveControl, 0) == pdTRUE;
+}
+
+// UI loop side, LED frames are scheduled only while there is something to blend
+bool liveControlPending()
+{
+    return liveControlMailbox != NULL && uxQueueMessagesWaiting(liveControlMailbox) > 0;
+}
@@ -0,0 +1,133 @@
+// core includes
+#include <string.h>
+
+// project includes
+#include "queryString.h"
+
+int8_t hexDigitValue(char c)
+{
+    if(c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+
+    if(c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+
+    if(c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+
+    return -1;
+}
+
+/* Decodes one key or value in place, up to (not including) '&' (or '=' too, for key), and terminates it.
+ * Decoded text is never longer than encoded one, so writing can not overtake reading, and never contains NUL, so length is its strlen().
+ * Returns position right after the separator it stopped at (or at the end of string), separator itself is returned in stoppedAt ('\0' at the end).
+ */
+char* decodeQueryToken(char *token, bool key, uint16_t *length, char *stoppedAt)
+{
+    char *read = token;
+    char *write = token;
+
+    while(*read != '\0' && *read != '&' && (*read != '=' || !key))
+    {
+        int8_t high, low;
+
+        if(*read == '+') // form encoding of space
+        {
+            *write++ = ' ';
+            read++;
+        }
+        else if(*read == '%' && (high = hexDigitValue(read[1])) >= 0 && (low = hexDigitValue(read[2])) >= 0 && (high | low) != 0)
+        {
+            *write++ = (char)((high << 4) | low);
+            read += 3;
+        }
+        else
+        {
+            *write++ = *read++; // including '%' not followed by two hex digits and "%00" (NUL would cut value short of its length)
+        }
+    }
+
+    char *next = (*read != '\0') ? read + 1 : read;
+
+    *stoppedAt = *read;
+    *write = '\0';
+    *length = write - token;
+
+    return next;
+}
+
+// query string of request target (after '?'), NULL if there is none
+char* findQueryString(char *target)
+{
+    char *query = strchr(target, '?');
+
+    return (query != NULL) ? query + 1 : NULL;
+}
+
+/* Single pass tokenizer, call repeatedly with the same cursor (start it with findQueryString()).
+ * Buffer is modified: separators are replaced by terminators and escapes are decoded, nothing is copied.
+ * Parameter without '=' has empty value. Returns false once there are no more parameters.
+ */
+bool nextQueryParameter(char **cursor, QueryParameter *parameter)
+{
+    char *position = *cursor;
+
+    if(position == NULL)
+    {
+        return false;
+    }
+
+    // skip empty parameters ("a=1&&b=2")
+    while(*position == '&')
+    {
+        position++;
+    }
+
+    if(*position == '\0')
+    {
+        *cursor = position;
+        return false;
+    }
+
+    char *key = position;
+    uint16_t keyLength;
+    char separator;
+
+    position = decodeQueryToken(key, true, &keyLength, &separator);
+
+    parameter->key = key;
+
+    if(separator == '=')
+    {
+        parameter->value = position;
+        position = decodeQueryToken(position, false, &parameter->valueLength, &separator);
+    }
+    else
+    {
+        parameter->value = key + keyLength; // terminator of the key, so empty string
+        parameter->valueLength = 0;
+    }
+
+    *cursor = position;
+
+    return true;
+}
+
+// false when value does not fit, destination is left untouched then
+bool copyQueryValue(const QueryParameter *parameter, char *destination, uint16_t maxLength)
+{
+    if(parameter->valueLength > maxLength)
+    {
+        return false;
+    }
+
+    memcpy(destination, parameter->value, parameter->valueLength + 1);
+
+    return true;
+}
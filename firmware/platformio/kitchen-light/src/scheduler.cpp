@@ -0,0 +1,171 @@
+// core includes
+#include <Arduino.h>
+
+// project includes
+#include "scheduler.h"
+#include "console.h"
+#include "conf.h"
+
+/* Few tasks with periods from tens of ms to hours, so plain array scanned once per run is enough (and cheaper than any wheel or heap at this size).
+ * Periodic task is rearmed from the time it actually ran, not from its deadline, so a late run does not cause a burst of catch-up runs.
+ * Deadlines are compared as signed difference, millis() overflow is fine as long as no delay is over 24 days.
+ */
+
+bool taskDue(const SchedulerTask *task, uint32_t now)
+{
+    return task->armed && (int32_t)(now - task->dueMs) >= 0;
+}
+
+void beginScheduler(Scheduler *scheduler, const char *name)
+{
+    memset(scheduler, 0, sizeof(Scheduler));
+    scheduler->name = name;
+}
+
+// periodMs 0 makes it one-shot, first run is delayMs from now, returns SCHEDULER_NO_TASK when there is no free slot
+uint8_t addSchedulerTask(Scheduler *scheduler, const char *name, void (*function)(), uint32_t periodMs, uint32_t delayMs, uint32_t now)
+{
+    if(scheduler->taskCount >= SCHEDULER_MAX_TASKS)
+    {
+        CONSOLE("SCHEDULER: NO SLOT FOR ")
+        CONSOLE_CRLF(name)
+
+        return SCHEDULER_NO_TASK;
+    }
+
+    SchedulerTask *task = &scheduler->tasks[scheduler->taskCount];
+
+    task->name = name;
+    task->function = function;
+    task->periodMs = periodMs;
+    task->dueMs = now + delayMs;
+    task->armed = true;
+
+    return scheduler->taskCount++;
+}
+
+// (re)arms task to run delayMs from now, whatever its deadline was, 0 runs it in the next runScheduler()
+void scheduleTask(Scheduler *scheduler, uint8_t task, uint32_t delayMs, uint32_t now)
+{
+    if(task >= scheduler->taskCount)
+    {
+        return;
+    }
+
+    scheduler->tasks[task].dueMs = now + delayMs;
+    scheduler->tasks[task].armed = true;
+}
+
+void cancelTask(Scheduler *scheduler, uint8_t task)
+{
+    if(task >= scheduler->taskCount)
+    {
+        return;
+    }
+
+    scheduler->tasks[task].armed = false;
+}
+
+bool taskArmed(const Scheduler *scheduler, uint8_t task)
+{
+    return task < scheduler->taskCount && scheduler->tasks[task].armed;
+}
+
+// time until the earliest armed task is due, 0 if any is due already, SCHEDULER_MAX_IDLE_MS at most
+uint32_t nextSchedulerDeadline(const Scheduler *scheduler, uint32_t now)
+{
+    uint32_t idleMs = SCHEDULER_MAX_IDLE_MS;
+
+    for(uint8_t i = 0; i < scheduler->taskCount; i++)
+    {
+        const SchedulerTask *task = &scheduler->tasks[i];
+
+        if(!task->armed)
+        {
+            continue;
+        }
+
+        if(taskDue(task, now))
+        {
+            return 0;
+        }
+
+        idleMs = min(idleMs, task->dueMs - now);
+    }
+
+    return idleMs;
+}
+
+/* Runs every task which is due, in order they were added, then returns time until the next deadline (SCHEDULER_MAX_IDLE_MS at most).
+ * Task is rearmed (periodic) or disarmed (one-shot) before it runs, so it may reschedule itself (or cancel) from its function.
+ */
+uint32_t runScheduler(Scheduler *scheduler, uint32_t now)
+{
+    for(uint8_t i = 0; i < scheduler->taskCount; i++)
+    {
+        SchedulerTask *task = &scheduler->tasks[i];
+
+        if(!taskDue(task, now))
+        {
+            continue;
+        }
+
+        uint32_t latenessMs = now - task->dueMs;
+
+        if(task->periodMs > 0)
+        {
+            task->dueMs = now + task->periodMs;
+        }
+        else
+        {
+            task->armed = false;
+        }
+
+        uint32_t timer = micros();
+
+        task->function();
+
+        uint32_t runtimeUs = micros() - timer;
+
+        task->runs++;
+        task->runtimeUs += runtimeUs;
+        task->maxRuntimeUs = max(task->maxRuntimeUs, runtimeUs);
+        task->maxLatenessMs = max(task->maxLatenessMs, latenessMs);
+    }
+
+    // function of a task run above may have armed another one, which is due already (0 then)
+    return nextSchedulerDeadline(scheduler, now);
+}
+
+void printSchedulerStats(const Scheduler *scheduler, uint32_t now)
+{
+    CONSOLE("SCHEDULER: ")
+    CONSOLE_CRLF(scheduler->name)
+
+    for(uint8_t i = 0; i < scheduler->taskCount; i++)
+    {
+        const SchedulerTask *task = &scheduler->tasks[i];
+
+        CONSOLE("  |-- ")
+        CONSOLE(task->name)
+        CONSOLE(": runs ")
+        CONSOLE(task->runs)
+        CONSOLE(", avg ")
+        CONSOLE((task->runs > 0) ? (uint32_t)(task->runtimeUs / task->runs) : 0)
+        CONSOLE(" us, max ")
+        CONSOLE(task->maxRuntimeUs)
+        CONSOLE(" us, max late ")
+        CONSOLE(task->maxLatenessMs)
+        CONSOLE(" ms, next ")
+
+        if(task->armed)
+        {
+            CONSOLE((int32_t)(task->dueMs - now))
+            CONSOLE_CRLF(" ms")
+        }
+        else
+        {
+            CONSOLE_CRLF("-")
+        }
+    }
+}
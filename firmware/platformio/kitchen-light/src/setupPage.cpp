@@ -0,0 +1,50 @@
+// generated by scripts/gzipSetupPage.py from web/setup.html, do not edit
+// 4094 B original, 3688 B minified, 1342 B gzipped
+#include "setupPage.h"
+
+const char *setupPageEtag = "\"29ec099b\"";
+const uint32_t setupPageGzipLength = 1342;
+const uint8_t setupPageGzip[1342] = {
+	0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xad,0x57,0x6d,0x6f,0xdb,0x36,0x10,0xfe,0xae,0x5f,0x71,0xd5,0x87,0x41,0x46,0x5c,0xa9,0xe9,0x5e,0x50,0xd4,0xb2,
+	0x06,0xd7,0x71,0x37,0xa3,0x6d,0x1c,0x24,0x0e,0x8a,0x36,0x08,0x06,0x5a,0xa2,0x6d,0x2e,0x32,0x29,0x50,0x54,0x52,0xa5,0xcb,0x7f,0xdf,0x91,0x14,0x1d,0x29,0x71,0xdc,
+	0x16,0xdb,0x97,0xc8,0x39,0xde,0x3d,0xf7,0xdc,0xab,0xa8,0xf8,0xd9,0xd1,0x6c,0x3c,0xff,0x74,0x32,0x81,0xb5,0xda,0xe4,0x89,0x17,0xbb,0x07,0x25,0x19,0x3e,0x14,0x53,
+	0x39,0x4d,0xde,0x31,0x95,0xae,0x29,0x87,0x9c,0xad,0xd6,0x0a,0x4a,0xaa,0xaa,0x22,0x8e,0xec,0x91,0x17,0x47,0x8d,0xea,0x42,0x64,0xb5,0x36,0x3c,0x4c,0xce,0xb4,0x02,
+	0x5c,0xb5,0x8d,0x50,0xeb,0x10,0x0f,0x8b,0xc4,0x9b,0x72,0x45,0x25,0xa7,0x0a,0x52,0xc1,0x39,0x4d,0x15,0xbb,0x66,0xaa,0x06,0x56,0x02,0xa7,0x34,0xa3,0x19,0x28,0x01,
+	0xa4,0x52,0x62,0x43,0x14,0x4b,0x49,0x9e,0xd7,0x50,0xd6,0x3c,0x5d,0x4b,0xc1,0xd9,0x2d,0x85,0x8c,0x28,0xda,0x07,0xc5,0x36,0x14,0x08,0xcf,0x40,0x2c,0x14,0x61,0x1c,
+	0xd2,0x4a,0x4a,0xca,0x15,0xdc,0x50,0xa2,0xd6,0x54,0x02,0x8a,0x6a,0x51,0x49,0x48,0x11,0x39,0x8c,0x17,0x32,0xf1,0x4e,0x72,0x4a,0x4a,0x0a,0x4b,0x96,0xe7,0x80,0x2a,
+	0xb0,0x14,0x72,0x03,0xa2,0x52,0x21,0xd2,0x47,0x4e,0xb1,0xf9,0x9f,0x20,0x19,0xc1,0x87,0x7e,0x64,0x7f,0xfc,0x55,0x90,0x15,0x0d,0x8b,0x75,0xe1,0xa3,0x42,0x4e,0x16,
+	0x34,0xd7,0x66,0x43,0xbf,0x2c,0x59,0xe6,0x27,0xf1,0x22,0xf9,0x38,0x7d,0x3b,0x85,0xe3,0xd1,0x87,0x49,0x1c,0x2d,0x92,0x38,0x32,0x2a,0x89,0x71,0x17,0x33,0x5e,0x54,
+	0x0a,0x54,0x5d,0xd0,0xa1,0xaf,0xe8,0x17,0xe5,0x03,0xcb,0x1a,0x4b,0xe0,0x64,0x43,0xef,0x51,0x64,0x63,0xd1,0x72,0x50,0xdc,0xb4,0xf0,0x4f,0x46,0x67,0x67,0x1f,0x67,
+	0xa7,0x47,0xdf,0xeb,0x43,0x1b,0x37,0x2e,0x1a,0x1c,0xb9,0x43,0x5f,0x92,0x8c,0x09,0x6b,0xa0,0x93,0x34,0xe2,0xd9,0x58,0x54,0x5c,0xc9,0x7a,0x2c,0x32,0x7a,0x6a,0x0f,
+	0x2d,0x48,0x2e,0x52,0xa2,0xb3,0xe1,0xc3,0x35,0xc9,0x2b,0xba,0x4b,0xdf,0x07,0x81,0x15,0x22,0x7c,0xa5,0x4f,0xd7,0x34,0xbd,0x32,0x00,0x6f,0x2a,0xa5,0x04,0x2f,0x83,
+	0x9e,0x0f,0x46,0x48,0xb3,0x6e,0x94,0x4f,0xf9,0x4d,0x1a,0x09,0xfc,0x04,0x63,0x54,0x79,0x3a,0xe6,0x56,0x0c,0x39,0x51,0xef,0x05,0xdf,0xcf,0xdb,0xea,0x7c,0x8b,0x6b,
+	0x97,0x63,0x1b,0x37,0x79,0x8f,0x78,0xaa,0xca,0x28,0x12,0x43,0xe1,0xca,0xfc,0x6e,0xb3,0xb3,0x0c,0x33,0x76,0xfd,0x44,0x5a,0x8f,0xd8,0xf5,0x03,0xf8,0xd4,0x1e,0x3e,
+	0x4f,0x75,0x12,0x75,0xc5,0xc7,0xb3,0xf3,0xe3,0xf9,0xe9,0xa7,0xc7,0xb5,0x2e,0x69,0x8e,0xa3,0x62,0x81,0xdb,0x46,0x4d,0xb0,0x0f,0x80,0x22,0xab,0xbe,0xbb,0xbb,0x34,
+	0x31,0xeb,0x6c,0x3a,0x7f,0xec,0x29,0x98,0x2e,0xef,0x67,0xc7,0x4c,0xa5,0x50,0x38,0x6a,0x35,0x6c,0xc8,0xdf,0xc2,0x49,0xdd,0x78,0x59,0xaf,0x7d,0x60,0x4a,0x6b,0x4a,
+	0x9a,0x8a,0xcd,0x86,0xf2,0x66,0x88,0x2b,0x9c,0xb7,0xdc,0xa5,0x4c,0x0f,0x6b,0xee,0x92,0x86,0x00,0xa5,0xc2,0x9d,0xd1,0xdb,0xd7,0xc7,0x86,0xa6,0x0b,0xaf,0xa1,0xec,
+	0xa2,0x89,0x30,0xc9,0xad,0x54,0xdb,0x2a,0x3d,0x4e,0x2f,0xca,0x4d,0xa0,0xef,0x47,0xf3,0xe9,0xfc,0xfc,0xe8,0xbb,0xc7,0x54,0xdb,0xb9,0x2e,0xb2,0x10,0x3b,0xd2,0x88,
+	0xd1,0x58,0xf0,0xd9,0xf1,0x1f,0x3f,0x86,0xae,0x9b,0xd0,0xf5,0x28,0xdf,0x11,0x56,0xcb,0x89,0x5e,0x74,0xb7,0x82,0xdb,0xe6,0x98,0x4f,0x3f,0x4c,0xe0,0xf3,0xec,0x78,
+	0xb2,0xb7,0x3d,0xb6,0x26,0x8d,0x8f,0x16,0xc4,0xde,0xb6,0x20,0x05,0x7b,0x7e,0x45,0x6d,0x67,0xcc,0x4e,0x26,0xc7,0x1f,0x27,0xa3,0xf9,0x9f,0x93,0x53,0x18,0x9d,0x4c,
+	0xe1,0xdd,0x64,0x47,0xa3,0x48,0xba,0x62,0x58,0x46,0x69,0x6a,0xbb,0xc2,0x7d,0x6e,0x7a,0x42,0xab,0x23,0x0c,0xe0,0x1a,0xa6,0x10,0x13,0x58,0x4b,0xba,0x1c,0xfa,0x6b,
+	0xa5,0x8a,0xf2,0x75,0x14,0x89,0x82,0xf2,0x66,0x49,0x6f,0x48,0x11,0x0a,0xb9,0x8a,0xfc,0x64,0xcf,0x61,0x1c,0x91,0x64,0x6f,0x97,0x38,0xd6,0x4d,0xb0,0xad,0x20,0x76,
+	0x6d,0xbd,0xb2,0x5a,0x6c,0x98,0xda,0x6e,0x84,0x51,0x51,0xe0,0xeb,0x05,0x5f,0x43,0x4b,0xb6,0xaa,0xa4,0xdd,0x16,0xba,0x0c,0xfa,0x65,0xa0,0x93,0x9a,0x4a,0x56,0xa8,
+	0xc4,0x5b,0x56,0xdc,0xbc,0x0f,0x60,0xc7,0xbe,0xf0,0xbe,0x7a,0x6c,0x09,0x41,0x26,0xd2,0x0a,0x3b,0x5f,0x85,0x98,0x87,0x49,0x4e,0xf5,0xcf,0x37,0xf5,0x34,0x0b,0x9e,
+	0x5c,0x72,0xbd,0xb0,0xd9,0x89,0x1a,0xe1,0x07,0xac,0x75,0x93,0xf7,0xc2,0x52,0xd5,0x39,0x0d,0x33,0x56,0x16,0x39,0xa9,0x61,0x08,0xfe,0x02,0xb7,0xdd,0x95,0x3f,0xf0,
+	0xee,0x80,0xe6,0x25,0xfd,0x5f,0x20,0xb9,0xee,0x19,0x44,0xdc,0x1f,0x5f,0x7b,0x41,0x7e,0x5f,0x4c,0xf7,0xc3,0xfa,0x9f,0xe2,0xd8,0x0b,0xb3,0xe5,0x7e,0xe7,0xed,0xa8,
+	0xd9,0xc0,0x8b,0x22,0xb7,0xbb,0x4c,0xf3,0x9a,0xeb,0x84,0x9e,0x11,0x10,0x85,0x2e,0x74,0x89,0xa7,0x28,0x59,0x4a,0x81,0x77,0x04,0x94,0x2e,0x18,0x27,0xa8,0xaa,0xc8,
+	0x22,0xa7,0x10,0x94,0x94,0x82,0x6d,0x8d,0x32,0x5a,0x51,0x4e,0xb1,0x71,0xe8,0x67,0x54,0x9b,0xeb,0xe3,0xb0,0xa8,0x7b,0x7d,0x58,0x48,0x71,0x53,0xe2,0x64,0xa4,0x04,
+	0xdd,0x97,0xb8,0x1e,0xef,0x7b,0x48,0xdf,0x40,0xb4,0xf6,0x99,0x19,0xc5,0x32,0x58,0x54,0xcb,0x25,0x95,0x3a,0x63,0xd7,0x44,0xc2,0xa2,0x56,0xa8,0x3f,0xc4,0xab,0xd0,
+	0x0d,0x9c,0x33,0xae,0x5e,0x8d,0xa4,0x24,0xb5,0x53,0x1a,0x18,0x9d,0x8c,0xea,0x2d,0x2f,0x1b,0xad,0x39,0x8e,0xc2,0x91,0x95,0x04,0x8d,0x42,0x21,0x4a,0x66,0x7c,0x0d,
+	0xe1,0x37,0x2b,0xd1,0xa3,0xaa,0xc3,0x1a,0xc2,0xc5,0xe5,0xbd,0xce,0x97,0xf9,0xad,0x13,0x6d,0xe9,0x71,0x84,0x3b,0x53,0x92,0xf1,0x55,0xe0,0x38,0xe1,0x42,0x47,0x2d,
+	0xc3,0x2c,0x64,0xb8,0xdc,0xbf,0xcc,0x96,0xc1,0x8b,0xfe,0xd6,0x4b,0xe3,0x54,0x8f,0x24,0xaa,0x35,0xe4,0x42,0xfb,0x0c,0xac,0x15,0x8e,0x1d,0x31,0x71,0x38,0x9b,0xbe,
+	0x06,0xed,0xa1,0x65,0x8b,0xaa,0x76,0x73,0x00,0x87,0x03,0x4f,0xe2,0xe5,0x51,0x72,0x03,0xa8,0x4b,0xa8,0xc1,0x53,0xd7,0xad,0xf8,0x70,0x5c,0x2e,0x5e,0x5c,0xc2,0x3f,
+	0x60,0x3d,0x5c,0x1c,0x5e,0x42,0x1c,0xc3,0xab,0x5e,0x3b,0xdc,0xae,0xf6,0xcb,0x6e,0xe0,0xdd,0xc3,0x9f,0x9b,0x43,0xdd,0x03,0xdd,0x93,0x5f,0x5a,0x4e,0x7e,0xed,0x38,
+	0x69,0x38,0xd9,0x3a,0xea,0xc8,0x9f,0x9c,0xb8,0xf6,0xbb,0xd9,0x65,0xab,0x59,0xca,0xdf,0xb6,0xde,0xae,0x6f,0xb4,0xc4,0xbd,0x04,0x81,0x36,0x67,0x68,0xf1,0x62,0x80,
+	0x8f,0xb8,0x93,0x1a,0x94,0x1c,0x1c,0xb8,0xb2,0x69,0x77,0xa8,0x66,0x8b,0x19,0xea,0x5e,0x1e,0xaf,0x89,0x1c,0x6f,0xab,0x72,0xe1,0x72,0x7f,0xd9,0x87,0xae,0x40,0x97,
+	0xe1,0xb2,0x5d,0x9c,0x83,0x21,0xbc,0x1c,0x78,0x9d,0x80,0x43,0x92,0x65,0x81,0xee,0xbf,0x99,0x99,0x98,0xa0,0xdd,0x37,0x7d,0xe3,0x5b,0x97,0xf7,0x6e,0x27,0xe5,0x56,
+	0x79,0xb6,0x8c,0x9b,0x0e,0x0d,0x8b,0xaa,0x5c,0x77,0xc0,0x9e,0x44,0x69,0x17,0x72,0x0b,0xe3,0xda,0xfa,0x07,0x70,0xb6,0x35,0xef,0x64,0xcf,0xf2,0x41,0xad,0x86,0xd8,
+	0xc5,0x83,0x9c,0x75,0xbb,0x09,0xf5,0x9c,0xe7,0x8b,0x1d,0xb9,0xbc,0x7c,0x94,0x4b,0x53,0x20,0x7d,0x95,0x1a,0x76,0x26,0x6e,0xe0,0x75,0x1b,0xe3,0x61,0x96,0x83,0x86,
+	0xd6,0x33,0xdc,0x71,0x7e,0x0f,0x7e,0x77,0x34,0x0f,0xc0,0x8f,0x7c,0xfc,0x6b,0x20,0x5f,0x9b,0x47,0xdf,0x31,0xb2,0x91,0x63,0xec,0x14,0xbf,0xc6,0x02,0x3f,0xd2,0xe8,
+	0x65,0x88,0x2b,0x0d,0x17,0x27,0xbe,0x6a,0x79,0xe0,0x66,0x1f,0xc1,0xcb,0x02,0x43,0xa5,0x3d,0xf8,0x0a,0xcd,0x10,0x3a,0x51,0x68,0xe6,0xf7,0x8d,0x59,0x43,0x48,0x13,
+	0xee,0x9c,0x6d,0x77,0x9b,0xa1,0x2b,0xbc,0x64,0x34,0xaf,0x4d,0xbc,0x31,0xd8,0x0f,0xc2,0xc8,0x7c,0x51,0xfe,0x0b,0x84,0x27,0xdc,0x45,0x68,0x0e,0x00,0x00,
+};
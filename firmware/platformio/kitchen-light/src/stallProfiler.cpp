@@ -0,0 +1,206 @@
+// core includes
+#include <Arduino.h>
+
+// project includes
+#include "stallProfiler.h"
+#include "trace.h"
+#include "console.h"
+#include "conf.h"
+
+/* Each loop (and its sites) is written only by its own task, so nothing is locked.
+ * Summary is printed from UI loop while network task may be updating its part, numbers may be off by a sample.
+ * Histogram is in ms, bucket i (from 1) holds [2^(i-1), 2^i) ms, bucket 0 under 1 ms, the last one everything above.
+ */
+
+struct StallSiteStats
+{
+    const char *name;
+    StallLoop loop;
+    uint32_t count;
+    uint64_t totalUs;
+    uint32_t maxUs;
+    uint32_t buckets[STALL_PROFILER_BUCKETS];
+};
+
+struct StallLoopStats
+{
+    const char *name;
+    uint32_t thresholdMs; // iteration over this is logged
+    uint32_t beginUs;
+    uint8_t depth; // of open probes
+    uint32_t nestedUs[STALL_PROFILER_MAX_DEPTH + 1]; // time of probes nested at each level, [0] is everything probed
+    StallSite worstSite; // longest own time this iteration
+    uint32_t worstUs;
+    uint32_t iterations;
+    uint32_t stalls;
+    uint32_t maxUs;
+};
+
+StallSiteStats stallSites[(uint8_t)StallSite::COUNT] = {
+    {"network messages", StallLoop::UI},
+    {"light commands", StallLoop::UI},
+    {"encoders", StallLoop::UI},
+    {"factory reset", StallLoop::UI},
+    {"screen redraw", StallLoop::UI},
+    {"main screen", StallLoop::UI},
+    {"LED show", StallLoop::UI},
+    {"NVS write", StallLoop::UI},
+    {"wifi", StallLoop::NETWORK},
+    {"web server", StallLoop::NETWORK},
+    {"connectivity", StallLoop::NETWORK},
+    {"weather HTTP", StallLoop::NETWORK},
+    {"forecast HTTP", StallLoop::NETWORK}
+};
+
+StallLoopStats stallLoops[(uint8_t)StallLoop::COUNT] = {
+    {"UI", STALL_PROFILER_UI_THRESHOLD_MS},
+    {"network", STALL_PROFILER_NETWORK_THRESHOLD_MS}
+};
+
+uint8_t stallBucket(uint32_t us)
+{
+    uint32_t ms = us / 1000;
+
+    if(ms == 0)
+    {
+        return 0;
+    }
+
+    return min((uint8_t)(32 - __builtin_clz(ms)), (uint8_t)(STALL_PROFILER_BUCKETS - 1));
+}
+
+StallProbe::StallProbe(StallSite site) : site(site)
+{
+    StallLoopStats *loop = &stallLoops[(uint8_t)stallSites[(uint8_t)site].loop];
+
+    // too deep, still counted for the site, only its own time is not known
+    if(loop->depth < STALL_PROFILER_MAX_DEPTH)
+    {
+        loop->nestedUs[loop->depth + 1] = 0;
+    }
+
+    loop->depth++;
+    traceBegin(stallSites[(uint8_t)site].name, stallSites[(uint8_t)site].loop);
+    beginUs = micros();
+}
+
+StallProbe::~StallProbe()
+{
+    uint32_t elapsedUs = micros() - beginUs;
+    StallSiteStats *stats = &stallSites[(uint8_t)site];
+    StallLoopStats *loop = &stallLoops[(uint8_t)stats->loop];
+
+    stats->count++;
+    stats->totalUs += elapsedUs;
+    stats->maxUs = max(stats->maxUs, elapsedUs);
+    stats->buckets[stallBucket(elapsedUs)]++;
+
+    loop->depth--;
+    traceEnd(stats->name, stats->loop);
+
+    if(loop->depth < STALL_PROFILER_MAX_DEPTH)
+    {
+        uint32_t ownUs = elapsedUs - loop->nestedUs[loop->depth + 1];
+
+        if(ownUs > loop->worstUs)
+        {
+            loop->worstUs = ownUs;
+            loop->worstSite = site;
+        }
+
+        loop->nestedUs[loop->depth] += elapsedUs;
+    }
+}
+
+void stallLoopBegin(StallLoop loop)
+{
+    StallLoopStats *stats = &stallLoops[(uint8_t)loop];
+
+    stats->depth = 0;
+    stats->nestedUs[0] = 0;
+    stats->worstUs = 0;
+    stats->beginUs = micros();
+}
+
+// logs iteration over threshold with the site that took most of it (or time no probe covers, if that was more), deferred, so logging a stall does not add to it
+void stallLoopEnd(StallLoop loop)
+{
+    StallLoopStats *stats = &stallLoops[(uint8_t)loop];
+    uint32_t elapsedUs = micros() - stats->beginUs;
+    uint32_t unprobedUs = elapsedUs - stats->nestedUs[0];
+
+    stats->iterations++;
+    stats->maxUs = max(stats->maxUs, elapsedUs);
+
+    if(elapsedUs / 1000 <= stats->thresholdMs)
+    {
+        return;
+    }
+
+    stats->stalls++;
+
+    LOG_WARNING("STALL: %s loop %lu ms", stats->name, elapsedUs / 1000)
+
+    if(stats->worstUs >= unprobedUs)
+    {
+        LOG_WARNING("  |-- site: %s (%lu ms)", stallSites[(uint8_t)stats->worstSite].name, stats->worstUs / 1000)
+    }
+    else
+    {
+        LOG_WARNING("  |-- site: not probed (%lu ms)", unprobedUs / 1000)
+    }
+}
+
+void printStallProfile()
+{
+    CONSOLE_CRLF("STALL PROFILE")
+
+    for(uint8_t i = 0; i < (uint8_t)StallLoop::COUNT; i++)
+    {
+        CONSOLE("  |-- ")
+        CONSOLE(stallLoops[i].name)
+        CONSOLE(" loop: iterations ")
+        CONSOLE(stallLoops[i].iterations)
+        CONSOLE(", max ")
+        CONSOLE(stallLoops[i].maxUs / 1000)
+        CONSOLE(" ms, stalls ")
+        CONSOLE(stallLoops[i].stalls)
+        CONSOLE(" (over ")
+        CONSOLE(stallLoops[i].thresholdMs)
+        CONSOLE_CRLF(" ms)")
+    }
+
+    CONSOLE("  |-- histogram buckets (ms): <1")
+
+    for(uint8_t bucket = 1; bucket < STALL_PROFILER_BUCKETS - 1; bucket++)
+    {
+        CONSOLE(" <")
+        CONSOLE(1UL << bucket)
+    }
+
+    CONSOLE(" >=")
+    CONSOLE_CRLF(1UL << (STALL_PROFILER_BUCKETS - 2))
+
+    for(uint8_t i = 0; i < (uint8_t)StallSite::COUNT; i++)
+    {
+        const StallSiteStats *stats = &stallSites[i];
+
+        CONSOLE("  |-- ")
+        CONSOLE(stats->name)
+        CONSOLE(": count ")
+        CONSOLE(stats->count)
+        CONSOLE(", avg ")
+        CONSOLE((stats->count > 0) ? (uint32_t)(stats->totalUs / stats->count) : 0)
+        CONSOLE(" us, max ")
+        CONSOLE(stats->maxUs)
+        CONSOLE(" us, ms histogram")
+
+        for(uint8_t bucket = 0; bucket < STALL_PROFILER_BUCKETS; bucket++)
+        {
+            CONSOLE(" ")
+            CONSOLE(stats->buckets[bucket])
+        }
+
+        CONSOLE_CRLF("")
+    }
+}
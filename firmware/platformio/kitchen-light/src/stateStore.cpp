@@ -0,0 +1,191 @@
+// core includes
+#include <Arduino.h>
+
+// project includes
+#include "stateStore.h"
+#include "console.h"
+#include "conf.h"
+
+/* Setters only record the change, subscribers are called from dispatchStateChanges() (once per UI loop iteration),
+ * so any number of changes in between (e.g. light command setting several fields) ends up as a single notification.
+ * Subscribers may set state again, that is dispatched next time.
+ */
+
+struct StateSubscription
+{
+    uint32_t fields;
+    StateSubscriber subscriber;
+};
+
+UiState currentState;
+UiState dispatchedState; // as subscribers saw it last time
+uint32_t changedFields = 0;
+bool stateSynced = false; // subscribers got initial state already
+StateSubscription stateSubscriptions[STATE_STORE_MAX_SUBSCRIBERS];
+uint8_t stateSubscriptionCount = 0;
+
+/* Every field counts as changed at the first dispatch, so subscribers start in sync with loaded state.
+ * Previous state is the same as current one then, whatever was set during setup() is the initial state.
+ */
+void beginStateStore(const UiState *initialState)
+{
+    currentState = *initialState;
+    changedFields = (1UL << (uint8_t)StateField::COUNT) - 1;
+    stateSynced = false;
+}
+
+bool subscribeState(uint32_t fields, StateSubscriber subscriber)
+{
+    if(stateSubscriptionCount >= STATE_STORE_MAX_SUBSCRIBERS)
+    {
+        CONSOLE_CRLF("STATE STORE: NO SLOT FOR SUBSCRIBER")
+        return false;
+    }
+
+    stateSubscriptions[stateSubscriptionCount].fields = fields;
+    stateSubscriptions[stateSubscriptionCount].subscriber = subscriber;
+    stateSubscriptionCount++;
+
+    return true;
+}
+
+const UiState* uiState()
+{
+    return &currentState;
+}
+
+void setBrightness(uint8_t brightness)
+{
+    if(currentState.brightness != brightness)
+    {
+        currentState.brightness = brightness;
+        markStateChanged(StateField::BRIGHTNESS);
+    }
+}
+
+void setColorPickerType(ColorPickerType colorPickerType)
+{
+    if(currentState.colorPickerType != colorPickerType)
+    {
+        currentState.colorPickerType = colorPickerType;
+        markStateChanged(StateField::COLOR_PICKER_TYPE);
+    }
+}
+
+void setColorHueIndex(uint16_t colorHueIndex)
+{
+    if(currentState.colorHueIndex != colorHueIndex)
+    {
+        currentState.colorHueIndex = colorHueIndex;
+        markStateChanged(StateField::COLOR_HUE_INDEX);
+    }
+}
+
+void setColorTemperatureIndex(uint16_t colorTemperatureIndex)
+{
+    if(currentState.colorTemperatureIndex != colorTemperatureIndex)
+    {
+        currentState.colorTemperatureIndex = colorTemperatureIndex;
+        markStateChanged(StateField::COLOR_TEMPERATURE_INDEX);
+    }
+}
+
+void setNumberOfLeds(uint16_t numberOfLeds)
+{
+    if(currentState.numberOfLeds != numberOfLeds)
+    {
+        currentState.numberOfLeds = numberOfLeds;
+        markStateChanged(StateField::NUMBER_OF_LEDS);
+    }
+}
+
+// color matters only while active
+void setLiveColor(bool liveColorActive, CRGB liveColor)
+{
+    if(currentState.liveColorActive != liveColorActive || (liveColorActive && currentState.liveColor != liveColor))
+    {
+        currentState.liveColorActive = liveColorActive;
+        currentState.liveColor = liveColor;
+        markStateChanged(StateField::LIVE_COLOR);
+    }
+}
+
+void setValidWifiSetup(bool validWifiSetup)
+{
+    if(currentState.validWifiSetup != validWifiSetup)
+    {
+        currentState.validWifiSetup = validWifiSetup;
+        markStateChanged(StateField::WIFI_SETUP);
+    }
+}
+
+void setOfflineMode(bool offlineMode)
+{
+    if(currentState.offlineMode != offlineMode)
+    {
+        currentState.offlineMode = offlineMode;
+        markStateChanged(StateField::OFFLINE_MODE);
+    }
+}
+
+void setInternetConnection(bool internetConnection)
+{
+    if(currentState.internetConnection != internetConnection)
+    {
+        currentState.internetConnection = internetConnection;
+        markStateChanged(StateField::INTERNET_CONNECTION);
+    }
+}
+
+void setWifiSignal(WifiSignal wifiSignal)
+{
+    if(currentState.wifiSignal != wifiSignal)
+    {
+        currentState.wifiSignal = wifiSignal;
+        markStateChanged(StateField::WIFI_SIGNAL);
+    }
+}
+
+void setValidWeather(bool validWeather)
+{
+    if(currentState.validWeather != validWeather)
+    {
+        currentState.validWeather = validWeather;
+        markStateChanged(StateField::WEATHER);
+    }
+}
+
+// for data that belongs to a field but is not held by store (weather data)
+void markStateChanged(StateField field)
+{
+    changedFields |= STATE_FIELD(field);
+}
+
+void dispatchStateChanges()
+{
+    uint32_t fields = changedFields;
+
+    if(fields == 0)
+    {
+        return;
+    }
+
+    if(!stateSynced)
+    {
+        dispatchedState = currentState;
+        stateSynced = true;
+    }
+
+    UiState previousState = dispatchedState;
+
+    changedFields = 0;
+    dispatchedState = currentState;
+
+    for(uint8_t i = 0; i < stateSubscriptionCount; i++)
+    {
+        if(stateSubscriptions[i].fields & fields)
+        {
+            stateSubscriptions[i].subscriber(&currentState, &previousState, stateSubscriptions[i].fields & fields);
+        }
+    }
+}
@@ -0,0 +1,206 @@
+// core includes
+#include <Arduino.h>
+#include <time.h>
+#include <sys/time.h>
+#include "esp_attr.h"
+#include "esp_sntp.h"
+#include "esp_timer.h"
+
+// project includes
+#include "timeSync.h"
+#include "connectivity.h"
+#include "utilities.h"
+#include "console.h"
+#include "conf.h"
+
+const char* timeQualityString[] = {"NONE", "RESTORED", "SYNCED", "FREE_RUNNING"};
+
+struct TimeSyncRecord
+{
+    uint32_t magic;
+    int64_t syncEpoch; // s
+    float driftPpm; // of the clock between NTP syncs, + means clock is slow
+    bool driftKnown;
+    uint32_t checksum;
+};
+
+/* System time (RTC timer) survives ESP.restart(), record of the last NTP sync survives in RTC slow memory.
+ * Both are lost on power-on, which is detected by invalid record.
+ */
+RTC_NOINIT_ATTR TimeSyncRecord timeSyncRecord;
+
+portMUX_TYPE timeSyncMux = portMUX_INITIALIZER_UNLOCKED; // record is written from sntp callback (tcpip task)
+volatile bool syncedThisBoot = false;
+int64_t lastSyncMonotonicUs = 0; // only syncs in this boot can be used to estimate drift
+int64_t lastSyncEpochUs = 0;
+
+bool timeSyncRecordValid(const TimeSyncRecord *record)
+{
+    return record->magic == TIME_SYNC_RECORD_MAGIC && record->checksum == fnv1aHash((const uint8_t*)record, offsetof(TimeSyncRecord, checksum));
+}
+
+// called from sntp (tcpip task) after system time was set
+void onTimeSync(struct timeval *tv)
+{
+    int64_t monotonicUs = esp_timer_get_time();
+    int64_t epochUs = (int64_t)tv->tv_sec * 1000000LL + tv->tv_usec;
+    float driftPpm = 0.0f;
+    bool driftMeasured = false;
+
+    // NTP time elapsed vs. local clock elapsed, short intervals would be mostly NTP jitter
+    if(lastSyncMonotonicUs != 0 && monotonicUs - lastSyncMonotonicUs >= (int64_t)TIME_DRIFT_MIN_INTERVAL_S * 1000000LL)
+    {
+        float elapsedUs = (float)(monotonicUs - lastSyncMonotonicUs);
+        driftPpm = ((float)(epochUs - lastSyncEpochUs) - elapsedUs) / elapsedUs * 1000000.0f;
+        driftMeasured = true;
+    }
+
+    lastSyncMonotonicUs = monotonicUs;
+    lastSyncEpochUs = epochUs;
+
+    portENTER_CRITICAL(&timeSyncMux);
+
+    if(!timeSyncRecordValid(&timeSyncRecord))
+    {
+        timeSyncRecord.driftKnown = false;
+    }
+
+    if(driftMeasured)
+    {
+        // smoothed, single measurement is still noisy
+        timeSyncRecord.driftPpm = timeSyncRecord.driftKnown ? timeSyncRecord.driftPpm + (driftPpm - timeSyncRecord.driftPpm) / 4.0f : driftPpm;
+        timeSyncRecord.driftKnown = true;
+    }
+
+    timeSyncRecord.magic = TIME_SYNC_RECORD_MAGIC;
+    timeSyncRecord.syncEpoch = tv->tv_sec;
+    timeSyncRecord.checksum = fnv1aHash((const uint8_t*)&timeSyncRecord, offsetof(TimeSyncRecord, checksum));
+
+    portEXIT_CRITICAL(&timeSyncMux);
+
+    syncedThisBoot = true;
+    reportConnectivitySuccess();
+
+    CONSOLE_CRLF("NTP SYNC: OK")
+
+    if(driftMeasured)
+    {
+        CONSOLE("  |-- measured drift: ")
+        CONSOLE(driftPpm)
+        CONSOLE_CRLF(" ppm")
+    }
+}
+
+/* Has to be called early in setup(), before anything uses time.
+ * Clock is kept only when it was synced by NTP before restart, otherwise it is reset (basically any year < 2015).
+ */
+void beginTimeSync(const char *timeZone)
+{
+    CONSOLE("Time: ")
+
+    if(!timeSyncRecordValid(&timeSyncRecord))
+    {
+        struct timeval tv;
+        tv.tv_sec = 0;
+        tv.tv_usec = 0;
+        settimeofday(&tv, NULL);
+    }
+
+    sntp_set_time_sync_notification_cb(onTimeSync);
+
+    // time zone is known from preferences, restored time can be shown in local time before Wi-Fi connects
+    setenv("TZ", timeZone, 1);
+    tzset();
+
+    CONSOLE_CRLF(timeQualityString[(uint8_t)getTimeQuality()])
+
+    if(timeSyncRecordValid(&timeSyncRecord))
+    {
+        CONSOLE("  |-- last NTP sync: ")
+        CONSOLE((int32_t)(time(NULL) - timeSyncRecord.syncEpoch))
+        CONSOLE_CRLF(" s ago")
+        CONSOLE("  |-- drift: ")
+
+        if(timeSyncRecord.driftKnown)
+        {
+            CONSOLE(timeSyncRecord.driftPpm)
+            CONSOLE_CRLF(" ppm")
+        }
+        else
+        {
+            CONSOLE_CRLF("unknown")
+        }
+    }
+
+    CONSOLE("  |-- timezone: ")
+    CONSOLE_CRLF(timeZone)
+}
+
+/* Never waits, onTimeSync() is called once NTP answers (and then every hour, sntp default).
+ * Safe to be called on every Wi-Fi (re)connect.
+ */
+void startTimeSync()
+{
+    CONSOLE("NTP SYNC: ")
+
+    if(sntp_enabled())
+    {
+        sntp_restart();
+        CONSOLE_CRLF("RESTARTED")
+    }
+    else
+    {
+        configTzTime(getenv("TZ"), NTP_server_domain); // unlike configTime(), keeps our time zone
+        CONSOLE_CRLF("STARTED")
+    }
+}
+
+/* Estimated error grows with time since last sync, at measured drift (or pessimistic default) plus margin.
+ * Once it reaches TIME_MAX_ERROR_S clock is not shown anymore.
+ */
+TimeQuality getTimeQuality()
+{
+    TimeSyncRecord record;
+    bool recordValid;
+    time_t now = time(NULL);
+
+    portENTER_CRITICAL(&timeSyncMux);
+    recordValid = timeSyncRecordValid(&timeSyncRecord);
+    record = timeSyncRecord;
+    portEXIT_CRITICAL(&timeSyncMux);
+
+    if(!recordValid || now < MIN_VALID_EPOCH || now < record.syncEpoch)
+    {
+        return TimeQuality::NONE;
+    }
+
+    float age = (float)(now - record.syncEpoch);
+    float driftPpm = (record.driftKnown ? fabsf(record.driftPpm) : TIME_DEFAULT_DRIFT_PPM) + TIME_DRIFT_MARGIN_PPM;
+
+    if(age * driftPpm / 1000000.0f > TIME_MAX_ERROR_S)
+    {
+        return TimeQuality::NONE;
+    }
+
+    if(!syncedThisBoot)
+    {
+        return TimeQuality::RESTORED;
+    }
+
+    return (age < TIME_SYNC_FRESH_S) ? TimeQuality::SYNCED : TimeQuality::FREE_RUNNING;
+}
+
+// never waits, unlike getLocalTime()
+bool getLocalDateTime(struct tm *timeInfo)
+{
+    time_t now = time(NULL);
+
+    if(getTimeQuality() == TimeQuality::NONE)
+    {
+        return false;
+    }
+
+    localtime_r(&now, timeInfo);
+
+    return true;
+}
@@ -0,0 +1,226 @@
+// core includes
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <stdarg.h>
+#include <atomic>
+
+// project includes
+#include "trace.h"
+#include "conf.h"
+
+/* Fixed ring of the last TRACE_RING_SIZE events, written lock free by UI loop and network task.
+ * Recording is paused while any dump runs (serial "trace" and GET /trace may overlap), events that happen meanwhile are lost.
+ * A writer which got past the pause check still finishes its record, so every record carries the position it was written for,
+ * stored last with release, dump reads it with acquire before and after copying and skips records not (or no longer) there.
+ * Output is Chrome Trace Event JSON (chrome://tracing, Perfetto), one thread per loop, timestamps in us since boot.
+ * Ring overwrites oldest events, end of a span whose begin is already gone is left out.
+ */
+
+struct TraceRecord
+{
+    int64_t timeUs;
+    const char *name;
+    char phase; // B(egin), E(nd), i(nstant)
+    StallLoop loop;
+    std::atomic<uint32_t> sequence; // position + 1 once record is complete, 0 while it is being written
+};
+
+const char *traceThreadNames[(uint8_t)StallLoop::COUNT] = {"UI loop", "network task"};
+
+TraceRecord traceRing[TRACE_RING_SIZE];
+std::atomic<uint32_t> traceHead(0); // events recorded since boot
+std::atomic<uint8_t> traceDumps(0); // running at once, recording resumes when the last one finishes
+
+void traceRecord(const char *name, char phase, StallLoop loop)
+{
+    if(!TRACE_ENABLED || traceDumps.load(std::memory_order_acquire) != 0)
+    {
+        return;
+    }
+
+    uint32_t position = traceHead.fetch_add(1, std::memory_order_relaxed);
+    TraceRecord *record = &traceRing[position % TRACE_RING_SIZE];
+
+    record->sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    record->timeUs = esp_timer_get_time();
+    record->name = name;
+    record->phase = phase;
+    record->loop = loop;
+    record->sequence.store(position + 1, std::memory_order_release);
+}
+
+// copy of the record written for position, false when it is not complete or already overwritten
+bool traceReadRecord(uint32_t position, TraceRecord *copy)
+{
+    const TraceRecord *record = &traceRing[position % TRACE_RING_SIZE];
+
+    if(record->sequence.load(std::memory_order_acquire) != position + 1)
+    {
+        return false;
+    }
+
+    copy->timeUs = record->timeUs;
+    copy->name = record->name;
+    copy->phase = record->phase;
+    copy->loop = record->loop;
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    return record->sequence.load(std::memory_order_relaxed) == position + 1;
+}
+
+void traceBegin(const char *name, StallLoop loop)
+{
+    traceRecord(name, 'B', loop);
+}
+
+void traceEnd(const char *name, StallLoop loop)
+{
+    traceRecord(name, 'E', loop);
+}
+
+void traceInstant(const char *name, StallLoop loop)
+{
+    traceRecord(name, 'i', loop);
+}
+
+// writes whole events only, returns false when the next one does not fit and from then on, so nothing shorter gets in after it
+class TraceWriter
+{
+    public:
+        TraceWriter(Print *out, char *buffer, size_t size) : out(out), buffer(buffer), size(size) {}
+
+        bool write(const char *format, ...)
+        {
+            char line[128];
+            va_list arguments;
+
+            va_start(arguments, format);
+            int length = vsnprintf(line, sizeof(line), format, arguments);
+            va_end(arguments);
+
+            if(length < 0 || length >= (int)sizeof(line))
+            {
+                return true; // cannot happen with names firmware uses, skipped rather than cut
+            }
+
+            if(out != nullptr)
+            {
+                out->write((const uint8_t*)line, length);
+                return true;
+            }
+
+            if(full || used + length + reserved >= size)
+            {
+                full = true;
+                return false;
+            }
+
+            memcpy(buffer + used, line, length + 1);
+            used += length;
+
+            return true;
+        }
+
+        // closing "]}\n" had its room reserved, nothing at all when even the opening did not fit
+        void close()
+        {
+            if(out != nullptr)
+            {
+                out->write((const uint8_t*)"]}\n", 3);
+                return;
+            }
+
+            if(used == 0)
+            {
+                return;
+            }
+
+            memcpy(buffer + used, "]}\n", 4);
+            used += 3;
+        }
+
+        size_t used = 0;
+
+    private:
+        Print *out;
+        char *buffer;
+        size_t size;
+        size_t reserved = 3; // room for closing "]}\n", so text is always valid JSON
+        bool full = false;
+};
+
+void writeTrace(TraceWriter *writer)
+{
+    uint8_t depth[(uint8_t)StallLoop::COUNT] = {};
+    const char *separator = "";
+
+    traceDumps.fetch_add(1, std::memory_order_acq_rel);
+
+    uint32_t head = traceHead.load(std::memory_order_relaxed);
+    uint32_t first = (head > TRACE_RING_SIZE) ? head - TRACE_RING_SIZE : 0;
+
+    writer->write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    for(uint8_t i = 0; i < (uint8_t)StallLoop::COUNT; i++)
+    {
+        writer->write("%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}", separator, i, traceThreadNames[i]);
+        separator = ",\n";
+    }
+
+    for(uint32_t position = first; position != head; position++)
+    {
+        TraceRecord record;
+
+        if(!traceReadRecord(position, &record))
+        {
+            continue;
+        }
+
+        uint8_t thread = (uint8_t)record.loop;
+        bool written;
+
+        if(record.phase == 'E' && depth[thread] == 0)
+        {
+            continue;
+        }
+
+        if(record.phase == 'i')
+        {
+            written = writer->write("%s{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%lld,\"pid\":1,\"tid\":%u}", separator, record.name, (long long)record.timeUs, thread);
+        }
+        else
+        {
+            written = writer->write("%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%lld,\"pid\":1,\"tid\":%u}", separator, record.name, record.phase, (long long)record.timeUs, thread);
+        }
+
+        if(!written)
+        {
+            break;
+        }
+
+        depth[thread] += (record.phase == 'B') ? 1 : ((record.phase == 'E') ? -1 : 0);
+    }
+
+    traceDumps.fetch_sub(1, std::memory_order_release);
+
+    writer->close();
+}
+
+void printTrace(Print *out)
+{
+    TraceWriter writer(out, nullptr, 0);
+
+    writeTrace(&writer);
+}
+
+// for web server, which sends body after handler returns, returns text length
+size_t renderTrace(char *buffer, size_t size)
+{
+    TraceWriter writer(nullptr, buffer, size);
+
+    buffer[0] = '\0';
+    writeTrace(&writer);
+
+    return writer.used;
+}
@@ -0,0 +1,84 @@
+// core includes
+#include <Arduino.h>
+#include "esp_pm.h"
+
+// project includes
+#include "uiIdle.h"
+#include "metrics.h"
+#include "console.h"
+#include "conf.h"
+
+TaskHandle_t uiTask = NULL; // Arduino loop task, nothing is woken before beginUiIdle()
+volatile uint32_t inputTimestampUs = 0;
+volatile bool inputPending = false; // input not yet taken by UI loop
+
+/* To be called from setup() (runs in the loop task).
+ * Frequency scaling lets CPU slow down while all tasks block, it needs framework built with power management,
+ * otherwise it just reports NOT SUPPORTED and idle is plain FreeRTOS idle (CPU waits for interrupt at full clock).
+ */
+void beginUiIdle()
+{
+    esp_pm_config_esp32s3_t powerConfig = {};
+
+    uiTask = xTaskGetCurrentTaskHandle();
+
+    powerConfig.max_freq_mhz = POWER_MAX_CPU_FREQUENCY_MHZ;
+    powerConfig.min_freq_mhz = POWER_MIN_CPU_FREQUENCY_MHZ;
+    powerConfig.light_sleep_enable = false; // knob interrupts (CHANGE) do not wake from light sleep
+
+    CONSOLE("Power management: ")
+    CONSOLE_CRLF(esp_pm_configure(&powerConfig) == ESP_OK ? "OK" : "NOT SUPPORTED")
+}
+
+// any task, wakes UI loop right away (or makes its next idle return immediately)
+void wakeUiLoop()
+{
+    if(uiTask != NULL)
+    {
+        xTaskNotifyGive(uiTask);
+    }
+}
+
+// knob and switch interrupts, the first edge since UI loop last took it is kept to measure input to response latency
+void IRAM_ATTR wakeUiLoopFromInput()
+{
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+
+    if(!inputPending)
+    {
+        inputTimestampUs = micros();
+        inputPending = true;
+    }
+
+    if(uiTask != NULL)
+    {
+        vTaskNotifyGiveFromISR(uiTask, &higherPriorityTaskWoken);
+        portYIELD_FROM_ISR(higherPriorityTaskWoken);
+    }
+}
+
+// blocks until woken or timeout (next scheduler deadline), every return counts as wake-up
+void idleUiLoop(uint32_t timeoutMs)
+{
+    if(timeoutMs == 0)
+    {
+        return;
+    }
+
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeoutMs));
+    metricIncrement(Metric::UI_WAKEUPS);
+}
+
+// edge coming in right between reading and clearing is lost, one latency sample less
+bool takeInputTimestamp(uint32_t *inputUs)
+{
+    if(!inputPending)
+    {
+        return false;
+    }
+
+    *inputUs = inputTimestampUs;
+    inputPending = false;
+
+    return true;
+}
@@ -14,7 +14,9 @@ const char* monthNames[] = {"Jan",
                             "Nov",
                             "Dec"};
 
-const char* stateString[] = {"NONE", "MAIN", "BRIGHTNESS", "COLOR"};
+const char* dayNames[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+
+const char* stateString[] = {"NONE", "MAIN", "BRIGHTNESS", "COLOR", "FORECAST"};
 const char* CPT_String[] = {"NONE", "COLOR_TEMPERATURE", "COLOR_HUE"};
 const char* wifiSignalString[] = {"NONE", "DISCONNECTED", "BAD", "GOOD", "EXCELLENT"};
 const char* weatherString[] = {"NONE", 
@@ -29,10 +31,25 @@ const char* weatherString[] = {"NONE",
                                 "MIST_DAY", "MIST_NIGHT"    
                             };
 
-const char* NTP_server_domain = "pool.ntp.org";
+const char* NTP_server_domain = NTP_SERVER;
 const IPAddress pingIp(8,8,8,8);
-const char* openWeatherServerUrlformatableCityAndCountryCode = "http://api.openweathermap.org/data/2.5/weather?q=%s,%s&APPID=%s&units=metric";
-const char* openWeatherServerUrlformatableLatLon = "http://api.openweathermap.org/data/2.5/weather?lat=%s&lon=%s&APPID=%s&units=metric";
+const char* openWeatherServerUrlformatableCityAndCountryCode = "http://" OPENWEATHER_SERVER "/data/2.5/weather?q=%s,%s&APPID=%s&units=metric";
+const char* openWeatherServerUrlformatableLatLon = "http://" OPENWEATHER_SERVER "/data/2.5/weather?lat=%s&lon=%s&APPID=%s&units=metric";
+const char* openWeatherForecastUrlformatableCityAndCountryCode = "http://" OPENWEATHER_SERVER "/data/2.5/forecast?q=%s,%s&APPID=%s&units=metric&cnt=40";
+const char* openWeatherForecastUrlformatableLatLon = "http://" OPENWEATHER_SERVER "/data/2.5/forecast?lat=%s&lon=%s&APPID=%s&units=metric&cnt=40";
 
 char defaultSoftAP_ssid[MAX_SOFTAP_SSID_LENGTH] = "";
-char defaultSoftAP_pwd[MAX_SOFTAP_PWD_LENGTH] = "";
\ No newline at end of file
+char defaultSoftAP_pwd[MAX_SOFTAP_PWD_LENGTH] = "";
+// used as checksum of data kept in RTC memory and as hash of weather location
+uint32_t fnv1aHash(const uint8_t *data, size_t length)
+{
+    uint32_t hash = 2166136261UL;
+
+    for(size_t i = 0; i < length; i++)
+    {
+        hash ^= data[i];
+        hash *= 16777619UL;
+    }
+
+    return hash;
+}
@@ -0,0 +1,202 @@
+// core includes
+#include <Arduino.h>
+#include <time.h>
+#include "esp_attr.h"
+
+// project includes
+#include "weather.h"
+#include "console.h"
+#include "conf.h"
+
+// lib includes
+#include <ArduinoJson.h>
+
+struct WeatherCache
+{
+    uint32_t magic;
+    uint32_t locationHash;
+    time_t fetchEpoch;
+    WeatherData weatherData;
+    uint32_t checksum;
+};
+
+/* RTC slow memory is not touched by ESP.restart() (config save, factory reset, ...), only by power-on.
+ * Same goes for system time (RTC timer), which is what makes it possible to tell cache age right after restart.
+ */
+RTC_NOINIT_ATTR WeatherCache weatherCache;
+
+/* Instead of analyzing description parameter of weather, we simply save icon parameter, which
+ * exactly describes what kind of picture shall we use for given weather.
+ * https://openweathermap.org/weather-conditions
+ */
+Weather weatherFromOpenweatherIcon(const char* openweatherIconString)
+{
+    if(strcmp(openweatherIconString, "01d") == 0)
+    {
+        return Weather::CLEAR_SKY_DAY;
+    }
+    else if(strcmp(openweatherIconString, "01n") == 0)
+    {
+        return Weather::CLEAR_SKY_NIGHT;
+    }
+    else if(strcmp(openweatherIconString, "02d") == 0)
+    {
+        return Weather::FEW_CLOUDS_DAY;
+    }
+    else if(strcmp(openweatherIconString, "02n") == 0)
+    {
+        return Weather::FEW_CLOUDS_NIGHT;
+    }
+    else if(strcmp(openweatherIconString, "03d") == 0)
+    {
+        return Weather::SCATTERED_CLOUDS_DAY;
+    }
+    else if(strcmp(openweatherIconString, "03n") == 0)
+    {
+        return Weather::SCATTERED_CLOUDS_NIGHT;
+    }
+    else if(strcmp(openweatherIconString, "04d") == 0)
+    {
+        return Weather::BROKEN_CLOUDS_DAY;
+    }
+    else if(strcmp(openweatherIconString, "04n") == 0)
+    {
+        return Weather::BROKEN_CLOUDS_NIGHT;
+    }
+    else if(strcmp(openweatherIconString, "09d") == 0)
+    {
+        return Weather::SHOWER_RAIN_DAY;
+    }
+    else if(strcmp(openweatherIconString, "09n") == 0)
+    {
+        return Weather::SHOWER_RAIN_NIGHT;
+    }
+    else if(strcmp(openweatherIconString, "10d") == 0)
+    {
+        return Weather::RAIN_DAY;
+    }
+    else if(strcmp(openweatherIconString, "10n") == 0)
+    {
+        return Weather::RAIN_NIGHT;
+    }
+    else if(strcmp(openweatherIconString, "11d") == 0)
+    {
+        return Weather::THUNDERSTORM_DAY;
+    }
+    else if(strcmp(openweatherIconString, "11n") == 0)
+    {
+        return Weather::THUNDERSTORM_NIGHT;
+    }
+    else if(strcmp(openweatherIconString, "13d") == 0)
+    {
+        return Weather::SNOW_DAY;
+    }
+    else if(strcmp(openweatherIconString, "13n") == 0)
+    {
+        return Weather::SNOW_DAY;
+    }
+    else if(strcmp(openweatherIconString, "50d") == 0)
+    {
+        return Weather::MIST_DAY;
+    }
+    else if(strcmp(openweatherIconString, "50n") == 0)
+    {
+        return Weather::MIST_NIGHT;
+    }
+    else
+    {
+        return Weather::NONE;
+    }
+}
+
+/* Parses OpenWeather current weather response directly from stream (no payload buffer).
+ * Filter makes ArduinoJson skip everything except the few values we actually display,
+ * so the document stays tiny no matter how large the response is.
+ */
+bool parseWeatherJson(Stream &stream, WeatherData *weatherData)
+{
+    JsonDocument filter;
+    JsonDocument doc;
+
+    filter["main"]["temp"] = true;
+    filter["main"]["humidity"] = true;
+    filter["wind"]["speed"] = true;
+    filter["weather"][0]["icon"] = true;
+
+    CONSOLE("JSON DESERIALIZATON: ")
+    DeserializationError error = deserializeJson(doc, stream, DeserializationOption::Filter(filter));
+
+    if(error || !doc["main"]["temp"].is<float>() || !doc["weather"][0]["icon"].is<const char*>())
+    {
+        CONSOLE_CRLF("ERROR");
+        return false;
+    }
+    
+    CONSOLE_CRLF("OK");
+
+    weatherData->temperature_C = doc["main"]["temp"].as<float>();
+    weatherData->humidity = doc["main"]["humidity"].as<uint8_t>();
+    weatherData->windSpeed = doc["wind"]["speed"].as<float>();
+    weatherData->weather = weatherFromOpenweatherIcon(doc["weather"][0]["icon"].as<const char*>());
+
+    return true;
+}
+
+// cached weather is only valid for the very same request, location or API key might have been changed
+uint32_t weatherLocationHash(const char *serverURL)
+{
+    return fnv1aHash((const uint8_t*)serverURL, strlen(serverURL));
+}
+
+void saveWeatherCache(const WeatherData *weatherData, uint32_t locationHash)
+{
+    time_t now = time(NULL);
+
+    // without valid datetime cache age could never be evaluated
+    if(now < MIN_VALID_EPOCH)
+    {
+        weatherCache.magic = 0;
+        return;
+    }
+
+    weatherCache.magic = WEATHER_CACHE_MAGIC;
+    weatherCache.locationHash = locationHash;
+    weatherCache.fetchEpoch = now;
+    weatherCache.weatherData = *weatherData;
+    weatherCache.checksum = fnv1aHash((const uint8_t*)&weatherCache, offsetof(WeatherCache, checksum));
+}
+
+bool loadWeatherCache(WeatherData *weatherData, uint32_t locationHash, uint32_t *ageMs)
+{
+    time_t now = time(NULL);
+
+    CONSOLE("WEATHER CACHE: ")
+
+    if(weatherCache.magic != WEATHER_CACHE_MAGIC || weatherCache.checksum != fnv1aHash((const uint8_t*)&weatherCache, offsetof(WeatherCache, checksum)))
+    {
+        CONSOLE_CRLF("EMPTY")
+        return false;
+    }
+
+    if(weatherCache.locationHash != locationHash)
+    {
+        CONSOLE_CRLF("DIFFERENT LOCATION")
+        return false;
+    }
+
+    if(now < MIN_VALID_EPOCH || now < weatherCache.fetchEpoch || (uint32_t)(now - weatherCache.fetchEpoch) > WEATHER_SYNC_TIMEOUT_MS / 1000)
+    {
+        CONSOLE_CRLF("EXPIRED")
+        return false;
+    }
+
+    *weatherData = weatherCache.weatherData;
+    *ageMs = (uint32_t)(now - weatherCache.fetchEpoch) * 1000;
+
+    CONSOLE_CRLF("OK")
+    CONSOLE("  |-- age: ")
+    CONSOLE(*ageMs / 1000)
+    CONSOLE_CRLF(" s")
+
+    return true;
+}
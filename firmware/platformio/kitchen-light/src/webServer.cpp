@@ -0,0 +1,1038 @@
+// core includes
+#include <Arduino.h>
+#include <WiFi.h>
+#include <lwip/sockets.h>
+#include <errno.h>
+#include <stdarg.h>
+
+// project includes
+#include "webServer.h"
+#include "metrics.h"
+#include "console.h"
+#include "conf.h"
+
+// lib includes
+#include <mbedtls/sha1.h>
+#include <mbedtls/base64.h>
+
+const char* webMethodString[] = {"OTHER", "GET", "HEAD", "POST", "PUT"};
+
+enum class WebClientState {FREE, REQUEST_LINE, HEADERS, BODY, SENDING, WEBSOCKET};
+
+// RFC 6455
+#define WEB_SOCKET_GUID "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+#define WEB_SOCKET_MAX_FRAME_HEADER_SIZE 14 // 2 + 8 (64 bit length) + 4 (mask)
+#define WEB_SOCKET_OPCODE_TEXT 0x1
+#define WEB_SOCKET_OPCODE_BINARY 0x2
+#define WEB_SOCKET_OPCODE_CLOSE 0x8
+#define WEB_SOCKET_OPCODE_PING 0x9
+#define WEB_SOCKET_OPCODE_PONG 0xA
+#define WEB_SOCKET_CLOSE_NORMAL 1000
+#define WEB_SOCKET_CLOSE_PROTOCOL_ERROR 1002
+#define WEB_SOCKET_CLOSE_UNSUPPORTED_DATA 1003
+#define WEB_SOCKET_CLOSE_TOO_BIG 1009
+
+// one per connection, request is read and response is sent in pieces, on every handleWebServer() call
+struct WebClient
+{
+    WiFiClient client;
+    WebClientState state;
+    uint32_t timer; // last activity
+    char line[WEB_SERVER_MAX_HEADER_LINE_LENGTH + 1]; // header line, cut, request line is read straight into request target
+    uint16_t lineLength;
+    bool lineOverflow;
+    uint32_t contentLength; // of request body
+    WebRequest request;
+    WebResponse response;
+    char header[WEB_SERVER_MAX_HEADER_SIZE];
+    uint16_t headerLength;
+    uint32_t sent; // of header and body together
+    uint32_t requestTimer; // when request was fully received
+    uint32_t firstByteMs; // request received until first byte of response was accepted by TCP stack
+    WebTemplateCursor templateCursor; // body rendered so far, when response is a template
+    uint8_t frameHeader[WEB_SOCKET_MAX_FRAME_HEADER_SIZE]; // WebSocket frame being received, payload goes to request body
+    uint8_t frameHeaderLength;
+    uint8_t frameHeaderSize; // 0 until first two bytes tell it
+    uint16_t framePayloadLength;
+    uint16_t framePayloadReceived;
+    uint32_t pingTimer;
+    uint8_t pendingFrame[2 + WEB_SOCKET_MAX_SEND_PAYLOAD]; // rest of the last frame socket did not take at once, goes first on next poll
+    uint8_t pendingFrameLength;
+};
+
+/* WiFiClient::write() does not return when socket buffer is full, it waits for room (select() with 1 s timeout, up to 10 times, again after every progress),
+ * so one slow client would hold up whole network task. This takes only what fits into socket buffer right now, 0 when nothing does.
+ */
+class NonBlockingSocket : public Print
+{
+    public:
+        NonBlockingSocket(int fd) : fd(fd) {}
+
+        size_t write(uint8_t c) override
+        {
+            return write(&c, 1);
+        }
+
+        size_t write(const uint8_t *data, size_t length) override
+        {
+            if(failed)
+            {
+                return 0;
+            }
+
+            ssize_t written = send(fd, data, length, MSG_DONTWAIT);
+
+            if(written < 0)
+            {
+                failed = (errno != EAGAIN && errno != EWOULDBLOCK);
+                return 0;
+            }
+
+            return written;
+        }
+
+        bool failed = false; // connection is broken, not just full
+
+    private:
+        int fd;
+};
+
+WiFiServer webServer(WIFI_SERVER_PORT);
+WebClient webClients[WEB_SERVER_MAX_CLIENTS];
+WebRequestHandler requestHandler = nullptr;
+WebSocketHandler webSocketHandler = nullptr;
+uint32_t allocatedBodyBytes = 0; // of all responses being sent, WEB_SERVER_MAX_ALLOCATED_BODY_SIZE at most
+
+const char* webStatusText(uint16_t status)
+{
+    switch(status)
+    {
+        case 101: return "Switching Protocols";
+        case 200: return "OK";
+        case 204: return "No Content";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 413: return "Payload Too Large";
+        case 414: return "URI Too Long";
+        case 426: return "Upgrade Required";
+        case 500: return "Internal Server Error";
+        case 503: return "Service Unavailable";
+        default: return "";
+    }
+}
+
+void webRespond(WebResponse *response, uint16_t status, const char *contentType, const char *body)
+{
+    response->status = status;
+    response->contentType = contentType;
+    response->contentEncoding = NULL;
+    response->etag = NULL;
+    response->body = body;
+    response->bodyLength = strlen(body);
+    response->templateValueCount = 0;
+}
+
+void webRespondFormatted(WebResponse *response, uint16_t status, const char *contentType, const char *format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    int length = vsnprintf(response->buffer, sizeof(response->buffer), format, args);
+    va_end(args);
+
+    if(length < 0 || length >= (int)sizeof(response->buffer))
+    {
+        CONSOLE_CRLF("SERVER: RESPONSE OVERFLOW")
+        webRespond(response, 500, "text/plain", "");
+        return;
+    }
+
+    response->status = status;
+    response->contentType = contentType;
+    response->contentEncoding = NULL;
+    response->etag = NULL;
+    response->body = response->buffer;
+    response->bodyLength = length;
+    response->templateValueCount = 0;
+}
+
+/* Buffer for a large generated body (metrics, trace), for this response only, so overlapping requests never overwrite body still being sent.
+ * It is on heap only until response is done (sent or connection closed), then server frees it.
+ * NULL when responses being sent hold too much already or heap has no such block, handler answers 503 then.
+ */
+char* webAllocateBody(WebResponse *response, uint32_t size)
+{
+    if(response->allocatedBody != NULL || allocatedBodyBytes + size > WEB_SERVER_MAX_ALLOCATED_BODY_SIZE)
+    {
+        return NULL;
+    }
+
+    response->allocatedBody = (char*)malloc(size);
+
+    if(response->allocatedBody == NULL)
+    {
+        return NULL;
+    }
+
+    response->allocatedBodySize = size;
+    allocatedBodyBytes += size;
+
+    return response->allocatedBody;
+}
+
+void freeAllocatedBody(WebResponse *response)
+{
+    if(response->allocatedBody == NULL)
+    {
+        return;
+    }
+
+    free(response->allocatedBody);
+    allocatedBodyBytes -= response->allocatedBodySize;
+    response->allocatedBody = NULL;
+    response->allocatedBodySize = 0;
+}
+
+// constant body (in flash), answers 304 without body when browser already has the same version
+void webRespondStatic(const WebRequest *request, WebResponse *response, const char *contentType, const char *contentEncoding, const uint8_t *body, uint32_t bodyLength, const char *etag)
+{
+    response->status = 200;
+    response->contentType = contentType;
+    response->contentEncoding = contentEncoding;
+    response->etag = etag;
+    response->body = (const char*)body;
+    response->bodyLength = bodyLength;
+    response->templateValueCount = 0;
+
+    if(etag != NULL && (strstr(request->ifNoneMatch, etag) != NULL || strcmp(request->ifNoneMatch, "*") == 0))
+    {
+        response->status = 304;
+        response->bodyLength = 0;
+    }
+}
+
+/* Page with values (HTML escaped) in place of "{{name}}", values are pointers, so they have to stay valid until response is sent.
+ * Template is only measured here, it is rendered piece by piece as socket takes it, without any buffer.
+ */
+void webRespondTemplate(WebResponse *response, uint16_t status, const char *contentType, const char *text, const WebTemplateValue *values, uint8_t valueCount)
+{
+    if(valueCount > WEB_TEMPLATE_MAX_VALUES)
+    {
+        CONSOLE_CRLF("SERVER: TOO MANY TEMPLATE VALUES")
+        webRespond(response, 500, "text/plain", "");
+        return;
+    }
+
+    webRespond(response, status, contentType, text);
+    memcpy(response->templateValues, values, valueCount * sizeof(WebTemplateValue));
+    response->templateValueCount = valueCount;
+    response->bodyLength = webTemplateLength(text, values, valueCount);
+}
+
+// answers WebSocket handshake (101), connection then stays open as WebSocket instead of being closed after response
+void webAcceptWebSocket(const WebRequest *request, WebResponse *response)
+{
+    if(webSocketHandler == nullptr || request->method != WebMethod::GET || !request->webSocketUpgrade || strlen(request->webSocketKey) != WEB_SOCKET_KEY_LENGTH)
+    {
+        webRespond(response, 400, "text/plain", "");
+        return;
+    }
+
+    webRespond(response, 101, "", "");
+}
+
+// Sec-WebSocket-Accept = base64(sha1(key + GUID)), 28 characters
+void webSocketAcceptValue(const char *key, char *accept, size_t size)
+{
+    char keyWithGuid[WEB_SOCKET_KEY_LENGTH + sizeof(WEB_SOCKET_GUID)];
+    uint8_t hash[20];
+    size_t length = 0;
+
+    snprintf(keyWithGuid, sizeof(keyWithGuid), "%s%s", key, WEB_SOCKET_GUID);
+    mbedtls_sha1((const unsigned char*)keyWithGuid, strlen(keyWithGuid), hash);
+    mbedtls_base64_encode((unsigned char*)accept, size, &length, hash, sizeof(hash));
+    accept[min(length, size - 1)] = '\0';
+}
+
+void closeWebClient(WebClient *webClient)
+{
+    if(webClient->state == WebClientState::WEBSOCKET && webSocketHandler != nullptr)
+    {
+        webSocketHandler(WebSocketEvent::CLOSE, webClient - webClients, NULL, 0);
+    }
+
+    webClient->client.stop();
+    webClient->state = WebClientState::FREE;
+    freeAllocatedBody(&webClient->response);
+}
+
+// false when it does not fit, header is then not complete
+bool appendHeader(WebClient *webClient, const char *format, ...)
+{
+    size_t size = sizeof(webClient->header) - webClient->headerLength;
+    va_list args;
+
+    va_start(args, format);
+    int length = vsnprintf(webClient->header + webClient->headerLength, size, format, args);
+    va_end(args);
+
+    if(length < 0 || length >= (int)size)
+    {
+        return false;
+    }
+
+    webClient->headerLength += length;
+
+    return true;
+}
+
+bool formatResponseHeader(WebClient *webClient)
+{
+    WebResponse *response = &webClient->response;
+
+    webClient->headerLength = 0;
+
+    if(!appendHeader(webClient, "HTTP/1.1 %u %s\r\n", response->status, webStatusText(response->status)))
+    {
+        return false;
+    }
+
+    // handshake, connection stays open (as WebSocket) after it, so no body and no close
+    if(response->status == 101)
+    {
+        char accept[32];
+
+        webSocketAcceptValue(webClient->request.webSocketKey, accept, sizeof(accept));
+        response->bodyLength = 0;
+
+        return appendHeader(webClient, "Upgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: %s\r\n\r\n", accept);
+    }
+
+    // 304 has no body, its headers describe the cached copy, which browser already has
+    if(response->status != 304 && !appendHeader(webClient, "Content-Type: %s\r\nContent-Length: %lu\r\n", response->contentType, (unsigned long)response->bodyLength))
+    {
+        return false;
+    }
+
+    if(response->contentEncoding != NULL && !appendHeader(webClient, "Content-Encoding: %s\r\n", response->contentEncoding))
+    {
+        return false;
+    }
+
+    // browser has to ask every time, but gets only 304 when nothing changed
+    if(response->etag != NULL && !appendHeader(webClient, "ETag: %s\r\nCache-Control: no-cache\r\n", response->etag))
+    {
+        return false;
+    }
+
+    return appendHeader(webClient, "Connection: close\r\n\r\n");
+}
+
+// status line and headers are formatted here, body is whatever handler left in response
+void startResponse(WebClient *webClient)
+{
+    WebResponse *response = &webClient->response;
+
+    // truncated header would be sent as if it was whole, 500 of plain text always fits
+    if(!formatResponseHeader(webClient))
+    {
+        CONSOLE_CRLF("SERVER: RESPONSE HEADER OVERFLOW")
+        webRespond(response, 500, "text/plain", "");
+        formatResponseHeader(webClient);
+    }
+
+    if(webClient->request.method == WebMethod::HEAD)
+    {
+        response->bodyLength = 0;
+    }
+
+    webTemplateBegin(&webClient->templateCursor, response->body);
+    webClient->sent = 0;
+    webClient->firstByteMs = 0;
+    webClient->state = WebClientState::SENDING;
+}
+
+void respondWithError(WebClient *webClient, uint16_t status)
+{
+    webClient->requestTimer = millis();
+    webRespond(&webClient->response, status, "text/plain", "");
+    startResponse(webClient);
+
+    CONSOLE("SERVER: BAD REQUEST ")
+    CONSOLE_CRLF(status)
+}
+
+// request line was read into target, target is moved to its start
+bool parseRequestLine(WebRequest *request)
+{
+    char *line = request->target;
+    char *target = strchr(line, ' ');
+    char *version;
+
+    if(target == NULL)
+    {
+        return false;
+    }
+
+    *target++ = '\0';
+    version = strchr(target, ' ');
+
+    if(version == NULL || strncmp(version + 1, "HTTP/", 5) != 0)
+    {
+        return false;
+    }
+
+    *version = '\0';
+
+    if(strlen(target) > WEB_SERVER_MAX_TARGET_LENGTH)
+    {
+        return false;
+    }
+
+    if(strcmp(line, "GET") == 0)
+    {
+        request->method = WebMethod::GET;
+    }
+    else if(strcmp(line, "HEAD") == 0)
+    {
+        request->method = WebMethod::HEAD;
+    }
+    else if(strcmp(line, "POST") == 0)
+    {
+        request->method = WebMethod::POST;
+    }
+    else if(strcmp(line, "PUT") == 0)
+    {
+        request->method = WebMethod::PUT;
+    }
+    else
+    {
+        request->method = WebMethod::OTHER;
+    }
+
+    memmove(request->target, target, strlen(target) + 1);
+    request->ifNoneMatch[0] = '\0';
+    request->body[0] = '\0';
+    request->bodyLength = 0;
+    request->webSocketUpgrade = false;
+    request->webSocketKey[0] = '\0';
+
+    return true;
+}
+
+void dispatchRequest(WebClient *webClient)
+{
+    webClient->requestTimer = millis();
+    metricIncrement(Metric::WEB_REQUESTS);
+
+    CONSOLE("SERVER: ")
+    CONSOLE(webMethodString[(uint8_t)webClient->request.method])
+    CONSOLE(" ")
+    CONSOLE_CRLF(webClient->request.target)
+
+    webRespond(&webClient->response, 200, "text/html", "");
+    requestHandler(&webClient->request, &webClient->response);
+    startResponse(webClient);
+}
+
+void processLine(WebClient *webClient)
+{
+    if(webClient->state == WebClientState::REQUEST_LINE)
+    {
+        // empty lines before request line are allowed (RFC 9112, 2.2)
+        if(webClient->lineLength == 0 && !webClient->lineOverflow)
+        {
+            return;
+        }
+
+        if(webClient->lineOverflow)
+        {
+            respondWithError(webClient, 414);
+            return;
+        }
+
+        if(!parseRequestLine(&webClient->request))
+        {
+            respondWithError(webClient, 400);
+            return;
+        }
+
+        webClient->contentLength = 0;
+        webClient->state = WebClientState::HEADERS;
+    }
+    else if(webClient->state == WebClientState::HEADERS && webClient->lineLength > 0)
+    {
+        // only headers we need
+        if(strncasecmp(webClient->line, "Content-Length:", 15) == 0)
+        {
+            webClient->contentLength = strtoul(webClient->line + 15, NULL, 10);
+        }
+        else if(strncasecmp(webClient->line, "If-None-Match:", 14) == 0)
+        {
+            const char *value = webClient->line + 14;
+
+            while(*value == ' ')
+            {
+                value++;
+            }
+
+            strncpy(webClient->request.ifNoneMatch, value, WEB_SERVER_MAX_ETAG_LENGTH);
+            webClient->request.ifNoneMatch[WEB_SERVER_MAX_ETAG_LENGTH] = '\0';
+        }
+        else if(strncasecmp(webClient->line, "Upgrade:", 8) == 0)
+        {
+            const char *value = webClient->line + 8;
+
+            while(*value == ' ')
+            {
+                value++;
+            }
+
+            webClient->request.webSocketUpgrade = (strncasecmp(value, "websocket", 9) == 0);
+        }
+        else if(strncasecmp(webClient->line, "Sec-WebSocket-Key:", 18) == 0)
+        {
+            const char *value = webClient->line + 18;
+            size_t length;
+
+            while(*value == ' ')
+            {
+                value++;
+            }
+
+            length = strcspn(value, " ");
+
+            // anything else than 24 characters is refused by webAcceptWebSocket()
+            if(length <= WEB_SOCKET_KEY_LENGTH)
+            {
+                memcpy(webClient->request.webSocketKey, value, length);
+                webClient->request.webSocketKey[length] = '\0';
+            }
+        }
+    }
+    else if(webClient->state == WebClientState::HEADERS)
+    {
+        // end of headers, body (if any) is read whole before handler is called
+        if(webClient->contentLength > WEB_SERVER_MAX_REQUEST_BODY_SIZE)
+        {
+            respondWithError(webClient, 413);
+        }
+        else if(webClient->contentLength > 0)
+        {
+            webClient->state = WebClientState::BODY;
+        }
+        else
+        {
+            dispatchRequest(webClient);
+        }
+    }
+}
+
+// bounded amount per call, so one fast client cannot keep network task busy
+void readRequest(WebClient *webClient)
+{
+    uint16_t budget = WEB_SERVER_MAX_READ_PER_POLL;
+
+    while(budget-- > 0 && (webClient->state == WebClientState::REQUEST_LINE || webClient->state == WebClientState::HEADERS || webClient->state == WebClientState::BODY))
+    {
+        int c = webClient->client.read();
+
+        if(c < 0)
+        {
+            break;
+        }
+
+        webClient->timer = millis();
+
+        // request line goes straight to request target (handler gets it in place), header lines to a short buffer
+        bool requestLine = (webClient->state == WebClientState::REQUEST_LINE);
+        char *line = requestLine ? webClient->request.target : webClient->line;
+        size_t lineSize = requestLine ? sizeof(webClient->request.target) : sizeof(webClient->line);
+
+        if(webClient->state == WebClientState::BODY)
+        {
+            WebRequest *request = &webClient->request;
+
+            request->body[request->bodyLength++] = (char)c;
+
+            if(request->bodyLength == webClient->contentLength)
+            {
+                request->body[request->bodyLength] = '\0';
+                dispatchRequest(webClient);
+            }
+        }
+        else if(c == '\n')
+        {
+            line[webClient->lineLength] = '\0';
+            processLine(webClient);
+            webClient->lineLength = 0;
+            webClient->lineOverflow = false;
+        }
+        else if(c != '\r')
+        {
+            if(webClient->lineLength < lineSize - 1)
+            {
+                line[webClient->lineLength++] = (char)c;
+            }
+            else
+            {
+                webClient->lineOverflow = true;
+            }
+        }
+    }
+}
+
+// rest of a frame socket took only partly, false when client was closed (connection broken)
+bool flushWebSocketFrame(WebClient *webClient)
+{
+    NonBlockingSocket socket(webClient->client.fd());
+    size_t written;
+
+    if(webClient->pendingFrameLength == 0)
+    {
+        return true;
+    }
+
+    written = socket.write(webClient->pendingFrame, webClient->pendingFrameLength);
+
+    if(socket.failed)
+    {
+        CONSOLE("SERVER: WEBSOCKET #")
+        CONSOLE(webClient - webClients)
+        CONSOLE_CRLF(" SEND FAILED")
+
+        closeWebClient(webClient);
+        return false;
+    }
+
+    webClient->pendingFrameLength -= written;
+    memmove(webClient->pendingFrame, webClient->pendingFrame + written, webClient->pendingFrameLength);
+
+    return true;
+}
+
+/* Never waits. Header and payload go to socket in one send(), so frame is never split between a queued part and a refused one,
+ * what socket takes only partly waits in pendingFrame. Client which has not taken even that by the next frame, or whose socket
+ * buffer is full (EAGAIN, kilobytes of frames behind), is closed, so one stalled client never holds up broadcast to others.
+ */
+bool sendWebSocketFrame(WebClient *webClient, uint8_t opcode, const uint8_t *data, uint16_t length)
+{
+    uint8_t frame[sizeof(webClient->pendingFrame)];
+    uint8_t frameLength = 2 + length;
+    size_t written;
+
+    if(length > WEB_SOCKET_MAX_SEND_PAYLOAD)
+    {
+        CONSOLE_CRLF("SERVER: WEBSOCKET FRAME TOO BIG")
+        return false;
+    }
+
+    if(!flushWebSocketFrame(webClient))
+    {
+        return false;
+    }
+
+    frame[0] = 0x80 | opcode; // FIN, server frames are never masked
+    frame[1] = length;
+
+    if(length > 0)
+    {
+        memcpy(frame + 2, data, length);
+    }
+
+    NonBlockingSocket socket(webClient->client.fd());
+
+    written = (webClient->pendingFrameLength == 0) ? socket.write(frame, frameLength) : 0;
+
+    if(written == 0)
+    {
+        CONSOLE("SERVER: WEBSOCKET #")
+        CONSOLE(webClient - webClients)
+        CONSOLE_CRLF(socket.failed ? " SEND FAILED" : " TOO SLOW")
+
+        closeWebClient(webClient);
+        return false;
+    }
+
+    webClient->pendingFrameLength = frameLength - written;
+    memcpy(webClient->pendingFrame, frame + written, webClient->pendingFrameLength);
+
+    return true;
+}
+
+void closeWebSocket(WebClient *webClient, uint16_t code)
+{
+    uint8_t payload[2] = {(uint8_t)(code >> 8), (uint8_t)(code & 0xFF)};
+
+    CONSOLE("SERVER: WEBSOCKET #")
+    CONSOLE(webClient - webClients)
+    CONSOLE(" CLOSE ")
+    CONSOLE_CRLF(code)
+
+    // best effort, connection is closed right after anyway
+    if(sendWebSocketFrame(webClient, WEB_SOCKET_OPCODE_CLOSE, payload, sizeof(payload)))
+    {
+        closeWebClient(webClient);
+    }
+}
+
+void openWebSocket(WebClient *webClient)
+{
+    webClient->state = WebClientState::WEBSOCKET;
+    webClient->frameHeaderLength = 0;
+    webClient->frameHeaderSize = 0;
+    webClient->pingTimer = millis();
+    webClient->pendingFrameLength = 0;
+
+    CONSOLE("SERVER: WEBSOCKET #")
+    CONSOLE(webClient - webClients)
+    CONSOLE_CRLF(" OPEN")
+
+    webSocketHandler(WebSocketEvent::OPEN, webClient - webClients, NULL, 0);
+}
+
+// whole frame header is in, false when frame is refused (connection is being closed then)
+bool startWebSocketFrame(WebClient *webClient)
+{
+    const uint8_t *header = webClient->frameHeader;
+    uint8_t opcode = header[0] & 0x0F;
+    uint32_t length = header[1] & 0x7F;
+
+    if(length == 126)
+    {
+        length = (header[2] << 8) | header[3];
+    }
+    else if(length == 127)
+    {
+        // 64 bit length, anything above 16 bit is too big anyway
+        length = (header[2] | header[3] | header[4] | header[5] | header[6] | header[7]) ? UINT32_MAX : ((header[8] << 8) | header[9]);
+    }
+
+    // client frames have to be masked (RFC 6455, 5.1)
+    if((header[1] & 0x80) == 0)
+    {
+        closeWebSocket(webClient, WEB_SOCKET_CLOSE_PROTOCOL_ERROR);
+        return false;
+    }
+
+    // messages are small, fragmentation and text are not used by the protocol on top
+    if((header[0] & 0x80) == 0 || opcode == 0x0 || opcode == WEB_SOCKET_OPCODE_TEXT)
+    {
+        closeWebSocket(webClient, WEB_SOCKET_CLOSE_UNSUPPORTED_DATA);
+        return false;
+    }
+
+    // control frames are at most 125 B (RFC 6455, 5.5), pong echoes ping payload back
+    if(length > WEB_SERVER_MAX_REQUEST_BODY_SIZE || ((opcode & 0x8) != 0 && length > WEB_SOCKET_MAX_SEND_PAYLOAD))
+    {
+        closeWebSocket(webClient, WEB_SOCKET_CLOSE_TOO_BIG);
+        return false;
+    }
+
+    webClient->framePayloadLength = length;
+    webClient->framePayloadReceived = 0;
+
+    return true;
+}
+
+void completeWebSocketFrame(WebClient *webClient)
+{
+    uint8_t opcode = webClient->frameHeader[0] & 0x0F;
+    const uint8_t *payload = (const uint8_t*)webClient->request.body;
+    uint16_t length = webClient->framePayloadLength;
+
+    webClient->frameHeaderLength = 0;
+    webClient->frameHeaderSize = 0;
+
+    switch(opcode)
+    {
+        case WEB_SOCKET_OPCODE_BINARY:
+            webSocketHandler(WebSocketEvent::MESSAGE, webClient - webClients, payload, length);
+            break;
+        case WEB_SOCKET_OPCODE_PING:
+            sendWebSocketFrame(webClient, WEB_SOCKET_OPCODE_PONG, payload, length);
+            break;
+        case WEB_SOCKET_OPCODE_CLOSE:
+            closeWebSocket(webClient, WEB_SOCKET_CLOSE_NORMAL);
+            break;
+        default: // pong, only refreshes activity timer
+            break;
+    }
+}
+
+// frame header, then payload (unmasked into request body), bounded amount per call same as HTTP request
+void readWebSocket(WebClient *webClient)
+{
+    uint16_t budget = WEB_SERVER_MAX_READ_PER_POLL;
+
+    while(budget-- > 0 && webClient->state == WebClientState::WEBSOCKET)
+    {
+        int c = webClient->client.read();
+
+        if(c < 0)
+        {
+            break;
+        }
+
+        webClient->timer = millis();
+
+        if(webClient->frameHeaderSize == 0 || webClient->frameHeaderLength < webClient->frameHeaderSize)
+        {
+            webClient->frameHeader[webClient->frameHeaderLength++] = (uint8_t)c;
+
+            if(webClient->frameHeaderLength == 2)
+            {
+                uint8_t length = webClient->frameHeader[1] & 0x7F;
+
+                webClient->frameHeaderSize = 2 + ((length == 126) ? 2 : (length == 127) ? 8 : 0) + ((webClient->frameHeader[1] & 0x80) ? 4 : 0);
+            }
+
+            if(webClient->frameHeaderLength == webClient->frameHeaderSize && startWebSocketFrame(webClient) && webClient->framePayloadLength == 0)
+            {
+                completeWebSocketFrame(webClient);
+            }
+        }
+        else
+        {
+            const uint8_t *mask = webClient->frameHeader + webClient->frameHeaderSize - 4;
+
+            webClient->request.body[webClient->framePayloadReceived] = (char)(c ^ mask[webClient->framePayloadReceived % 4]);
+            webClient->framePayloadReceived++;
+
+            if(webClient->framePayloadReceived == webClient->framePayloadLength)
+            {
+                completeWebSocketFrame(webClient);
+            }
+        }
+    }
+}
+
+bool webSocketSend(uint8_t client, const uint8_t *data, uint16_t length)
+{
+    if(client >= WEB_SERVER_MAX_CLIENTS || webClients[client].state != WebClientState::WEBSOCKET)
+    {
+        return false;
+    }
+
+    return sendWebSocketFrame(&webClients[client], WEB_SOCKET_OPCODE_BINARY, data, length);
+}
+
+// returns number of clients it was sent to
+uint8_t webSocketBroadcast(const uint8_t *data, uint16_t length)
+{
+    uint8_t count = 0;
+
+    for(uint8_t i = 0; i < WEB_SERVER_MAX_CLIENTS; i++)
+    {
+        if(webSocketSend(i, data, length))
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+void sendResponse(WebClient *webClient)
+{
+    uint32_t total = webClient->headerLength + webClient->response.bodyLength;
+    uint32_t budget = WEB_SERVER_MAX_WRITE_PER_POLL;
+    NonBlockingSocket socket(webClient->client.fd());
+
+    while(webClient->sent < total && budget > 0)
+    {
+        uint32_t length = min(min(budget, (uint32_t)WEB_SERVER_WRITE_CHUNK_SIZE), total - webClient->sent);
+        size_t written;
+
+        if(webClient->sent < webClient->headerLength)
+        {
+            length = min(length, webClient->headerLength - webClient->sent);
+            written = socket.write((const uint8_t*)webClient->header + webClient->sent, length);
+        }
+        else if(webClient->response.templateValueCount > 0)
+        {
+            // rendered straight to the socket, cursor remembers where it stopped
+            written = webTemplateWrite(&webClient->templateCursor, webClient->response.templateValues, webClient->response.templateValueCount, &socket, length);
+        }
+        else
+        {
+            // written straight from where body is (flash for constant pages), TCP stack copies it into segments
+            written = socket.write((const uint8_t*)webClient->response.body + webClient->sent - webClient->headerLength, length);
+        }
+
+        if(webClient->sent == 0 && written > 0)
+        {
+            webClient->firstByteMs = millis() - webClient->requestTimer;
+        }
+
+        if(written > 0)
+        {
+            webClient->timer = millis();
+        }
+
+        // socket may take only part of it, counted is what it took
+        webClient->sent += written;
+        budget -= min((uint32_t)written, budget);
+
+        if(written < length)
+        {
+            break; // socket buffer full, rest goes next time
+        }
+    }
+
+    if(socket.failed)
+    {
+        CONSOLE("SERVER: CLIENT #")
+        CONSOLE(webClient - webClients)
+        CONSOLE_CRLF(" SEND FAILED")
+
+        closeWebClient(webClient);
+        return;
+    }
+
+    if(webClient->sent >= total)
+    {
+        LOG_INFO("SERVER: RESPONSE %lu", webClient->response.status)
+        LOG_INFO("  |-- sent: %lu B", total)
+        LOG_INFO("  |-- first byte: %lu ms", webClient->firstByteMs)
+        LOG_INFO("  |-- total: %lu ms", millis() - webClient->requestTimer)
+
+        if(webClient->response.status == 101)
+        {
+            openWebSocket(webClient);
+        }
+        else
+        {
+            closeWebClient(webClient);
+        }
+    }
+}
+
+void acceptWebClients()
+{
+    for(uint8_t i = 0; i < WEB_SERVER_MAX_CLIENTS; i++)
+    {
+        WebClient *webClient = &webClients[i];
+
+        if(webClient->state != WebClientState::FREE)
+        {
+            continue;
+        }
+
+        // when all slots are taken, new connections wait in TCP backlog
+        WiFiClient client = webServer.available();
+
+        if(!client)
+        {
+            return;
+        }
+
+        webClient->client = client;
+        webClient->state = WebClientState::REQUEST_LINE;
+        webClient->timer = millis();
+        webClient->lineLength = 0;
+        webClient->lineOverflow = false;
+
+        CONSOLE("SERVER: NEW CLIENT #")
+        CONSOLE_CRLF(i)
+    }
+}
+
+// handlers are called from handleWebServer(), so in network task
+void beginWebServer(WebRequestHandler handler, WebSocketHandler socketHandler)
+{
+    requestHandler = handler;
+    webSocketHandler = socketHandler;
+
+    for(uint8_t i = 0; i < WEB_SERVER_MAX_CLIENTS; i++)
+    {
+        webClients[i].state = WebClientState::FREE;
+    }
+
+    webServer.begin();
+    webServer.setNoDelay(true);
+}
+
+// no connection open (WebSocket included), only new ones may come
+bool webServerIdle()
+{
+    for(uint8_t i = 0; i < WEB_SERVER_MAX_CLIENTS; i++)
+    {
+        if(webClients[i].state != WebClientState::FREE)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Never waits, has to be called periodically (network task loop).
+ * Every connection is a small state machine (request line -> headers -> sending response), so slow or idle client does not hold up others.
+ */
+void handleWebServer()
+{
+    acceptWebClients();
+
+    for(uint8_t i = 0; i < WEB_SERVER_MAX_CLIENTS; i++)
+    {
+        WebClient *webClient = &webClients[i];
+
+        if(webClient->state == WebClientState::FREE)
+        {
+            continue;
+        }
+
+        if(webClient->state == WebClientState::SENDING)
+        {
+            sendResponse(webClient);
+        }
+        else if(webClient->state == WebClientState::WEBSOCKET)
+        {
+            if(flushWebSocketFrame(webClient))
+            {
+                readWebSocket(webClient);
+            }
+
+            // nothing from client for a while, ping makes it answer (or dead connection fail on write)
+            if(webClient->state == WebClientState::WEBSOCKET && millis() - webClient->pingTimer > WEB_SOCKET_PING_INTERVAL_MS && millis() - webClient->timer > WEB_SOCKET_PING_INTERVAL_MS)
+            {
+                webClient->pingTimer = millis();
+                sendWebSocketFrame(webClient, WEB_SOCKET_OPCODE_PING, NULL, 0);
+            }
+        }
+        else
+        {
+            readRequest(webClient); // request line, headers and body
+
+            if(webClient->state == WebClientState::SENDING)
+            {
+                sendResponse(webClient);
+            }
+        }
+
+        if(webClient->state == WebClientState::FREE)
+        {
+            continue;
+        }
+
+        if(!webClient->client.connected() && webClient->client.available() == 0)
+        {
+            CONSOLE("SERVER: CLIENT #")
+            CONSOLE(i)
+            CONSOLE_CRLF(" DISCONNECTED")
+
+            closeWebClient(webClient);
+        }
+        else if(millis() - webClient->timer > ((webClient->state == WebClientState::WEBSOCKET) ? WEB_SOCKET_TIMEOUT_MS : SERVER_CLIENT_TIMEOUT_MS))
+        {
+            CONSOLE("SERVER: CLIENT #")
+            CONSOLE(i)
+            CONSOLE_CRLF(" TIMEOUT")
+
+            closeWebClient(webClient);
+        }
+    }
+}
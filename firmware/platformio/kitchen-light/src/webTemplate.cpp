@@ -0,0 +1,191 @@
+// core includes
+#include <string.h>
+
+// project includes
+#include "webTemplate.h"
+
+/* Nothing is rendered into memory: literal parts are written straight from template (flash)
+ * and values straight from where they are, escaped characters as constant entities.
+ * Length is known in advance (webTemplateLength()), so response still has Content-Length.
+ */
+
+#define WEB_TEMPLATE_ESCAPED_CHARACTERS "&<>\"'"
+
+const char* htmlEntity(char c)
+{
+    switch(c)
+    {
+        case '&': return "&amp;";
+        case '<': return "&lt;";
+        case '>': return "&gt;";
+        case '"': return "&quot;";
+        case '\'': return "&#39;";
+        default: return NULL;
+    }
+}
+
+// value of "{{name}}" at position (empty for unknown name) and end right after it, NULL when there is no placeholder at position
+const char* matchPlaceholder(const char *position, const WebTemplateValue *values, uint8_t valueCount, const char **end)
+{
+    if(position[0] != '{' || position[1] != '{')
+    {
+        return NULL;
+    }
+
+    const char *name = position + 2;
+    const char *close = strstr(name, "}}");
+
+    if(close == NULL)
+    {
+        return NULL;
+    }
+
+    *end = close + 2;
+
+    for(uint8_t i = 0; i < valueCount; i++)
+    {
+        if(strncmp(values[i].name, name, close - name) == 0 && values[i].name[close - name] == '\0')
+        {
+            return (values[i].value != NULL) ? values[i].value : "";
+        }
+    }
+
+    return "";
+}
+
+// literal part up to next placeholder (at least one character, so "{{" which is not a placeholder is written as text)
+size_t literalLength(const char *position)
+{
+    const char *next = strstr(position + 1, "{{");
+
+    return (next != NULL) ? (size_t)(next - position) : strlen(position);
+}
+
+uint32_t webTemplateLength(const char *text, const WebTemplateValue *values, uint8_t valueCount)
+{
+    const char *position = text;
+    uint32_t length = 0;
+
+    while(*position != '\0')
+    {
+        const char *end;
+        const char *value = matchPlaceholder(position, values, valueCount, &end);
+
+        if(value != NULL)
+        {
+            for(; *value != '\0'; value++)
+            {
+                const char *entity = htmlEntity(*value);
+
+                length += (entity != NULL) ? strlen(entity) : 1;
+            }
+
+            position = end;
+        }
+        else
+        {
+            size_t literal = literalLength(position);
+
+            length += literal;
+            position += literal;
+        }
+    }
+
+    return length;
+}
+
+void webTemplateBegin(WebTemplateCursor *cursor, const char *text)
+{
+    cursor->position = text;
+    cursor->value = NULL;
+    cursor->entityOffset = 0;
+}
+
+/* Writes at most maxLength, in as few writes as template allows (whole literal parts, whole runs of value without escaping).
+ * Returns number of bytes written, less than maxLength when template is done or output did not take more (socket buffer full).
+ */
+size_t webTemplateWrite(WebTemplateCursor *cursor, const WebTemplateValue *values, uint8_t valueCount, Print *out, size_t maxLength)
+{
+    size_t total = 0;
+
+    while(total < maxLength)
+    {
+        const char *data;
+        const char *entity = NULL;
+        size_t length;
+
+        if(cursor->value != NULL)
+        {
+            if(*cursor->value == '\0')
+            {
+                cursor->value = NULL;
+                continue;
+            }
+
+            entity = htmlEntity(*cursor->value);
+
+            if(entity != NULL)
+            {
+                data = entity + cursor->entityOffset;
+                length = strlen(data);
+            }
+            else
+            {
+                data = cursor->value;
+                length = strcspn(data, WEB_TEMPLATE_ESCAPED_CHARACTERS);
+            }
+        }
+        else
+        {
+            const char *end;
+
+            if(*cursor->position == '\0')
+            {
+                break;
+            }
+
+            const char *value = matchPlaceholder(cursor->position, values, valueCount, &end);
+
+            if(value != NULL)
+            {
+                cursor->value = value;
+                cursor->position = end;
+                cursor->entityOffset = 0;
+                continue;
+            }
+
+            data = cursor->position;
+            length = literalLength(data);
+        }
+
+        size_t written = out->write((const uint8_t*)data, (length < maxLength - total) ? length : maxLength - total);
+
+        if(written == 0)
+        {
+            break;
+        }
+
+        total += written;
+
+        if(entity != NULL)
+        {
+            cursor->entityOffset += written;
+
+            if(entity[cursor->entityOffset] == '\0')
+            {
+                cursor->value++;
+                cursor->entityOffset = 0;
+            }
+        }
+        else if(cursor->value != NULL)
+        {
+            cursor->value += written;
+        }
+        else
+        {
+            cursor->position += written;
+        }
+    }
+
+    return total;
+}
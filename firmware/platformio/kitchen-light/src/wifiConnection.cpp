@@ -0,0 +1,199 @@
+// core includes
+#include <Arduino.h>
+#include <WiFi.h>
+
+// project includes
+#include "wifiConnection.h"
+#include "console.h"
+#include "conf.h"
+
+const char* wifiConnectionStateString[] = {"NONE", "NO_CREDENTIALS", "CONNECTING", "CONNECTED", "WAITING_FOR_RETRY", "FAILED"};
+
+const char *connectionSsid = nullptr;
+const char *connectionPwd = nullptr;
+const WifiConnectionDriver *connectionDriver = nullptr;
+WifiConnectionStateCallback connectionStateCallback = nullptr;
+WifiConnectionState connectionState = WifiConnectionState::NONE;
+uint32_t connectionStateTimer = 0;
+uint32_t connectionBeginTimer = 0;
+uint32_t reconnectBackoffMs = WIFI_RECONNECT_BACKOFF_MIN_MS;
+bool connectedOnce = false;
+QueueHandle_t wifiEventQueue = NULL;
+
+void arduinoWifiBegin(const char *ssid, const char *pwd)
+{
+    WiFi.begin(ssid, pwd);
+    WiFi.setSleep(WIFI_PS_MIN_MODEM); // radio sleeps between beacons, association is kept
+}
+
+void arduinoWifiDisconnect()
+{
+    WiFi.disconnect();
+}
+
+const WifiConnectionDriver arduinoWifiDriver = {arduinoWifiBegin, arduinoWifiDisconnect};
+
+// called from WiFi event task, only forward to loop
+void onWifiEvent(WiFiEvent_t event, WiFiEventInfo_t info)
+{
+    WifiConnectionEvent connectionEvent = WifiConnectionEvent::NONE;
+
+    if(event == ARDUINO_EVENT_WIFI_STA_GOT_IP)
+    {
+        connectionEvent = WifiConnectionEvent::GOT_IP;
+    }
+    else if(event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED || event == ARDUINO_EVENT_WIFI_STA_LOST_IP)
+    {
+        connectionEvent = WifiConnectionEvent::DISCONNECTED;
+    }
+
+    if(connectionEvent != WifiConnectionEvent::NONE && wifiEventQueue != NULL)
+    {
+        xQueueSend(wifiEventQueue, &connectionEvent, 0);
+    }
+}
+
+void setWifiConnectionState(WifiConnectionState state, uint32_t now)
+{
+    connectionStateTimer = now;
+
+    if(state == connectionState)
+    {
+        return;
+    }
+
+    connectionState = state;
+
+    CONSOLE("WIFI STATUS: ")
+    CONSOLE_CRLF(wifiConnectionStateString[(uint8_t)connectionState])
+
+    if(connectionStateCallback != nullptr)
+    {
+        connectionStateCallback(connectionState);
+    }
+}
+
+void connectionAttemptFailed(uint32_t now)
+{
+    // initial connection has its own overall timeout, after that device falls back to soft AP
+    if(!connectedOnce && now - connectionBeginTimer > WIFI_CONNECT_TIMEOUT_MS)
+    {
+        connectionDriver->disconnect();
+        setWifiConnectionState(WifiConnectionState::FAILED, now);
+        return;
+    }
+
+    CONSOLE("  |-- retry in: ")
+    CONSOLE(reconnectBackoffMs)
+    CONSOLE_CRLF(" ms")
+
+    setWifiConnectionState(WifiConnectionState::WAITING_FOR_RETRY, now);
+}
+
+void beginWifiConnection(const char *ssid, const char *pwd, WifiConnectionStateCallback callback, const WifiConnectionDriver *driver)
+{
+    uint32_t now = millis();
+
+    connectionSsid = ssid;
+    connectionPwd = pwd;
+    connectionStateCallback = callback;
+    connectionDriver = (driver != nullptr) ? driver : &arduinoWifiDriver;
+    connectionBeginTimer = now;
+    reconnectBackoffMs = WIFI_RECONNECT_BACKOFF_MIN_MS;
+    connectedOnce = false;
+
+    if(strcmp(ssid, INVALID_WIFI_SSID) == 0 && strcmp(pwd, INVALID_WIFI_PWD) == 0)
+    {
+        setWifiConnectionState(WifiConnectionState::NO_CREDENTIALS, now);
+        return;
+    }
+
+    if(driver == nullptr)
+    {
+        if(wifiEventQueue == NULL)
+        {
+            wifiEventQueue = xQueueCreate(WIFI_EVENT_QUEUE_LENGTH, sizeof(WifiConnectionEvent));
+            WiFi.onEvent(onWifiEvent);
+        }
+
+        WiFi.setAutoReconnect(false); // reconnecting is handled here, with backoff
+    }
+
+    connectionDriver->begin(connectionSsid, connectionPwd);
+    setWifiConnectionState(WifiConnectionState::CONNECTING, now);
+}
+
+/* Whole connection state machine, no blocking and no calls to WiFi status.
+ * TICK event is used to evaluate timeouts.
+ */
+void processWifiConnectionEvent(WifiConnectionEvent event, uint32_t now)
+{
+    switch(connectionState)
+    {
+        case WifiConnectionState::CONNECTING:
+            if(event == WifiConnectionEvent::GOT_IP)
+            {
+                connectedOnce = true;
+                reconnectBackoffMs = WIFI_RECONNECT_BACKOFF_MIN_MS;
+                setWifiConnectionState(WifiConnectionState::CONNECTED, now);
+            }
+            else if(event == WifiConnectionEvent::DISCONNECTED)
+            {
+                connectionAttemptFailed(now);
+            }
+            else if(event == WifiConnectionEvent::TICK && now - connectionStateTimer > WIFI_CONNECT_ATTEMPT_TIMEOUT_MS)
+            {
+                connectionDriver->disconnect(); // resulting DISCONNECTED event is ignored while waiting for retry
+                connectionAttemptFailed(now);
+            }
+            break;
+
+        case WifiConnectionState::CONNECTED:
+            if(event == WifiConnectionEvent::DISCONNECTED)
+            {
+                reconnectBackoffMs = WIFI_RECONNECT_BACKOFF_MIN_MS;
+                setWifiConnectionState(WifiConnectionState::WAITING_FOR_RETRY, now);
+            }
+            break;
+
+        case WifiConnectionState::WAITING_FOR_RETRY:
+            if(event == WifiConnectionEvent::GOT_IP)
+            {
+                connectedOnce = true;
+                reconnectBackoffMs = WIFI_RECONNECT_BACKOFF_MIN_MS;
+                setWifiConnectionState(WifiConnectionState::CONNECTED, now);
+            }
+            else if(event == WifiConnectionEvent::TICK && now - connectionStateTimer > reconnectBackoffMs)
+            {
+                reconnectBackoffMs = min((uint32_t)(reconnectBackoffMs * 2), (uint32_t)WIFI_RECONNECT_BACKOFF_MAX_MS);
+
+                connectionDriver->begin(connectionSsid, connectionPwd);
+                setWifiConnectionState(WifiConnectionState::CONNECTING, now);
+            }
+            break;
+
+        default:
+            // NONE, NO_CREDENTIALS and FAILED are final
+            break;
+    }
+}
+
+void handleWifiConnection()
+{
+    WifiConnectionEvent event;
+
+    if(wifiEventQueue != NULL)
+    {
+        while(xQueueReceive(wifiEventQueue, &event, 0) == pdTRUE)
+        {
+            processWifiConnectionEvent(event, millis());
+        }
+    }
+
+    processWifiConnectionEvent(WifiConnectionEvent::TICK, millis());
+}
+
+WifiConnectionState getWifiConnectionState()
+{
+    return connectionState;
+}
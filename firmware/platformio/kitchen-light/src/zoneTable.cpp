@@ -0,0 +1,93 @@
+// core includes
+#include <Arduino.h>
+#include <rom/miniz.h>
+
+// project includes
+#include "zoneTable.h"
+#include "console.h"
+
+/* Table is in flash only gzipped, the same bytes setup page gets (and builds its dropdowns from).
+ * Firmware needs it only to check submitted setup, so it is inflated to heap just for that, with inflater in ROM.
+ */
+
+#define ZONE_TABLE_HEADER_SIZE 6
+#define GZIP_HEADER_SIZE 10 // generator writes no optional fields (no file name, no comment)
+#define GZIP_TRAILER_SIZE 8
+
+// caller frees it, NULL when out of memory or data is broken
+uint8_t* inflateZoneTable()
+{
+    tinfl_decompressor *decompressor = (tinfl_decompressor*)malloc(sizeof(tinfl_decompressor)); // about 11 kB, too much for network task stack
+    uint8_t *table = (uint8_t*)malloc(zoneTableLength);
+    size_t inLength = zoneTableGzipLength - GZIP_HEADER_SIZE - GZIP_TRAILER_SIZE;
+    size_t outLength = zoneTableLength;
+    tinfl_status status = TINFL_STATUS_FAILED;
+
+    if(decompressor != NULL && table != NULL)
+    {
+        tinfl_init(decompressor);
+        status = tinfl_decompress(decompressor, zoneTableGzip + GZIP_HEADER_SIZE, &inLength, table, table, &outLength, TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF);
+    }
+
+    free(decompressor);
+
+    if(status != TINFL_STATUS_DONE || outLength != zoneTableLength)
+    {
+        free(table);
+        return NULL;
+    }
+
+    return table;
+}
+
+const uint8_t* skipTableString(const uint8_t *position)
+{
+    return position + strlen((const char*)position) + 1;
+}
+
+/* POSIX TZ has to be one of those setup page offers, so does country code (NULL skips it).
+ * Table layout is described in scripts/generateZoneTable.py, zones themselves are not needed here.
+ * When table can not be inflated, check passes, so it never blocks setup on its own.
+ */
+bool zoneTableContains(const char *posixTz, const char *countryCode)
+{
+    uint8_t *table = inflateZoneTable();
+
+    if(table == NULL)
+    {
+        CONSOLE_CRLF("ZONE TABLE: INFLATE FAILED, NOT CHECKED")
+        return true;
+    }
+
+    uint16_t countryCount = table[0] | (table[1] << 8);
+    uint8_t regionCount = table[2];
+    uint8_t posixTzCount = table[3];
+    const uint8_t *position = table + ZONE_TABLE_HEADER_SIZE;
+    bool countryFound = (countryCode == NULL);
+    bool posixTzFound = false;
+
+    for(uint16_t i = 0; i < countryCount; i++)
+    {
+        if(!countryFound && strlen(countryCode) == 2 && position[0] == countryCode[0] && position[1] == countryCode[1])
+        {
+            countryFound = true;
+        }
+
+        position = skipTableString(position + 2);
+    }
+
+    for(uint8_t i = 0; i < regionCount; i++)
+    {
+        position = skipTableString(position);
+    }
+
+    for(uint8_t i = 0; i < posixTzCount && !posixTzFound; i++)
+    {
+        posixTzFound = (strcmp((const char*)position, posixTz) == 0);
+        position = skipTableString(position);
+    }
+
+    free(table);
+
+    return countryFound && posixTzFound;
+}
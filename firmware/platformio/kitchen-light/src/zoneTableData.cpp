@@ -0,0 +1,186 @@
+// generated by scripts/generateZoneTable.py from web/countries.json and web/zones.json, do not edit
+// 246 countries, 461 zones, 9660 B table, 5655 B gzipped
+#include "zoneTable.h"
+
+const char *zoneTableEtag = "\"4efa4938\"";
+const uint32_t zoneTableLength = 9660;
+const uint32_t zoneTableGzipLength = 5655;
+const uint8_t zoneTableGzip[5655] = {
+	0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x6d,0x5a,0x6b,0x7b,0x1a,0x39,0x96,0x16,0x9d,0x4c,0x42,0x62,0x9b,0xbe,0xa5,0xdd,0xb3,0xb3,0xb3,0x33,0x24,0x93,
+	0xc9,0x26,0x69,0x13,0x1b,0x5f,0x72,0x99,0xed,0xf5,0x74,0x55,0x71,0x35,0x54,0x99,0x50,0x05,0x6e,0x7b,0x67,0x97,0x47,0x80,0x4c,0xc9,0x14,0x25,0x52,0x17,0xbb,0xf1,
+	0x7f,0xdc,0xbf,0xb3,0x9f,0xf7,0x3d,0x2a,0x8c,0x3d,0xdd,0xf9,0x82,0x8e,0x8e,0x54,0xd2,0xd1,0xd1,0xb9,0x8b,0xff,0x63,0x5f,0xfe,0xcf,0xff,0xe6,0x8c,0x9a,0x71,0x3e,
+	0xf1,0x79,0x28,0xe3,0x84,0x87,0xcc,0xf8,0xd9,0x08,0x78,0x38,0x2e,0x36,0x63,0x6a,0x62,0x66,0xb4,0x8d,0x60,0x88,0x41,0xce,0x2a,0x67,0x46,0x30,0x11,0x11,0x20,0xc3,
+	0x35,0x66,0x00,0x46,0x3c,0x2c,0xba,0x7c,0xa6,0x80,0xa8,0x18,0xe1,0x58,0x45,0x11,0xa0,0x63,0x23,0x9c,0xa8,0x00,0x40,0x13,0x40,0x2a,0x03,0x02,0x3f,0x1a,0x61,0xc2,
+	0xa3,0x51,0x82,0x2f,0x98,0x51,0x47,0x47,0x4e,0x52,0x5e,0xc4,0x27,0x45,0x93,0x47,0xc3,0x74,0x0c,0x6c,0xd7,0x88,0x26,0x02,0x03,0x21,0x60,0xdb,0x88,0x66,0x82,0x76,
+	0x34,0x4e,0x8c,0x28,0x1d,0xa2,0xed,0x19,0x69,0x9c,0x44,0x3c,0x20,0x9c,0xa7,0x61,0x82,0xce,0x8c,0x6b,0x11,0x0d,0xb9,0xbc,0x00,0xd9,0xa6,0x6b,0x72,0x9f,0xcf,0x78,
+	0xcc,0xcc,0x06,0xa0,0x88,0x4b,0xe0,0x2a,0x26,0x0f,0x27,0x01,0x1f,0x8b,0xd8,0x67,0xa6,0x49,0x7b,0xf1,0xb1,0xc2,0x8c,0x53,0x53,0x04,0x3c,0x4a,0x01,0x55,0x01,0x4d,
+	0x64,0x3a,0x63,0xe6,0x19,0x20,0x79,0x2d,0x98,0x79,0x64,0x62,0x6f,0x7c,0x6c,0x9b,0x22,0x9a,0x11,0x6d,0xa6,0x67,0xfa,0x29,0xb1,0xc6,0x3c,0x36,0x55,0x20,0x2f,0xb1,
+	0xb5,0x69,0x98,0x2a,0x06,0x85,0xfa,0x0c,0x0d,0x11,0x5d,0x8b,0x89,0xba,0x24,0xda,0xcd,0x13,0x53,0x25,0xf1,0x15,0x27,0xb0,0x6f,0xaa,0xf4,0x52,0x24,0x4b,0x4e,0x32,
+	0xb3,0x6b,0x46,0xfc,0x5a,0x06,0xac,0x79,0x6c,0x46,0x32,0x91,0xb1,0x5f,0x6c,0x86,0x63,0x09,0x1e,0x1e,0x8f,0x04,0x7e,0x3d,0x11,0x01,0xad,0xa2,0x05,0x33,0x1d,0x33,
+	0x4a,0x43,0x21,0x8b,0x15,0x22,0x32,0xe6,0x01,0x07,0x7d,0x75,0x33,0x0d,0x26,0x9c,0xce,0x6d,0xd6,0xcc,0x34,0x9a,0x62,0xb7,0x62,0x8d,0xc7,0x8a,0x99,0x4d,0x74,0x53,
+	0xac,0xc4,0x5a,0x0d,0x8b,0xcf,0x86,0x0a,0x6b,0x32,0xcb,0x06,0x28,0x22,0xa5,0x42,0x66,0x19,0x16,0xc8,0xc1,0x39,0xac,0xbe,0xc5,0xe7,0xa2,0xd8,0x17,0xd1,0x58,0xb0,
+	0xd6,0xa9,0xc5,0x17,0x33,0x6c,0x7b,0x73,0xcf,0x56,0xcd,0x02,0xff,0xc1,0xe3,0xa2,0x71,0x9e,0x5d,0x6d,0x57,0xcc,0xd3,0x61,0x20,0x47,0xcc,0xab,0x58,0x3e,0x1f,0x33,
+	0xab,0x6d,0xf9,0x32,0x10,0xcc,0x72,0xd0,0xe2,0x80,0xd6,0xcf,0x96,0x1f,0x41,0x68,0xc0,0xf4,0x9b,0x33,0x5a,0x96,0xa5,0x46,0x2a,0x2e,0xbe,0x6c,0x09,0x70,0x33,0x9c,
+	0xbc,0xba,0x5d,0xfe,0xd8,0x52,0x81,0x9a,0x0d,0x41,0x5b,0xcb,0xb6,0xd4,0x4c,0x45,0xb8,0x08,0xab,0x6e,0x29,0x48,0x0b,0xb3,0x2a,0xba,0xdd,0x2a,0x56,0xc4,0x4c,0x8d,
+	0x22,0x0e,0x41,0xb9,0xdd,0xdd,0x6a,0x59,0x4a,0x4d,0x6f,0x17,0xea,0x5a,0x0a,0x82,0x5a,0xec,0x92,0x30,0x59,0x4d,0x4b,0x25,0xa2,0x58,0x79,0xd6,0xbc,0x54,0x32,0x12,
+	0xac,0xd1,0xb5,0x22,0x85,0xcf,0x31,0xd2,0xb3,0x48,0x72,0xac,0x53,0x6b,0x31,0xa7,0x9b,0xb6,0xce,0xac,0x6b,0x31,0xf2,0x6f,0x97,0xad,0xb4,0x2a,0x22,0x9c,0xf1,0x68,
+	0xca,0x2a,0x47,0x95,0x0b,0x39,0x54,0x69,0x22,0x59,0xc5,0xae,0xa8,0x99,0x0c,0x69,0xe9,0xca,0xf1,0x0d,0x78,0x87,0x13,0x55,0xab,0x3a,0x4a,0x21,0x43,0x11,0xab,0xd6,
+	0xab,0x93,0xc5,0x3c,0x61,0x6e,0xbf,0x1a,0x40,0x09,0x82,0x4b,0x8d,0xad,0x7f,0xac,0x7e,0x4a,0x39,0x2e,0x51,0x82,0x8f,0xf5,0x54,0x86,0x82,0xb3,0x6a,0xb7,0x8a,0x7b,
+	0x8d,0x08,0xaa,0x56,0xe3,0x44,0x91,0x60,0x57,0xbd,0x6a,0xe2,0x4b,0x35,0x07,0x58,0x6b,0xd5,0x78,0x30,0xbd,0xab,0x72,0xc5,0x97,0x36,0xd6,0x03,0x87,0xe3,0x57,0xac,
+	0x76,0x5c,0xe3,0x91,0x12,0xab,0xd3,0xd7,0x8e,0x6a,0xf2,0x42,0xb2,0x5a,0xb3,0x26,0x43,0xcd,0xf1,0x5a,0xb7,0x16,0xf1,0x70,0x24,0x58,0xbd,0x56,0x8b,0x44,0x88,0x13,
+	0x62,0x5b,0x12,0xbf,0xce,0x4d,0xbf,0xa3,0x82,0x45,0x28,0x62,0x6c,0xe5,0xdd,0xa0,0x5c,0x1c,0xd6,0x17,0xd1,0xad,0xcc,0x49,0x11,0xb3,0xba,0x51,0xe7,0x43,0xc8,0x4b,
+	0xdd,0xae,0x73,0x7d,0x4f,0xf5,0x6a,0x5d,0xa8,0x68,0x42,0x9a,0x0f,0x28,0x82,0xb0,0x2c,0x58,0xbd,0x51,0xf7,0x69,0xf5,0x7a,0xb3,0x2e,0x87,0x10,0x16,0xa8,0x35,0xab,
+	0x77,0xeb,0x91,0x10,0x44,0x42,0x9b,0x80,0x8c,0xae,0x7a,0x05,0xb0,0x16,0xbb,0x7a,0xa7,0x0e,0x96,0x89,0x40,0xa5,0x73,0x4c,0xe9,0xa1,0x33,0x63,0x75,0x0f,0x4d,0x22,
+	0x66,0x10,0x6d,0x56,0xaf,0xd7,0x53,0xd0,0x12,0x0b,0xac,0xee,0x2c,0x79,0x56,0x3f,0xc9,0x80,0x92,0x29,0x21,0xff,0x29,0xab,0x9f,0xd6,0xd3,0x05,0xed,0xdb,0xf0,0x1a,
+	0x1c,0xba,0xc3,0x1a,0x76,0x43,0xf0,0xe8,0x86,0x65,0xc5,0x17,0x45,0x7b,0x34,0x56,0x21,0x0f,0x6e,0xed,0x56,0xdf,0x68,0xe0,0xe0,0x45,0x57,0x88,0xe2,0xcb,0x3e,0x49,
+	0x14,0xee,0xd1,0x92,0x09,0x30,0x09,0x76,0x7e,0xc5,0x1a,0x4e,0x43,0x85,0xe3,0x34,0x82,0xc5,0x68,0xb4,0x00,0x4e,0x8a,0x2d,0xfc,0xb0,0x46,0xaf,0x91,0x86,0xd0,0xb3,
+	0x05,0x6b,0xba,0xcd,0x91,0xd0,0x67,0x69,0x3a,0x5a,0x51,0x59,0xb3,0x82,0x56,0x65,0xbc,0x6c,0x76,0x9b,0xe0,0xfb,0x96,0xde,0x6e,0x76,0x47,0x5c,0x8b,0xc7,0xe7,0xac,
+	0xf9,0x11,0x63,0x9f,0x58,0xb3,0xda,0x8c,0x96,0x0b,0xd8,0x98,0x26,0x30,0x54,0xb4,0x61,0x46,0x9a,0xed,0x66,0x1c,0x71,0x01,0x43,0xe0,0x35,0x13,0x1e,0x2c,0xd8,0x91,
+	0x7d,0x04,0xcb,0x45,0x42,0x77,0xd4,0x39,0xe2,0x73,0x4c,0x39,0xaa,0x1e,0x89,0x88,0x38,0x72,0x74,0x7c,0xa4,0xa2,0x31,0x30,0xad,0xb3,0x16,0xbf,0xe6,0x53,0x5f,0xdb,
+	0xe8,0x56,0xb5,0x25,0xc2,0x05,0x34,0xa9,0xd9,0x92,0x91,0x1c,0xe2,0x74,0xac,0xd5,0x6d,0x29,0x92,0xb1,0x56,0xc7,0x51,0x51,0xe2,0x17,0x97,0xbd,0x93,0x56,0x7a,0x05,
+	0x86,0xb1,0x56,0xbd,0xb5,0x88,0x26,0x8b,0x6b,0xfd,0x79,0xdb,0x68,0x73,0x55,0xec,0x08,0x35,0x0f,0xc4,0xb3,0xf8,0xb3,0x4a,0xd7,0xee,0xb7,0x79,0x42,0x96,0xae,0x6d,
+	0xb6,0x05,0xcc,0x3f,0xe4,0xa2,0xed,0xb6,0x45,0xac,0x12,0x5f,0xb1,0x76,0xb7,0x2d,0x87,0xda,0x11,0xb4,0x4f,0x01,0xe1,0x62,0x8a,0x46,0xc4,0x87,0x45,0x3a,0x85,0x0f,
+	0x82,0x40,0x59,0xbb,0xd9,0x96,0x50,0xb7,0x44,0x84,0x71,0x22,0x60,0x4d,0xdb,0x5e,0x5b,0x26,0x7e,0xaa,0xfd,0x48,0xbb,0xd7,0x4e,0x7f,0x11,0x30,0x54,0x69,0x34,0x61,
+	0xf6,0xb1,0xcd,0x47,0x5c,0x31,0xbb,0x85,0x56,0x8c,0xb5,0x76,0xd8,0x75,0x1b,0x82,0x33,0xe1,0xf1,0x08,0xd2,0x65,0x9f,0x40,0x1b,0xf8,0x95,0x64,0xf6,0x29,0x01,0x0b,
+	0x62,0xbe,0xdd,0x07,0x38,0x96,0x97,0x90,0x5a,0xbb,0x0d,0x10,0x83,0x9e,0x4d,0xc2,0xc8,0xec,0x86,0xcd,0xa3,0xd8,0xe7,0x41,0xb0,0x12,0x04,0xfb,0x23,0x50,0x70,0x2c,
+	0xf2,0x53,0x2a,0x98,0xdd,0xb5,0x79,0x0a,0x91,0xd7,0x84,0xd8,0xbd,0xac,0x23,0x61,0x1f,0x4e,0xb1,0xc0,0x42,0x25,0x09,0xa6,0xfc,0x6c,0x8b,0x5f,0xe4,0x48,0xb1,0x9a,
+	0x6d,0xcb,0x51,0x94,0xdd,0xf7,0x56,0xb1,0x26,0xc6,0x02,0x4c,0x12,0xe3,0x4c,0x80,0x62,0xba,0x68,0xbb,0x62,0xab,0x60,0xac,0x2e,0xb1,0x94,0x65,0x43,0xfc,0xf0,0x91,
+	0xed,0xd8,0x64,0xca,0xc8,0x53,0xd9,0x55,0x80,0xe0,0x80,0x98,0x44,0xc0,0xbb,0xd4,0x89,0xa1,0x6f,0x3c,0x61,0xb6,0x61,0xc3,0xfe,0x8d,0x68,0xfa,0x99,0xad,0xae,0x49,
+	0xdd,0x34,0x71,0xb6,0x0d,0x5e,0xc2,0x26,0x31,0xc7,0x70,0x20,0x55,0xa4,0x84,0x4e,0xd7,0x01,0x8d,0x29,0x73,0x3a,0x8e,0x98,0xf3,0x80,0x39,0x6d,0x47,0x90,0xee,0x2e,
+	0x9d,0xb3,0x73,0xa7,0x57,0x24,0xc7,0x1a,0x04,0x60,0x8a,0x63,0x39,0xe2,0xaa,0x68,0xf1,0x60,0xc9,0x50,0xe7,0x8c,0xfa,0x67,0x82,0x6b,0x69,0x74,0x9a,0x0e,0x64,0x2d,
+	0xe2,0xf0,0xc1,0xcc,0xa9,0x3a,0x12,0x3e,0x9d,0x39,0x75,0xdd,0xd2,0xdc,0x9e,0x23,0x41,0x8b,0x53,0x83,0x1c,0x9d,0xab,0xe0,0xc6,0xf0,0x32,0x3b,0x13,0x2c,0xb2,0x1a,
+	0x36,0xb9,0x21,0xb8,0x9f,0x1b,0x0e,0x3b,0xc7,0x18,0xba,0xe2,0x0b,0x76,0x6c,0x1f,0xc3,0x4a,0xb0,0x4e,0xab,0xc3,0xa7,0x59,0x34,0xd1,0x39,0xe9,0x60,0xd3,0x94,0x75,
+	0x5c,0xb4,0x22,0xa6,0x6b,0xb8,0xeb,0xea,0xb6,0xe0,0xfb,0x46,0xe9,0x5c,0x8a,0x31,0xeb,0x18,0x1d,0xac,0x39,0x83,0xe1,0xaa,0x77,0xf8,0x1c,0xe1,0x01,0x91,0xbc,0x34,
+	0x07,0x9d,0xd3,0x4e,0x46,0xef,0x82,0x75,0xaa,0x1d,0x01,0x76,0x74,0x1a,0x1d,0xf8,0x22,0x39,0x9f,0x63,0x3c,0x66,0x1d,0xa7,0x23,0x93,0x11,0x97,0x11,0x36,0x6c,0xc3,
+	0xde,0x11,0xbd,0x1d,0xaf,0x03,0x7a,0xd3,0x09,0x78,0xd6,0xe9,0x76,0x60,0x61,0x12,0x45,0x3e,0x43,0xb1,0x8f,0xc6,0x47,0x4e,0x66,0xab,0x5b,0xed,0x8a,0x34,0x94,0x90,
+	0xec,0xee,0x71,0x57,0xcd,0xb4,0x44,0x74,0x7b,0x5d,0x38,0x5c,0x22,0x71,0x79,0xdd,0x7a,0xf8,0xa4,0x0b,0x87,0x4e,0x81,0x40,0xdb,0x45,0x58,0x91,0x50,0xd0,0x02,0x46,
+	0x04,0x62,0xb6,0x60,0x6e,0x23,0x43,0x35,0xd0,0x85,0x79,0x6a,0x39,0x59,0xb7,0x25,0x93,0x24,0xd6,0xc1,0x81,0x23,0x2e,0x65,0xcc,0xda,0x56,0x86,0x6f,0xa7,0x23,0x12,
+	0x8c,0x5a,0xd6,0xcb,0xe4,0x92,0x75,0xec,0xac,0xdb,0x91,0x60,0x8b,0xd0,0x5f,0xd9,0x24,0x0f,0x01,0xf6,0xee,0x2f,0x3f,0xec,0x4b,0xd8,0x78,0xb4,0x34,0x98,0x19,0x56,
+	0x7d,0xf0,0x13,0x37,0x8b,0xbf,0x5c,0x2c,0x91,0xdd,0x4b,0xa8,0x98,0xeb,0xb9,0x50,0x6f,0x4f,0xcd,0xb2,0xb5,0x3a,0x40,0x8e,0x24,0x6c,0xaf,0x6b,0xb8,0x3c,0x1d,0x4b,
+	0xad,0xab,0xa0,0xc2,0x75,0x5c,0x92,0x4d,0xf0,0xa7,0xeb,0xba,0x88,0xa3,0x08,0x65,0xb9,0x62,0x31,0xc2,0xd1,0x48,0x88,0xdc,0xb6,0x4b,0x04,0xf1,0x62,0x5b,0x40,0x07,
+	0x98,0x5b,0x77,0xe1,0xd0,0xf9,0x1c,0x76,0x85,0xb9,0x2d,0x37,0x80,0xd4,0x4f,0xe9,0x93,0x26,0x81,0x3a,0x5a,0x73,0x4d,0x97,0x5c,0xbc,0xba,0x8d,0x29,0xdc,0x63,0x17,
+	0x8c,0x25,0x5d,0x38,0x33,0xb4,0xcf,0x59,0xc6,0x16,0xac,0xee,0x66,0xdd,0xa5,0x83,0xd1,0x74,0xe2,0x04,0xe3,0x2b,0x09,0xef,0x84,0xaf,0xdf,0xb0,0xaa,0xeb,0xce,0x29,
+	0x86,0x6b,0xb7,0xdc,0x48,0x16,0xdb,0x3c,0x9c,0x62,0x83,0x8a,0x9b,0x92,0x2d,0x74,0xbb,0x2e,0xd4,0x16,0xc2,0x02,0x4a,0x8e,0xdc,0x4b,0x8e,0xf8,0x14,0xae,0x80,0xd6,
+	0x38,0xd2,0x5c,0x58,0x08,0xcc,0x39,0x73,0xaf,0x28,0xda,0x22,0x51,0x70,0xab,0xee,0x15,0xae,0x13,0xa1,0x50,0xc3,0xbd,0x92,0xc9,0x75,0xa6,0x2f,0xcc,0x3d,0x75,0x17,
+	0x24,0xc8,0x99,0xf1,0xba,0x8d,0x76,0x4e,0x3c,0x2e,0x71,0xe1,0xcc,0x3b,0xf2,0xf8,0x85,0x5c,0x0a,0xb2,0x77,0xe6,0xf1,0xf0,0x5a,0x0b,0x89,0xd7,0xf0,0x7c,0x9e,0xad,
+	0xec,0xb5,0x3d,0x89,0x50,0xa6,0x04,0xcb,0x08,0xcb,0xe1,0xd5,0x3d,0x85,0x68,0xc6,0x6b,0x79,0x6a,0x2a,0x48,0xea,0xbd,0x63,0x0f,0xc6,0x00,0x5f,0x78,0x1e,0xe8,0x95,
+	0x63,0x9e,0x51,0xe9,0xa9,0x21,0xa7,0x79,0x8e,0x07,0xf9,0xd3,0x8e,0xb9,0xeb,0x21,0xa2,0x83,0xb9,0xf7,0x6c,0x02,0x28,0xf8,0xcd,0x36,0xb5,0xa8,0x9b,0x09,0x92,0x05,
+	0x07,0xa1,0xe2,0x15,0x6b,0xbd,0xbe,0x97,0xe2,0xe4,0x29,0xeb,0xd5,0x7b,0x13,0x2d,0x9d,0x3d,0xa3,0x37,0xa5,0xb0,0x57,0x30,0xa3,0xda,0x0b,0x25,0x59,0x2a,0x7d,0xb0,
+	0xea,0x4c,0x92,0xdd,0x82,0x83,0x37,0x97,0xe8,0x16,0x2e,0x72,0xac,0x66,0xac,0xe7,0x2e,0x11,0x99,0x45,0x63,0x3d,0xfb,0x9f,0xfa,0xc5,0xe3,0x34,0x09,0x16,0x98,0xbb,
+	0xda,0xb4,0x77,0xda,0x8b,0x52,0xad,0x86,0xbd,0xb3,0xde,0xf5,0x50,0x2c,0x79,0xd3,0xef,0xf5,0x79,0x08,0x7f,0x9e,0xb2,0x7e,0xb5,0x0f,0x99,0xba,0x86,0xec,0x72,0xd6,
+	0x77,0xfa,0x52,0x24,0xb8,0x25,0xd6,0xaf,0xf7,0x25,0xae,0x79,0x25,0x17,0x5b,0xc5,0x65,0x00,0xcc,0xfa,0xcd,0x5f,0x8f,0xf4,0xde,0xb8,0x6f,0xd8,0x49,0xed,0x04,0x16,
+	0x5c,0x66,0x07,0xaf,0xa5,0x49,0x0a,0xd5,0xaa,0x36,0x4e,0x88,0xc9,0x11,0xa5,0x1c,0x3e,0xac,0x01,0x3b,0xad,0x9e,0x0a,0x70,0x8a,0x9d,0xd9,0x67,0x59,0xbc,0x72,0x76,
+	0x72,0x26,0x67,0x43,0x3e,0xbc,0x02,0x07,0x32,0x31,0x5b,0x66,0x29,0x37,0xed,0xf6,0x9d,0x1c,0x63,0x89,0xc9,0x22,0xf0,0xdb,0x3e,0xfc,0x6a,0x92,0x8e,0xa6,0x8b,0x15,
+	0x42,0x1b,0xbd,0x41,0x85,0x4f,0x15,0xbc,0xcb,0xdd,0x34,0x46,0xb7,0xcc,0xa0,0xeb,0x33,0x12,0x10,0xaf,0x7b,0xab,0x2c,0xa5,0x9a,0x20,0x58,0x4c,0x23,0x05,0xb5,0xcb,
+	0xb6,0x60,0x1d,0x3e,0x92,0xe7,0x98,0x53,0xb7,0xbd,0x1d,0x56,0x35,0xbc,0xd2,0x1e,0xb3,0xaa,0x5e,0xa9,0xcc,0x4e,0x0c,0xfa,0xb5,0xf0,0xbb,0x8b,0x08,0x11,0xbf,0xd5,
+	0xaa,0xeb,0x6d,0xd9,0xfb,0x6f,0x0e,0xde,0x1c,0x6c,0xef,0x6c,0xd9,0xe5,0x1d,0x40,0xfb,0xdb,0xbb,0xfb,0xec,0xc7,0x1f,0x76,0xca,0x87,0x34,0x97,0xbe,0xb3,0xf4,0xac,
+	0x3d,0x8c,0xdd,0xcc,0xd9,0xd9,0xde,0x23,0x1d,0x5f,0xad,0xc3,0x1a,0xae,0x57,0xde,0x69,0x54,0xf4,0xb4,0x5d,0x3d,0xad,0xfc,0xa6,0xfc,0x66,0x87,0x19,0x2d,0xd7,0xfb,
+	0x60,0xb4,0x3e,0x33,0xe0,0x7a,0xd8,0xa5,0xb4,0xb3,0x77,0xb8,0x47,0xcd,0xfe,0xe1,0xbe,0xee,0xe8,0xf5,0x31,0x4e,0xd4,0xec,0xbd,0xd9,0x27,0x00,0xfa,0xe9,0x1d,0x30,
+	0xcb,0xf5,0xde,0x2e,0x27,0x52,0x73,0x70,0x78,0x00,0x3f,0xe7,0xbd,0xb3,0x7f,0xbb,0x32,0xcd,0xb4,0x7e,0x8b,0xa6,0xd9,0x7a,0xa9,0xea,0xe7,0x89,0x31,0x7e,0x8b,0xc6,
+	0x3e,0xbb,0x87,0xbb,0xf8,0x2d,0x1f,0x2e,0x8f,0xbf,0x5d,0x2a,0xaf,0x38,0xa0,0x77,0x3a,0xb8,0xdd,0x69,0x7b,0xf5,0xe1,0x76,0x19,0x4e,0xc8,0x7b,0xdf,0xf9,0xec,0x8a,
+	0x38,0xb0,0x5e,0xf7,0xf3,0x9b,0xfd,0x33,0x2f,0x3e,0x60,0xe4,0x2d,0xae,0x83,0xae,0x28,0x83,0x98,0xa6,0xa6,0x8c,0xeb,0xd9,0x59,0xd1,0x74,0x7b,0x29,0x65,0xe6,0xb8,
+	0xde,0xde,0xdf,0xf6,0x76,0x9c,0xcf,0x6c,0xfd,0x43,0x99,0x6e,0xb4,0x4c,0x57,0xfb,0xee,0xb0,0xf4,0x8e,0x10,0x3b,0x40,0xe0,0xf4,0xe0,0x0a,0x5a,0x43,0x33,0x26,0x63,
+	0x7f,0xb6,0x21,0xdd,0x32,0x66,0x1f,0x1c,0x96,0x0e,0xe0,0xd7,0x69,0xd2,0xae,0x73,0x46,0x93,0x3e,0x64,0xa2,0x70,0x67,0xce,0xde,0x61,0x49,0xb7,0x3b,0x87,0x3b,0xf8,
+	0xdd,0x3d,0x2c,0xed,0xde,0x50,0x57,0xbe,0x23,0x32,0x18,0x7a,0x7b,0x58,0x7a,0x4b,0x5b,0x63,0x4a,0x79,0x97,0x10,0xfb,0x87,0xa5,0xfd,0xbb,0xc2,0xf8,0xeb,0x33,0x11,
+	0xe5,0x3b,0xef,0x0f,0x4b,0xef,0xa9,0xfd,0x70,0x58,0xfa,0xa0,0x49,0xda,0x03,0xe9,0x07,0x38,0xe8,0x6f,0xbf,0xdc,0x5b,0x7d,0xf9,0xab,0x65,0xf7,0x21,0xd9,0x07,0xd9,
+	0xba,0x19,0x88,0x60,0xdc,0xc3,0xb2,0x27,0x4d,0x13,0xdc,0x38,0x69,0x7a,0x58,0xba,0x49,0x22,0xdd,0xac,0xac,0xe6,0xef,0xbe,0xbd,0x59,0x4d,0x93,0x4a,0xbb,0xee,0xd3,
+	0xae,0x1d,0x7c,0x79,0xa0,0x09,0xd9,0x27,0xee,0xfc,0x6d,0xff,0x40,0x7f,0xaa,0x29,0x82,0x54,0xe8,0x55,0x3d,0x03,0x4d,0x47,0x77,0xa0,0x04,0x19,0xdd,0x7b,0xb4,0x02,
+	0x5d,0x10,0x3b,0xba,0x41,0xbd,0x25,0xd4,0x5b,0x42,0x9d,0x54,0xbd,0x9d,0x93,0x3b,0x27,0x29,0xdf,0xee,0xad,0x2f,0x9d,0x19,0xb4,0xf4,0x07,0x4c,0x35,0xac,0xcf,0x5d,
+	0xd5,0xf2,0x1e,0x6f,0xa7,0x69,0xce,0x11,0x81,0xef,0x89,0x40,0xba,0xef,0x3d,0x7d,0xe3,0x18,0xba,0x91,0x86,0x5f,0xad,0xc2,0x8c,0x13,0x4d,0xf0,0x8f,0x98,0x75,0x58,
+	0xa6,0x8d,0x31,0x8d,0x64,0x06,0x97,0x75,0x58,0xd6,0xd2,0xf9,0xf6,0x50,0xeb,0xe1,0xbb,0xc3,0x77,0xd4,0xbc,0x3f,0xa4,0xc9,0xb8,0x17,0x3a,0x4b,0x19,0x52,0x50,0xa6,
+	0x5b,0x2e,0xe3,0x52,0xcb,0xda,0x88,0x90,0x24,0xb0,0x9e,0x67,0xfd,0xf6,0xa2,0xee,0x88,0x05,0xb1,0xae,0x4c,0xc6,0xea,0x06,0xb7,0xe2,0x80,0x36,0x61,0xe6,0xe7,0x58,
+	0x62,0xbb,0x2d,0x2d,0x71,0xe5,0x5d,0x3a,0x60,0x79,0x17,0x27,0x24,0x02,0xd0,0x59,0x8a,0xe7,0x36,0xa1,0x56,0xcc,0xd1,0x0c,0xd0,0xc4,0x6b,0xe3,0xb1,0x52,0xad,0xdd,
+	0x95,0x6a,0xed,0x32,0xcb,0xcf,0xf8,0xa7,0x6d,0x99,0x3e,0x15,0xd8,0xa5,0xf9,0xe8,0x02,0x53,0x5e,0x69,0x90,0x96,0xde,0xdf,0xb2,0x9f,0x31,0x63,0x28,0xc7,0x54,0x20,
+	0x02,0x34,0x42,0x96,0xc3,0x58,0xce,0x18,0x8f,0x65,0x3c,0x30,0xe0,0x29,0xd0,0xfb,0xc2,0x08,0x26,0x08,0x73,0x62,0xc2,0xc7,0x33,0xf2,0x2b,0x8c,0x99,0x08,0x43,0xa7,
+	0x8a,0xb1,0x7b,0x54,0x3e,0x4a,0xa5,0xc6,0x84,0x17,0x69,0x40,0x40,0x96,0x8f,0xb2,0xfb,0x26,0x99,0xfc,0x05,0x62,0x21,0xcc,0x8a,0xf8,0xf5,0x35,0xbf,0xa4,0xd0,0x9b,
+	0x06,0xd2,0x8b,0x74,0x36,0x4c,0x69,0xa1,0xdf,0xc1,0x67,0x23,0xf4,0x67,0x0f,0x2c,0x1e,0xf3,0x21,0x3e,0x80,0xdf,0x60,0x0f,0x2d,0x91,0x26,0xb4,0x8b,0x85,0x84,0x61,
+	0x8a,0x3c,0x93,0x31,0x78,0x17,0xc4,0xa3,0x2c,0x57,0xe1,0xd1,0x40,0xc4,0x03,0x17,0x11,0x33,0xbc,0x26,0xfa,0x37,0x65,0x09,0x76,0xaf,0xa2,0x52,0xca,0x95,0xd9,0x83,
+	0x6a,0x30,0x30,0xb8,0x4c,0xe9,0x3c,0x48,0xe6,0x45,0xa2,0xae,0x00,0xde,0xa7,0xcc,0x9d,0x32,0x15,0x80,0x0d,0x9c,0x81,0xc8,0xca,0x1f,0x29,0x64,0xea,0x08,0x12,0x87,
+	0x94,0x66,0xb1,0xfb,0x47,0x54,0x0e,0x61,0xb9,0x16,0x9f,0xcd,0xf5,0x4a,0xf7,0x5b,0xf0,0xa2,0x89,0x4a,0x67,0x04,0xca,0x09,0x25,0x51,0xec,0x1e,0x22,0x03,0x24,0x4f,
+	0x31,0x86,0xef,0xb5,0x11,0xa2,0xc4,0xd4,0x22,0xcf,0x17,0xcb,0xc3,0xb1,0x36,0x82,0x4a,0xc2,0xa5,0x3a,0xe2,0x60,0xf7,0xdb,0xe9,0x10,0x87,0xe5,0xb1,0x2f,0x75,0x27,
+	0xc6,0x41,0x30,0x4c,0x79,0xda,0x10,0xe7,0xbe,0x6f,0x23,0x90,0x4f,0x00,0xe4,0x6d,0x1e,0x53,0xd4,0x0e,0x80,0xb8,0x4e,0x74,0xe6,0x6c,0x35,0x41,0x10,0x1b,0xfb,0xc0,
+	0x32,0xa4,0x46,0x91,0xa2,0x6c,0x93,0xe5,0x1c,0x62,0xd9,0x90,0x68,0x71,0x70,0x6d,0x33,0x0a,0xaa,0x01,0x4a,0x40,0xc4,0x29,0x07,0x6c,0x98,0x8e,0x7c,0xe4,0x69,0xe8,
+	0x1c,0xa7,0xc8,0x11,0xc7,0x2a,0x9d,0x28,0xac,0x71,0x8f,0xa2,0x7d,0x55,0x72,0xd4,0x25,0xf6,0x63,0x08,0x80,0x07,0x9e,0xa6,0xf5,0x11,0x22,0xaf,0xb9,0xa2,0xc3,0x7d,
+	0xa1,0xa3,0x2d,0x50,0x75,0x22,0xc3,0xb1,0xaf,0xc4,0x94,0xe5,0x1e,0x1b,0x63,0x8e,0x66,0xcd,0x08,0xb1,0x26,0x12,0x0c,0xc1,0x72,0xeb,0xab,0xaa,0x25,0x81,0xba,0x50,
+	0xc9,0x72,0x1b,0x86,0xce,0x3e,0x28,0x70,0xf8,0x62,0xc3,0x4c,0x45,0xa8,0x20,0x3f,0x32,0x42,0xc8,0xf4,0xc5,0x86,0x85,0x64,0x02,0x72,0x33,0xa2,0x21,0x0b,0xb9,0x3a,
+	0x62,0x3b,0x40,0x47,0x90,0x82,0x05,0xda,0x36,0x1f,0x74,0xa5,0xba,0x20,0x94,0x2d,0xc2,0x31,0x72,0x3d,0x40,0xc0,0x0c,0xea,0x08,0x70,0x04,0x71,0xf8,0x8b,0x0d,0x57,
+	0x67,0xae,0xd4,0x86,0x83,0x23,0x70,0x76,0x09,0xb6,0x53,0x49,0xa3,0x5e,0x3a,0x4a,0x67,0x1a,0xd9,0x03,0xb3,0xb8,0xd4,0x84,0xe9,0xaa,0x68,0xae,0x60,0xc4,0x29,0x42,
+	0x7b,0xa4,0x09,0xb9,0x2f,0x8d,0x44,0x4e,0xd5,0x14,0xf3,0x72,0x1b,0x26,0x92,0x70,0x8c,0x7e,0xa5,0xdb,0x01,0x44,0x97,0x32,0x99,0x18,0x9f,0xad,0x0a,0xa0,0x98,0x43,
+	0xe9,0x0b,0xcd,0xc9,0x8a,0x9e,0x18,0x23,0xf1,0x2c,0xb9,0x10,0x53,0x5a,0xee,0x6b,0x53,0xf1,0x41,0x9f,0xa2,0x3b,0x96,0xfb,0xc6,0x44,0x50,0x4b,0xc0,0xb7,0xa6,0x92,
+	0x31,0xe6,0x7e,0x4b,0x55,0xc6,0x48,0x8e,0x27,0x02,0x8b,0x2f,0x30,0x19,0xfd,0x39,0x4e,0x14,0xd1,0x4e,0x20,0xc5,0xc2,0x4a,0x69,0xa8,0xf1,0x11,0x72,0x7b,0xda,0xce,
+	0xa2,0x98,0x3c,0xcc,0x06,0xa9,0xea,0xc8,0x72,0x4f,0x2c,0x1f,0x61,0x14,0xa2,0xe0,0xdc,0x57,0x80,0x70,0x30,0x9f,0x18,0xfd,0x95,0xae,0xed,0x0d,0x74,0x6d,0x2f,0xf7,
+	0x9d,0x05,0x0e,0x27,0x9a,0x1c,0x2b,0x95,0xa4,0xad,0xb9,0x75,0x2b,0x8d,0x74,0xb9,0x20,0x07,0xa5,0xd1,0xd5,0x3b,0x88,0xeb,0x25,0x66,0x7c,0x57,0xe1,0x57,0xb1,0xba,
+	0x05,0x06,0xf8,0x96,0x6e,0xf8,0xdb,0x8a,0x08,0x2f,0x91,0xdf,0xe6,0x36,0x2b,0x22,0x89,0x94,0x4c,0xb0,0xc6,0xaa,0xc4,0x97,0xfb,0xb6,0x3a,0x46,0xba,0xa2,0xb7,0xf8,
+	0xa6,0x2a,0xa9,0xe6,0x8a,0x78,0x2d,0xf7,0x15,0x74,0x6c,0x55,0xd1,0xcb,0x7d,0x57,0x83,0x60,0x0d,0x1c,0x11,0xe8,0xe5,0x37,0xa8,0x87,0x4c,0x16,0xf7,0x98,0xfb,0xbe,
+	0x1e,0xf0,0xd1,0x92,0x07,0xbf,0xaf,0xab,0x71,0xe2,0xf3,0x21,0x61,0x95,0x8a,0x97,0xd8,0x4d,0xcd,0x93,0x01,0x05,0xf1,0xd8,0xf7,0xa6,0x20,0x06,0xe8,0xb6,0x20,0x96,
+	0xfb,0xea,0xb6,0x12,0x96,0xfb,0x06,0xf0,0x82,0x7f,0x82,0xfc,0xe1,0xcc,0xcb,0x8a,0x57,0xee,0xfb,0x06,0x74,0xf3,0x9c,0xff,0xc2,0x72,0xff,0xd2,0xe0,0x97,0x1a,0xf5,
+	0x5d,0x43,0x44,0x33,0x15,0x43,0x4c,0x15,0xbb,0xb7,0xb9,0x8c,0x61,0x49,0xca,0x63,0x76,0xef,0x49,0x2b,0x54,0xbf,0x00,0x8b,0x64,0x50,0x50,0x6d,0xf5,0xde,0x66,0x47,
+	0x20,0x6c,0xce,0xcc,0xc0,0xbd,0x27,0x1e,0x92,0xbb,0x01,0xd5,0xc1,0x30,0xd0,0x17,0x97,0x5c,0xb7,0x3a,0xb9,0xa4,0x7c,0xf2,0xde,0xe6,0x09,0xe5,0x55,0x7c,0x04,0xde,
+	0x34,0xc3,0xf4,0x52,0x82,0xee,0xcd,0xe6,0x27,0xe4,0x19,0xc4,0xb9,0x2f,0x6f,0xca,0x54,0xb9,0xb5,0x23,0xf0,0x0a,0x76,0xf0,0xfe,0x66,0x5b,0x41,0x4c,0x33,0xf3,0x70,
+	0x7f,0x93,0x4a,0x1c,0x72,0x24,0x88,0xac,0xdc,0x7a,0x0b,0x91,0x30,0x44,0x5e,0x5e,0x60,0x8d,0xaf,0xa1,0x07,0x1d,0x7e,0x8d,0x13,0xb6,0x25,0x52,0xfc,0xdc,0x1f,0xda,
+	0xa4,0x41,0xe1,0x44,0x50,0xa2,0x99,0x5b,0x6f,0xab,0x2b,0x11,0x0d,0x74,0xa2,0x4a,0xfd,0x0d,0x2a,0x05,0x49,0x12,0x0d,0x1b,0xe7,0xd2,0x1a,0xf8,0x35,0x41,0x29,0xcd,
+	0xa5,0x24,0x17,0xf2,0x98,0x41,0x37,0x65,0x9d,0xdc,0x13,0x9b,0xd4,0x50,0x17,0x95,0x73,0xdf,0xd9,0xfc,0x9a,0x53,0x48,0x4e,0x68,0xe8,0x2a,0x6e,0x5b,0x10,0xa3,0x6d,
+	0x44,0xf4,0xc4,0xfe,0x35,0x5b,0x60,0x74,0x4a,0x53,0x34,0x96,0x8a,0x3d,0x19,0x4b,0x72,0xff,0xba,0x4a,0xbc,0x73,0xdf,0xe3,0x30,0x23,0x2d,0x1a,0x5f,0xe9,0x32,0x0e,
+	0x52,0xf3,0x05,0x91,0x46,0xf0,0xa5,0x1c,0x0b,0x90,0xa7,0xcf,0x1b,0x09,0x64,0xd0,0x20,0xe6,0xb6,0xba,0x93,0xdb,0x74,0xb8,0xf6,0x12,0x00,0xc4,0xd5,0xe0,0x54,0xd1,
+	0xed,0x6f,0x3a,0x72,0x0e,0xba,0xb1,0xdc,0x9a,0x43,0x86,0x29,0xf7,0x47,0x87,0x2c,0xb6,0xcf,0xd9,0xef,0x9e,0x98,0x22,0x0d,0xb8,0x0f,0x80,0x2a,0xf0,0x10,0xd6,0xdf,
+	0x3d,0xa1,0xef,0x20,0x82,0xa4,0xa2,0xbf,0x77,0xd2,0x14,0xdf,0x3f,0x39,0xbe,0xc0,0xcd,0x20,0x97,0xcc,0x7d,0xb9,0xac,0x93,0xe4,0x36,0x01,0x4c,0x42,0x19,0x21,0x3d,
+	0x9a,0x80,0x32,0x2a,0x91,0x40,0x23,0xe0,0x32,0xc0,0x82,0x0e,0x0c,0x5c,0x28,0x7f,0xa1,0x49,0x10,0xd8,0x12,0x4f,0x4b,0x19,0x77,0x41,0x29,0x21,0x06,0xea,0x7c,0x90,
+	0xe5,0xd7,0xb9,0xaf,0xb5,0xe1,0x1c,0xf4,0x45,0xe0,0xd3,0xad,0x65,0x95,0x92,0x81,0xae,0x94,0x60,0xcd,0x14,0x19,0xcf,0xc0,0x20,0xc1,0x05,0x63,0x9f,0x74,0xf1,0xc5,
+	0x02,0x63,0x5a,0xa3,0xd0,0x0b,0xa7,0x32,0x1c,0x34,0xc3,0x40,0xe0,0xd0,0x1b,0x5d,0x81,0x04,0x87,0xf8,0xdc,0x15,0x13,0xb2,0x94,0x98,0x20,0x62,0x15,0xa4,0x48,0x8c,
+	0x73,0xdf,0x90,0xc9,0x33,0xa9,0x50,0x4d,0xab,0xc2,0xba,0x21,0x8f,0xa2,0xc3,0xfd,0x1b,0x81,0x52,0x9b,0x81,0x75,0x02,0xd5,0x40,0x2b,0xe7,0x24,0x9b,0xa5,0x20,0x33,
+	0x29,0xc9,0xd2,0x9f,0xdc,0x91,0x82,0x2d,0x18,0x2e,0x60,0xef,0xc6,0xe0,0xa0,0x2b,0x93,0x29,0xe9,0x91,0x9b,0x0c,0xee,0xd4,0x62,0x72,0x7f,0x46,0x1f,0x5e,0x2f,0x8c,
+	0xb3,0x21,0x5d,0x84,0xc9,0xc0,0xac,0xee,0xa2,0x41,0xcf,0x57,0x33,0xbe,0x44,0x2f,0xab,0x2a,0xa0,0xd9,0xbd,0x92,0xe7,0xc9,0x00,0xd6,0x25,0xca,0xfa,0x9e,0x98,0xe0,
+	0x13,0x78,0xc5,0x39,0x69,0xa0,0xe7,0xa7,0x90,0xef,0xdc,0x26,0x5a,0x32,0xa6,0x99,0x72,0xff,0xc1,0x93,0x17,0xa9,0x56,0xc7,0x4d,0x8f,0xae,0x32,0xa1,0x43,0x78,0xc4,
+	0x4c,0x92,0xab,0x3f,0xf4,0xe9,0xb0,0xa9,0xe6,0xd4,0x77,0x27,0x3e,0xd2,0x6a,0x78,0x18,0xb2,0x9e,0x4f,0xa0,0x61,0xa1,0x9c,0x0b,0x5c,0xd9,0xda,0x29,0x9f,0x22,0x16,
+	0xc0,0x7e,0xdf,0x9e,0x92,0xd2,0x5c,0x4d,0x43,0xe2,0xe0,0x03,0xe4,0xfa,0x54,0xfb,0x7d,0xf0,0xb4,0xc2,0xa9,0x78,0xf4,0xe0,0x59,0x25,0x25,0x33,0x55,0xe9,0x45,0x99,
+	0xa2,0x3d,0xf8,0x0b,0x14,0xe4,0x53,0x8a,0xbb,0x06,0xfc,0xdc,0xce,0x2c,0xdf,0x83,0xbf,0xda,0x23,0x3b,0x85,0xff,0x61,0x0f,0x20,0x0a,0x01,0xd2,0x57,0x00,0x5d,0x45,
+	0x15,0x3b,0xce,0x1e,0xbc,0x70,0x17,0xea,0x0a,0xed,0xbf,0x7b,0x91,0x0a,0x02,0xf6,0xe0,0x65,0x1f,0x86,0x56,0x4d,0xd9,0xc3,0x87,0x6d,0x15,0x4e,0x16,0x02,0x9e,0x81,
+	0xaa,0x26,0xf9,0x17,0x06,0xd5,0x49,0xf2,0x2f,0x8d,0x60,0xc6,0xa1,0x10,0xe8,0xcf,0xc8,0x5c,0xe7,0x5f,0x19,0x30,0x5d,0x8b,0x88,0xe5,0x9f,0x1b,0x9f,0x12,0x88,0xb6,
+	0x6e,0xd5,0x50,0x10,0x10,0xfb,0x13,0x18,0xe7,0x84,0x40,0x44,0x44,0x34,0xf8,0xc2,0xe4,0x13,0x7f,0xcc,0xc7,0x1a,0xca,0xde,0xe2,0xf2,0xaf,0x4d,0x1c,0x96,0xe5,0x9f,
+	0x52,0x4c,0x05,0x4f,0xa5,0xa1,0x08,0x3a,0x1d,0xb0,0xfc,0x0f,0xa6,0x80,0xf1,0xc5,0x02,0x2f,0x11,0x5e,0xf9,0x53,0xd8,0xed,0xfc,0x56,0xf6,0x02,0xc6,0xf2,0x25,0x78,
+	0x07,0x38,0x9f,0xfc,0x96,0xe5,0x2b,0x39,0xe4,0x41,0x4c,0xd4,0xbc,0xc9,0xde,0x92,0x14,0xd6,0xaf,0xd0,0x9b,0xdf,0x08,0x96,0x21,0xff,0xb2,0xe2,0x53,0xf8,0x91,0x2f,
+	0x55,0x24,0xdc,0x7d,0xfe,0x75,0x05,0x3e,0x12,0xed,0xf3,0x4a,0x0a,0x1f,0x11,0x12,0xa9,0xdb,0x35,0x4c,0x9e,0xa4,0xe4,0xd5,0xf2,0x3b,0x75,0x18,0x09,0x34,0x0d,0x31,
+	0xc4,0xdd,0x81,0x9a,0x06,0x6c,0x80,0x2f,0x07,0xb6,0x0c,0x7d,0x96,0x2f,0xd3,0x83,0xc0,0x40,0x3f,0x08,0xd0,0xc8,0x25,0x4e,0xb2,0xd5,0x8c,0x70,0x59,0x31,0x68,0xdb,
+	0x3d,0xa2,0x78,0x8d,0x16,0xd9,0x3b,0x82,0xb9,0x9e,0x53,0xac,0x97,0xdf,0x3f,0x42,0x80,0x13,0x6b,0x95,0xcd,0x1f,0xb4,0xf8,0x90,0xce,0xf5,0x0a,0xc1,0xd6,0xc8,0xe7,
+	0x24,0xab,0xf9,0xb7,0x2d,0x72,0x86,0x88,0x93,0xf2,0xef,0x5a,0x3c,0xf1,0xc1,0xd4,0x31,0xb8,0x51,0x42,0x10,0x16,0x8e,0x17,0x50,0xeb,0xfc,0xfb,0x96,0x0a,0x60,0x93,
+	0x00,0x3d,0x85,0xe5,0x8c,0x43,0xb5,0xe0,0x11,0xed,0xb6,0xd5,0xa2,0xc8,0x0f,0x12,0x3c,0xc3,0x46,0xba,0x8b,0x55,0x88,0xae,0x17,0xcb,0xd2,0x7e,0xfe,0x03,0x55,0xd0,
+	0xb1,0x58,0xd1,0xa6,0x78,0x88,0xf8,0xf3,0x37,0x1b,0x14,0xc2,0x04,0x61,0xfe,0x7f,0xc0,0x70,0x4a,0x08,0x64,0xfe,0xb5,0x9d,0xc6,0x23,0xba,0xa5,0x6d,0x87,0x0a,0x49,
+	0x92,0x36,0xa2,0x68,0x69,0x9a,0x5e,0x87,0x42,0x9f,0x4b,0x77,0x63,0x39,0x94,0x7a,0xdf,0x97,0xc7,0x33,0x6a,0x9e,0x1f,0xc3,0x8c,0x63,0xac,0xe3,0xc3,0x90,0x0e,0x3a,
+	0x82,0xb8,0xb3,0xdb,0x21,0x3b,0x0f,0xd1,0xc7,0xf8,0x8f,0x9d,0x05,0x09,0x10,0xd7,0x14,0x65,0x85,0xd5,0xfc,0xf3,0x8f,0x8b,0xeb,0x45,0x40,0xef,0x16,0xc0,0x75,0xe5,
+	0x82,0x8f,0xf1,0x51,0xd1,0xe5,0x53,0x1f,0x9e,0x0c,0xe4,0x3d,0x77,0xc9,0x50,0x4d,0xa9,0x80,0x96,0xff,0xd1,0x15,0x8a,0x78,0xf5,0xc1,0x05,0x27,0x26,0x3e,0xdd,0xd8,
+	0xd6,0x6d,0xa1,0x11,0x5f,0x45,0x62,0x1c,0x8a,0xa9,0x0a,0x16,0x9a,0x9c,0x0f,0x1e,0x87,0xee,0xd0,0xb5,0x7a,0x9c,0x44,0x05,0xca,0x9a,0x7f,0xed,0x0d,0x71,0xe3,0x31,
+	0x90,0xff,0xe9,0x09,0x48,0x1b,0xc9,0xaf,0xe7,0xcb,0xd9,0x1c,0xb1,0x65,0xfe,0xd0,0x53,0xd3,0x05,0x04,0xe5,0x29,0xc2,0x41,0xcd,0xce,0x1e,0x82,0xeb,0x70,0xc8,0x33,
+	0x4a,0x5f,0xf6,0xa2,0x74,0xf6,0x09,0x5f,0x3e,0xeb,0xc5,0x49,0xc9,0x21,0x55,0xc9,0x3f,0xed,0x4b,0xa1,0x8f,0x87,0xed,0x9f,0xf5,0x03,0x04,0xa9,0x97,0x99,0xae,0xe4,
+	0x4b,0x5a,0x5f,0x69,0x95,0xbf,0x9f,0x82,0x58,0x12,0x9b,0xe7,0xa7,0x02,0x97,0x06,0xc7,0x12,0x6a,0xff,0x9a,0x7f,0x7d,0x2a,0x10,0x2d,0x83,0x84,0x47,0x7f,0x32,0xae,
+	0xc9,0x66,0xb1,0x47,0xdf,0xdf,0xbc,0x23,0x3f,0xfa,0x89,0x1e,0x62,0x11,0xf1,0x3f,0x32,0xe8,0x21,0x76,0x90,0x3d,0xc4,0x3e,0xfa,0x49,0xbf,0xf0,0xa1,0xb5,0x11,0x14,
+	0x48,0x50,0xf0,0x88,0x75,0xc5,0x62,0x7a,0xc1,0xc9,0xfb,0x3e,0xfa,0xa3,0x2e,0x94,0x0e,0x6e,0x5e,0xe2,0x1e,0x31,0x98,0xad,0x65,0xb1,0xf9,0xd1,0x86,0x9b,0x70,0x18,
+	0xdf,0x05,0x7b,0x6c,0x42,0x6d,0x03,0x0e,0xaf,0xc4,0x1e,0x5b,0x66,0x24,0x63,0x1d,0x63,0x3f,0x36,0xcd,0x48,0x81,0x45,0x83,0x06,0xac,0x06,0x7b,0xfc,0x17,0xb2,0x6e,
+	0xb0,0x18,0x8f,0x2b,0xc8,0x33,0xae,0x70,0x0f,0x8f,0xab,0xd5,0x74,0x04,0xd1,0x78,0xfc,0x97,0x06,0x82,0xd6,0x28,0xc1,0xb7,0x6d,0x84,0xc6,0x82,0x14,0xfe,0x71,0xad,
+	0x8d,0xfb,0x1b,0x34,0xe0,0x98,0x31,0x6e,0x8b,0x80,0x5e,0x6b,0x68,0xcd,0x7a,0x07,0xfe,0xc1,0x07,0xce,0x5d,0xe0,0x5e,0x16,0x6c,0x8d,0xb2,0xc1,0xec,0xf7,0x87,0x1d,
+	0xb6,0x66,0x50,0x5b,0x66,0x6b,0x0d,0xdd,0x02,0xd1,0xd4,0x00,0x30,0x47,0x1a,0xd8,0x65,0x6b,0x7f,0x24,0x00,0xed,0x06,0xb5,0x7b,0x6c,0xed,0x6b,0x6a,0xf7,0xd9,0xda,
+	0x37,0xd4,0x1e,0xb0,0xb5,0x16,0xb5,0x6f,0xd9,0x5a,0x9b,0xda,0x77,0x6c,0xcd,0xa6,0xf6,0x3d,0x5b,0x73,0xa8,0xfd,0x90,0x6d,0x55,0xc2,0xca,0x0f,0xa8,0xc5,0xc2,0xcf,
+	0x74,0x0b,0x44,0x51,0x03,0xc0,0xbc,0xd2,0x00,0xb6,0x38,0xd6,0x00,0xf6,0xe8,0x68,0x00,0x9b,0x7c,0x24,0x00,0x23,0x2f,0xa8,0xc5,0xc0,0x6b,0x6a,0x81,0x7f,0x4e,0x2d,
+	0x36,0x7f,0x49,0x2d,0x36,0x7f,0x4a,0x2d,0x36,0xdf,0xa2,0x16,0x9b,0x97,0xa8,0x5d,0x6e,0xbe,0x43,0x0d,0x3d,0x74,0x52,0xb5,0x9a,0xad,0x75,0x7b,0x96,0x47,0xbf,0x9e,
+	0x45,0xbf,0x21,0x39,0x47,0xd8,0x01,0xc0,0x67,0x69,0x90,0xb2,0xf5,0x87,0xc6,0x8c,0xca,0x96,0x63,0x64,0x74,0x80,0x97,0xff,0x92,0x58,0x7f,0x6d,0x50,0xa5,0x10,0x0a,
+	0x11,0xb2,0xf5,0x6d,0x03,0x46,0x1a,0x4e,0x6b,0xfd,0x21,0xfd,0x19,0x21,0x82,0x14,0x68,0x30,0x22,0x5d,0x01,0x40,0xaf,0x10,0x71,0x80,0xc8,0x4f,0x77,0xd2,0x38,0x46,
+	0x28,0x8a,0x8f,0x4c,0xd8,0x01,0x4e,0x01,0x32,0xa1,0x21,0x5e,0xf3,0x1b,0x30,0x86,0xf6,0xc0,0x86,0xaf,0xbb,0x30,0x67,0x80,0x39,0xd1,0x60,0xa9,0x39,0x34,0x97,0x6b,
+	0xbc,0x57,0xa1,0x3a,0x37,0x2d,0x7d,0xfb,0x84,0xbb,0xde,0x5b,0xbd,0xc1,0xae,0x6f,0x43,0xbc,0xf0,0xdd,0x54,0x02,0x4b,0xcf,0x96,0x14,0x2b,0xd0,0xb3,0xe5,0xfa,0x8b,
+	0x26,0x55,0x7b,0xc9,0xb2,0xad,0xf7,0x96,0xcf,0x93,0xeb,0x8f,0x5a,0xa4,0xd2,0xd8,0x11,0x64,0xe3,0xd3,0x96,0x14,0x97,0x6c,0xbd,0xdf,0x42,0x0e,0x87,0xf6,0xa7,0x36,
+	0x24,0x51,0xd1,0x4e,0xed,0x0b,0xec,0x79,0x41,0xce,0x72,0xbd,0x07,0x87,0x33,0xce,0x90,0xb7,0xaf,0x80,0xeb,0x0f,0x21,0xfc,0x88,0xce,0x34,0x40,0xd9,0xd0,0xfa,0x36,
+	0xc5,0x79,0xc2,0xe7,0x33,0xda,0x18,0x46,0x19,0x5a,0x87,0xb1,0xec,0x8d,0x6d,0xbd,0x6f,0xab,0x78,0xa4,0xae,0x80,0x39,0x8e,0x11,0x1f,0xac,0x3f,0x44,0xec,0x23,0x89,
+	0x81,0x1d,0x35,0x9e,0x28,0x5d,0xf2,0x05,0x4c,0x39,0x1b,0x58,0xb9,0xdd,0x85,0x1f,0x47,0xbf,0x4b,0x61,0xd7,0xfa,0x6b,0x6d,0x7b,0xa8,0x4f,0x39,0xd6,0xf2,0xc5,0x84,
+	0x3a,0x11,0xbf,0x10,0xc8,0x1d,0x69,0x02,0x38,0x4e,0xe4,0xf7,0x5d,0x39,0x3b,0x17,0x91,0x42,0x60,0x4d,0x33,0xa6,0x6a,0x7e,0x41,0xcb,0xb9,0xea,0x5c,0xea,0xef,0x13,
+	0x35,0x9a,0xfa,0x2a,0xc0,0xbd,0x6e,0x7b,0x54,0xae,0x0e,0xe9,0x50,0x1e,0x34,0x38,0xa4,0x7d,0x7a,0x01,0x8c,0xa2,0xba,0x24,0xba,0xb7,0x7b,0xd7,0x3e,0xc8,0x52,0x74,
+	0xbc,0x3e,0x1f,0xa7,0xd7,0xba,0xd5,0x4f,0xd2,0x04,0xc1,0xdc,0x10,0x63,0xb6,0xfb,0x32,0x08,0xe9,0x29,0x72,0xbd,0xdf,0x57,0xc1,0x44,0x65,0x2c,0x7d,0x78,0x02,0x37,
+	0xc0,0xe9,0xa8,0x67,0x7c,0x12,0x89,0x21,0xe6,0x9d,0x91,0x6d,0x54,0xd7,0xfe,0x82,0xe4,0xe4,0x2c,0x8d,0x48,0x0a,0x37,0x72,0x54,0x9b,0x0e,0xc9,0xbe,0xc0,0x5c,0xb1,
+	0x8d,0x97,0x96,0xaf,0xf3,0xf7,0x8d,0xa7,0xab,0xff,0x68,0xb0,0x8d,0xbf,0xeb,0x3f,0x67,0x60,0x6e,0xf6,0xff,0x0b,0xb6,0xf1,0xbc,0x25,0x22,0xf0,0x08,0xd6,0x84,0x6d,
+	0xbc,0xb6,0xb9,0x2f,0x80,0x5a,0xbd,0xac,0x12,0xe6,0xe6,0x75,0x74,0x23,0x77,0xf3,0x3a,0xba,0xf1,0xfa,0xe6,0xd5,0xac,0x70,0x6c,0xd0,0xff,0x17,0x0a,0x7f,0x35,0xd2,
+	0x91,0xfe,0xff,0x02,0x2b,0x14,0x4d,0x64,0xe3,0xf0,0xf6,0x59,0x98,0x52,0x38,0x01,0x11,0x48,0x8a,0x66,0xac,0xf0,0xcc,0xf2,0x29,0x8a,0x2d,0xfc,0x5c,0xe5,0xa4,0x0c,
+	0x98,0x59,0x3d,0x87,0xd9,0xc4,0x1a,0x55,0x0a,0xa8,0x60,0x3b,0x17,0x80,0x6b,0xf0,0x5a,0xea,0x5c,0xb1,0xc2,0x2b,0xfd,0x27,0x07,0x34,0x69,0xc8,0xcf,0xa9,0x00,0x52,
+	0x68,0x21,0x5f,0xe6,0x73,0x7d,0xa4,0x82,0xa3,0xff,0x9f,0xa0,0x57,0xa1,0x44,0x8a,0x07,0xe0,0x23,0x14,0xae,0x70,0xaa,0xff,0x5a,0x50,0x38,0x83,0xef,0x46,0xd8,0x09,
+	0xdd,0x2b,0x74,0xe8,0x79,0x3c,0x41,0xc6,0x41,0x4b,0x14,0x5b,0x8a,0x9e,0xdd,0xb1,0x6c,0xeb,0x8a,0x5f,0xc0,0x53,0x43,0x07,0x0a,0xaf,0x6c,0x7e,0x91,0x82,0x15,0x85,
+	0xff,0x82,0x28,0x20,0xf4,0x8f,0xc1,0xa7,0xc2,0x3f,0x6c,0x39,0xa6,0xe7,0xcc,0xc2,0xab,0xec,0xed,0xb5,0xd0,0xd4,0x4f,0xa2,0x85,0xff,0x5e,0x3e,0x89,0x62,0x2d,0x47,
+	0xa5,0x33,0x81,0xc3,0xff,0xa3,0x03,0x9a,0x06,0xf4,0xc3,0x0a,0xa5,0xec,0xa9,0xb3,0x60,0xaf,0x1e,0x23,0x0b,0xc5,0x0e,0xc2,0x51,0xf2,0x57,0x85,0x67,0x3a,0xec,0xb6,
+	0xb3,0x30,0x96,0x15,0x1a,0x5d,0x18,0xfd,0x44,0x3f,0x0e,0x15,0x4e,0x5d,0xf8,0x34,0x88,0x42,0xa1,0xe1,0x21,0x63,0x27,0x52,0x5f,0x79,0x90,0x41,0x84,0x6b,0x85,0xec,
+	0xfd,0x28,0x41,0x8c,0x01,0xe4,0x09,0x9f,0x0a,0xdd,0xd0,0xd3,0x08,0xfb,0x7f,0x92,0x32,0x2f,0xf7,0xbc,0x25,0x00,0x00,
+};
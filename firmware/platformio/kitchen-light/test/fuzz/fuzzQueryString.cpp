@@ -0,0 +1,58 @@
+// core includes
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// project includes
+#include "queryString.h"
+#include "conf.h"
+
+/* libFuzzer target (env:fuzz), whole input is a request target as web server hands it over.
+ * Checks what setup handler relies on: both pointers stay inside the buffer, length is what copy uses,
+ * copy refuses exactly the values longer than destination, and tokenizer always ends.
+ */
+
+#define FUZZ_DESTINATION_LENGTH 16
+
+void check(bool condition)
+{
+    if(!condition)
+    {
+        abort();
+    }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    char target[WEB_SERVER_MAX_TARGET_LENGTH + 1];
+    char destination[FUZZ_DESTINATION_LENGTH + 1];
+    QueryParameter parameter;
+    size_t parameters = 0;
+
+    if(size > WEB_SERVER_MAX_TARGET_LENGTH)
+    {
+        return 0;
+    }
+
+    memcpy(target, data, size);
+    target[size] = '\0';
+
+    char *end = target + strlen(target);
+    char *cursor = findQueryString(target);
+
+    while(nextQueryParameter(&cursor, &parameter))
+    {
+        check(parameter.key >= target && parameter.key <= end);
+        check(parameter.value >= target && parameter.value + parameter.valueLength <= end);
+        check(strlen(parameter.value) == parameter.valueLength);
+        check(cursor >= target && cursor <= end);
+
+        bool copied = copyQueryValue(&parameter, destination, FUZZ_DESTINATION_LENGTH);
+
+        check(copied == (parameter.valueLength <= FUZZ_DESTINATION_LENGTH));
+        check(!copied || strcmp(destination, parameter.value) == 0);
+        check(++parameters <= size); // every parameter takes at least one character
+    }
+
+    return 0;
+}
@@ -0,0 +1,260 @@
+// core includes
+#include <Arduino.h>
+#include <atomic>
+#include <string>
+#include <vector>
+
+// project includes
+#include "deferredLog.h"
+#include "metrics.h"
+#include "sim.h"
+#include "conf.h"
+
+// lib includes
+#include <unity.h>
+
+/* Deferred log ring with its log task running on the simulator, printed lines are caught from the console.
+ * A scripted task pushes records in phases, two more push at once at the end.
+ * Simulator is cooperative on one host thread, so producers interleave between records, never inside a compare exchange,
+ * that part relies on the atomics themselves. Whole script runs once, tests then check what it recorded.
+ */
+
+#define EARLY_RECORDS 3 // pushed before log task exists
+#define ORDER_RECORDS 10
+#define WRAP_ROUNDS 10 // of half a ring each, the ring goes around 5 times
+#define OVERFLOW_RECORDS 5 // over the ring size, pushed while log task has no chance to run
+#define PRODUCER_RECORDS 100 // per producer
+#define LOG_TASK_TURN_MS 10 // script sleeps this long to let log task print everything
+#define TEST_RUN_US (60 * SIM_US_PER_S)
+
+// ring positions, kept by deferredLog.cpp
+extern std::atomic<uint32_t> logHead;
+extern uint32_t logTail;
+
+std::vector<std::string> lines;
+uint32_t pushed = 0; // by the script, not counting records it expects to be dropped
+uint32_t logDroppedBefore = 0; // metric, when overflow phase started
+bool scriptDone = false;
+uint8_t producersDone = 0;
+
+void catchLine(const char *line)
+{
+    lines.push_back(line);
+}
+
+// lines starting with prefix, in order they were printed
+std::vector<std::string> linesStartingWith(const char *prefix)
+{
+    std::vector<std::string> found;
+
+    for(const std::string &line : lines)
+    {
+        if(line.compare(0, strlen(prefix), prefix) == 0)
+        {
+            found.push_back(line);
+        }
+    }
+
+    return found;
+}
+
+uint32_t metricValue(const char *name)
+{
+    static char text[METRICS_TEXT_MAX_SIZE];
+    char line[64];
+
+    renderMetrics(text, sizeof(text));
+    snprintf(line, sizeof(line), "\n%s ", name);
+
+    const char *found = strstr(text, line);
+
+    return (found != NULL) ? (uint32_t)strtoul(found + strlen(line), NULL, 10) : 0;
+}
+
+void producer(void *parameters)
+{
+    const char *format = (const char*)parameters;
+
+    for(uint32_t i = 0; i < PRODUCER_RECORDS; i++)
+    {
+        deferLog(format, i);
+        delay(i % 3); // both on the same turn now and then, log task in between some of them
+    }
+
+    producersDone++;
+
+    for(;;)
+    {
+        delay(SCHEDULER_MAX_IDLE_MS);
+    }
+}
+
+void scriptedLogging(void *parameters)
+{
+    for(uint32_t i = 0; i < EARLY_RECORDS; i++)
+    {
+        deferLog("EARLY %lu", i);
+    }
+
+    beginDeferredLog();
+    delay(LOG_TASK_TURN_MS);
+
+    for(uint32_t i = 0; i < ORDER_RECORDS; i++)
+    {
+        deferLog("ORDER %lu %s %ld", i, "text", -(long)i);
+    }
+
+    delay(LOG_TASK_TURN_MS);
+
+    for(uint32_t round = 0; round < WRAP_ROUNDS; round++)
+    {
+        for(uint32_t i = 0; i < LOG_RING_SIZE / 2; i++)
+        {
+            deferLog("WRAP %lu", round * (LOG_RING_SIZE / 2) + i);
+        }
+
+        delay(LOG_TASK_TURN_MS);
+    }
+
+    logDroppedBefore = metricValue("light_log_dropped_total");
+
+    for(uint32_t i = 0; i < LOG_RING_SIZE + OVERFLOW_RECORDS; i++)
+    {
+        deferLog("OVERFLOW %lu", i);
+    }
+
+    delay(LOG_TASK_TURN_MS);
+
+    pushed = EARLY_RECORDS + ORDER_RECORDS + WRAP_ROUNDS * (LOG_RING_SIZE / 2) + LOG_RING_SIZE;
+
+    xTaskCreatePinnedToCore(producer, "producer A", 4096, (void*)"PRODUCER A %lu", 1, NULL, 0);
+    xTaskCreatePinnedToCore(producer, "producer B", 4096, (void*)"PRODUCER B %lu", 1, NULL, 1);
+
+    while(producersDone < 2)
+    {
+        delay(LOG_TASK_TURN_MS);
+    }
+
+    delay(LOG_TASK_TURN_MS);
+    pushed += 2 * PRODUCER_RECORDS;
+    scriptDone = true;
+    simStop("script done");
+
+    for(;;)
+    {
+        delay(SCHEDULER_MAX_IDLE_MS);
+    }
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void expectNumbered(const char *prefix, uint32_t count)
+{
+    std::vector<std::string> found = linesStartingWith(prefix);
+    char expected[64];
+
+    TEST_ASSERT_EQUAL_UINT32(count, found.size());
+
+    for(uint32_t i = 0; i < found.size(); i++)
+    {
+        snprintf(expected, sizeof(expected), "%s%lu", prefix, (unsigned long)i);
+        TEST_ASSERT_EQUAL_STRING(expected, found[i].c_str());
+    }
+}
+
+void test_script_completes()
+{
+    TEST_ASSERT_TRUE(scriptDone);
+    TEST_ASSERT_EQUAL_STRING("script done", simStopReason());
+}
+
+// zero initialized ring is free for the first lap, so nothing pushed before begin is lost
+void test_records_before_begin()
+{
+    expectNumbered("EARLY ", EARLY_RECORDS);
+}
+
+void test_order_and_arguments()
+{
+    std::vector<std::string> found = linesStartingWith("ORDER ");
+
+    TEST_ASSERT_EQUAL_UINT32(ORDER_RECORDS, found.size());
+    TEST_ASSERT_EQUAL_STRING("ORDER 0 text 0", found[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("ORDER 9 text -9", found[9].c_str());
+}
+
+// every slot is taken again on later laps, sequence tells the laps apart
+void test_wraparound()
+{
+    expectNumbered("WRAP ", WRAP_ROUNDS * (LOG_RING_SIZE / 2));
+}
+
+// full ring keeps what it has and drops the new ones, drop is reported once, after the records
+void test_overflow_drops_newest()
+{
+    std::vector<std::string> dropped = linesStartingWith("LOG: DROPPED ");
+    std::vector<std::string> overflow = linesStartingWith("OVERFLOW ");
+
+    expectNumbered("OVERFLOW ", LOG_RING_SIZE);
+    TEST_ASSERT_EQUAL_UINT32(1, dropped.size());
+    TEST_ASSERT_EQUAL_STRING("LOG: DROPPED 5", dropped[0].c_str());
+    TEST_ASSERT_EQUAL_UINT32(logDroppedBefore + OVERFLOW_RECORDS, metricValue("light_log_dropped_total"));
+
+    for(uint32_t i = 0; i < lines.size(); i++)
+    {
+        if(lines[i] == dropped[0])
+        {
+            TEST_ASSERT_TRUE(i > 0 && lines[i - 1] == overflow.back());
+        }
+    }
+}
+
+// both producers get every record printed exactly once, each in its own order
+void test_two_producers()
+{
+    uint32_t switches = 0;
+    char previous = '\0';
+
+    expectNumbered("PRODUCER A ", PRODUCER_RECORDS);
+    expectNumbered("PRODUCER B ", PRODUCER_RECORDS);
+
+    // they did push at once, not one after the other
+    for(const std::string &line : linesStartingWith("PRODUCER "))
+    {
+        switches += (previous != '\0' && line[9] != previous) ? 1 : 0;
+        previous = line[9];
+    }
+
+    TEST_ASSERT_GREATER_THAN_UINT32(PRODUCER_RECORDS / 2, switches);
+}
+
+// ring positions agree with what was pushed (dropped records take no position)
+void test_positions()
+{
+    TEST_ASSERT_EQUAL_UINT32(pushed, logHead.load());
+    TEST_ASSERT_EQUAL_UINT32(pushed, logTail);
+}
+
+int main(int argc, char **argv)
+{
+    simConsoleListener = catchLine;
+    xTaskCreatePinnedToCore(scriptedLogging, "loopTask", 8192, NULL, 1, NULL, 1);
+    simRun(TEST_RUN_US);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_script_completes);
+    RUN_TEST(test_records_before_begin);
+    RUN_TEST(test_order_and_arguments);
+    RUN_TEST(test_wraparound);
+    RUN_TEST(test_overflow_drops_newest);
+    RUN_TEST(test_two_producers);
+    RUN_TEST(test_positions);
+
+    return UNITY_END();
+}
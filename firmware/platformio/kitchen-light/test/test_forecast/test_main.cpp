@@ -0,0 +1,175 @@
+// core includes
+#include <Arduino.h>
+#include <stdlib.h>
+#include <time.h>
+
+// project includes
+#include "forecast.h"
+#include "conf.h"
+
+// lib includes
+#include <unity.h>
+
+/* Forecast ring (consecutive 3-hourly samples, oldest overwritten) and its daily summary for the forecast screen.
+ * Samples are made up: temperature tells which sample it is, so min/max of a day show which samples were grouped into it.
+ */
+
+#define MIDNIGHT_UTC 1700006400 // 2023-11-15 00:00:00 UTC, Wednesday
+#define SAMPLES_PER_DAY (86400 / FORECAST_SAMPLE_PERIOD_S)
+
+ForecastRing ring;
+
+void setUp()
+{
+    memset(&ring, 0, sizeof(ring));
+    setenv("TZ", "UTC0", 1);
+    tzset();
+}
+
+void tearDown()
+{
+}
+
+// temperature is index of the sample in 0.1 °C, weather of the noon sample differs from the rest of the day
+ForecastSample makeSample(uint16_t index, uint32_t epoch)
+{
+    ForecastSample sample;
+    time_t sampleTime = (time_t)epoch;
+    struct tm timeInfo;
+
+    localtime_r(&sampleTime, &timeInfo);
+
+    sample.temperature_dC = (int16_t)index;
+    sample.humidity = 50;
+    sample.windSpeed = 3;
+    sample.weather = (uint8_t)((timeInfo.tm_hour == FORECAST_DAY_WEATHER_HOUR) ? Weather::CLEAR_SKY_DAY : Weather::RAIN_DAY);
+
+    return sample;
+}
+
+void fillRing(uint32_t firstEpoch, uint16_t samples)
+{
+    for(uint16_t i = 0; i < samples; i++)
+    {
+        uint32_t epoch = firstEpoch + (uint32_t)i * FORECAST_SAMPLE_PERIOD_S;
+        ForecastSample sample = makeSample(i, epoch);
+
+        TEST_ASSERT_TRUE(forecastPush(&ring, epoch, &sample));
+    }
+}
+
+void test_push_and_get()
+{
+    ForecastSample sample;
+    uint32_t epoch;
+
+    TEST_ASSERT_FALSE(forecastGet(&ring, 0, &sample, &epoch));
+
+    fillRing(MIDNIGHT_UTC, 3);
+
+    TEST_ASSERT_EQUAL_UINT8(3, ring.count);
+    TEST_ASSERT_TRUE(forecastGet(&ring, 2, &sample, &epoch));
+    TEST_ASSERT_EQUAL_UINT32(MIDNIGHT_UTC + 2 * FORECAST_SAMPLE_PERIOD_S, epoch);
+    TEST_ASSERT_EQUAL(2, sample.temperature_dC);
+    TEST_ASSERT_FALSE(forecastGet(&ring, 3, &sample, &epoch));
+}
+
+void test_gap_and_order_refused()
+{
+    ForecastSample sample = makeSample(99, MIDNIGHT_UTC);
+
+    fillRing(MIDNIGHT_UTC, 2);
+
+    TEST_ASSERT_FALSE(forecastPush(&ring, MIDNIGHT_UTC + 3 * FORECAST_SAMPLE_PERIOD_S, &sample)); // one missing
+    TEST_ASSERT_FALSE(forecastPush(&ring, MIDNIGHT_UTC + FORECAST_SAMPLE_PERIOD_S, &sample)); // again
+    TEST_ASSERT_FALSE(forecastPush(&ring, MIDNIGHT_UTC + 2 * FORECAST_SAMPLE_PERIOD_S + 60, &sample)); // off the grid
+    TEST_ASSERT_EQUAL_UINT8(2, ring.count);
+
+    forecastClear(&ring);
+    TEST_ASSERT_EQUAL_UINT8(0, ring.count);
+    TEST_ASSERT_TRUE(forecastPush(&ring, MIDNIGHT_UTC + 60, &sample)); // empty ring takes any epoch
+}
+
+void test_full_ring_drops_oldest()
+{
+    ForecastSample sample;
+    uint32_t epoch;
+
+    fillRing(MIDNIGHT_UTC, FORECAST_MAX_SAMPLES + 5);
+
+    TEST_ASSERT_EQUAL_UINT8(FORECAST_MAX_SAMPLES, ring.count);
+    TEST_ASSERT_EQUAL_UINT32(MIDNIGHT_UTC + 5 * FORECAST_SAMPLE_PERIOD_S, ring.firstEpoch);
+
+    for(uint8_t i = 0; i < FORECAST_MAX_SAMPLES; i++)
+    {
+        TEST_ASSERT_TRUE(forecastGet(&ring, i, &sample, &epoch));
+        TEST_ASSERT_EQUAL(i + 5, sample.temperature_dC);
+        TEST_ASSERT_EQUAL_UINT32(MIDNIGHT_UTC + (uint32_t)(i + 5) * FORECAST_SAMPLE_PERIOD_S, epoch);
+    }
+}
+
+void test_daily_summary()
+{
+    ForecastDay days[FORECAST_MAX_SAMPLES];
+
+    fillRing(MIDNIGHT_UTC, FORECAST_MAX_SAMPLES); // exactly 5 days
+
+    TEST_ASSERT_EQUAL_UINT8(5, forecastDailySummary(&ring, MIDNIGHT_UTC, days, FORECAST_MAX_SAMPLES));
+
+    for(uint8_t i = 0; i < 5; i++)
+    {
+        TEST_ASSERT_EQUAL((int)MIDNIGHT_UTC + i * 86400, (int)days[i].epoch);
+        TEST_ASSERT_EQUAL(i * SAMPLES_PER_DAY, days[i].minTemperature_dC);
+        TEST_ASSERT_EQUAL(i * SAMPLES_PER_DAY + SAMPLES_PER_DAY - 1, days[i].maxTemperature_dC);
+        TEST_ASSERT_EQUAL(Weather::CLEAR_SKY_DAY, days[i].weather); // from noon
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(2, forecastDailySummary(&ring, MIDNIGHT_UTC, days, 2)); // screen has room for fewer
+}
+
+// samples over are skipped, the one in progress still counts
+void test_daily_summary_skips_past()
+{
+    ForecastDay days[FORECAST_MAX_SAMPLES];
+    time_t now = MIDNIGHT_UTC + 86400 + 13 * 3600; // Thursday 13:00, noon sample is over
+
+    fillRing(MIDNIGHT_UTC, FORECAST_MAX_SAMPLES);
+
+    TEST_ASSERT_EQUAL_UINT8(4, forecastDailySummary(&ring, now, days, FORECAST_MAX_SAMPLES));
+    TEST_ASSERT_EQUAL((int)(MIDNIGHT_UTC + 86400 + 12 * 3600), (int)days[0].epoch); // 12:00 sample runs until 15:00
+    TEST_ASSERT_EQUAL(SAMPLES_PER_DAY + 4, days[0].minTemperature_dC);
+    TEST_ASSERT_EQUAL(2 * SAMPLES_PER_DAY - 1, days[0].maxTemperature_dC);
+    TEST_ASSERT_EQUAL(Weather::CLEAR_SKY_DAY, days[0].weather); // noon sample in progress is the closest one
+
+    TEST_ASSERT_EQUAL_UINT8(0, forecastDailySummary(&ring, MIDNIGHT_UTC + 5 * 86400, days, FORECAST_MAX_SAMPLES)); // all over
+}
+
+// days are local, 5 hours behind UTC the first two samples belong to the evening before
+void test_daily_summary_local_days()
+{
+    ForecastDay days[FORECAST_MAX_SAMPLES];
+
+    setenv("TZ", "EST5", 1);
+    tzset();
+    fillRing(MIDNIGHT_UTC, FORECAST_MAX_SAMPLES);
+
+    TEST_ASSERT_EQUAL_UINT8(6, forecastDailySummary(&ring, MIDNIGHT_UTC, days, FORECAST_MAX_SAMPLES));
+    TEST_ASSERT_EQUAL(0, days[0].minTemperature_dC); // 19:00 and 22:00 of Tuesday
+    TEST_ASSERT_EQUAL(1, days[0].maxTemperature_dC);
+    TEST_ASSERT_EQUAL(2, days[1].minTemperature_dC); // 01:00 .. 22:00 of Wednesday
+    TEST_ASSERT_EQUAL(2 + SAMPLES_PER_DAY - 1, days[1].maxTemperature_dC);
+    TEST_ASSERT_EQUAL(FORECAST_MAX_SAMPLES - 1, days[5].maxTemperature_dC);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_push_and_get);
+    RUN_TEST(test_gap_and_order_refused);
+    RUN_TEST(test_full_ring_drops_oldest);
+    RUN_TEST(test_daily_summary);
+    RUN_TEST(test_daily_summary_skips_past);
+    RUN_TEST(test_daily_summary_local_days);
+
+    return UNITY_END();
+}
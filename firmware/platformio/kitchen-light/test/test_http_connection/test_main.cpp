@@ -0,0 +1,268 @@
+// core includes
+#include <Arduino.h>
+#include <WiFi.h>
+
+// project includes
+#include "httpConnection.h"
+#include "sim.h"
+#include "conf.h"
+
+// lib includes
+#include <unity.h>
+
+/* HTTP client against the weather API of the simulator (keep-alive server, closes idle connections after 5 s).
+ * A scripted task sends weather and forecast requests the way network task does, with network conditions changed in between,
+ * and records what each of them cost: TCP connects and DNS lookups as simulated network counted them, timing as module reported it.
+ * Whole script runs once, tests then check what it recorded.
+ */
+
+#define WEATHER_URL "http://api.openweathermap.org/data/2.5/weather?lat=48.15&lon=17.11&units=metric&appid=0123456789abcdef"
+#define FORECAST_URL "http://api.openweathermap.org/data/2.5/forecast?lat=48.15&lon=17.11&units=metric&appid=0123456789abcdef"
+#define SERVER_IDLE_MS 6000 // longer than keep-alive of simulated server
+#define TEST_RUN_US (2 * 3600 * SIM_US_PER_S)
+
+enum class Step : uint8_t
+{
+    FIRST,
+    AGAIN,
+    FORECAST,
+    WEATHER_UNREAD,
+    AFTER_WEATHER_UNREAD,
+    FORECAST_UNREAD,
+    AFTER_FORECAST_UNREAD,
+    AFTER_IDLE,
+    API_DOWN,
+    AFTER_API_DOWN,
+    DNS_EXPIRED,
+    INTERNET_LOST,
+    OFFLINE,
+    INTERNET_BACK,
+    COUNT
+};
+
+struct StepResult
+{
+    int status;
+    HttpTiming timing;
+    uint32_t bodySize; // read by the script, 0 when it left body to httpEnd()
+    uint64_t tcpConnects;
+    uint64_t dnsLookups;
+    uint32_t durationMs;
+};
+
+StepResult results[(uint8_t)Step::COUNT];
+bool scriptDone = false;
+
+// simulated server puts the whole response in at once, so body is there as soon as the headers are
+void request(Step step, const char *url, bool readBody)
+{
+    StepResult *result = &results[(uint8_t)step];
+    uint64_t tcpConnects = simStats.tcpConnects;
+    uint64_t dnsLookups = simStats.dnsLookups;
+    uint32_t timer = millis();
+
+    result->status = httpGet(url);
+
+    while(readBody && result->status > 0 && httpBody().read() >= 0)
+    {
+        result->bodySize++;
+    }
+
+    httpEnd();
+
+    result->timing = getHttpStats()->lastTiming;
+    result->tcpConnects = simStats.tcpConnects - tcpConnects;
+    result->dnsLookups = simStats.dnsLookups - dnsLookups;
+    result->durationMs = millis() - timer;
+}
+
+void scriptedRequests(void *parameters)
+{
+    WiFi.mode(WIFI_STA);
+    WiFi.begin("home", "password");
+
+    while(WiFi.status() != WL_CONNECTED)
+    {
+        delay(100);
+    }
+
+    request(Step::FIRST, WEATHER_URL, true);
+    request(Step::AGAIN, WEATHER_URL, true);
+    request(Step::FORECAST, FORECAST_URL, true);
+    request(Step::WEATHER_UNREAD, WEATHER_URL, false);
+    request(Step::AFTER_WEATHER_UNREAD, WEATHER_URL, true);
+    request(Step::FORECAST_UNREAD, FORECAST_URL, false);
+    request(Step::AFTER_FORECAST_UNREAD, WEATHER_URL, true);
+
+    delay(SERVER_IDLE_MS);
+    request(Step::AFTER_IDLE, WEATHER_URL, true);
+
+    simNetwork.api = false;
+    request(Step::API_DOWN, WEATHER_URL, false);
+    simNetwork.api = true;
+    request(Step::AFTER_API_DOWN, WEATHER_URL, true);
+
+    delay(HTTP_DNS_CACHE_TTL_MS);
+    request(Step::DNS_EXPIRED, WEATHER_URL, true);
+
+    simNetwork.internet = false; // connection of the previous request still looks open
+    request(Step::INTERNET_LOST, WEATHER_URL, true);
+    request(Step::OFFLINE, WEATHER_URL, true);
+    simNetwork.internet = true;
+    request(Step::INTERNET_BACK, WEATHER_URL, true);
+
+    scriptDone = true;
+    simStop("script done");
+
+    for(;;)
+    {
+        delay(SCHEDULER_MAX_IDLE_MS);
+    }
+}
+
+const StepResult* result(Step step)
+{
+    return &results[(uint8_t)step];
+}
+
+void expectNewConnection(Step step, bool dnsCached)
+{
+    TEST_ASSERT_FALSE(result(step)->timing.connectionReused);
+    TEST_ASSERT_EQUAL(dnsCached, result(step)->timing.dnsCached);
+    TEST_ASSERT_EQUAL_UINT64(1, result(step)->tcpConnects);
+    TEST_ASSERT_EQUAL_UINT64(dnsCached ? 0 : 1, result(step)->dnsLookups);
+}
+
+void expectReused(Step step)
+{
+    TEST_ASSERT_TRUE(result(step)->timing.connectionReused);
+    TEST_ASSERT_EQUAL_UINT64(0, result(step)->tcpConnects);
+    TEST_ASSERT_EQUAL_UINT64(0, result(step)->dnsLookups);
+    TEST_ASSERT_EQUAL_UINT32(0, result(step)->timing.dnsMs);
+    TEST_ASSERT_EQUAL_UINT32(0, result(step)->timing.connectMs);
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_script_completes()
+{
+    TEST_ASSERT_TRUE(scriptDone);
+    TEST_ASSERT_EQUAL_STRING("script done", simStopReason());
+}
+
+void test_first_request()
+{
+    TEST_ASSERT_EQUAL(200, result(Step::FIRST)->status);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, result(Step::FIRST)->bodySize);
+    expectNewConnection(Step::FIRST, false);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, result(Step::FIRST)->timing.dnsMs);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, result(Step::FIRST)->timing.connectMs);
+}
+
+// weather and forecast go to the same host, both over the one connection
+void test_reuse()
+{
+    char message[96];
+
+    TEST_ASSERT_EQUAL(200, result(Step::AGAIN)->status);
+    TEST_ASSERT_EQUAL_UINT32(result(Step::FIRST)->bodySize, result(Step::AGAIN)->bodySize);
+    expectReused(Step::AGAIN);
+    TEST_ASSERT_EQUAL(200, result(Step::FORECAST)->status);
+    expectReused(Step::FORECAST);
+    TEST_ASSERT_LESS_THAN_UINT32(result(Step::FIRST)->durationMs, result(Step::AGAIN)->durationMs);
+
+    snprintf(message, sizeof(message), "weather request: new connection %lu ms, reused %lu ms",
+        (unsigned long)result(Step::FIRST)->durationMs, (unsigned long)result(Step::AGAIN)->durationMs);
+    TEST_MESSAGE(message);
+}
+
+// body left unread: short one is drained and connection kept, long one is cheaper to drop with the connection
+void test_unread_body()
+{
+    TEST_ASSERT_EQUAL(200, result(Step::WEATHER_UNREAD)->status);
+    expectReused(Step::AFTER_WEATHER_UNREAD);
+
+    TEST_ASSERT_GREATER_THAN_UINT32(HTTP_MAX_DRAIN_SIZE, result(Step::FORECAST)->bodySize);
+    TEST_ASSERT_EQUAL(200, result(Step::FORECAST_UNREAD)->status);
+    TEST_ASSERT_EQUAL(200, result(Step::AFTER_FORECAST_UNREAD)->status);
+    expectNewConnection(Step::AFTER_FORECAST_UNREAD, true);
+}
+
+void test_server_closed_idle_connection()
+{
+    TEST_ASSERT_EQUAL(200, result(Step::AFTER_IDLE)->status);
+    expectNewConnection(Step::AFTER_IDLE, true);
+}
+
+// error response has a body too, connection survives it
+void test_error_status_keeps_connection()
+{
+    TEST_ASSERT_EQUAL(503, result(Step::API_DOWN)->status);
+    expectReused(Step::API_DOWN);
+    TEST_ASSERT_EQUAL(200, result(Step::AFTER_API_DOWN)->status);
+    expectReused(Step::AFTER_API_DOWN);
+}
+
+void test_dns_cache_expires()
+{
+    TEST_ASSERT_EQUAL(200, result(Step::DNS_EXPIRED)->status);
+    expectNewConnection(Step::DNS_EXPIRED, false);
+}
+
+/* Reused connection gets no answer, request is sent once more over a new one, which cannot connect.
+ * Cached address is dropped with it, so next request looks the host up again (and fails, still offline).
+ */
+void test_internet_lost()
+{
+    TEST_ASSERT_EQUAL(HTTP_ERROR_CONNECT, result(Step::INTERNET_LOST)->status);
+    TEST_ASSERT_FALSE(result(Step::INTERNET_LOST)->timing.connectionReused);
+    TEST_ASSERT_EQUAL_UINT64(1, result(Step::INTERNET_LOST)->tcpConnects);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(HTTP_TIMEOUT_MS + HTTP_CONNECT_TIMEOUT_MS, result(Step::INTERNET_LOST)->durationMs);
+
+    TEST_ASSERT_EQUAL(HTTP_ERROR_DNS, result(Step::OFFLINE)->status);
+    TEST_ASSERT_EQUAL_UINT64(1, result(Step::OFFLINE)->dnsLookups);
+    TEST_ASSERT_EQUAL_UINT64(0, result(Step::OFFLINE)->tcpConnects);
+
+    TEST_ASSERT_EQUAL(200, result(Step::INTERNET_BACK)->status);
+    expectNewConnection(Step::INTERNET_BACK, false);
+}
+
+void test_stats()
+{
+    const HttpStats *stats = getHttpStats();
+    char message[128];
+
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)Step::COUNT, stats->requests);
+    TEST_ASSERT_EQUAL_UINT32(2, stats->failures);
+    TEST_ASSERT_EQUAL_UINT32(simStats.dnsLookups, stats->dnsLookups);
+    TEST_ASSERT_EQUAL_UINT32(simStats.tcpConnects - simStats.tcpConnectFailures, stats->connectionsOpened);
+
+    snprintf(message, sizeof(message), "%lu requests: %lu connections opened, %lu reused, %lu DNS lookups",
+        (unsigned long)stats->requests, (unsigned long)stats->connectionsOpened, (unsigned long)stats->connectionsReused, (unsigned long)stats->dnsLookups);
+    TEST_MESSAGE(message);
+}
+
+int main(int argc, char **argv)
+{
+    xTaskCreatePinnedToCore(scriptedRequests, "networkTask", 8192, NULL, 1, NULL, 0);
+    simRun(TEST_RUN_US);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_script_completes);
+    RUN_TEST(test_first_request);
+    RUN_TEST(test_reuse);
+    RUN_TEST(test_unread_body);
+    RUN_TEST(test_server_closed_idle_connection);
+    RUN_TEST(test_error_status_keeps_connection);
+    RUN_TEST(test_dns_cache_expires);
+    RUN_TEST(test_internet_lost);
+    RUN_TEST(test_stats);
+
+    return UNITY_END();
+}
@@ -0,0 +1,270 @@
+// core includes
+#include <Arduino.h>
+#include <string>
+
+// project includes
+#include "lightApi.h"
+#include "networkTask.h"
+#include "utilities.h"
+#include "conf.h"
+
+// lib includes
+#include <unity.h>
+
+/* JSON API handler called straight with requests as web server parses them, light state and commands go through
+ * the real mailbox and queue (beginNetworkTask() creates them, its task never runs, simulator is not started).
+ * Every test starts from the same published state, with no command waiting.
+ */
+
+#define FIELD_COUNT 4
+
+struct ApiResult
+{
+    uint16_t status;
+    std::string body;
+};
+
+struct FieldRange
+{
+    const char *name;
+    int32_t min;
+    int32_t max;
+};
+
+const FieldRange fieldRanges[FIELD_COUNT] = {
+    {"brightness", 0, 255},
+    {"hueIndex", 0, PICKER_WIDTH - 1},
+    {"temperatureIndex", 0, PICKER_WIDTH - 1},
+    {"ledCount", 1, LED_STRIP_MAX_LED_COUNT}
+};
+
+const char *wrongTypes[] = {"\"12\"", "12.5", "true", "[12]", "{\"value\":12}"};
+const uint8_t wrongTypeCount = sizeof(wrongTypes) / sizeof(wrongTypes[0]);
+
+const LightState published = {100, 255, 180, 120, ColorPickerType::COLOR_TEMPERATURE, 10, 20, 60};
+
+void idleNetworkSetup()
+{
+}
+
+uint32_t idleNetworkLoop()
+{
+    return NETWORK_TASK_PERIOD_MS;
+}
+
+ApiResult call(WebMethod method, const char *target, const char *body)
+{
+    static WebRequest request;
+    static WebResponse response;
+
+    memset(&request, 0, sizeof(request));
+    memset(&response, 0, sizeof(response));
+    request.method = method;
+    strncpy(request.target, target, sizeof(request.target) - 1);
+    strncpy(request.body, body, sizeof(request.body) - 1);
+    request.bodyLength = strlen(request.body);
+
+    handleLightApiRequest(&request, &response);
+
+    return {response.status, std::string(response.body, response.bodyLength)};
+}
+
+ApiResult put(const char *body)
+{
+    return call(WebMethod::PUT, "/api/state", body);
+}
+
+// 400 naming the field (or reason), nothing goes to UI loop
+void expectRejected(const char *body, const char *error)
+{
+    ApiResult result = put(body);
+    LightCommand command;
+
+    TEST_ASSERT_EQUAL_MESSAGE(400, result.status, body);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE((std::string("{\"error\":\"") + error + "\"}").c_str(), result.body.c_str(), body);
+    TEST_ASSERT_FALSE_MESSAGE(receiveLightCommand(&command), body);
+}
+
+// 200, command taken right away so the queue never fills
+LightCommand expectAccepted(const char *body)
+{
+    ApiResult result = put(body);
+    LightCommand command = {};
+
+    TEST_ASSERT_EQUAL_MESSAGE(200, result.status, body);
+    TEST_ASSERT_TRUE_MESSAGE(receiveLightCommand(&command), body);
+
+    return command;
+}
+
+std::string field(const char *name, const char *value)
+{
+    return std::string("{\"") + name + "\":" + value + "}";
+}
+
+std::string field(const char *name, int32_t value)
+{
+    return field(name, std::to_string(value).c_str());
+}
+
+void setUp()
+{
+    LightCommand command;
+
+    postLightState(&published);
+
+    while(receiveLightCommand(&command))
+    {
+    }
+}
+
+void tearDown()
+{
+}
+
+void test_get_state()
+{
+    const char *expected = "{\"brightness\":100,\"pickerType\":\"COLOR_TEMPERATURE\",\"hueIndex\":10,\"temperatureIndex\":20,\"ledCount\":60}";
+    ApiResult result = call(WebMethod::GET, "/api/state", "");
+
+    TEST_ASSERT_EQUAL(200, result.status);
+    TEST_ASSERT_EQUAL_STRING(expected, result.body.c_str());
+
+    result = call(WebMethod::GET, "/api/state?fresh=1", "");
+    TEST_ASSERT_EQUAL(200, result.status);
+    TEST_ASSERT_EQUAL_STRING(expected, result.body.c_str());
+}
+
+// both ends of every integer field pass, one past them names the field
+void test_field_ranges()
+{
+    for(uint8_t i = 0; i < FIELD_COUNT; i++)
+    {
+        const FieldRange *range = &fieldRanges[i];
+
+        expectAccepted(field(range->name, range->min).c_str());
+        expectAccepted(field(range->name, range->max).c_str());
+        expectRejected(field(range->name, range->min - 1).c_str(), range->name);
+        expectRejected(field(range->name, range->max + 1).c_str(), range->name);
+    }
+}
+
+// integers only, no strings of digits, fractions, booleans or containers
+void test_wrong_types()
+{
+    for(uint8_t i = 0; i < FIELD_COUNT; i++)
+    {
+        for(uint8_t j = 0; j < wrongTypeCount; j++)
+        {
+            expectRejected(field(fieldRanges[i].name, wrongTypes[j]).c_str(), fieldRanges[i].name);
+        }
+    }
+
+    expectRejected("{\"pickerType\":2}", "pickerType");
+    expectRejected("{\"pickerType\":true}", "pickerType");
+    expectRejected("{\"pickerType\":[\"COLOR_HUE\"]}", "pickerType");
+}
+
+// only the two pickers knobs offer, names exactly as GET reports them
+void test_picker_type()
+{
+    TEST_ASSERT_TRUE(expectAccepted("{\"pickerType\":\"COLOR_HUE\"}").state.colorPickerType == ColorPickerType::COLOR_HUE);
+    TEST_ASSERT_TRUE(expectAccepted("{\"pickerType\":\"COLOR_TEMPERATURE\"}").state.colorPickerType == ColorPickerType::COLOR_TEMPERATURE);
+
+    expectRejected("{\"pickerType\":\"NONE\"}", "pickerType");
+    expectRejected("{\"pickerType\":\"color_hue\"}", "pickerType");
+    expectRejected("{\"pickerType\":\"COLOR_HUE \"}", "pickerType");
+    expectRejected("{\"pickerType\":\"\"}", "pickerType");
+}
+
+// null is the same as a missing field, unknown fields are ignored, nothing left to apply is an error
+void test_no_known_field()
+{
+    expectRejected("{}", "no known field");
+    expectRejected("{\"unknown\":12}", "no known field");
+    expectRejected("{\"brightness\":null}", "no known field");
+    expectRejected("{\"Brightness\":12}", "no known field");
+}
+
+void test_invalid_json()
+{
+    expectRejected("", "invalid JSON");
+    expectRejected("{", "invalid JSON");
+    expectRejected("{\"brightness\":12", "invalid JSON");
+    expectRejected("[{\"brightness\":12}]", "invalid JSON");
+    expectRejected("null", "invalid JSON");
+    expectRejected("12", "invalid JSON");
+    expectRejected("\"brightness\"", "invalid JSON");
+}
+
+// the first invalid field is named, valid ones before it are not applied either
+void test_invalid_field_rejects_whole_request()
+{
+    expectRejected("{\"brightness\":12,\"ledCount\":0}", "ledCount");
+    expectRejected("{\"brightness\":12,\"pickerType\":\"NONE\"}", "pickerType");
+    expectRejected("{\"brightness\":300,\"ledCount\":0}", "brightness");
+}
+
+// response is the published state with the request applied on top, command carries only the fields that came
+void test_merged_state_after_put()
+{
+    ApiResult result = put("{\"brightness\":200,\"pickerType\":\"COLOR_HUE\",\"unknown\":1}");
+    LightCommand command;
+
+    TEST_ASSERT_EQUAL(200, result.status);
+    TEST_ASSERT_EQUAL_STRING("{\"brightness\":200,\"pickerType\":\"COLOR_HUE\",\"hueIndex\":10,\"temperatureIndex\":20,\"ledCount\":60}", result.body.c_str());
+    TEST_ASSERT_TRUE(receiveLightCommand(&command));
+    TEST_ASSERT_EQUAL_UINT8(LIGHT_COMMAND_BRIGHTNESS | LIGHT_COMMAND_COLOR_PICKER_TYPE, command.fields);
+    TEST_ASSERT_EQUAL_UINT8(200, command.state.brightness);
+    TEST_ASSERT_TRUE(command.state.colorPickerType == ColorPickerType::COLOR_HUE);
+    TEST_ASSERT_EQUAL_UINT16(published.colorHueIndex, command.state.colorHueIndex);
+    TEST_ASSERT_EQUAL_UINT16(published.numberOfLeds, command.state.numberOfLeds);
+
+    result = put("{\"brightness\":1,\"pickerType\":\"COLOR_TEMPERATURE\",\"hueIndex\":287,\"temperatureIndex\":0,\"ledCount\":9999}");
+    TEST_ASSERT_EQUAL(200, result.status);
+    TEST_ASSERT_EQUAL_STRING("{\"brightness\":1,\"pickerType\":\"COLOR_TEMPERATURE\",\"hueIndex\":287,\"temperatureIndex\":0,\"ledCount\":9999}", result.body.c_str());
+    TEST_ASSERT_TRUE(receiveLightCommand(&command));
+    TEST_ASSERT_EQUAL_UINT8(LIGHT_COMMAND_BRIGHTNESS | LIGHT_COMMAND_COLOR_PICKER_TYPE | LIGHT_COMMAND_COLOR_HUE_INDEX |
+        LIGHT_COMMAND_COLOR_TEMPERATURE_INDEX | LIGHT_COMMAND_NUMBER_OF_LEDS, command.fields);
+}
+
+// UI loop not taking commands fills the queue, request is then refused rather than waited for
+void test_busy_when_queue_full()
+{
+    for(uint8_t i = 0; i < LIGHT_COMMAND_QUEUE_LENGTH; i++)
+    {
+        TEST_ASSERT_EQUAL(200, put("{\"brightness\":12}").status);
+    }
+
+    ApiResult result = put("{\"brightness\":12}");
+
+    TEST_ASSERT_EQUAL(503, result.status);
+    TEST_ASSERT_EQUAL_STRING("{\"error\":\"busy\"}", result.body.c_str());
+}
+
+void test_methods_and_resources()
+{
+    TEST_ASSERT_EQUAL(405, call(WebMethod::POST, "/api/state", "{\"brightness\":12}").status);
+    TEST_ASSERT_EQUAL(404, call(WebMethod::GET, "/api/states", "").status);
+    TEST_ASSERT_EQUAL(404, call(WebMethod::GET, "/api/", "").status);
+    TEST_ASSERT_EQUAL(426, call(WebMethod::GET, "/api/live", "").status);
+}
+
+int main(int argc, char **argv)
+{
+    beginNetworkTask(idleNetworkSetup, idleNetworkLoop);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_get_state);
+    RUN_TEST(test_field_ranges);
+    RUN_TEST(test_wrong_types);
+    RUN_TEST(test_picker_type);
+    RUN_TEST(test_no_known_field);
+    RUN_TEST(test_invalid_json);
+    RUN_TEST(test_invalid_field_rejects_whole_request);
+    RUN_TEST(test_merged_state_after_put);
+    RUN_TEST(test_busy_when_queue_full);
+    RUN_TEST(test_methods_and_resources);
+
+    return UNITY_END();
+}
@@ -0,0 +1,166 @@
+// core includes
+#include <Arduino.h>
+#include <stdlib.h>
+
+// project includes
+#include "metrics.h"
+#include "conf.h"
+
+// lib includes
+#include <unity.h>
+
+/* Metrics registry as /metrics shows it: values are read back from the rendered Prometheus text.
+ * Registry is global and never reset, so every test compares text before and after what it recorded.
+ */
+
+#define SMALL_BUFFER_SIZE 100
+
+char text[METRICS_TEXT_MAX_SIZE];
+size_t textLength;
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void render()
+{
+    textLength = renderMetrics(text, sizeof(text));
+}
+
+// value of the sample line which starts with given name and labels, test fails if there is none
+uint32_t sample(const char *series)
+{
+    char line[96];
+    const char *found;
+
+    snprintf(line, sizeof(line), "\n%s ", series);
+    found = strstr(text, line);
+
+    TEST_ASSERT_TRUE_MESSAGE(found != NULL, series);
+
+    return (uint32_t)strtoul(found + strlen(line), NULL, 10);
+}
+
+void test_counter()
+{
+    uint32_t before;
+
+    render();
+    before = sample("light_web_requests_total");
+
+    metricIncrement(Metric::WEB_REQUESTS);
+    metricIncrement(Metric::WEB_REQUESTS, 2);
+    render();
+
+    TEST_ASSERT_EQUAL_UINT32(before + 3, sample("light_web_requests_total"));
+    TEST_ASSERT_NOT_NULL(strstr(text, "# TYPE light_web_requests_total counter\n"));
+}
+
+// 32 bit wrap, Prometheus takes it as counter reset
+void test_counter_wraps()
+{
+    uint32_t before;
+
+    render();
+    before = sample("light_nvs_writes_total");
+
+    metricIncrement(Metric::NVS_WRITES, 0xFFFFFFFF);
+    render();
+
+    TEST_ASSERT_EQUAL_UINT32(before - 1, sample("light_nvs_writes_total"));
+}
+
+// heap gauges are sampled by render itself, whatever was set before is overwritten
+void test_heap_gauges()
+{
+    metricSet(Metric::FREE_HEAP_BYTES, 1);
+    render();
+
+    TEST_ASSERT_EQUAL_UINT32(ESP.getFreeHeap(), sample("light_free_heap_bytes"));
+    TEST_ASSERT_NOT_NULL(strstr(text, "# TYPE light_free_heap_bytes gauge\n"));
+}
+
+// ping buckets: 10, 20, 50, 100, 200, 300, 500, 1000, bounds are inclusive
+void test_histogram_buckets()
+{
+    uint32_t le10, le20, le1000, inf, sum, count;
+
+    render();
+    le10 = sample("light_ping_ms_bucket{le=\"10\"}");
+    le20 = sample("light_ping_ms_bucket{le=\"20\"}");
+    le1000 = sample("light_ping_ms_bucket{le=\"1000\"}");
+    inf = sample("light_ping_ms_bucket{le=\"+Inf\"}");
+    sum = sample("light_ping_ms_sum");
+    count = sample("light_ping_ms_count");
+
+    metricObserve(Metric::PING_MS, 0);
+    metricObserve(Metric::PING_MS, 10);
+    metricObserve(Metric::PING_MS, 11);
+    metricObserve(Metric::PING_MS, 1000);
+    metricObserve(Metric::PING_MS, 1001);
+    render();
+
+    TEST_ASSERT_EQUAL_UINT32(le10 + 2, sample("light_ping_ms_bucket{le=\"10\"}"));
+    TEST_ASSERT_EQUAL_UINT32(le20 + 3, sample("light_ping_ms_bucket{le=\"20\"}")); // cumulative
+    TEST_ASSERT_EQUAL_UINT32(le1000 + 4, sample("light_ping_ms_bucket{le=\"1000\"}"));
+    TEST_ASSERT_EQUAL_UINT32(inf + 5, sample("light_ping_ms_bucket{le=\"+Inf\"}"));
+    TEST_ASSERT_EQUAL_UINT32(sum + 2022, sample("light_ping_ms_sum"));
+    TEST_ASSERT_EQUAL_UINT32(count + 5, sample("light_ping_ms_count"));
+    TEST_ASSERT_EQUAL_UINT32(sample("light_ping_ms_bucket{le=\"+Inf\"}"), sample("light_ping_ms_count"));
+}
+
+// every metric has HELP and TYPE, whole text fits the buffer web server allocates for it
+void test_format()
+{
+    uint32_t help = 0;
+    uint32_t type = 0;
+    char message[64];
+
+    render();
+
+    for(const char *line = text; *line != '\0'; line = strchr(line, '\n') + 1)
+    {
+        help += (strncmp(line, "# HELP ", 7) == 0) ? 1 : 0;
+        type += (strncmp(line, "# TYPE ", 7) == 0) ? 1 : 0;
+    }
+
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)Metric::COUNT, help);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)Metric::COUNT, type);
+    TEST_ASSERT_EQUAL(strlen(text), textLength);
+    TEST_ASSERT_LESS_THAN(METRICS_TEXT_MAX_SIZE - 1, textLength); // not cut
+    TEST_ASSERT_EQUAL('\n', text[textLength - 1]);
+
+    snprintf(message, sizeof(message), "metrics text: %lu bytes", (unsigned long)textLength);
+    TEST_MESSAGE(message);
+}
+
+// too small buffer gets the beginning of the text, still terminated
+void test_truncated()
+{
+    char small[SMALL_BUFFER_SIZE + 1];
+
+    small[SMALL_BUFFER_SIZE] = '#'; // past the size render was given
+    render();
+
+    TEST_ASSERT_EQUAL(SMALL_BUFFER_SIZE - 1, renderMetrics(small, SMALL_BUFFER_SIZE));
+    TEST_ASSERT_EQUAL('\0', small[SMALL_BUFFER_SIZE - 1]);
+    TEST_ASSERT_EQUAL('#', small[SMALL_BUFFER_SIZE]);
+    TEST_ASSERT_EQUAL_MEMORY(text, small, SMALL_BUFFER_SIZE - 1);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_counter);
+    RUN_TEST(test_counter_wraps);
+    RUN_TEST(test_heap_gauges);
+    RUN_TEST(test_histogram_buckets);
+    RUN_TEST(test_format);
+    RUN_TEST(test_truncated);
+
+    return UNITY_END();
+}
@@ -0,0 +1,250 @@
+// core includes
+#include <Arduino.h>
+
+// project includes
+#include "networkTask.h"
+#include "uiIdle.h"
+#include "sim.h"
+#include "conf.h"
+
+// lib includes
+#include <unity.h>
+
+/* Network task -> UI loop messaging (networkTask.cpp) with both sides running as tasks of the simulator:
+ * a scripted UI loop which idles as the real one does, and scriptedNetworkLoop() posting scripted messages.
+ * Simulator is cooperative on one host thread, so it shows latency, queue overflow and coalescing as firmware sees them,
+ * but not races of the two cores, these rely on FreeRTOS queues being safe between cores.
+ * Whole script runs once, tests then check what it recorded.
+ */
+
+#define LATENCY_MESSAGES 100
+#define BURST_MESSAGES (NETWORK_MESSAGE_QUEUE_LENGTH + 4)
+#define UI_BUSY_MS 200 // long blocking work in UI loop, nothing is taken from queues meanwhile
+#define LIVE_CONTROL_MESSAGES 5
+#define TEST_RUN_US (60 * SIM_US_PER_S)
+
+enum class Phase {LATENCY, BURST, MAILBOX, DONE};
+
+Phase phase = Phase::LATENCY;
+uint8_t sequence = 0; // of the next message network task posts
+// latency
+uint32_t latencyReceived = 0;
+uint32_t maxLatencyUs = 0;
+uint64_t totalLatencyUs = 0;
+// burst
+uint32_t burstPosted = 0;
+uint32_t burstRefused = 0;
+uint32_t burstReceived = 0;
+bool burstInOrder = true;
+uint8_t expectedSequence = 0;
+// mailbox
+bool mailboxPosted = false;
+uint32_t lightCommandsAccepted = 0;
+uint32_t lightCommandsReceived = 0;
+uint32_t liveControlsReceived = 0;
+uint8_t liveControlBrightness = 0;
+
+// sequence number rides in humidity, post time in syncTimer
+bool postScriptedMessage()
+{
+    NetworkMessage message;
+
+    memset(&message, 0, sizeof(message));
+    message.type = NetworkMessageType::WEATHER;
+    message.weatherUpdate.syncTimer = micros();
+    message.weatherUpdate.weatherData.humidity = sequence;
+
+    if(!postNetworkMessage(&message))
+    {
+        return false;
+    }
+
+    sequence++;
+
+    return true;
+}
+
+void scriptedNetworkSetup()
+{
+}
+
+void postMailboxes()
+{
+    LiveControl liveControl = {};
+    LightCommand command = {};
+
+    for(uint8_t i = 1; i <= LIVE_CONTROL_MESSAGES; i++)
+    {
+        liveControl.brightness = i;
+        postLiveControl(&liveControl);
+    }
+
+    command.fields = LIGHT_COMMAND_BRIGHTNESS;
+
+    for(uint8_t i = 0; i < LIGHT_COMMAND_QUEUE_LENGTH + 1; i++)
+    {
+        lightCommandsAccepted += postLightCommand(&command) ? 1 : 0;
+    }
+
+    mailboxPosted = true;
+}
+
+// one message per pass, then as many as fit (what does not fit is posted again next pass, as publishNetworkState() does)
+uint32_t scriptedNetworkLoop()
+{
+    if(phase == Phase::LATENCY && sequence < LATENCY_MESSAGES)
+    {
+        postScriptedMessage();
+    }
+    else if(phase == Phase::BURST)
+    {
+        while(burstPosted < BURST_MESSAGES)
+        {
+            if(!postScriptedMessage())
+            {
+                burstRefused++;
+                break;
+            }
+
+            burstPosted++;
+        }
+    }
+    else if(phase == Phase::MAILBOX && !mailboxPosted)
+    {
+        postMailboxes();
+    }
+
+    return NETWORK_TASK_PERIOD_MS;
+}
+
+void takeNetworkMessages()
+{
+    NetworkMessage message;
+
+    while(receiveNetworkMessage(&message))
+    {
+        uint32_t latencyUs = micros() - message.weatherUpdate.syncTimer;
+
+        if(phase == Phase::LATENCY)
+        {
+            latencyReceived++;
+            maxLatencyUs = max(maxLatencyUs, latencyUs);
+            totalLatencyUs += latencyUs;
+        }
+        else if(phase == Phase::BURST)
+        {
+            burstInOrder = burstInOrder && message.weatherUpdate.weatherData.humidity == expectedSequence;
+            burstReceived++;
+        }
+
+        expectedSequence = message.weatherUpdate.weatherData.humidity + 1;
+    }
+}
+
+void takeMailboxes()
+{
+    LiveControl liveControl;
+    LightCommand command;
+
+    while(receiveLiveControl(&liveControl))
+    {
+        liveControlsReceived++;
+        liveControlBrightness = liveControl.brightness;
+    }
+
+    while(receiveLightCommand(&command))
+    {
+        lightCommandsReceived++;
+    }
+}
+
+// stands in for setup() and loop() of main.cpp
+void scriptedUiLoop(void *parameters)
+{
+    beginUiIdle();
+    beginNetworkTask(scriptedNetworkSetup, scriptedNetworkLoop);
+
+    while(phase != Phase::DONE)
+    {
+        idleUiLoop(SCHEDULER_MAX_IDLE_MS);
+        takeNetworkMessages();
+
+        if(phase == Phase::LATENCY && latencyReceived == LATENCY_MESSAGES)
+        {
+            phase = Phase::BURST;
+            delay(UI_BUSY_MS);
+        }
+        else if(phase == Phase::BURST && burstReceived == BURST_MESSAGES)
+        {
+            phase = Phase::MAILBOX;
+            delay(UI_BUSY_MS);
+            takeMailboxes();
+            phase = Phase::DONE;
+        }
+    }
+
+    simStop("script done");
+
+    for(;;)
+    {
+        delay(SCHEDULER_MAX_IDLE_MS);
+    }
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_script_completes()
+{
+    TEST_ASSERT_TRUE(phase == Phase::DONE);
+    TEST_ASSERT_EQUAL_STRING("script done", simStopReason());
+}
+
+// UI loop idles in a task notification, every post wakes it, so a message waits only for the network pass to end
+void test_latency()
+{
+    char message[96];
+
+    TEST_ASSERT_EQUAL_UINT32(LATENCY_MESSAGES, latencyReceived);
+    TEST_ASSERT_LESS_THAN(NETWORK_TASK_PERIOD_MS * 1000, maxLatencyUs);
+
+    snprintf(message, sizeof(message), "network message latency: avg %lu us, max %lu us", (unsigned long)(totalLatencyUs / latencyReceived), (unsigned long)maxLatencyUs);
+    TEST_MESSAGE(message);
+}
+
+// full queue refuses without blocking, reposted messages all come, in order
+void test_burst_while_ui_busy()
+{
+    TEST_ASSERT_EQUAL_UINT32(BURST_MESSAGES, burstPosted);
+    TEST_ASSERT_EQUAL_UINT32(BURST_MESSAGES, burstReceived);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(UI_BUSY_MS / NETWORK_TASK_PERIOD_MS - 1, burstRefused); // every pass while UI was busy
+    TEST_ASSERT_TRUE(burstInOrder);
+}
+
+void test_mailboxes()
+{
+    TEST_ASSERT_TRUE(mailboxPosted);
+    TEST_ASSERT_EQUAL_UINT32(1, liveControlsReceived); // coalesced
+    TEST_ASSERT_EQUAL_UINT8(LIVE_CONTROL_MESSAGES, liveControlBrightness); // to the latest one
+    TEST_ASSERT_EQUAL_UINT32(LIGHT_COMMAND_QUEUE_LENGTH, lightCommandsAccepted); // the extra one is refused (503)
+    TEST_ASSERT_EQUAL_UINT32(LIGHT_COMMAND_QUEUE_LENGTH, lightCommandsReceived);
+}
+
+int main(int argc, char **argv)
+{
+    xTaskCreatePinnedToCore(scriptedUiLoop, "loopTask", 8192, NULL, 1, NULL, 1);
+    simRun(TEST_RUN_US);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_script_completes);
+    RUN_TEST(test_latency);
+    RUN_TEST(test_burst_while_ui_busy);
+    RUN_TEST(test_mailboxes);
+
+    return UNITY_END();
+}
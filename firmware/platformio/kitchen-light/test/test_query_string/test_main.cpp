@@ -0,0 +1,165 @@
+// core includes
+#include <string.h>
+
+// project includes
+#include "queryString.h"
+
+// lib includes
+#include <unity.h>
+
+/* Query string tokenizer (setup form), edge cases of what a browser or anyone else may send.
+ * Every case tokenizes its own copy, as the tokenizer decodes in place.
+ */
+
+char buffer[256];
+char *cursor;
+QueryParameter parameter;
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void startQuery(const char *target)
+{
+    strncpy(buffer, target, sizeof(buffer) - 1);
+    buffer[sizeof(buffer) - 1] = '\0';
+    cursor = findQueryString(buffer);
+}
+
+void expectParameter(const char *key, const char *value)
+{
+    TEST_ASSERT_TRUE(nextQueryParameter(&cursor, &parameter));
+    TEST_ASSERT_EQUAL_STRING(key, parameter.key);
+    TEST_ASSERT_EQUAL_STRING(value, parameter.value);
+    TEST_ASSERT_EQUAL(strlen(value), parameter.valueLength);
+}
+
+void expectEnd()
+{
+    TEST_ASSERT_FALSE(nextQueryParameter(&cursor, &parameter));
+    TEST_ASSERT_FALSE(nextQueryParameter(&cursor, &parameter)); // stays at the end
+}
+
+void test_plain_parameters()
+{
+    startQuery("/?ssid=home&pwd=secret");
+    expectParameter("ssid", "home");
+    expectParameter("pwd", "secret");
+    expectEnd();
+}
+
+void test_no_query()
+{
+    startQuery("/favicon.ico");
+    TEST_ASSERT_NULL(cursor);
+    expectEnd();
+
+    startQuery("/?");
+    expectEnd();
+}
+
+void test_escapes_and_plus_are_decoded()
+{
+    startQuery("/?timezone=CET-1CEST%2CM3.5.0%2cM10.5.0%2F3&city=New+York&sep=%26%3D");
+    expectParameter("timezone", "CET-1CEST,M3.5.0,M10.5.0/3");
+    expectParameter("city", "New York");
+    expectParameter("sep", "&="); // decoded separators do not split anything
+    expectEnd();
+}
+
+void test_trailing_percent_is_kept()
+{
+    startQuery("/?a=50%");
+    expectParameter("a", "50%");
+    expectEnd();
+}
+
+void test_incomplete_escape_is_kept()
+{
+    startQuery("/?a=%0&b=%4&c=%zz");
+    expectParameter("a", "%0");
+    expectParameter("b", "%4");
+    expectParameter("c", "%zz");
+    expectEnd();
+}
+
+void test_encoded_nul_is_kept()
+{
+    startQuery("/?pwd=ab%00cd&%00=x");
+    expectParameter("pwd", "ab%00cd");
+    expectParameter("%00", "x");
+    expectEnd();
+}
+
+void test_empty_parameters_are_skipped()
+{
+    startQuery("/?&&a=1&&&b=2&&");
+    expectParameter("a", "1");
+    expectParameter("b", "2");
+    expectEnd();
+}
+
+void test_key_without_value()
+{
+    startQuery("/?flag&a=1&empty=&last");
+    expectParameter("flag", "");
+    expectParameter("a", "1");
+    expectParameter("empty", "");
+    expectParameter("last", "");
+    expectEnd();
+}
+
+void test_equals_in_value()
+{
+    startQuery("/?api-key=a=b==&=novalue");
+    expectParameter("api-key", "a=b==");
+    expectParameter("", "novalue");
+    expectEnd();
+}
+
+void test_overlong_value_is_refused()
+{
+    char destination[8] = "kept";
+
+    startQuery("/?city=Bratislava&cc=SK");
+    TEST_ASSERT_TRUE(nextQueryParameter(&cursor, &parameter));
+    TEST_ASSERT_FALSE(copyQueryValue(&parameter, destination, sizeof(destination) - 1));
+    TEST_ASSERT_EQUAL_STRING("kept", destination); // untouched
+
+    TEST_ASSERT_TRUE(nextQueryParameter(&cursor, &parameter));
+    TEST_ASSERT_TRUE(copyQueryValue(&parameter, destination, 2)); // exactly fits
+    TEST_ASSERT_EQUAL_STRING("SK", destination);
+}
+
+void test_overlong_value_counts_decoded_length()
+{
+    char destination[4];
+
+    // 9 encoded characters, 3 decoded ones
+    startQuery("/?cc=%41%42%43");
+    TEST_ASSERT_TRUE(nextQueryParameter(&cursor, &parameter));
+    TEST_ASSERT_TRUE(copyQueryValue(&parameter, destination, 3));
+    TEST_ASSERT_EQUAL_STRING("ABC", destination);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_plain_parameters);
+    RUN_TEST(test_no_query);
+    RUN_TEST(test_escapes_and_plus_are_decoded);
+    RUN_TEST(test_trailing_percent_is_kept);
+    RUN_TEST(test_incomplete_escape_is_kept);
+    RUN_TEST(test_encoded_nul_is_kept);
+    RUN_TEST(test_empty_parameters_are_skipped);
+    RUN_TEST(test_key_without_value);
+    RUN_TEST(test_equals_in_value);
+    RUN_TEST(test_overlong_value_is_refused);
+    RUN_TEST(test_overlong_value_counts_decoded_length);
+
+    return UNITY_END();
+}
@@ -0,0 +1,202 @@
+// core includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+// project includes
+#include "queryString.h"
+
+// lib includes
+#include <unity.h>
+
+/* Setup form parsed by the tokenizer against the strstr based parse it replaced (kept here as it was, without console output).
+ * Both have to give the same values, times are only printed (host numbers, the ratio is what matters).
+ */
+
+#define BENCHMARK_ITERATIONS 200000
+#define LEGACY_MAX_LENGTH 128
+
+const char *formTarget = "/?ssid=Home%20Network&pwd=p%40ss%21word&location=cityAndCountryCode&city=Bratislava&country-code=SK"
+    "&lat=&lon=&timezone=CET-1CEST%2CM3.5.0%2CM10.5.0%2F3&api-key=0123456789abcdef0123456789abcdef";
+
+struct Form
+{
+    char ssid[LEGACY_MAX_LENGTH + 1];
+    char pwd[LEGACY_MAX_LENGTH + 1];
+    char location[LEGACY_MAX_LENGTH + 1];
+    char city[LEGACY_MAX_LENGTH + 1];
+    char countryCode[LEGACY_MAX_LENGTH + 1];
+    char timeZone[LEGACY_MAX_LENGTH + 1];
+    char apiKey[LEGACY_MAX_LENGTH + 1];
+};
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void legacyDecodeUrlCodes(char *valBuffFiltered, char *valBuff)
+{
+    uint16_t index = 0;
+    char buff[3] = "";
+    char c;
+    char *ptr;
+
+    for(uint16_t i = 0; i < strlen(valBuff); i++)
+    {
+        c = valBuff[i];
+
+        if(c == '%')
+        {
+            buff[0] = valBuff[i + 1];
+            buff[1] = valBuff[i + 2];
+            valBuffFiltered[index++] = (char)strtol(buff, &ptr, 16);
+            i += 2;
+            continue;
+        }
+        else
+        {
+            valBuffFiltered[index++] = c;
+        }
+    }
+}
+
+void legacyParseParameter(const char *buff, const char *param, char *saveToParam, uint16_t paramMaxLength)
+{
+    char valBuff[LEGACY_MAX_LENGTH + 1] = "";
+    uint16_t index = 0;
+    const char *ptr = strstr(buff, param);
+
+    if(ptr == NULL)
+    {
+        return;
+    }
+
+    while(index < LEGACY_MAX_LENGTH)
+    {
+        char c = ptr[index + (strlen(param))];
+
+        if(c == '&' || c == '\0')
+        {
+            char valBuffFiltered[LEGACY_MAX_LENGTH + 1] = "";
+            legacyDecodeUrlCodes(valBuffFiltered, valBuff);
+            strcpy(saveToParam, valBuffFiltered);
+            break;
+        }
+
+        valBuff[index++] = c;
+
+        if(index > paramMaxLength)
+        {
+            break;
+        }
+    }
+}
+
+bool legacyParseForm(const char *target, Form *form)
+{
+    if(strstr(target, "ssid=") == NULL || strstr(target, "pwd=") == NULL || strstr(target, "location=") == NULL ||
+        strstr(target, "timezone=") == NULL || strstr(target, "api-key=") == NULL)
+    {
+        return false;
+    }
+
+    legacyParseParameter(target, "ssid=", form->ssid, LEGACY_MAX_LENGTH);
+    legacyParseParameter(target, "pwd=", form->pwd, LEGACY_MAX_LENGTH);
+    legacyParseParameter(target, "location=", form->location, LEGACY_MAX_LENGTH);
+    legacyParseParameter(target, "city=", form->city, LEGACY_MAX_LENGTH);
+    legacyParseParameter(target, "country-code=", form->countryCode, LEGACY_MAX_LENGTH);
+    legacyParseParameter(target, "timezone=", form->timeZone, LEGACY_MAX_LENGTH);
+    legacyParseParameter(target, "api-key=", form->apiKey, LEGACY_MAX_LENGTH);
+
+    return true;
+}
+
+// as handleSetupRequest() does it, target is copied first (tokenizer works in place, request buffer is reused on device)
+bool parseForm(const char *target, Form *form)
+{
+    const struct
+    {
+        const char *key;
+        char *destination;
+    } fields[] = {{"ssid", form->ssid}, {"pwd", form->pwd}, {"location", form->location}, {"city", form->city},
+        {"country-code", form->countryCode}, {"timezone", form->timeZone}, {"api-key", form->apiKey}};
+    char buffer[512];
+    char *cursor;
+    QueryParameter parameter;
+
+    strcpy(buffer, target);
+    cursor = findQueryString(buffer);
+
+    while(nextQueryParameter(&cursor, &parameter))
+    {
+        for(const auto &field : fields)
+        {
+            if(strcmp(parameter.key, field.key) == 0)
+            {
+                if(!copyQueryValue(&parameter, field.destination, LEGACY_MAX_LENGTH))
+                {
+                    return false;
+                }
+
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+void test_same_result()
+{
+    Form legacy;
+    Form tokenized;
+
+    memset(&legacy, 0, sizeof(legacy));
+    memset(&tokenized, 0, sizeof(tokenized));
+
+    TEST_ASSERT_TRUE(legacyParseForm(formTarget, &legacy));
+    TEST_ASSERT_TRUE(parseForm(formTarget, &tokenized));
+    TEST_ASSERT_EQUAL_STRING("Home Network", tokenized.ssid);
+    TEST_ASSERT_EQUAL_STRING("p@ss!word", tokenized.pwd);
+    TEST_ASSERT_EQUAL_STRING("CET-1CEST,M3.5.0,M10.5.0/3", tokenized.timeZone);
+    TEST_ASSERT_EQUAL_MEMORY(&legacy, &tokenized, sizeof(Form));
+}
+
+template<typename Parse> double nanosecondsPerForm(Parse parse)
+{
+    Form form;
+    volatile uint32_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for(uint32_t i = 0; i < BENCHMARK_ITERATIONS; i++)
+    {
+        parse(formTarget, &form);
+        sink = sink + (uint8_t)form.apiKey[i % 32];
+    }
+
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / BENCHMARK_ITERATIONS;
+}
+
+void test_benchmark()
+{
+    char message[128];
+    double legacy = nanosecondsPerForm(legacyParseForm);
+    double tokenized = nanosecondsPerForm(parseForm);
+
+    snprintf(message, sizeof(message), "setup form: strstr parse %.0f ns, tokenizer %.0f ns (%.1fx)", legacy, tokenized, legacy / tokenized);
+    TEST_MESSAGE(message);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_same_result);
+    RUN_TEST(test_benchmark);
+
+    return UNITY_END();
+}
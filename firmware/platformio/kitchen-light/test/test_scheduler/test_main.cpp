@@ -0,0 +1,233 @@
+// core includes
+#include <Arduino.h>
+
+// project includes
+#include "scheduler.h"
+#include "conf.h"
+
+// lib includes
+#include <unity.h>
+
+/* Scheduler on a clock the test moves itself, near millis() overflow included.
+ * Task functions are plain functions, so they reach scheduler and their own slot through globals.
+ * Runtime is measured with micros() of the simulator, which moves only by what a task spends (delayMicroseconds) and 1 us per clock read.
+ */
+
+#define NEAR_OVERFLOW_MS 0xFFFFFF00 // 256 ms before millis() wraps around
+#define TASK_BUSY_US 250
+
+Scheduler scheduler;
+uint8_t periodic;
+uint8_t oneShot;
+uint8_t other;
+uint32_t periodicRuns;
+uint32_t oneShotRuns;
+uint32_t otherRuns;
+uint32_t clockMs; // "now" of the run in progress, for tasks which rearm themselves
+
+void setUp()
+{
+    beginScheduler(&scheduler, "test");
+    periodicRuns = 0;
+    oneShotRuns = 0;
+    otherRuns = 0;
+}
+
+void tearDown()
+{
+}
+
+void countPeriodic()
+{
+    periodicRuns++;
+}
+
+void countOneShot()
+{
+    oneShotRuns++;
+}
+
+void countOther()
+{
+    otherRuns++;
+}
+
+// one-shot which comes back 100 ms later, three times
+void rearmOneShot()
+{
+    oneShotRuns++;
+
+    if(oneShotRuns < 3)
+    {
+        scheduleTask(&scheduler, oneShot, 100, clockMs);
+    }
+}
+
+// periodic task which is done after its second run
+void cancelItself()
+{
+    periodicRuns++;
+
+    if(periodicRuns == 2)
+    {
+        cancelTask(&scheduler, periodic);
+    }
+}
+
+// cancels a task added after it, which is due in the same run
+void cancelOther()
+{
+    periodicRuns++;
+    cancelTask(&scheduler, other);
+}
+
+void busy()
+{
+    periodicRuns++;
+    delayMicroseconds(TASK_BUSY_US);
+}
+
+uint32_t run(uint32_t now)
+{
+    clockMs = now;
+
+    return runScheduler(&scheduler, now);
+}
+
+void test_periodic_across_overflow()
+{
+    uint32_t now = NEAR_OVERFLOW_MS;
+
+    periodic = addSchedulerTask(&scheduler, "periodic", countPeriodic, 100, 100, now);
+
+    TEST_ASSERT_EQUAL_UINT32(100, nextSchedulerDeadline(&scheduler, now));
+    TEST_ASSERT_EQUAL_UINT32(100, run(now));
+    TEST_ASSERT_EQUAL_UINT32(0, periodicRuns);
+
+    // 0xFFFFFF64, 0xFFFFFFC8 and then 0x0000002C, 0x00000090 past the wrap
+    for(uint8_t i = 1; i <= 4; i++)
+    {
+        now = NEAR_OVERFLOW_MS + i * 100;
+
+        TEST_ASSERT_EQUAL_UINT32(1, nextSchedulerDeadline(&scheduler, now - 1));
+        TEST_ASSERT_EQUAL_UINT32(0, nextSchedulerDeadline(&scheduler, now));
+        TEST_ASSERT_EQUAL_UINT32(100, run(now));
+        TEST_ASSERT_EQUAL_UINT32(i, periodicRuns);
+    }
+
+    TEST_ASSERT_TRUE(now < NEAR_OVERFLOW_MS); // it did wrap
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.tasks[periodic].maxLatenessMs);
+}
+
+void test_one_shot_across_overflow()
+{
+    oneShot = addSchedulerTask(&scheduler, "one-shot", countOneShot, 0, 500, NEAR_OVERFLOW_MS); // due at 244 after the wrap
+
+    TEST_ASSERT_EQUAL_UINT32(245, run(0xFFFFFFFF));
+    TEST_ASSERT_EQUAL_UINT32(244, run(0));
+    TEST_ASSERT_EQUAL_UINT32(0, oneShotRuns);
+    TEST_ASSERT_EQUAL_UINT32(SCHEDULER_MAX_IDLE_MS, run(244));
+    TEST_ASSERT_EQUAL_UINT32(1, oneShotRuns);
+    TEST_ASSERT_FALSE(taskArmed(&scheduler, oneShot));
+}
+
+void test_one_shot_rearms_itself()
+{
+    oneShot = addSchedulerTask(&scheduler, "one-shot", rearmOneShot, 0, 0, 1000);
+
+    TEST_ASSERT_EQUAL_UINT32(100, run(1000)); // rearmed from its own function, next deadline is its new one
+    TEST_ASSERT_EQUAL_UINT32(1, oneShotRuns);
+    TEST_ASSERT_TRUE(taskArmed(&scheduler, oneShot));
+    TEST_ASSERT_EQUAL_UINT32(50, run(1050));
+    TEST_ASSERT_EQUAL_UINT32(1, oneShotRuns);
+    run(1100);
+    TEST_ASSERT_EQUAL_UINT32(2, oneShotRuns);
+    TEST_ASSERT_EQUAL_UINT32(SCHEDULER_MAX_IDLE_MS, run(1200)); // third run does not rearm it
+    TEST_ASSERT_EQUAL_UINT32(3, oneShotRuns);
+    TEST_ASSERT_FALSE(taskArmed(&scheduler, oneShot));
+    run(5000);
+    TEST_ASSERT_EQUAL_UINT32(3, oneShotRuns);
+}
+
+void test_cancel_from_own_task()
+{
+    periodic = addSchedulerTask(&scheduler, "cancels itself", cancelItself, 10, 0, 0);
+
+    run(0);
+    run(10);
+    TEST_ASSERT_EQUAL_UINT32(2, periodicRuns);
+    TEST_ASSERT_FALSE(taskArmed(&scheduler, periodic)); // periodic rearm came before its function, cancel wins
+    run(20);
+    run(1000);
+    TEST_ASSERT_EQUAL_UINT32(2, periodicRuns);
+}
+
+void test_cancel_other_task()
+{
+    periodic = addSchedulerTask(&scheduler, "cancels other", cancelOther, 0, 0, 0);
+    other = addSchedulerTask(&scheduler, "other", countOther, 0, 0, 0);
+
+    run(0);
+    TEST_ASSERT_EQUAL_UINT32(1, periodicRuns);
+    TEST_ASSERT_EQUAL_UINT32(0, otherRuns); // due in the same run, but cancelled before its turn
+    TEST_ASSERT_FALSE(taskArmed(&scheduler, other));
+}
+
+void test_lateness_and_runtime()
+{
+    periodic = addSchedulerTask(&scheduler, "busy", busy, 100, 100, 0);
+
+    run(130); // 30 ms late
+    run(230); // on time, period counts from the late run
+    run(400); // 70 ms late
+    TEST_ASSERT_EQUAL_UINT32(3, periodicRuns);
+    TEST_ASSERT_EQUAL_UINT32(3, scheduler.tasks[periodic].runs);
+    TEST_ASSERT_EQUAL_UINT32(70, scheduler.tasks[periodic].maxLatenessMs);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(3 * TASK_BUSY_US, (uint32_t)scheduler.tasks[periodic].runtimeUs);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(3 * (TASK_BUSY_US + 10), (uint32_t)scheduler.tasks[periodic].runtimeUs);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(TASK_BUSY_US, scheduler.tasks[periodic].maxRuntimeUs);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(TASK_BUSY_US + 10, scheduler.tasks[periodic].maxRuntimeUs);
+}
+
+void test_idle_cap()
+{
+    TEST_ASSERT_EQUAL_UINT32(SCHEDULER_MAX_IDLE_MS, nextSchedulerDeadline(&scheduler, 0)); // nothing at all
+
+    periodic = addSchedulerTask(&scheduler, "hourly", countPeriodic, 3600000, 3600000, 0);
+    oneShot = addSchedulerTask(&scheduler, "soon", countOneShot, 0, SCHEDULER_MAX_IDLE_MS - 1, 0);
+
+    TEST_ASSERT_EQUAL_UINT32(SCHEDULER_MAX_IDLE_MS - 1, nextSchedulerDeadline(&scheduler, 0));
+    TEST_ASSERT_EQUAL_UINT32(SCHEDULER_MAX_IDLE_MS, run(SCHEDULER_MAX_IDLE_MS - 1)); // only the hourly one is left
+    TEST_ASSERT_EQUAL_UINT32(1, oneShotRuns);
+
+    cancelTask(&scheduler, periodic);
+    TEST_ASSERT_EQUAL_UINT32(SCHEDULER_MAX_IDLE_MS, nextSchedulerDeadline(&scheduler, 0xFFFFFFFF)); // cancelled ones do not count
+}
+
+void test_no_free_slot()
+{
+    for(uint8_t i = 0; i < SCHEDULER_MAX_TASKS; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT8(i, addSchedulerTask(&scheduler, "task", countPeriodic, 0, 0, 0));
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(SCHEDULER_NO_TASK, addSchedulerTask(&scheduler, "one too many", countPeriodic, 0, 0, 0));
+    scheduleTask(&scheduler, SCHEDULER_NO_TASK, 0, 0); // callers do not check, must be harmless
+    cancelTask(&scheduler, SCHEDULER_NO_TASK);
+    TEST_ASSERT_FALSE(taskArmed(&scheduler, SCHEDULER_NO_TASK));
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_periodic_across_overflow);
+    RUN_TEST(test_one_shot_across_overflow);
+    RUN_TEST(test_one_shot_rearms_itself);
+    RUN_TEST(test_cancel_from_own_task);
+    RUN_TEST(test_cancel_other_task);
+    RUN_TEST(test_lateness_and_runtime);
+    RUN_TEST(test_idle_cap);
+    RUN_TEST(test_no_free_slot);
+
+    return UNITY_END();
+}
@@ -0,0 +1,329 @@
+// core includes
+#include <Arduino.h>
+#include <string>
+#include <vector>
+
+// project includes
+#include "stallProfiler.h"
+#include "deferredLog.h"
+#include "sim.h"
+#include "conf.h"
+
+// lib includes
+#include <unity.h>
+
+/* Stall profiler on the simulator clock: a scripted task does work of known length (simCharge) inside probes and loop iterations,
+ * stalls are caught from the deferred log, per site numbers from the printed profile. Probe adds one clock read to what it measures.
+ * Whole script runs once, tests then check what it recorded.
+ */
+
+#define LOG_TASK_TURN_MS 10 // script sleeps this long to let log task print everything
+#define BUCKET_SAMPLES 14
+#define CLOCK_READS_US 10 // probes and trace read the clock, measured time is over the work by a few us
+#define TEST_RUN_US (600 * SIM_US_PER_S)
+
+// work inside LED show probe (just under and at 1, 2, 4, 128 and 256 ms with the clock read added) and bucket it has to land in
+const uint32_t bucketSamplesUs[BUCKET_SAMPLES] = {0, 998, 1000, 1998, 2000, 3998, 4000, 127998, 128000, 254998, 255000, 256000, 1000000, 60000000};
+const uint8_t expectedBuckets[BUCKET_SAMPLES] = {0, 0, 1, 1, 2, 2, 3, 7, 8, 8, 8, 9, 9, 9};
+
+std::vector<std::string> lines;
+bool scriptDone = false;
+
+void catchLine(const char *line)
+{
+    lines.push_back(line);
+}
+
+void work(uint32_t ms)
+{
+    simCharge(ms * SIM_US_PER_MS);
+}
+
+// probe inside probe, nested one takes most of the time, outer one has the longest total
+void nestedIteration()
+{
+    stallLoopBegin(StallLoop::UI);
+
+    {
+        StallProbe probe(StallSite::SCREEN_REDRAW);
+
+        work(30);
+
+        {
+            StallProbe probe(StallSite::MAIN_SCREEN);
+
+            work(40);
+        }
+
+        work(5);
+    }
+
+    work(2);
+    stallLoopEnd(StallLoop::UI);
+}
+
+void unprobedIteration()
+{
+    stallLoopBegin(StallLoop::UI);
+
+    {
+        StallProbe probe(StallSite::ENCODERS);
+
+        work(20);
+    }
+
+    work(60);
+    stallLoopEnd(StallLoop::UI);
+}
+
+// probes nested deeper than STALL_PROFILER_MAX_DEPTH: the last level it follows gets their time as its own
+void tooDeep(uint8_t level)
+{
+    const StallSite sites[] = {StallSite::WIFI, StallSite::WEB_SERVER, StallSite::CONNECTIVITY, StallSite::WEATHER_HTTP};
+
+    if(level == STALL_PROFILER_MAX_DEPTH + 2)
+    {
+        return;
+    }
+
+    StallProbe probe((level < STALL_PROFILER_MAX_DEPTH) ? sites[level] : StallSite::FORECAST_HTTP);
+
+    work((level < STALL_PROFILER_MAX_DEPTH) ? 10 : 800);
+    tooDeep(level + 1);
+}
+
+void scriptedLoops(void *parameters)
+{
+    beginDeferredLog();
+
+    lines.push_back("PHASE NESTED");
+    nestedIteration();
+    delay(LOG_TASK_TURN_MS);
+
+    lines.push_back("PHASE UNPROBED");
+    unprobedIteration();
+    delay(LOG_TASK_TURN_MS);
+
+    lines.push_back("PHASE THRESHOLD");
+    stallLoopBegin(StallLoop::UI);
+    simCharge(STALL_PROFILER_UI_THRESHOLD_MS * SIM_US_PER_MS + 990); // 50.99 ms is not over 50
+    stallLoopEnd(StallLoop::UI);
+    stallLoopBegin(StallLoop::UI);
+    work(STALL_PROFILER_UI_THRESHOLD_MS + 1);
+    stallLoopEnd(StallLoop::UI);
+    delay(LOG_TASK_TURN_MS);
+
+    lines.push_back("PHASE TOO DEEP");
+    stallLoopBegin(StallLoop::NETWORK);
+    tooDeep(0);
+    stallLoopEnd(StallLoop::NETWORK);
+    delay(LOG_TASK_TURN_MS);
+
+    // depth is back to 0, own time is known again
+    lines.push_back("PHASE AFTER TOO DEEP");
+    stallLoopBegin(StallLoop::NETWORK);
+
+    {
+        StallProbe probe(StallSite::FORECAST_HTTP);
+
+        work(1200);
+    }
+
+    stallLoopEnd(StallLoop::NETWORK);
+    delay(LOG_TASK_TURN_MS);
+
+    for(uint8_t i = 0; i < BUCKET_SAMPLES; i++)
+    {
+        StallProbe probe(StallSite::LED_SHOW);
+
+        simCharge(bucketSamplesUs[i]);
+    }
+
+    lines.push_back("PHASE PROFILE");
+    printStallProfile();
+
+    scriptDone = true;
+    simStop("script done");
+
+    for(;;)
+    {
+        delay(SCHEDULER_MAX_IDLE_MS);
+    }
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// lines printed after the phase marker, up to the next one
+std::vector<std::string> phaseLines(const char *phase)
+{
+    std::vector<std::string> found;
+    bool inside = false;
+
+    for(const std::string &line : lines)
+    {
+        if(line.compare(0, 6, "PHASE ") == 0)
+        {
+            inside = (line.compare(6, std::string::npos, phase) == 0);
+            continue;
+        }
+
+        if(inside)
+        {
+            found.push_back(line);
+        }
+    }
+
+    return found;
+}
+
+struct SiteProfile
+{
+    uint32_t count;
+    uint32_t avgUs;
+    uint32_t maxUs;
+    uint32_t buckets[STALL_PROFILER_BUCKETS];
+};
+
+// printed profile line of the site read back
+SiteProfile siteProfile(const char *site)
+{
+    std::string prefix = std::string("  |-- ") + site + ": ";
+    SiteProfile profile = {};
+
+    for(const std::string &line : phaseLines("PROFILE"))
+    {
+        if(line.compare(0, prefix.size(), prefix) != 0)
+        {
+            continue;
+        }
+
+        const char *text = line.c_str() + prefix.size();
+        int length = 0;
+
+        TEST_ASSERT_EQUAL(3, sscanf(text, "count %u, avg %u us, max %u us, ms histogram%n", &profile.count, &profile.avgUs, &profile.maxUs, &length));
+        text += length;
+
+        for(uint8_t bucket = 0; bucket < STALL_PROFILER_BUCKETS; bucket++)
+        {
+            TEST_ASSERT_EQUAL(1, sscanf(text, " %u%n", &profile.buckets[bucket], &length));
+            text += length;
+        }
+
+        TEST_ASSERT_EQUAL_STRING("", text);
+    }
+
+    return profile;
+}
+
+void expectTime(uint32_t workUs, uint32_t measuredUs)
+{
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(workUs, measuredUs);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(workUs + CLOCK_READS_US, measuredUs);
+}
+
+void expectOnlyBucket(uint8_t expected, const SiteProfile &profile)
+{
+    for(uint8_t bucket = 0; bucket < STALL_PROFILER_BUCKETS; bucket++)
+    {
+        TEST_ASSERT_EQUAL_UINT32((bucket == expected) ? profile.count : 0, profile.buckets[bucket]);
+    }
+}
+
+void expectStall(const char *phase, const char *stall, const char *site)
+{
+    std::vector<std::string> found = phaseLines(phase);
+
+    TEST_ASSERT_EQUAL_UINT32(2, found.size());
+    TEST_ASSERT_EQUAL_STRING(stall, found[0].c_str());
+    TEST_ASSERT_EQUAL_STRING(site, found[1].c_str());
+}
+
+void test_script_completes()
+{
+    TEST_ASSERT_TRUE(scriptDone);
+    TEST_ASSERT_EQUAL_STRING("script done", simStopReason());
+}
+
+// main screen took 40 ms of its own, screen redraw 75 ms in total but only 35 ms without main screen
+void test_own_time_of_nested_probes()
+{
+    SiteProfile screenRedraw = siteProfile("screen redraw");
+    SiteProfile mainScreen = siteProfile("main screen");
+
+    expectStall("NESTED", "STALL: UI loop 77 ms", "  |-- site: main screen (40 ms)");
+    TEST_ASSERT_EQUAL_UINT32(1, screenRedraw.count);
+    expectTime(75000, screenRedraw.maxUs);
+    expectOnlyBucket(7, screenRedraw);
+    TEST_ASSERT_EQUAL_UINT32(1, mainScreen.count);
+    expectTime(40000, mainScreen.maxUs);
+    expectOnlyBucket(6, mainScreen);
+}
+
+void test_worst_site_vs_unprobed_time()
+{
+    expectStall("UNPROBED", "STALL: UI loop 80 ms", "  |-- site: not probed (60 ms)");
+}
+
+// threshold is in whole ms, 50.99 ms is not over it
+void test_threshold()
+{
+    expectStall("THRESHOLD", "STALL: UI loop 51 ms", "  |-- site: not probed (51 ms)");
+}
+
+// too deep probes are still counted for their site, their time goes to the deepest level with known own time
+void test_max_depth_overflow()
+{
+    expectStall("TOO DEEP", "STALL: network loop 1640 ms", "  |-- site: weather HTTP (1610 ms)");
+    TEST_ASSERT_EQUAL_UINT32(3, siteProfile("forecast HTTP").count);
+    TEST_ASSERT_EQUAL_UINT32(1, siteProfile("wifi").count);
+    expectTime((10 + 2 * 800) * SIM_US_PER_MS, siteProfile("weather HTTP").maxUs); // 10 ms of its own and 800 ms of both too deep probes
+    expectStall("AFTER TOO DEEP", "STALL: network loop 1200 ms", "  |-- site: forecast HTTP (1200 ms)");
+}
+
+// bucket 0 under 1 ms, bucket i [2^(i-1), 2^i) ms, last one everything from 256 ms up
+void test_bucket_edges()
+{
+    SiteProfile ledShow = siteProfile("LED show");
+    uint32_t buckets[STALL_PROFILER_BUCKETS] = {};
+
+    for(uint8_t i = 0; i < BUCKET_SAMPLES; i++)
+    {
+        buckets[expectedBuckets[i]]++;
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(BUCKET_SAMPLES, ledShow.count);
+    expectTime(bucketSamplesUs[BUCKET_SAMPLES - 1], ledShow.maxUs);
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(buckets, ledShow.buckets, STALL_PROFILER_BUCKETS);
+}
+
+void test_histogram_header()
+{
+    std::vector<std::string> found = phaseLines("PROFILE");
+
+    TEST_ASSERT_TRUE(found.size() > 3);
+    TEST_ASSERT_EQUAL_STRING("  |-- histogram buckets (ms): <1 <2 <4 <8 <16 <32 <64 <128 <256 >=256", found[3].c_str());
+}
+
+int main(int argc, char **argv)
+{
+    simConsoleListener = catchLine;
+    xTaskCreatePinnedToCore(scriptedLoops, "loopTask", 8192, NULL, 1, NULL, 1);
+    simRun(TEST_RUN_US);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_script_completes);
+    RUN_TEST(test_own_time_of_nested_probes);
+    RUN_TEST(test_worst_site_vs_unprobed_time);
+    RUN_TEST(test_threshold);
+    RUN_TEST(test_max_depth_overflow);
+    RUN_TEST(test_bucket_edges);
+    RUN_TEST(test_histogram_header);
+
+    return UNITY_END();
+}
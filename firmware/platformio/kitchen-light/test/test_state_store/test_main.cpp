@@ -0,0 +1,253 @@
+// core includes
+#include <Arduino.h>
+
+// project includes
+#include "stateStore.h"
+#include "conf.h"
+
+// lib includes
+#include <unity.h>
+
+/* State store with recording subscribers: what each of them got and how many times.
+ * Subscriptions cannot be removed, so they are made once, every test starts from a fresh initial state instead.
+ */
+
+#define ALL_STATE_FIELDS ((1UL << (uint8_t)StateField::COUNT) - 1)
+#define INITIAL_BRIGHTNESS 100
+#define SUBSCRIBERS 3
+
+const CRGB red = CRGB(255, 0, 0);
+const CRGB blue = CRGB(0, 0, 255);
+
+struct Notifications
+{
+    uint32_t calls;
+    uint32_t changedFields; // of the last call
+    UiState state;
+    UiState previous;
+};
+
+Notifications lightNotifications;
+Notifications networkNotifications;
+Notifications offlineNotifications;
+
+void record(Notifications *notifications, const UiState *state, const UiState *previous, uint32_t changedFields)
+{
+    notifications->calls++;
+    notifications->changedFields = changedFields;
+    notifications->state = *state;
+    notifications->previous = *previous;
+}
+
+void recordLight(const UiState *state, const UiState *previous, uint32_t changedFields)
+{
+    record(&lightNotifications, state, previous, changedFields);
+}
+
+void recordNetwork(const UiState *state, const UiState *previous, uint32_t changedFields)
+{
+    record(&networkNotifications, state, previous, changedFields);
+}
+
+// offline mode dims the light, as a subscriber may set state itself
+void dimWhenOffline(const UiState *state, const UiState *previous, uint32_t changedFields)
+{
+    record(&offlineNotifications, state, previous, changedFields);
+
+    if(state->offlineMode && !previous->offlineMode)
+    {
+        setBrightness(state->brightness / 2);
+    }
+}
+
+void setUp()
+{
+    UiState initialState = {};
+
+    initialState.brightness = INITIAL_BRIGHTNESS;
+    initialState.colorPickerType = ColorPickerType::COLOR_TEMPERATURE;
+    initialState.wifiSignal = WifiSignal::DISCONNECTED;
+
+    beginStateStore(&initialState);
+    lightNotifications = {};
+    networkNotifications = {};
+    offlineNotifications = {};
+}
+
+void tearDown()
+{
+}
+
+// first dispatch after begin, as in setup()
+void sync()
+{
+    dispatchStateChanges();
+    lightNotifications = {};
+    networkNotifications = {};
+    offlineNotifications = {};
+}
+
+void test_initial_dispatch()
+{
+    dispatchStateChanges();
+
+    TEST_ASSERT_EQUAL_UINT32(1, lightNotifications.calls);
+    TEST_ASSERT_EQUAL_UINT32(STATE_FIELDS_LIGHT, lightNotifications.changedFields); // every field it subscribed to
+    TEST_ASSERT_EQUAL_UINT32(1, networkNotifications.calls);
+    TEST_ASSERT_EQUAL_UINT32(STATE_FIELDS_NETWORK, networkNotifications.changedFields);
+    TEST_ASSERT_EQUAL_MEMORY(&lightNotifications.state, &lightNotifications.previous, sizeof(UiState)); // nothing came before
+    TEST_ASSERT_EQUAL_UINT8(INITIAL_BRIGHTNESS, lightNotifications.state.brightness);
+
+    dispatchStateChanges();
+    TEST_ASSERT_EQUAL_UINT32(1, lightNotifications.calls);
+}
+
+// state set during setup() is the initial state, not a change from it
+void test_set_before_first_dispatch()
+{
+    setBrightness(50);
+    dispatchStateChanges();
+
+    TEST_ASSERT_EQUAL_UINT8(50, lightNotifications.state.brightness);
+    TEST_ASSERT_EQUAL_UINT8(50, lightNotifications.previous.brightness);
+}
+
+void test_same_value_is_no_change()
+{
+    sync();
+
+    setBrightness(INITIAL_BRIGHTNESS);
+    setColorPickerType(ColorPickerType::COLOR_TEMPERATURE);
+    setWifiSignal(WifiSignal::DISCONNECTED);
+    setLiveColor(false, red); // color of inactive live control does not matter
+    dispatchStateChanges();
+
+    TEST_ASSERT_EQUAL_UINT32(0, lightNotifications.calls);
+    TEST_ASSERT_EQUAL_UINT32(0, networkNotifications.calls);
+}
+
+// any number of changes in between is one notification, only of fields the subscriber asked for
+void test_changes_coalesce()
+{
+    sync();
+
+    setBrightness(10);
+    setBrightness(20);
+    setColorHueIndex(300);
+    setColorPickerType(ColorPickerType::COLOR_HUE);
+    dispatchStateChanges();
+
+    TEST_ASSERT_EQUAL_UINT32(1, lightNotifications.calls);
+    TEST_ASSERT_EQUAL_UINT32(STATE_FIELD(StateField::BRIGHTNESS) | STATE_FIELD(StateField::COLOR_HUE_INDEX) | STATE_FIELD(StateField::COLOR_PICKER_TYPE), lightNotifications.changedFields);
+    TEST_ASSERT_EQUAL_UINT8(20, lightNotifications.state.brightness);
+    TEST_ASSERT_EQUAL_UINT8(INITIAL_BRIGHTNESS, lightNotifications.previous.brightness);
+    TEST_ASSERT_EQUAL_UINT16(300, lightNotifications.state.colorHueIndex);
+    TEST_ASSERT_EQUAL_UINT32(0, networkNotifications.calls); // none of its fields
+
+    setBrightness(30);
+    dispatchStateChanges();
+
+    TEST_ASSERT_EQUAL_UINT32(2, lightNotifications.calls);
+    TEST_ASSERT_EQUAL_UINT32(STATE_FIELD(StateField::BRIGHTNESS), lightNotifications.changedFields);
+    TEST_ASSERT_EQUAL_UINT8(20, lightNotifications.previous.brightness); // as it was dispatched last time
+}
+
+void test_back_and_forth_counts()
+{
+    sync();
+
+    setBrightness(10);
+    setBrightness(INITIAL_BRIGHTNESS);
+    dispatchStateChanges();
+
+    TEST_ASSERT_EQUAL_UINT32(1, lightNotifications.calls);
+    TEST_ASSERT_EQUAL_UINT32(STATE_FIELD(StateField::BRIGHTNESS), lightNotifications.changedFields);
+    TEST_ASSERT_EQUAL_UINT8(lightNotifications.previous.brightness, lightNotifications.state.brightness);
+}
+
+void test_live_color()
+{
+    sync();
+
+    setLiveColor(true, red);
+    dispatchStateChanges();
+    TEST_ASSERT_EQUAL_UINT32(1, lightNotifications.calls);
+    TEST_ASSERT_EQUAL_UINT32(STATE_FIELD(StateField::LIVE_COLOR), lightNotifications.changedFields);
+
+    setLiveColor(true, red);
+    dispatchStateChanges();
+    TEST_ASSERT_EQUAL_UINT32(1, lightNotifications.calls);
+
+    setLiveColor(true, blue);
+    dispatchStateChanges();
+    TEST_ASSERT_EQUAL_UINT32(2, lightNotifications.calls);
+    TEST_ASSERT_TRUE(lightNotifications.state.liveColor == blue);
+    TEST_ASSERT_TRUE(lightNotifications.previous.liveColor == red);
+}
+
+// weather data lives outside of store, its field is marked by hand
+void test_mark_changed()
+{
+    sync();
+
+    markStateChanged(StateField::WEATHER);
+    dispatchStateChanges();
+
+    TEST_ASSERT_EQUAL_UINT32(0, lightNotifications.calls);
+    TEST_ASSERT_EQUAL_UINT32(1, networkNotifications.calls);
+    TEST_ASSERT_EQUAL_UINT32(STATE_FIELD(StateField::WEATHER), networkNotifications.changedFields);
+}
+
+// what a subscriber sets comes with the next dispatch, subscribers of this one see state as it was
+void test_subscriber_sets_state()
+{
+    sync();
+
+    setOfflineMode(true);
+    dispatchStateChanges();
+
+    TEST_ASSERT_EQUAL_UINT32(1, offlineNotifications.calls);
+    TEST_ASSERT_EQUAL_UINT32(0, lightNotifications.calls); // subscribed before, brightness was not changed yet
+    TEST_ASSERT_EQUAL_UINT32(1, networkNotifications.calls);
+    TEST_ASSERT_EQUAL_UINT8(INITIAL_BRIGHTNESS / 2, uiState()->brightness);
+
+    dispatchStateChanges();
+
+    TEST_ASSERT_EQUAL_UINT32(1, lightNotifications.calls);
+    TEST_ASSERT_EQUAL_UINT8(INITIAL_BRIGHTNESS / 2, lightNotifications.state.brightness);
+    TEST_ASSERT_EQUAL_UINT8(INITIAL_BRIGHTNESS, lightNotifications.previous.brightness);
+    TEST_ASSERT_EQUAL_UINT32(1, offlineNotifications.calls); // offline mode did not change again
+}
+
+void test_no_free_slot()
+{
+    for(uint8_t i = SUBSCRIBERS; i < STATE_STORE_MAX_SUBSCRIBERS; i++)
+    {
+        TEST_ASSERT_TRUE(subscribeState(0, recordLight)); // no fields, never called
+    }
+
+    TEST_ASSERT_FALSE(subscribeState(ALL_STATE_FIELDS, recordLight));
+
+    dispatchStateChanges(); // initial one
+    TEST_ASSERT_EQUAL_UINT32(1, lightNotifications.calls);
+}
+
+int main(int argc, char **argv)
+{
+    subscribeState(STATE_FIELDS_LIGHT, recordLight);
+    subscribeState(STATE_FIELDS_NETWORK, recordNetwork);
+    subscribeState(STATE_FIELD(StateField::OFFLINE_MODE), dimWhenOffline);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_initial_dispatch);
+    RUN_TEST(test_set_before_first_dispatch);
+    RUN_TEST(test_same_value_is_no_change);
+    RUN_TEST(test_changes_coalesce);
+    RUN_TEST(test_back_and_forth_counts);
+    RUN_TEST(test_live_color);
+    RUN_TEST(test_mark_changed);
+    RUN_TEST(test_subscriber_sets_state);
+    RUN_TEST(test_no_free_slot); // last, fills all slots
+
+    return UNITY_END();
+}
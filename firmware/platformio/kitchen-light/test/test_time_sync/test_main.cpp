@@ -0,0 +1,266 @@
+// core includes
+#include <Arduino.h>
+#include <WiFi.h>
+#include <string>
+#include <vector>
+
+// project includes
+#include "timeSync.h"
+#include "sim.h"
+#include "conf.h"
+
+// lib includes
+#include <unity.h>
+
+/* Time sync record against the simulated NTP (answers every hour, sets device clock to real time) on a clock with known drift.
+ * Restart is beginTimeSync() called again, RTC record and system time are kept as ESP.restart() keeps them.
+ * A scripted task goes through the phases, marking each with a "PHASE" line among console lines it catches,
+ * whole script runs once, tests then check what it recorded.
+ */
+
+#define TEST_TIME_ZONE "CET-1CEST,M3.5.0,M10.5.0/3"
+#define SIM_DRIFT_PPM 40.0 // device clock runs fast, firmware reports that as negative drift (+ means slow)
+#define DRIFT_TOLERANCE_PPM 0.1
+#define NTP_INTERVAL_S 3600 // sntp default
+#define NTP_ANSWER_MS 1000 // simulated answer takes 50 ms, script waits a bit longer
+#define MAX_AGE_S (uint32_t)(TIME_MAX_ERROR_S * 1000000.0 / (SIM_DRIFT_PPM + TIME_DRIFT_MARGIN_PPM)) // at measured drift
+#define AGE_MARGIN_S 3600
+#define TEST_RUN_US ((uint64_t)30 * 86400 * SIM_US_PER_S)
+
+// whole record is opaque here, only its syncEpoch (right after magic) is damaged
+struct TimeSyncRecord;
+extern TimeSyncRecord timeSyncRecord;
+#define SYNC_EPOCH_OFFSET 8
+
+enum class Check : uint8_t {POWER_ON, FIRST_SYNC, SECOND_SYNC, RESTART, STALE, JUST_UNDER_MAX_AGE, OVER_MAX_AGE, BAD_CHECKSUM, COUNT};
+
+std::vector<std::string> lines;
+std::vector<uint64_t> syncsUs; // when NTP answers came
+TimeQuality qualities[(uint8_t)Check::COUNT];
+time_t epochs[(uint8_t)Check::COUNT];
+time_t epochBeforeRestart = 0;
+bool scriptDone = false;
+
+void catchLine(const char *line)
+{
+    lines.push_back(line);
+
+    if(strcmp(line, "NTP SYNC: OK") == 0)
+    {
+        syncsUs.push_back(simNow());
+    }
+}
+
+void check(Check step)
+{
+    qualities[(uint8_t)step] = getTimeQuality();
+    epochs[(uint8_t)step] = time(NULL);
+}
+
+// sleeps until given time after the last NTP answer
+void sleepUntilAge(uint32_t ageS)
+{
+    delay((uint32_t)((syncsUs.back() + (uint64_t)ageS * SIM_US_PER_S - simNow()) / SIM_US_PER_MS));
+}
+
+void scriptedSyncs(void *parameters)
+{
+    lines.push_back("PHASE POWER ON");
+    beginTimeSync(TEST_TIME_ZONE);
+    check(Check::POWER_ON);
+
+    WiFi.mode(WIFI_STA);
+    WiFi.begin("home", "password");
+
+    while(WiFi.status() != WL_CONNECTED)
+    {
+        delay(100);
+    }
+
+    lines.push_back("PHASE FIRST SYNC");
+    startTimeSync();
+    delay(NTP_ANSWER_MS);
+    check(Check::FIRST_SYNC);
+
+    lines.push_back("PHASE SECOND SYNC");
+    sleepUntilAge(NTP_INTERVAL_S);
+    delay(NTP_ANSWER_MS);
+    check(Check::SECOND_SYNC);
+
+    lines.push_back("PHASE RESTART");
+    epochBeforeRestart = time(NULL);
+    beginTimeSync(TEST_TIME_ZONE);
+    check(Check::RESTART);
+
+    // no NTP answer from now on, estimated error grows at the measured drift
+    lines.push_back("PHASE NO NTP");
+    simNetwork.ntp = false;
+    sleepUntilAge(TIME_SYNC_FRESH_S + 1);
+    check(Check::STALE);
+    sleepUntilAge(MAX_AGE_S - AGE_MARGIN_S);
+    check(Check::JUST_UNDER_MAX_AGE);
+    sleepUntilAge(MAX_AGE_S + AGE_MARGIN_S);
+    check(Check::OVER_MAX_AGE);
+
+    lines.push_back("PHASE BAD CHECKSUM");
+    ((uint8_t*)&timeSyncRecord)[SYNC_EPOCH_OFFSET] ^= 0x01;
+    beginTimeSync(TEST_TIME_ZONE);
+    check(Check::BAD_CHECKSUM);
+
+    scriptDone = true;
+    simStop("script done");
+
+    for(;;)
+    {
+        delay(SCHEDULER_MAX_IDLE_MS);
+    }
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// lines printed after the phase marker, up to the next one
+std::vector<std::string> phaseLines(const char *phase)
+{
+    std::vector<std::string> found;
+    bool inside = false;
+
+    for(const std::string &line : lines)
+    {
+        if(line.compare(0, 6, "PHASE ") == 0)
+        {
+            inside = (line.compare(6, std::string::npos, phase) == 0);
+            continue;
+        }
+
+        if(inside)
+        {
+            found.push_back(line);
+        }
+    }
+
+    return found;
+}
+
+// number after prefix of the first line in the phase starting with it, NAN when there is none
+float phaseNumber(const char *phase, const char *prefix)
+{
+    for(const std::string &line : phaseLines(phase))
+    {
+        if(line.compare(0, strlen(prefix), prefix) == 0)
+        {
+            return strtof(line.c_str() + strlen(prefix), NULL);
+        }
+    }
+
+    return NAN;
+}
+
+bool phaseHasLine(const char *phase, const char *expected)
+{
+    for(const std::string &line : phaseLines(phase))
+    {
+        if(line == expected)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void expectQuality(TimeQuality expected, Check step)
+{
+    TEST_ASSERT_EQUAL_STRING(timeQualityString[(uint8_t)expected], timeQualityString[(uint8_t)qualities[(uint8_t)step]]);
+}
+
+void test_script_completes()
+{
+    TEST_ASSERT_TRUE(scriptDone);
+    TEST_ASSERT_EQUAL_STRING("script done", simStopReason());
+    TEST_ASSERT_EQUAL_UINT32(2, syncsUs.size());
+}
+
+// RTC memory holds garbage (zeros here) after power-on, clock is reset
+void test_power_on()
+{
+    TEST_ASSERT_TRUE(phaseHasLine("POWER ON", "Time: NONE"));
+    expectQuality(TimeQuality::NONE, Check::POWER_ON);
+    TEST_ASSERT_TRUE(epochs[(uint8_t)Check::POWER_ON] < MIN_VALID_EPOCH);
+}
+
+// one sync is too little to tell drift
+void test_first_sync()
+{
+    expectQuality(TimeQuality::SYNCED, Check::FIRST_SYNC);
+    TEST_ASSERT_TRUE(epochs[(uint8_t)Check::FIRST_SYNC] >= MIN_VALID_EPOCH);
+    TEST_ASSERT_TRUE(isnan(phaseNumber("FIRST SYNC", "  |-- measured drift: ")));
+}
+
+// NTP time elapsed against local clock elapsed over the hour between two syncs
+void test_drift_after_two_syncs()
+{
+    float driftPpm = phaseNumber("SECOND SYNC", "  |-- measured drift: ");
+    char message[64];
+
+    snprintf(message, sizeof(message), "measured drift %.2f ppm, simulated clock %.2f ppm fast", driftPpm, SIM_DRIFT_PPM);
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_TRUE(fabsf(driftPpm + SIM_DRIFT_PPM) < DRIFT_TOLERANCE_PPM);
+    expectQuality(TimeQuality::SYNCED, Check::SECOND_SYNC);
+}
+
+// valid record keeps the clock and brings back the drift estimate
+void test_restart_keeps_record()
+{
+    float driftPpm = phaseNumber("RESTART", "  |-- drift: ");
+
+    TEST_ASSERT_TRUE(phaseHasLine("RESTART", "Time: SYNCED"));
+    TEST_ASSERT_TRUE(phaseHasLine("RESTART", "  |-- last NTP sync: 1 s ago"));
+    TEST_ASSERT_TRUE(fabsf(driftPpm + SIM_DRIFT_PPM) < DRIFT_TOLERANCE_PPM);
+    TEST_ASSERT_TRUE(epochs[(uint8_t)Check::RESTART] - epochBeforeRestart <= 1);
+}
+
+// without NTP clock is shown until its estimated error at the measured drift (plus margin) gets over the limit
+void test_over_age_rejected()
+{
+    expectQuality(TimeQuality::FREE_RUNNING, Check::STALE);
+    expectQuality(TimeQuality::FREE_RUNNING, Check::JUST_UNDER_MAX_AGE);
+    expectQuality(TimeQuality::NONE, Check::OVER_MAX_AGE);
+}
+
+// one flipped bit of the record is caught by its checksum, the record is then treated as after power-on
+void test_bad_checksum_ignored()
+{
+    std::vector<std::string> found = phaseLines("BAD CHECKSUM");
+
+    TEST_ASSERT_EQUAL_UINT32(2, found.size());
+    TEST_ASSERT_EQUAL_STRING("Time: NONE", found[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("  |-- timezone: " TEST_TIME_ZONE, found[1].c_str());
+    expectQuality(TimeQuality::NONE, Check::BAD_CHECKSUM);
+    TEST_ASSERT_TRUE(epochs[(uint8_t)Check::BAD_CHECKSUM] < MIN_VALID_EPOCH);
+}
+
+int main(int argc, char **argv)
+{
+    simClockDriftPpm = SIM_DRIFT_PPM;
+    simConsoleListener = catchLine;
+    xTaskCreatePinnedToCore(scriptedSyncs, "loopTask", 8192, NULL, 1, NULL, 1);
+    simRun(TEST_RUN_US);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_script_completes);
+    RUN_TEST(test_power_on);
+    RUN_TEST(test_first_sync);
+    RUN_TEST(test_drift_after_two_syncs);
+    RUN_TEST(test_restart_keeps_record);
+    RUN_TEST(test_over_age_rejected);
+    RUN_TEST(test_bad_checksum_ignored);
+
+    return UNITY_END();
+}
@@ -0,0 +1,347 @@
+// core includes
+#include <Arduino.h>
+#include <atomic>
+#include <string>
+#include <vector>
+
+// project includes
+#include "trace.h"
+#include "conf.h"
+
+// lib includes
+#include <ArduinoJson.h>
+#include <unity.h>
+
+/* Trace ring and its Chrome Trace Event JSON, read back with ArduinoJson. Events are recorded straight from the test,
+ * timestamps come from the simulator clock (every read costs 1 us, so they all differ). Ring position is reset before
+ * each test, records left in the ring from earlier tests are then older than position and never read.
+ */
+
+#define FULL_TEXT_SIZE (TRACE_RING_SIZE * 96 + 1024) // whole ring, event is at most about 70 B
+#define CUT_EVENTS 30
+
+// ring position, kept by trace.cpp
+extern std::atomic<uint32_t> traceHead;
+
+struct Event
+{
+    std::string name;
+    std::string phase;
+    uint32_t thread;
+    int64_t timeUs;
+};
+
+const char *names[] = {"name 0", "name 1", "name 2", "name 3", "name 4", "name 5", "name 6"}; // only addresses are recorded
+const uint8_t nameCount = sizeof(names) / sizeof(names[0]);
+
+class StringPrint : public Print
+{
+    public:
+        size_t write(uint8_t c) override
+        {
+            return write(&c, 1);
+        }
+
+        size_t write(const uint8_t *data, size_t length) override
+        {
+            text.append((const char*)data, length);
+
+            return length;
+        }
+
+        std::string text;
+};
+
+// starts a second dump while printing the first one, as GET /trace may during serial "trace"
+class OverlappingDumpPrint : public StringPrint
+{
+    public:
+        size_t write(const uint8_t *data, size_t length) override
+        {
+            if(text.empty())
+            {
+                std::vector<char> buffer(FULL_TEXT_SIZE);
+
+                innerLength = renderTrace(buffer.data(), buffer.size());
+                traceInstant("during dumps", StallLoop::UI);
+            }
+
+            return StringPrint::write(data, length);
+        }
+
+        size_t innerLength = 0;
+};
+
+std::string render(size_t size)
+{
+    std::vector<char> buffer(size + 1, 'x');
+    size_t length = renderTrace(buffer.data(), size);
+
+    TEST_ASSERT_EQUAL_UINT32(length, strlen(buffer.data()));
+
+    return std::string(buffer.data(), length);
+}
+
+// events without thread_name metadata, fails when text is not valid JSON (metadata may be cut short, only when no event follows)
+std::vector<Event> parse(const std::string &text)
+{
+    JsonDocument document;
+    std::vector<Event> events;
+    DeserializationError error = deserializeJson(document, text.c_str(), text.size());
+
+    TEST_ASSERT_FALSE_MESSAGE(error, text.c_str());
+
+    JsonVariant traceEvents = document["traceEvents"];
+    uint32_t threadNames = 0;
+
+    for(size_t i = 0; i < traceEvents.size(); i++)
+    {
+        JsonVariant event = traceEvents[i];
+
+        if(strcmp(event["ph"].as<const char*>(), "M") == 0)
+        {
+            threadNames++;
+            continue;
+        }
+
+        events.push_back({event["name"].as<const char*>(), event["ph"].as<const char*>(), event["tid"].as<uint32_t>(), event["ts"].as<int64_t>()});
+    }
+
+    TEST_ASSERT_TRUE(threadNames == (uint32_t)StallLoop::COUNT || (threadNames < (uint32_t)StallLoop::COUNT && events.empty()));
+
+    return events;
+}
+
+std::vector<Event> renderEvents()
+{
+    return parse(render(FULL_TEXT_SIZE));
+}
+
+uint32_t countNamed(const std::vector<Event> &events, const char *name)
+{
+    uint32_t count = 0;
+
+    for(const Event &event : events)
+    {
+        count += (event.name == name) ? 1 : 0;
+    }
+
+    return count;
+}
+
+void expectInOrder(const std::vector<Event> &events)
+{
+    for(size_t i = 1; i < events.size(); i++)
+    {
+        TEST_ASSERT_TRUE(events[i].timeUs > events[i - 1].timeUs);
+    }
+}
+
+void setUp()
+{
+    traceHead.store(0);
+}
+
+void tearDown()
+{
+}
+
+void test_empty()
+{
+    std::string text = render(FULL_TEXT_SIZE);
+
+    TEST_ASSERT_EQUAL_UINT32(0, parse(text).size());
+    TEST_ASSERT_TRUE(text.find("\"tid\":1,") != std::string::npos);
+    TEST_ASSERT_TRUE(text.find("\"UI loop\"") != std::string::npos);
+    TEST_ASSERT_TRUE(text.find("\"network task\"") != std::string::npos);
+    TEST_ASSERT_EQUAL_STRING("]}\n", text.substr(text.size() - 3).c_str());
+}
+
+// spans of the two loops interleave, each loop keeps its own depth
+void test_nesting_per_thread()
+{
+    traceBegin("draw", StallLoop::UI);
+    traceBegin("weather", StallLoop::NETWORK);
+    traceBegin("text", StallLoop::UI);
+    traceInstant("knob", StallLoop::UI);
+    traceEnd("text", StallLoop::UI);
+    traceEnd("weather", StallLoop::NETWORK);
+    traceEnd("stray", StallLoop::NETWORK); // network is at depth 0 although UI loop is not
+    traceEnd("draw", StallLoop::UI);
+
+    std::vector<Event> events = renderEvents();
+    const char *expected[][3] = {{"draw", "B", "0"}, {"weather", "B", "1"}, {"text", "B", "0"}, {"knob", "i", "0"},
+        {"text", "E", "0"}, {"weather", "E", "1"}, {"draw", "E", "0"}};
+
+    TEST_ASSERT_EQUAL_UINT32(7, events.size());
+
+    for(uint8_t i = 0; i < 7; i++)
+    {
+        TEST_ASSERT_EQUAL_STRING(expected[i][0], events[i].name.c_str());
+        TEST_ASSERT_EQUAL_STRING(expected[i][1], events[i].phase.c_str());
+        TEST_ASSERT_EQUAL_UINT32(atoi(expected[i][2]), events[i].thread);
+    }
+
+    expectInOrder(events);
+}
+
+// oldest events are overwritten, the rest come out oldest first
+void test_wraparound()
+{
+    for(uint32_t i = 0; i < TRACE_RING_SIZE + 10; i++)
+    {
+        traceInstant(names[i % nameCount], StallLoop::UI);
+    }
+
+    std::vector<Event> events = renderEvents();
+
+    TEST_ASSERT_EQUAL_UINT32(TRACE_RING_SIZE, events.size());
+    TEST_ASSERT_EQUAL_STRING(names[10 % nameCount], events.front().name.c_str());
+    TEST_ASSERT_EQUAL_STRING(names[(TRACE_RING_SIZE + 9) % nameCount], events.back().name.c_str());
+    expectInOrder(events);
+}
+
+void test_end_kept_while_begin_is_in_ring()
+{
+    traceBegin("outer", StallLoop::UI);
+
+    for(uint32_t i = 0; i < TRACE_RING_SIZE - 2; i++)
+    {
+        traceInstant("filler", StallLoop::UI);
+    }
+
+    traceEnd("outer", StallLoop::UI);
+
+    std::vector<Event> events = renderEvents();
+
+    TEST_ASSERT_EQUAL_UINT32(TRACE_RING_SIZE, events.size());
+    TEST_ASSERT_EQUAL_STRING("B", events.front().phase.c_str());
+    TEST_ASSERT_EQUAL_STRING("E", events.back().phase.c_str());
+}
+
+// end of a span whose begin was overwritten would close a span of something else, so it is left out
+void test_end_dropped_after_begin_overwritten()
+{
+    traceBegin("outer", StallLoop::UI);
+
+    for(uint32_t i = 0; i < TRACE_RING_SIZE - 2; i++)
+    {
+        traceInstant("filler", StallLoop::UI);
+    }
+
+    traceBegin("inner", StallLoop::UI);
+    traceEnd("inner", StallLoop::UI);
+    traceEnd("outer", StallLoop::UI);
+
+    std::vector<Event> events = renderEvents();
+
+    TEST_ASSERT_EQUAL_UINT32(0, countNamed(events, "outer"));
+    TEST_ASSERT_EQUAL_UINT32(2, countNamed(events, "inner"));
+    TEST_ASSERT_EQUAL_STRING("E", events.back().phase.c_str());
+    TEST_ASSERT_EQUAL_STRING("inner", events.back().name.c_str());
+}
+
+// every buffer size gives valid JSON with whole events, the first ones, or nothing when not even the opening fits
+void test_cut_at_size()
+{
+    for(uint8_t i = 0; i < CUT_EVENTS; i++)
+    {
+        traceBegin(names[i % nameCount], (StallLoop)(i % 2));
+        traceInstant("knob", StallLoop::UI);
+        traceEnd(names[i % nameCount], (StallLoop)(i % 2));
+    }
+
+    std::string full = render(FULL_TEXT_SIZE);
+    std::vector<Event> fullEvents = parse(full);
+    size_t previousCount = 0;
+    bool opened = false;
+
+    TEST_ASSERT_EQUAL_UINT32(3 * CUT_EVENTS, fullEvents.size());
+
+    for(size_t size = 0; size <= full.size() + 1; size++)
+    {
+        std::string text = render(size);
+
+        if(text.empty())
+        {
+            TEST_ASSERT_FALSE(opened); // once opening fits, it always does
+            continue;
+        }
+
+        opened = true;
+        TEST_ASSERT_LESS_THAN_UINT32(size, text.size());
+        TEST_ASSERT_EQUAL_STRING("]}\n", text.substr(text.size() - 3).c_str());
+
+        std::vector<Event> events = parse(text);
+
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT32(previousCount, events.size());
+
+        for(size_t i = 0; i < events.size(); i++)
+        {
+            TEST_ASSERT_EQUAL_STRING(fullEvents[i].name.c_str(), events[i].name.c_str());
+            TEST_ASSERT_EQUAL_STRING(fullEvents[i].phase.c_str(), events[i].phase.c_str());
+        }
+
+        previousCount = events.size();
+    }
+
+    TEST_ASSERT_TRUE(opened);
+    TEST_ASSERT_EQUAL_UINT32(fullEvents.size(), previousCount);
+}
+
+// recording resumes when the last of overlapping dumps finishes, not the first
+void test_overlapping_dumps()
+{
+    OverlappingDumpPrint out;
+
+    traceInstant("before dumps", StallLoop::UI);
+    printTrace(&out);
+    traceInstant("after dumps", StallLoop::UI);
+
+    std::vector<Event> events = renderEvents();
+
+    TEST_ASSERT_GREATER_THAN_UINT32(0, out.innerLength);
+    TEST_ASSERT_EQUAL_UINT32(1, parse(out.text).size());
+    TEST_ASSERT_EQUAL_UINT32(2, events.size());
+    TEST_ASSERT_EQUAL_STRING("before dumps", events[0].name.c_str());
+    TEST_ASSERT_EQUAL_STRING("after dumps", events[1].name.c_str());
+}
+
+// position taken by a writer that has not finished its record yet, slot still holds the record of the previous lap
+void test_unfinished_record_skipped()
+{
+    for(uint32_t i = 0; i < TRACE_RING_SIZE; i++)
+    {
+        traceInstant(names[i % nameCount], StallLoop::UI);
+    }
+
+    traceHead.fetch_add(1);
+
+    std::vector<Event> events = renderEvents();
+
+    TEST_ASSERT_EQUAL_UINT32(TRACE_RING_SIZE - 1, events.size());
+    TEST_ASSERT_EQUAL_STRING(names[(TRACE_RING_SIZE - 1) % nameCount], events.back().name.c_str());
+    expectInOrder(events);
+
+    traceInstant("next", StallLoop::UI);
+    events = renderEvents();
+
+    TEST_ASSERT_EQUAL_UINT32(TRACE_RING_SIZE - 1, events.size());
+    TEST_ASSERT_EQUAL_STRING("next", events.back().name.c_str());
+    expectInOrder(events);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_empty);
+    RUN_TEST(test_nesting_per_thread);
+    RUN_TEST(test_wraparound);
+    RUN_TEST(test_end_kept_while_begin_is_in_ring);
+    RUN_TEST(test_end_dropped_after_begin_overwritten);
+    RUN_TEST(test_cut_at_size);
+    RUN_TEST(test_overlapping_dumps);
+    RUN_TEST(test_unfinished_record_skipped);
+
+    return UNITY_END();
+}
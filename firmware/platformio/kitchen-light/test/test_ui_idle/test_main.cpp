@@ -0,0 +1,210 @@
+// core includes
+#include <Arduino.h>
+#include <string>
+#include <vector>
+
+// project includes
+#include "trace.h"
+#include "metrics.h"
+#include "sim.h"
+#include "conf.h"
+
+// lib includes
+#include <ArduinoJson.h>
+#include <unity.h>
+
+/* Whole firmware (setup() and loop()) on the simulator as a configured device, as env:sim runs it without a scenario.
+ * Run goes in stages: settling on the main screen, a quiet minute, then a knob turn halfway between two clock ticks.
+ * UI loop iterations are read back from the trace, every one starts with the network messages probe.
+ * Simulator hands CPU over at the latest when the running task's tick is over, so woken UI loop runs within one tick.
+ */
+
+#define SETTLE_US (120 * SIM_US_PER_S) // Wi-Fi connected, time synced, weather and forecast fetched
+#define QUIET_US (60 * SIM_US_PER_S)
+#define KNOB_AFTER_TICK_US (MAIN_SCREEN_TIMER_MS * SIM_US_PER_MS / 2)
+#define AFTER_KNOB_US (100 * SIM_US_PER_MS) // knob screen spins from then on, ring would be full of it
+#define TICK_US SIM_US_PER_MS // one FreeRTOS tick
+#define TRACE_TEXT_SIZE (TRACE_RING_SIZE * 96 + 1024)
+
+const char *iterationStart = "network messages"; // first probe of loop()
+
+struct LoopCounts
+{
+    uint64_t iterations;
+    uint64_t notifyWakeups;
+    uint32_t uiWakeups;
+};
+
+LoopCounts quietBefore;
+LoopCounts quietAfter;
+LoopCounts knobBefore;
+LoopCounts knobAfter;
+std::vector<int64_t> quietStartsUs; // UI loop iterations during the quiet minute
+uint64_t quietBeginUs = 0;
+uint64_t edgeUs = 0; // first knob edge (its interrupt)
+int64_t wakeUs = -1; // first UI loop iteration after it
+
+// configured device, as if setup page was submitted before (same as simMain.cpp)
+void seedConfiguredDevice()
+{
+    simSeedPreferences("firstRun", std::to_string(DEFAULT_PREFERENCES_ID));
+    simSeedPreferences("CPT", "1");
+    simSeedPreferences("color-hue", "0");
+    simSeedPreferences("color-t", "40");
+    simSeedPreferences("brightness", "128");
+    simSeedPreferences("wifi_ssid", "home");
+    simSeedPreferences("wifi_pwd", "password");
+    simSeedPreferences("time-zone", "CET-1CEST,M3.5.0,M10.5.0/3");
+    simSeedPreferences("city", "Bratislava");
+    simSeedPreferences("country-c", "SK");
+    simSeedPreferences("lat", INVALID_LAT_LON);
+    simSeedPreferences("lon", INVALID_LAT_LON);
+    simSeedPreferences("api-key", "0123456789abcdef0123456789abcdef");
+    simSeedPreferences("rng-id", "1234");
+    simSeedPreferences("rng-pwd", "12345678");
+    simSeedPreferences("n-leds", "60");
+}
+
+uint32_t metricValue(const char *name)
+{
+    static char text[METRICS_TEXT_MAX_SIZE];
+    char line[64];
+
+    renderMetrics(text, sizeof(text));
+    snprintf(line, sizeof(line), "\n%s ", name);
+
+    const char *found = strstr(text, line);
+
+    return (found != NULL) ? (uint32_t)strtoul(found + strlen(line), NULL, 10) : 0;
+}
+
+LoopCounts loopCounts()
+{
+    return {simStats.loopIterations, simStats.loopNotifyWakeups, metricValue("light_ui_wakeups_total")};
+}
+
+// begin timestamps of UI loop iterations still in the trace ring, oldest first
+std::vector<int64_t> iterationStarts()
+{
+    std::vector<char> buffer(TRACE_TEXT_SIZE);
+    size_t length = renderTrace(buffer.data(), buffer.size());
+    JsonDocument document;
+    std::vector<int64_t> starts;
+
+    TEST_ASSERT_FALSE(deserializeJson(document, buffer.data(), length));
+
+    JsonVariant traceEvents = document["traceEvents"];
+
+    for(size_t i = 0; i < traceEvents.size(); i++)
+    {
+        JsonVariant event = traceEvents[i];
+
+        if(strcmp(event["name"].as<const char*>(), iterationStart) == 0 && strcmp(event["ph"].as<const char*>(), "B") == 0)
+        {
+            starts.push_back(event["ts"].as<int64_t>());
+        }
+    }
+
+    return starts;
+}
+
+void turnKnob()
+{
+    edgeUs = simNow();
+    simTurnKnob(1, 1);
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_runs_through()
+{
+    TEST_ASSERT_NULL(simStopReason());
+}
+
+// main screen refresh is the only deadline, loop sleeps until it, woken earlier only by notifications (network task results)
+void test_quiet_minute_sleeps_until_deadline()
+{
+    uint64_t iterations = quietAfter.iterations - quietBefore.iterations;
+    uint64_t notifyWakeups = quietAfter.notifyWakeups - quietBefore.notifyWakeups;
+    uint32_t uiWakeups = quietAfter.uiWakeups - quietBefore.uiWakeups;
+    uint64_t ticks = QUIET_US / (MAIN_SCREEN_TIMER_MS * SIM_US_PER_MS);
+    int64_t maxGapUs = 0;
+    char message[160];
+
+    for(size_t i = 1; i < quietStartsUs.size(); i++)
+    {
+        maxGapUs = max(maxGapUs, quietStartsUs[i] - quietStartsUs[i - 1]);
+    }
+
+    snprintf(message, sizeof(message), "quiet minute: %lu loop iterations, %lu idle wake-ups, %lu of them notified, longest sleep %lu us",
+        (unsigned long)iterations, (unsigned long)uiWakeups, (unsigned long)notifyWakeups, (unsigned long)maxGapUs);
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_EQUAL_UINT32(iterations, uiWakeups); // every iteration on the main screen ends in idle
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(ticks - 1, iterations);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(ticks + notifyWakeups + 1, iterations);
+    TEST_ASSERT_EQUAL_UINT32(iterations, quietStartsUs.size());
+    TEST_ASSERT_LESS_OR_EQUAL((int64_t)(MAIN_SCREEN_TIMER_MS * SIM_US_PER_MS + TICK_US), maxGapUs);
+}
+
+// interrupt notifies the sleeping loop, it runs within a tick instead of at the next clock refresh
+void test_knob_wakes_within_tick()
+{
+    char message[128];
+
+    TEST_ASSERT_TRUE_MESSAGE(wakeUs >= 0, "UI loop did not run after the knob edge, before the next clock refresh");
+    snprintf(message, sizeof(message), "knob edge to UI loop iteration: %ld us, %lu notified wake-ups",
+        (long)(wakeUs - (int64_t)edgeUs), (unsigned long)(knobAfter.notifyWakeups - knobBefore.notifyWakeups));
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_LESS_OR_EQUAL((int64_t)TICK_US, wakeUs - (int64_t)edgeUs);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1, knobAfter.notifyWakeups - knobBefore.notifyWakeups);
+}
+
+int main(int argc, char **argv)
+{
+    seedConfiguredDevice();
+    simRun(SETTLE_US);
+
+    quietBeginUs = simNow();
+    quietBefore = loopCounts();
+    simRun(QUIET_US);
+    quietAfter = loopCounts();
+
+    for(int64_t startUs : iterationStarts())
+    {
+        if(startUs >= (int64_t)quietBeginUs)
+        {
+            quietStartsUs.push_back(startUs);
+        }
+    }
+
+    // halfway between the next clock refresh and the one after it
+    uint64_t knobUs = quietStartsUs.back() + MAIN_SCREEN_TIMER_MS * SIM_US_PER_MS + KNOB_AFTER_TICK_US;
+
+    simAt(knobUs, turnKnob);
+    knobBefore = loopCounts();
+    simRun(knobUs - simNow() + AFTER_KNOB_US);
+    knobAfter = loopCounts();
+
+    for(int64_t startUs : iterationStarts())
+    {
+        if(wakeUs < 0 && startUs >= (int64_t)edgeUs)
+        {
+            wakeUs = startUs;
+        }
+    }
+
+    UNITY_BEGIN();
+    RUN_TEST(test_runs_through);
+    RUN_TEST(test_quiet_minute_sleeps_until_deadline);
+    RUN_TEST(test_knob_wakes_within_tick);
+
+    return UNITY_END();
+}
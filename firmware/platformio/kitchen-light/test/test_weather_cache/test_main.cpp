@@ -0,0 +1,191 @@
+// core includes
+#include <Arduino.h>
+#include <string>
+#include <vector>
+
+// project includes
+#include "weather.h"
+#include "utilities.h"
+#include "sim.h"
+#include "conf.h"
+
+// lib includes
+#include <unity.h>
+
+/* Weather cache in RTC memory, saved and loaded as setup() and weather fetch do, with the device clock set by the test.
+ * Cache is only ever read by its checksum, location hash and age, what loadWeatherCache() printed tells them apart.
+ * RTC memory is zeros here before the first save, setUp() empties the cache again by saving without a valid clock.
+ */
+
+#define TEST_API_KEY "0123456789abcdef0123456789abcdef"
+#define OTHER_API_KEY "fedcba9876543210fedcba9876543210"
+#define FETCH_EPOCH 1767225600 // 2026-01-01 00:00:00 UTC
+#define MAX_AGE_S (WEATHER_SYNC_TIMEOUT_MS / 1000)
+
+// whole cache is opaque here, only its weather data (after magic, location hash and fetch epoch) is damaged
+struct WeatherCache;
+extern WeatherCache weatherCache;
+#define WEATHER_DATA_OFFSET 16
+
+std::vector<std::string> lines;
+const WeatherData fetched = {-3.5f, 87, 4.2f, Weather::SNOW_DAY};
+
+void catchLine(const char *line)
+{
+    lines.push_back(line);
+}
+
+void setClock(time_t epoch)
+{
+    struct timeval tv;
+
+    tv.tv_sec = epoch;
+    tv.tv_usec = 0;
+    settimeofday(&tv, NULL);
+}
+
+// URL the way buildWeatherServerUrl() in main.cpp makes it
+uint32_t cityHash(const char *city, const char *countryCode, const char *apiKey)
+{
+    char url[256];
+
+    snprintf(url, sizeof(url), openWeatherServerUrlformatableCityAndCountryCode, city, countryCode, apiKey);
+
+    return weatherLocationHash(url);
+}
+
+uint32_t latLonHash(const char *lat, const char *lon, const char *apiKey)
+{
+    char url[256];
+
+    snprintf(url, sizeof(url), openWeatherServerUrlformatableLatLon, lat, lon, apiKey);
+
+    return weatherLocationHash(url);
+}
+
+// first line printed by the load, its result
+std::string load(uint32_t locationHash, WeatherData *weatherData, uint32_t *ageMs)
+{
+    lines.clear();
+
+    bool loaded = loadWeatherCache(weatherData, locationHash, ageMs);
+
+    TEST_ASSERT_FALSE(lines.empty());
+    TEST_ASSERT_EQUAL(lines[0] == "WEATHER CACHE: OK", loaded);
+
+    return lines[0];
+}
+
+std::string load(uint32_t locationHash)
+{
+    WeatherData weatherData;
+    uint32_t ageMs;
+
+    return load(locationHash, &weatherData, &ageMs);
+}
+
+void saveAt(time_t epoch)
+{
+    setClock(epoch);
+    saveWeatherCache(&fetched, cityHash("Bratislava", "SK", TEST_API_KEY));
+}
+
+void setUp()
+{
+    setClock(0);
+    saveWeatherCache(&fetched, cityHash("Bratislava", "SK", TEST_API_KEY));
+}
+
+void tearDown()
+{
+}
+
+void test_empty()
+{
+    setClock(FETCH_EPOCH);
+    TEST_ASSERT_EQUAL_STRING("WEATHER CACHE: EMPTY", load(cityHash("Bratislava", "SK", TEST_API_KEY)).c_str());
+}
+
+void test_saved_weather_loaded()
+{
+    WeatherData weatherData = {};
+    uint32_t ageMs = 0;
+
+    saveAt(FETCH_EPOCH);
+    setClock(FETCH_EPOCH + 600);
+
+    TEST_ASSERT_EQUAL_STRING("WEATHER CACHE: OK", load(cityHash("Bratislava", "SK", TEST_API_KEY), &weatherData, &ageMs).c_str());
+    TEST_ASSERT_EQUAL_UINT32(600000, ageMs);
+    TEST_ASSERT_EQUAL_FLOAT(fetched.temperature_C, weatherData.temperature_C);
+    TEST_ASSERT_EQUAL_UINT8(fetched.humidity, weatherData.humidity);
+    TEST_ASSERT_EQUAL_FLOAT(fetched.windSpeed, weatherData.windSpeed);
+    TEST_ASSERT_TRUE(fetched.weather == weatherData.weather);
+}
+
+// any change of the request (location, its kind, API key) makes cached weather someone else's, it stays for its own request
+void test_url_change_invalidates()
+{
+    saveAt(FETCH_EPOCH);
+
+    TEST_ASSERT_EQUAL_STRING("WEATHER CACHE: DIFFERENT LOCATION", load(cityHash("Kosice", "SK", TEST_API_KEY)).c_str());
+    TEST_ASSERT_EQUAL_STRING("WEATHER CACHE: DIFFERENT LOCATION", load(cityHash("Bratislava", "AT", TEST_API_KEY)).c_str());
+    TEST_ASSERT_EQUAL_STRING("WEATHER CACHE: DIFFERENT LOCATION", load(cityHash("Bratislava", "SK", OTHER_API_KEY)).c_str());
+    TEST_ASSERT_EQUAL_STRING("WEATHER CACHE: DIFFERENT LOCATION", load(latLonHash("48.14", "17.11", TEST_API_KEY)).c_str());
+    TEST_ASSERT_EQUAL_STRING("WEATHER CACHE: OK", load(cityHash("Bratislava", "SK", TEST_API_KEY)).c_str());
+}
+
+// weather as old as a regular fetch interval miss is still shown, anything older is not, nor from the future or without valid clock
+void test_over_age_rejected()
+{
+    uint32_t bratislava = cityHash("Bratislava", "SK", TEST_API_KEY);
+
+    saveAt(FETCH_EPOCH);
+
+    setClock(FETCH_EPOCH + MAX_AGE_S);
+    TEST_ASSERT_EQUAL_STRING("WEATHER CACHE: OK", load(bratislava).c_str());
+    setClock(FETCH_EPOCH + MAX_AGE_S + 1);
+    TEST_ASSERT_EQUAL_STRING("WEATHER CACHE: EXPIRED", load(bratislava).c_str());
+    setClock(FETCH_EPOCH - 1);
+    TEST_ASSERT_EQUAL_STRING("WEATHER CACHE: EXPIRED", load(bratislava).c_str());
+    setClock(0);
+    TEST_ASSERT_EQUAL_STRING("WEATHER CACHE: EXPIRED", load(bratislava).c_str());
+}
+
+// one flipped bit of the weather data is caught by the checksum
+void test_bad_checksum_ignored()
+{
+    uint32_t bratislava = cityHash("Bratislava", "SK", TEST_API_KEY);
+
+    saveAt(FETCH_EPOCH);
+    ((uint8_t*)&weatherCache)[WEATHER_DATA_OFFSET] ^= 0x01;
+    TEST_ASSERT_EQUAL_STRING("WEATHER CACHE: EMPTY", load(bratislava).c_str());
+
+    ((uint8_t*)&weatherCache)[WEATHER_DATA_OFFSET] ^= 0x01;
+    TEST_ASSERT_EQUAL_STRING("WEATHER CACHE: OK", load(bratislava).c_str());
+}
+
+// age could never be told, so save without valid clock drops the earlier weather as well
+void test_save_without_clock()
+{
+    uint32_t bratislava = cityHash("Bratislava", "SK", TEST_API_KEY);
+
+    saveAt(FETCH_EPOCH);
+    saveAt(MIN_VALID_EPOCH - 1);
+    setClock(FETCH_EPOCH);
+    TEST_ASSERT_EQUAL_STRING("WEATHER CACHE: EMPTY", load(bratislava).c_str());
+}
+
+int main(int argc, char **argv)
+{
+    simConsoleListener = catchLine;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_empty);
+    RUN_TEST(test_saved_weather_loaded);
+    RUN_TEST(test_url_change_invalidates);
+    RUN_TEST(test_over_age_rejected);
+    RUN_TEST(test_bad_checksum_ignored);
+    RUN_TEST(test_save_without_clock);
+
+    return UNITY_END();
+}
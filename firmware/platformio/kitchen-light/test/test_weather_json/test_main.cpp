@@ -0,0 +1,224 @@
+// core includes
+#include <Arduino.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// project includes
+#include "weather.h"
+#include "forecast.h"
+
+// lib includes
+#include <unity.h>
+
+/* OpenWeather responses parsed straight from a Stream, as firmware does with HTTP body.
+ * Payloads are the recorded ones of the stand-in servers (python tools), and the same damage their scenarios do to them:
+ * body cut in half, junk key in front of everything, 401 error body.
+ * Test runs from project folder (pio test), so payloads are found relative to it.
+ */
+
+#define PAYLOAD_DIRECTORY "../../../python tools/openweather and NTP stand-in servers/"
+#define OVERSIZED_PAYLOAD_SIZE 65536 // script.py oversizedPayloadSize
+#define ERROR_401_PAYLOAD "{\"cod\":401,\"message\":\"Invalid API key. Please see https://openweathermap.org/faq#error401 for more info.\"}"
+#define STREAM_TIMEOUT_MS 10 // whole payload is there, timeout only ends the read of a truncated one
+
+// body already received, read byte by byte
+class PayloadStream : public Stream
+{
+    public:
+        PayloadStream(const std::string &payload) : payload(payload), position(0)
+        {
+            setTimeout(STREAM_TIMEOUT_MS);
+        }
+
+        int available() override
+        {
+            return (int)(payload.size() - position);
+        }
+
+        int read() override
+        {
+            return (position < payload.size()) ? (uint8_t)payload[position++] : -1;
+        }
+
+        int peek() override
+        {
+            return (position < payload.size()) ? (uint8_t)payload[position] : -1;
+        }
+
+        size_t write(uint8_t c) override
+        {
+            return 0;
+        }
+
+    private:
+        std::string payload;
+        size_t position;
+};
+
+std::string weatherPayload;
+std::string forecastPayload;
+WeatherData parsedWeather; // main.cpp has its own weatherData and forecast
+ForecastRing parsedForecast;
+
+void setUp()
+{
+    TEST_ASSERT_TRUE_MESSAGE(!weatherPayload.empty() && !forecastPayload.empty(), "recorded payloads not found in " PAYLOAD_DIRECTORY);
+    memset(&parsedWeather, 0, sizeof(parsedWeather));
+    memset(&parsedForecast, 0, sizeof(parsedForecast));
+}
+
+void tearDown()
+{
+}
+
+void loadPayload(const char *fileName, std::string *payload)
+{
+    std::ifstream file(std::string(PAYLOAD_DIRECTORY) + fileName);
+    std::stringstream content;
+
+    if(!file)
+    {
+        return;
+    }
+
+    content << file.rdbuf();
+    *payload = content.str();
+
+    // trailing newline of the file is not part of the body
+    while(!payload->empty() && (payload->back() == '\n' || payload->back() == '\r'))
+    {
+        payload->pop_back();
+    }
+}
+
+// Content-Length promised more, connection closed in the middle
+std::string truncated(const std::string &payload)
+{
+    return payload.substr(0, payload.size() / 2);
+}
+
+// junk goes first, so parser has to skip it before anything it keeps
+std::string oversized(const std::string &payload)
+{
+    std::string padding(OVERSIZED_PAYLOAD_SIZE - payload.size(), 'x');
+
+    return "{\"padding\":\"" + padding + "\"," + payload.substr(1);
+}
+
+bool parseWeather(const std::string &payload)
+{
+    PayloadStream stream(payload);
+
+    return parseWeatherJson(stream, &parsedWeather);
+}
+
+bool parseForecast(const std::string &payload)
+{
+    PayloadStream stream(payload);
+
+    return parseForecastJson(stream, &parsedForecast);
+}
+
+void expectRecordedWeather()
+{
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 12.34f, parsedWeather.temperature_C);
+    TEST_ASSERT_EQUAL(76, parsedWeather.humidity);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 4.12f, parsedWeather.windSpeed);
+    TEST_ASSERT_EQUAL(Weather::BROKEN_CLOUDS_DAY, parsedWeather.weather);
+}
+
+void expectRecordedForecast()
+{
+    ForecastSample sample;
+    uint32_t epoch;
+
+    TEST_ASSERT_EQUAL(FORECAST_MAX_SAMPLES, parsedForecast.count);
+    TEST_ASSERT_TRUE(forecastGet(&parsedForecast, 0, &sample, &epoch));
+    TEST_ASSERT_EQUAL(1700049600, epoch);
+    TEST_ASSERT_EQUAL(80, sample.temperature_dC);
+    TEST_ASSERT_EQUAL(60, sample.humidity);
+    TEST_ASSERT_EQUAL(2, sample.windSpeed); // 1.5 m/s rounded
+    TEST_ASSERT_EQUAL(Weather::CLEAR_SKY_NIGHT, (Weather)sample.weather);
+    TEST_ASSERT_TRUE(forecastGet(&parsedForecast, FORECAST_MAX_SAMPLES - 1, &sample, &epoch));
+    TEST_ASSERT_EQUAL(1700049600 + (FORECAST_MAX_SAMPLES - 1) * FORECAST_SAMPLE_PERIOD_S, epoch);
+}
+
+void test_weather_recorded()
+{
+    TEST_ASSERT_TRUE(parseWeather(weatherPayload));
+    expectRecordedWeather();
+}
+
+void test_weather_truncated()
+{
+    TEST_ASSERT_FALSE(parseWeather(truncated(weatherPayload)));
+}
+
+void test_weather_oversized()
+{
+    TEST_ASSERT_TRUE(parseWeather(oversized(weatherPayload)));
+    expectRecordedWeather();
+}
+
+void test_weather_error()
+{
+    TEST_ASSERT_FALSE(parseWeather(ERROR_401_PAYLOAD));
+    TEST_ASSERT_FALSE(parseWeather(""));
+}
+
+void test_forecast_recorded()
+{
+    TEST_ASSERT_TRUE(parseForecast(forecastPayload));
+    expectRecordedForecast();
+}
+
+void test_forecast_truncated()
+{
+    TEST_ASSERT_TRUE(parseForecast(forecastPayload));
+    TEST_ASSERT_FALSE(parseForecast(truncated(forecastPayload)));
+    TEST_ASSERT_EQUAL(0, parsedForecast.count); // nothing half parsed is kept
+}
+
+void test_forecast_oversized()
+{
+    TEST_ASSERT_TRUE(parseForecast(oversized(forecastPayload)));
+    expectRecordedForecast();
+}
+
+void test_forecast_error()
+{
+    TEST_ASSERT_FALSE(parseForecast(ERROR_401_PAYLOAD));
+    TEST_ASSERT_EQUAL(0, parsedForecast.count);
+    TEST_ASSERT_FALSE(parseForecast(weatherPayload)); // valid JSON, but no list
+}
+
+void test_forecast_gap()
+{
+    std::string payload = forecastPayload;
+    size_t second = payload.find("\"dt\":1700060400");
+
+    TEST_ASSERT_TRUE(second != std::string::npos);
+    payload.replace(second, 15, "\"dt\":1700071200"); // one sample missing
+    TEST_ASSERT_FALSE(parseForecast(payload));
+    TEST_ASSERT_EQUAL(0, parsedForecast.count);
+}
+
+int main(int argc, char **argv)
+{
+    loadPayload("weather.json", &weatherPayload);
+    loadPayload("forecast.json", &forecastPayload);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_weather_recorded);
+    RUN_TEST(test_weather_truncated);
+    RUN_TEST(test_weather_oversized);
+    RUN_TEST(test_weather_error);
+    RUN_TEST(test_forecast_recorded);
+    RUN_TEST(test_forecast_truncated);
+    RUN_TEST(test_forecast_oversized);
+    RUN_TEST(test_forecast_error);
+    RUN_TEST(test_forecast_gap);
+
+    return UNITY_END();
+}
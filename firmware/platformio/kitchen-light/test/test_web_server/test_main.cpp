@@ -0,0 +1,364 @@
+// core includes
+#include <Arduino.h>
+#include <WiFi.h>
+#include <map>
+#include <string>
+#include <vector>
+
+// project includes
+#include "webServer.h"
+#include "sim.h"
+#include "conf.h"
+
+// lib includes
+#include <unity.h>
+
+/* HTTP side of the web server on simulated sockets. A scripted task is the network task: it polls the server
+ * and writes requests through raw connections, split as each case needs, then reads the whole response.
+ * Whole script runs once, tests then check what it recorded.
+ */
+
+#define CONTENT_TYPE_MIN_LENGTH 150
+#define CONTENT_TYPE_MAX_LENGTH 260 // header of 256 B cannot take it
+#define CONCURRENT_CLIENTS (WEB_SERVER_MAX_CLIENTS + 1) // the last one waits for a free slot
+#define POLL_LIMIT 20000 // polls of 1 ms, longer than client timeout
+#define TEST_RUN_US (3600 * SIM_US_PER_S)
+
+struct Response
+{
+    int status;
+    std::string header;
+    std::string body;
+    bool deviceClosed;
+    uint32_t durationMs; // request written until device closed connection
+};
+
+std::map<std::string, Response> responses;
+std::vector<Response> contentTypeResponses; // by content type length from CONTENT_TYPE_MIN_LENGTH
+std::vector<Response> concurrentResponses;
+std::vector<uint32_t> concurrentOrder; // client numbers in order their responses were complete
+bool scriptDone = false;
+
+void testRequest(WebRequest *request, WebResponse *response)
+{
+    static char contentType[CONTENT_TYPE_MAX_LENGTH + 1];
+
+    if(strcmp(request->target, "/hello") == 0)
+    {
+        webRespond(response, 200, "text/plain", "hello");
+    }
+    else if(strcmp(request->target, "/static") == 0)
+    {
+        webRespondStatic(request, response, "text/plain", NULL, (const uint8_t*)"static", 6, "\"v1\"");
+    }
+    else if(strncmp(request->target, "/type?", 6) == 0)
+    {
+        // "text/" and as many x as it takes, so header grows one byte at a time
+        size_t length = atoi(request->target + 6);
+
+        memset(contentType, 'x', length);
+        memcpy(contentType, "text/", 5);
+        contentType[length] = '\0';
+        webRespond(response, 200, contentType, "typed");
+    }
+    else if(strncmp(request->target, "/client?", 8) == 0)
+    {
+        webRespondFormatted(response, 200, "text/plain", "client %s", request->target + 8);
+    }
+    else
+    {
+        webRespondFormatted(response, 200, "text/plain", "%s %u %u", webMethodString[(uint8_t)request->method], (unsigned)strlen(request->target), request->bodyLength);
+    }
+}
+
+void poll()
+{
+    handleWebServer();
+    delay(1);
+}
+
+// polls until device closes connection, response is whatever it sent
+Response readResponse(int client, uint32_t startMs)
+{
+    Response response = {};
+    std::string text;
+
+    for(uint32_t i = 0; i < POLL_LIMIT && simRawDeviceOpen(client); i++)
+    {
+        poll();
+        text += simRawRead(client);
+    }
+
+    text += simRawRead(client);
+    response.deviceClosed = !simRawDeviceOpen(client);
+    response.durationMs = millis() - startMs;
+    simRawClose(client);
+
+    size_t headerEnd = text.find("\r\n\r\n");
+
+    if(sscanf(text.c_str(), "HTTP/1.1 %d", &response.status) != 1 || headerEnd == std::string::npos)
+    {
+        response.status = 0;
+        response.body = text;
+        return response;
+    }
+
+    response.header = text.substr(0, headerEnd + 4);
+    response.body = text.substr(headerEnd + 4);
+
+    return response;
+}
+
+// request written in pieces with server polled in between
+Response request(const std::string &data, size_t pieceSize = SIZE_MAX)
+{
+    int client = simRawConnect();
+    uint32_t startMs = millis();
+
+    for(size_t i = 0; i < data.size(); i += pieceSize)
+    {
+        simRawWrite(client, data.substr(i, pieceSize));
+        poll();
+    }
+
+    return readResponse(client, startMs);
+}
+
+std::string get(const std::string &target, const std::string &headers = "")
+{
+    return "GET " + target + " HTTP/1.1\r\nHost: 192.168.1.50\r\n" + headers + "\r\n";
+}
+
+// clients send their requests a byte at a time, in turns, all of them open at once
+void concurrentClients()
+{
+    int clients[CONCURRENT_CLIENTS];
+    std::string requests[CONCURRENT_CLIENTS];
+    std::string texts[CONCURRENT_CLIENTS];
+    bool done[CONCURRENT_CLIENTS] = {};
+    size_t longest = 0;
+
+    for(uint8_t i = 0; i < CONCURRENT_CLIENTS; i++)
+    {
+        clients[i] = simRawConnect();
+        requests[i] = get("/client?" + std::to_string(i), "X-Client: " + std::string(i * 10, 'c') + "\r\n");
+        longest = max(longest, requests[i].size());
+    }
+
+    for(size_t position = 0; position < longest; position++)
+    {
+        for(uint8_t i = 0; i < CONCURRENT_CLIENTS; i++)
+        {
+            if(position < requests[i].size())
+            {
+                simRawWrite(clients[i], requests[i].substr(position, 1));
+            }
+        }
+
+        poll();
+    }
+
+    for(uint32_t polls = 0; polls < POLL_LIMIT && concurrentOrder.size() < CONCURRENT_CLIENTS; polls++)
+    {
+        poll();
+
+        for(uint8_t i = 0; i < CONCURRENT_CLIENTS; i++)
+        {
+            if(!done[i] && !simRawDeviceOpen(clients[i]))
+            {
+                done[i] = true;
+                concurrentOrder.push_back(i);
+            }
+        }
+    }
+
+    for(uint8_t i = 0; i < CONCURRENT_CLIENTS; i++)
+    {
+        concurrentResponses.push_back(readResponse(clients[i], millis()));
+    }
+}
+
+void scriptedClients(void *parameters)
+{
+    WiFi.mode(WIFI_STA);
+    WiFi.begin("home", "password");
+
+    while(WiFi.status() != WL_CONNECTED)
+    {
+        delay(100);
+    }
+
+    beginWebServer(testRequest);
+
+    responses["hello"] = request(get("/hello"));
+    responses["hello byte by byte"] = request("\r\n" + get("/hello"), 1); // empty line before request line is allowed
+    responses["head"] = request("HEAD /hello HTTP/1.1\r\n\r\n");
+    responses["target at limit"] = request(get("/" + std::string(WEB_SERVER_MAX_TARGET_LENGTH - 1, 't')), 100);
+    responses["request line overflow"] = request(get("/" + std::string(WEB_SERVER_MAX_TARGET_LENGTH + 20, 't')), 100);
+    responses["bad request line"] = request("GET /hello\r\n\r\n");
+    responses["long header line"] = request(get("/static", "X-Long: " + std::string(1000, 'l') + "\r\nIf-None-Match: \"v1\"\r\n"), 50);
+    responses["body at limit"] = request("PUT /body HTTP/1.1\r\nContent-Length: 512\r\n\r\n" + std::string(WEB_SERVER_MAX_REQUEST_BODY_SIZE, 'b'), 64);
+    responses["body too large"] = request("POST /body HTTP/1.1\r\nContent-Length: 513\r\n\r\n");
+
+    for(size_t length = CONTENT_TYPE_MIN_LENGTH; length <= CONTENT_TYPE_MAX_LENGTH; length++)
+    {
+        contentTypeResponses.push_back(request(get("/type?" + std::to_string(length))));
+    }
+
+    responses["timeout in request line"] = request("GET /hel");
+    responses["timeout in headers"] = request("GET /hello HTTP/1.1\r\nHost: 192.16");
+    responses["timeout in body"] = request("PUT /body HTTP/1.1\r\nContent-Length: 10\r\n\r\n12345");
+
+    concurrentClients();
+
+    scriptDone = true;
+    simStop("script done");
+
+    for(;;)
+    {
+        delay(SCHEDULER_MAX_IDLE_MS);
+    }
+}
+
+const Response* response(const char *name)
+{
+    TEST_ASSERT_TRUE_MESSAGE(responses.count(name) == 1, name);
+
+    return &responses[name];
+}
+
+void expectResponse(const char *name, int status, const char *body)
+{
+    TEST_ASSERT_EQUAL_MESSAGE(status, response(name)->status, name);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(body, response(name)->body.c_str(), name);
+    TEST_ASSERT_TRUE(response(name)->deviceClosed);
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_script_completes()
+{
+    TEST_ASSERT_TRUE(scriptDone);
+    TEST_ASSERT_EQUAL_STRING("script done", simStopReason());
+}
+
+void test_requests()
+{
+    expectResponse("hello", 200, "hello");
+    expectResponse("hello byte by byte", 200, "hello");
+    expectResponse("head", 200, "");
+    TEST_ASSERT_TRUE(response("head")->header.find("Content-Length: 5\r\n") != std::string::npos);
+}
+
+// request line is read into request target, which has room for the longest target with method and version around it
+void test_request_line_overflow()
+{
+    char expected[32];
+
+    snprintf(expected, sizeof(expected), "GET %u 0", WEB_SERVER_MAX_TARGET_LENGTH);
+    expectResponse("target at limit", 200, expected);
+    expectResponse("request line overflow", 414, "");
+    expectResponse("bad request line", 400, "");
+}
+
+// header line longer than its buffer is cut, the next one is still read
+void test_long_header_line()
+{
+    expectResponse("long header line", 304, "");
+}
+
+void test_request_body()
+{
+    expectResponse("body at limit", 200, "PUT 5 512");
+    expectResponse("body too large", 413, "");
+}
+
+// every header which fits is sent whole, the ones which do not get 500 instead of being cut
+void test_response_header_overflow()
+{
+    uint32_t served = 0;
+
+    for(size_t i = 0; i < contentTypeResponses.size(); i++)
+    {
+        const Response *typed = &contentTypeResponses[i];
+        std::string contentType = "text/" + std::string(CONTENT_TYPE_MIN_LENGTH + i - 5, 'x');
+
+        TEST_ASSERT_TRUE(typed->deviceClosed);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(WEB_SERVER_MAX_HEADER_SIZE - 1, typed->header.size());
+
+        if(typed->status == 200)
+        {
+            TEST_ASSERT_EQUAL_UINT32(i, served); // no 200 after the first 500
+            TEST_ASSERT_TRUE(typed->header.find("Content-Type: " + contentType + "\r\nContent-Length: 5\r\nConnection: close\r\n\r\n") != std::string::npos);
+            TEST_ASSERT_EQUAL_STRING("typed", typed->body.c_str());
+            served++;
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL(500, typed->status);
+            TEST_ASSERT_TRUE(typed->header.find("Connection: close\r\n") != std::string::npos);
+            TEST_ASSERT_EQUAL_STRING("", typed->body.c_str());
+        }
+    }
+
+    // header of the last one served is as long as it can be
+    TEST_ASSERT_GREATER_THAN_UINT32(0, served);
+    TEST_ASSERT_LESS_THAN_UINT32(contentTypeResponses.size(), served);
+    TEST_ASSERT_EQUAL_UINT32(WEB_SERVER_MAX_HEADER_SIZE - 1, contentTypeResponses[served - 1].header.size());
+}
+
+// client which stops sending is closed after the timeout without a response, wherever in the request it stopped
+void test_timeouts()
+{
+    const char *names[] = {"timeout in request line", "timeout in headers", "timeout in body"};
+
+    for(const char *name : names)
+    {
+        TEST_ASSERT_EQUAL_MESSAGE(0, response(name)->status, name);
+        TEST_ASSERT_EQUAL_STRING("", response(name)->body.c_str());
+        TEST_ASSERT_TRUE(response(name)->deviceClosed);
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT32(SERVER_CLIENT_TIMEOUT_MS, response(name)->durationMs);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(SERVER_CLIENT_TIMEOUT_MS + 100, response(name)->durationMs);
+    }
+}
+
+// requests of all clients arrive interleaved, each gets its own response, the one over the limit waits for a free slot
+void test_concurrent_clients()
+{
+    char expected[32];
+
+    TEST_ASSERT_EQUAL_UINT32(CONCURRENT_CLIENTS, concurrentResponses.size());
+    TEST_ASSERT_EQUAL_UINT32(CONCURRENT_CLIENTS, concurrentOrder.size());
+    TEST_ASSERT_EQUAL_UINT32(CONCURRENT_CLIENTS - 1, concurrentOrder.back());
+
+    for(uint8_t i = 0; i < CONCURRENT_CLIENTS; i++)
+    {
+        snprintf(expected, sizeof(expected), "client %u", i);
+        TEST_ASSERT_EQUAL(200, concurrentResponses[i].status);
+        TEST_ASSERT_EQUAL_STRING(expected, concurrentResponses[i].body.c_str());
+    }
+}
+
+int main(int argc, char **argv)
+{
+    xTaskCreatePinnedToCore(scriptedClients, "networkTask", 8192, NULL, 1, NULL, 0);
+    simRun(TEST_RUN_US);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_script_completes);
+    RUN_TEST(test_requests);
+    RUN_TEST(test_request_line_overflow);
+    RUN_TEST(test_long_header_line);
+    RUN_TEST(test_request_body);
+    RUN_TEST(test_response_header_overflow);
+    RUN_TEST(test_timeouts);
+    RUN_TEST(test_concurrent_clients);
+
+    return UNITY_END();
+}
@@ -0,0 +1,432 @@
+// core includes
+#include <Arduino.h>
+#include <WiFi.h>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+// project includes
+#include "webServer.h"
+#include "sim.h"
+#include "conf.h"
+
+// lib includes
+#include <unity.h>
+
+/* WebSocket frames of the web server on simulated sockets. A scripted task is the network task: it polls the server
+ * and writes client frames through a raw connection, split as each case needs (byte by byte, header in pieces, frames across reads).
+ * Every case opens its own WebSocket and records what device sent back, handler events and whether device closed the connection.
+ * Whole script runs once, tests then check what it recorded.
+ */
+
+#define SOCKET_KEY "dGhlIHNhbXBsZSBub25jZQ==" // RFC 6455 example
+#define SOCKET_ACCEPT "s3pPLMBiTxaQ9kYGzzhZRbK+xOo="
+#define SEND_FRAME_SIZE (2 + WEB_SOCKET_MAX_SEND_PAYLOAD)
+#define FRAMES_TO_FILL (5744 / SEND_FRAME_SIZE + 1) // socket send buffer of the simulator, the last one fits only partly
+#define POLLS_PER_STEP 3
+#define TEST_RUN_US (600 * SIM_US_PER_S)
+
+enum class Length : uint8_t {SHORT, BITS_16, BITS_64}; // length form of a frame header
+
+struct SocketEvent
+{
+    WebSocketEvent event;
+    std::string data;
+};
+
+struct CaseResult
+{
+    std::string sent; // by device after handshake
+    std::vector<SocketEvent> events; // after open
+    bool deviceOpen;
+};
+
+std::map<std::string, CaseResult> results;
+std::vector<SocketEvent> events;
+std::map<std::string, std::vector<bool>> sendResults; // of webSocketSend(), by case
+std::string pendingFrameStart; // read by client before the frame which went after the pending one
+uint8_t openedClient = 0;
+bool handshakeOk = true;
+bool scriptDone = false;
+
+void testRequest(WebRequest *request, WebResponse *response)
+{
+    webAcceptWebSocket(request, response);
+}
+
+void testSocketEvent(WebSocketEvent event, uint8_t client, const uint8_t *data, uint16_t length)
+{
+    events.push_back({event, std::string((const char*)data, (data != NULL) ? length : 0)});
+    openedClient = (event == WebSocketEvent::OPEN) ? client : openedClient;
+}
+
+void poll(uint32_t times = POLLS_PER_STEP)
+{
+    while(times-- > 0)
+    {
+        handleWebServer();
+        delay(1);
+    }
+}
+
+// client frame, masked unless asked otherwise, payload length in the form given (longer forms for short payloads are valid too)
+std::string frame(uint8_t first, const std::string &payload, Length form = Length::SHORT, bool masked = true, uint64_t length = UINT64_MAX)
+{
+    const uint8_t mask[4] = {0xA1, 0x5B, 0x00, 0xFF};
+    std::string data(1, (char)first);
+    uint8_t maskBit = masked ? 0x80 : 0;
+
+    length = (length == UINT64_MAX) ? payload.size() : length;
+
+    if(form == Length::SHORT)
+    {
+        data += (char)(maskBit | length);
+    }
+    else if(form == Length::BITS_16)
+    {
+        data += (char)(maskBit | 126);
+        data += (char)(length >> 8);
+        data += (char)(length & 0xFF);
+    }
+    else
+    {
+        data += (char)(maskBit | 127);
+
+        for(int8_t shift = 56; shift >= 0; shift -= 8)
+        {
+            data += (char)((length >> shift) & 0xFF);
+        }
+    }
+
+    if(masked)
+    {
+        data.append((const char*)mask, sizeof(mask));
+    }
+
+    for(size_t i = 0; i < payload.size(); i++)
+    {
+        data += (char)(payload[i] ^ (masked ? mask[i % 4] : 0));
+    }
+
+    return data;
+}
+
+std::string binary(const std::string &payload, Length form = Length::SHORT)
+{
+    return frame(0x82, payload, form);
+}
+
+std::string pattern(size_t length, uint8_t seed)
+{
+    std::string text;
+
+    for(size_t i = 0; i < length; i++)
+    {
+        text += (char)(seed + i * 7);
+    }
+
+    return text;
+}
+
+// written in pieces with server polled in between, so every piece is a separate read
+void writeSplit(int client, const std::string &data, size_t pieceSize)
+{
+    for(size_t i = 0; i < data.size(); i += pieceSize)
+    {
+        simRawWrite(client, data.substr(i, pieceSize));
+        poll(1);
+    }
+}
+
+int openSocket()
+{
+    int client = simRawConnect();
+    std::string response;
+
+    simRawWrite(client, "GET /api/live HTTP/1.1\r\nHost: 192.168.1.50\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+        "Sec-WebSocket-Key: " SOCKET_KEY "\r\nSec-WebSocket-Version: 13\r\n\r\n");
+
+    for(uint8_t i = 0; i < 10 && response.find("\r\n\r\n") == std::string::npos; i++)
+    {
+        poll(1);
+        response += simRawRead(client);
+    }
+
+    poll();
+    handshakeOk = handshakeOk && response.compare(0, 12, "HTTP/1.1 101") == 0 && response.find("Sec-WebSocket-Accept: " SOCKET_ACCEPT "\r\n") != std::string::npos
+        && !events.empty() && events.back().event == WebSocketEvent::OPEN;
+    events.clear();
+
+    return client;
+}
+
+void runCase(const char *name, std::function<void(int client)> steps)
+{
+    int client = openSocket();
+
+    steps(client);
+    poll();
+    results[name] = {simRawRead(client), events, simRawDeviceOpen(client)};
+
+    simRawClose(client);
+    poll();
+    events.clear();
+}
+
+void fillSocket(const char *name)
+{
+    for(uint8_t i = 0; i < FRAMES_TO_FILL; i++)
+    {
+        std::string payload(WEB_SOCKET_MAX_SEND_PAYLOAD, (char)i);
+
+        sendResults[name].push_back(webSocketSend(openedClient, (const uint8_t*)payload.data(), payload.size()));
+    }
+}
+
+void scriptedClients(void *parameters)
+{
+    WiFi.mode(WIFI_STA);
+    WiFi.begin("home", "password");
+
+    while(WiFi.status() != WL_CONNECTED)
+    {
+        delay(100);
+    }
+
+    beginWebServer(testRequest, testSocketEvent);
+
+    runCase("byte by byte", [](int client) { writeSplit(client, binary("hello"), 1); });
+    runCase("16 bit length", [](int client) { writeSplit(client, binary(pattern(200, 1), Length::BITS_16), 3); });
+    runCase("16 bit length of short payload", [](int client) { writeSplit(client, binary("abc", Length::BITS_16), 1); });
+    runCase("64 bit length", [](int client) { writeSplit(client, binary(pattern(300, 2), Length::BITS_64), 7); });
+    runCase("largest payload", [](int client) { writeSplit(client, binary(pattern(WEB_SERVER_MAX_REQUEST_BODY_SIZE, 3), Length::BITS_16), 100); });
+
+    // second frame starts in the read which ends the first, third one comes in two halves
+    runCase("frames across reads", [](int client) {
+        std::string data = binary("first") + binary(pattern(150, 4), Length::BITS_16) + binary("third");
+
+        simRawWrite(client, data.substr(0, 12));
+        poll();
+        simRawWrite(client, data.substr(12, 100));
+        poll();
+        simRawWrite(client, data.substr(112));
+    });
+
+    runCase("ping", [](int client) { writeSplit(client, frame(0x89, "abc") + frame(0x89, ""), 2); });
+    runCase("pong", [](int client) { simRawWrite(client, frame(0x8A, "xyz") + binary("after pong")); });
+    runCase("close", [](int client) { simRawWrite(client, frame(0x88, std::string("\x03\xE8", 2))); });
+    runCase("unmasked", [](int client) { simRawWrite(client, frame(0x82, "hello", Length::SHORT, false)); });
+    runCase("oversize", [](int client) { writeSplit(client, binary(pattern(WEB_SERVER_MAX_REQUEST_BODY_SIZE + 1, 5), Length::BITS_16), 64); });
+    runCase("oversize 64 bit", [](int client) { simRawWrite(client, frame(0x82, "", Length::BITS_64, true, (1ULL << 32) + 5)); });
+    runCase("oversize control", [](int client) { simRawWrite(client, frame(0x89, pattern(WEB_SOCKET_MAX_SEND_PAYLOAD + 1, 6), Length::BITS_16)); });
+    runCase("text", [](int client) { simRawWrite(client, frame(0x81, "text")); });
+    runCase("fragment", [](int client) { simRawWrite(client, frame(0x02, "part")); });
+
+    // socket takes only the start of the last frame, rest waits in pendingFrame and goes first once client has read some
+    runCase("pending frame", [](int client) {
+        fillSocket("pending frame");
+        pendingFrameStart = simRawRead(client, 500); // no poll after, pending part has to go out ahead of the next frame
+
+        std::string payload(WEB_SOCKET_MAX_SEND_PAYLOAD, (char)FRAMES_TO_FILL);
+
+        sendResults["pending frame"].push_back(webSocketSend(openedClient, (const uint8_t*)payload.data(), payload.size()));
+    });
+
+    // client reads nothing, next frame cannot go after the pending one, so client is closed instead of getting a broken stream
+    runCase("too slow", [](int client) {
+        std::string payload(WEB_SOCKET_MAX_SEND_PAYLOAD, (char)FRAMES_TO_FILL);
+
+        fillSocket("too slow");
+        sendResults["too slow"].push_back(webSocketSend(openedClient, (const uint8_t*)payload.data(), payload.size()));
+    });
+
+    scriptDone = true;
+    simStop("script done");
+
+    for(;;)
+    {
+        delay(SCHEDULER_MAX_IDLE_MS);
+    }
+}
+
+const CaseResult* result(const char *name)
+{
+    TEST_ASSERT_TRUE_MESSAGE(results.count(name) == 1, name);
+
+    return &results[name];
+}
+
+void expectMessages(const char *name, const std::vector<std::string> &messages)
+{
+    const CaseResult *caseResult = result(name);
+
+    TEST_ASSERT_EQUAL_UINT32(messages.size(), caseResult->events.size());
+
+    for(size_t i = 0; i < messages.size(); i++)
+    {
+        TEST_ASSERT_TRUE(caseResult->events[i].event == WebSocketEvent::MESSAGE);
+        TEST_ASSERT_TRUE_MESSAGE(caseResult->events[i].data == messages[i], name);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, caseResult->sent.size());
+    TEST_ASSERT_TRUE(caseResult->deviceOpen);
+}
+
+// device answered with close frame of the code and closed connection, handler got only close
+void expectClosed(const char *name, uint16_t code)
+{
+    const CaseResult *caseResult = result(name);
+    std::string closeFrame = {(char)0x88, 2, (char)(code >> 8), (char)(code & 0xFF)};
+
+    TEST_ASSERT_TRUE_MESSAGE(caseResult->sent == closeFrame, name);
+    TEST_ASSERT_FALSE(caseResult->deviceOpen);
+    TEST_ASSERT_EQUAL_UINT32(1, caseResult->events.size());
+    TEST_ASSERT_TRUE(caseResult->events[0].event == WebSocketEvent::CLOSE);
+}
+
+// server frames back to back: FIN binary, 2 B header, payload of one repeated byte counting up from 0
+uint32_t expectFrameSequence(const std::string &stream, bool lastMayBeCut)
+{
+    size_t position = 0;
+    uint32_t frames = 0;
+
+    while(position < stream.size())
+    {
+        if(stream.size() - position < SEND_FRAME_SIZE)
+        {
+            TEST_ASSERT_TRUE(lastMayBeCut);
+            break;
+        }
+
+        TEST_ASSERT_EQUAL_UINT8(0x82, (uint8_t)stream[position]);
+        TEST_ASSERT_EQUAL_UINT8(WEB_SOCKET_MAX_SEND_PAYLOAD, (uint8_t)stream[position + 1]);
+        TEST_ASSERT_TRUE(stream.compare(position + 2, WEB_SOCKET_MAX_SEND_PAYLOAD, std::string(WEB_SOCKET_MAX_SEND_PAYLOAD, (char)frames)) == 0);
+
+        position += SEND_FRAME_SIZE;
+        frames++;
+    }
+
+    return frames;
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_script_completes()
+{
+    TEST_ASSERT_TRUE(scriptDone);
+    TEST_ASSERT_EQUAL_STRING("script done", simStopReason());
+    TEST_ASSERT_TRUE(handshakeOk);
+}
+
+// every byte of header, mask and payload in its own read
+void test_fragmented_header()
+{
+    expectMessages("byte by byte", {"hello"});
+    expectMessages("16 bit length of short payload", {"abc"});
+}
+
+void test_length_forms()
+{
+    expectMessages("16 bit length", {pattern(200, 1)});
+    expectMessages("64 bit length", {pattern(300, 2)});
+    expectMessages("largest payload", {pattern(WEB_SERVER_MAX_REQUEST_BODY_SIZE, 3)});
+}
+
+void test_frames_across_reads()
+{
+    expectMessages("frames across reads", {"first", pattern(150, 4), "third"});
+}
+
+// ping is answered by pong with the same payload, pong is only activity
+void test_ping_and_pong()
+{
+    const CaseResult *ping = result("ping");
+
+    TEST_ASSERT_TRUE(ping->sent == std::string("\x8A\x03" "abc" "\x8A\x00", 7));
+    TEST_ASSERT_EQUAL_UINT32(0, ping->events.size());
+    TEST_ASSERT_TRUE(ping->deviceOpen);
+    expectMessages("pong", {"after pong"});
+}
+
+void test_close_frame()
+{
+    expectClosed("close", 1000);
+}
+
+// client frames have to be masked (RFC 6455, 5.1)
+void test_unmasked_closes()
+{
+    expectClosed("unmasked", 1002);
+}
+
+void test_oversize_closes()
+{
+    expectClosed("oversize", 1009);
+    expectClosed("oversize 64 bit", 1009);
+    expectClosed("oversize control", 1009);
+}
+
+void test_unsupported_closes()
+{
+    expectClosed("text", 1003);
+    expectClosed("fragment", 1003);
+}
+
+// what socket did not take waits, next frame goes after it, so frames never interleave
+void test_pending_frame()
+{
+    const std::vector<bool> &sent = sendResults["pending frame"];
+    std::string stream = pendingFrameStart + result("pending frame")->sent;
+
+    TEST_ASSERT_EQUAL_UINT32(FRAMES_TO_FILL + 1, sent.size());
+
+    for(bool ok : sent)
+    {
+        TEST_ASSERT_TRUE(ok);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(FRAMES_TO_FILL + 1, expectFrameSequence(stream, false));
+    TEST_ASSERT_TRUE(result("pending frame")->deviceOpen);
+}
+
+void test_too_slow_closes()
+{
+    const std::vector<bool> &sent = sendResults["too slow"];
+    const CaseResult *tooSlow = result("too slow");
+
+    TEST_ASSERT_EQUAL_UINT32(FRAMES_TO_FILL + 1, sent.size());
+    TEST_ASSERT_TRUE(sent[FRAMES_TO_FILL - 1]); // only partly taken, rest pending
+    TEST_ASSERT_FALSE(sent[FRAMES_TO_FILL]);
+    TEST_ASSERT_FALSE(tooSlow->deviceOpen);
+    TEST_ASSERT_EQUAL_UINT32(FRAMES_TO_FILL - 1, expectFrameSequence(tooSlow->sent, true));
+    TEST_ASSERT_EQUAL_UINT32(1, tooSlow->events.size());
+    TEST_ASSERT_TRUE(tooSlow->events[0].event == WebSocketEvent::CLOSE);
+}
+
+int main(int argc, char **argv)
+{
+    xTaskCreatePinnedToCore(scriptedClients, "networkTask", 8192, NULL, 1, NULL, 0);
+    simRun(TEST_RUN_US);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_script_completes);
+    RUN_TEST(test_fragmented_header);
+    RUN_TEST(test_length_forms);
+    RUN_TEST(test_frames_across_reads);
+    RUN_TEST(test_ping_and_pong);
+    RUN_TEST(test_close_frame);
+    RUN_TEST(test_unmasked_closes);
+    RUN_TEST(test_oversize_closes);
+    RUN_TEST(test_unsupported_closes);
+    RUN_TEST(test_pending_frame);
+    RUN_TEST(test_too_slow_closes);
+
+    return UNITY_END();
+}
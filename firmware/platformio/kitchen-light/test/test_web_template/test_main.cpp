@@ -0,0 +1,195 @@
+// core includes
+#include <Arduino.h>
+#include <string>
+
+// project includes
+#include "webTemplate.h"
+
+// lib includes
+#include <unity.h>
+
+/* Streaming template engine: Content-Length (webTemplateLength()) has to be exactly what webTemplateWrite() writes,
+ * whatever pieces socket takes, otherwise HTTP response is corrupted. Output takes only a few bytes per call and
+ * refuses some calls altogether (socket buffer full), so rendering stops and continues anywhere, inside entities too.
+ */
+
+#define MAX_BYTES_PER_CALL 9
+#define MAX_LENGTHS 5
+
+// takes at most bytesPerCall at once, every refuseEvery-th call nothing (0 never refuses)
+class LimitedPrint : public Print
+{
+    public:
+        LimitedPrint(size_t bytesPerCall, uint32_t refuseEvery) : bytesPerCall(bytesPerCall), refuseEvery(refuseEvery) {}
+
+        size_t write(uint8_t c) override
+        {
+            return write(&c, 1);
+        }
+
+        size_t write(const uint8_t *data, size_t length) override
+        {
+            calls++;
+
+            if(refuseEvery != 0 && calls % refuseEvery == 0)
+            {
+                return 0;
+            }
+
+            length = (length < bytesPerCall) ? length : bytesPerCall;
+            text.append((const char*)data, length);
+
+            return length;
+        }
+
+        std::string text;
+        uint32_t calls = 0;
+
+    private:
+        size_t bytesPerCall;
+        uint32_t refuseEvery;
+};
+
+const WebTemplateValue values[] = {
+    {"name", "Kitchen & \"Light\""},
+    {"name2", "<b>'bold'</b>"},
+    {"escaped", "&<>\"'"},
+    {"plain", "no escaping at all"},
+    {"empty", ""},
+    {"missing", NULL}
+};
+
+const uint8_t valueCount = sizeof(values) / sizeof(values[0]);
+const size_t maxLengths[MAX_LENGTHS] = {1, 2, 5, 64, SIZE_MAX}; // what web server lets one call write
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// renders whole template in pieces, as web server does when socket takes more
+std::string render(const char *text, size_t bytesPerCall, uint32_t refuseEvery, size_t maxLength)
+{
+    LimitedPrint out(bytesPerCall, refuseEvery);
+    WebTemplateCursor cursor;
+    uint32_t idleCalls = 0;
+
+    webTemplateBegin(&cursor, text);
+
+    // done when it writes nothing although output would take it
+    while(idleCalls < 2)
+    {
+        idleCalls = (webTemplateWrite(&cursor, values, valueCount, &out, maxLength) == 0) ? idleCalls + 1 : 0;
+    }
+
+    return out.text;
+}
+
+// Content-Length and bytes written match in every way template can be cut
+void expectRendered(const char *text, const char *expected)
+{
+    char message[96];
+
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(strlen(expected), webTemplateLength(text, values, valueCount), text);
+
+    for(size_t bytesPerCall = 1; bytesPerCall <= MAX_BYTES_PER_CALL; bytesPerCall++)
+    {
+        for(uint8_t i = 0; i < MAX_LENGTHS; i++)
+        {
+            for(uint32_t refuseEvery = 0; refuseEvery <= 3; refuseEvery += 2)
+            {
+                snprintf(message, sizeof(message), "%s (%lu per call, max %lu, refuse every %lu)", text,
+                    (unsigned long)bytesPerCall, (unsigned long)maxLengths[i], (unsigned long)refuseEvery);
+                TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, render(text, bytesPerCall, refuseEvery, maxLengths[i]).c_str(), message);
+            }
+        }
+    }
+}
+
+void test_literal_only()
+{
+    expectRendered("", "");
+    expectRendered("<p>no placeholders & no escaping of template itself</p>", "<p>no placeholders & no escaping of template itself</p>");
+}
+
+void test_values()
+{
+    expectRendered("<h1>{{name}}</h1>", "<h1>Kitchen &amp; &quot;Light&quot;</h1>");
+    expectRendered("{{plain}}", "no escaping at all");
+    expectRendered("{{name2}}|{{name}}", "&lt;b&gt;&#39;bold&#39;&lt;/b&gt;|Kitchen &amp; &quot;Light&quot;"); // name is a prefix of name2
+    expectRendered("{{plain}}{{plain}}", "no escaping at allno escaping at all");
+}
+
+void test_every_escaped_character()
+{
+    expectRendered("[{{escaped}}]", "[&amp;&lt;&gt;&quot;&#39;]");
+    expectRendered("{{escaped}}", "&amp;&lt;&gt;&quot;&#39;");
+}
+
+void test_unknown_and_empty()
+{
+    expectRendered("a{{unknown}}b", "ab");
+    expectRendered("a{{}}b", "ab");
+    expectRendered("a{{empty}}b{{missing}}c", "abc");
+}
+
+// "{{" without "}}" after it is plain text, up to the end
+void test_unclosed_placeholder()
+{
+    expectRendered("a {{name", "a {{name");
+    expectRendered("{{", "{{");
+    expectRendered("{{{{{", "{{{{{");
+    expectRendered("{{name}} and {{name", "Kitchen &amp; &quot;Light&quot; and {{name");
+    expectRendered("x}}y{", "x}}y{");
+}
+
+// cursor keeps how much of an entity is out, the rest comes first next time
+void test_stop_inside_entity()
+{
+    LimitedPrint out(SIZE_MAX, 0);
+    WebTemplateCursor cursor;
+
+    webTemplateBegin(&cursor, "{{escaped}}");
+
+    TEST_ASSERT_EQUAL(2, webTemplateWrite(&cursor, values, valueCount, &out, 2));
+    TEST_ASSERT_EQUAL_STRING("&a", out.text.c_str());
+    TEST_ASSERT_EQUAL_UINT8(2, cursor.entityOffset);
+
+    TEST_ASSERT_EQUAL(4, webTemplateWrite(&cursor, values, valueCount, &out, 4));
+    TEST_ASSERT_EQUAL_STRING("&amp;&", out.text.c_str());
+    TEST_ASSERT_EQUAL_UINT8(1, cursor.entityOffset);
+
+    TEST_ASSERT_EQUAL(18, webTemplateWrite(&cursor, values, valueCount, &out, SIZE_MAX));
+    TEST_ASSERT_EQUAL_STRING("&amp;&lt;&gt;&quot;&#39;", out.text.c_str());
+    TEST_ASSERT_EQUAL(0, webTemplateWrite(&cursor, values, valueCount, &out, SIZE_MAX));
+}
+
+// output which takes nothing leaves cursor where it was
+void test_output_full()
+{
+    LimitedPrint out(4, 1); // refuses every call
+    WebTemplateCursor cursor;
+
+    webTemplateBegin(&cursor, "ab{{name}}");
+
+    TEST_ASSERT_EQUAL(0, webTemplateWrite(&cursor, values, valueCount, &out, SIZE_MAX));
+    TEST_ASSERT_EQUAL_STRING("ab{{name}}", cursor.position);
+    TEST_ASSERT_NULL(cursor.value);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_literal_only);
+    RUN_TEST(test_values);
+    RUN_TEST(test_every_escaped_character);
+    RUN_TEST(test_unknown_and_empty);
+    RUN_TEST(test_unclosed_placeholder);
+    RUN_TEST(test_stop_inside_entity);
+    RUN_TEST(test_output_full);
+
+    return UNITY_END();
+}
@@ -0,0 +1,261 @@
+// core includes
+#include <Arduino.h>
+
+// project includes
+#include "wifiConnection.h"
+#include "conf.h"
+
+// lib includes
+#include <unity.h>
+
+/* Wi-Fi connection state machine with a scripted driver: radio events and ticks are fed by the test, with time it chooses.
+ * Driver only counts what state machine asked for, nothing is connected for real.
+ */
+
+#define MAX_STATE_CHANGES 64
+
+uint32_t driverBegins;
+uint32_t driverDisconnects;
+WifiConnectionState stateChanges[MAX_STATE_CHANGES];
+uint8_t stateChangeCount;
+
+void scriptedBegin(const char *ssid, const char *pwd)
+{
+    driverBegins++;
+}
+
+void scriptedDisconnect()
+{
+    driverDisconnects++;
+}
+
+const WifiConnectionDriver scriptedDriver = {scriptedBegin, scriptedDisconnect};
+
+void onStateChange(WifiConnectionState state)
+{
+    if(stateChangeCount < MAX_STATE_CHANGES)
+    {
+        stateChanges[stateChangeCount++] = state;
+    }
+}
+
+void setUp()
+{
+    driverBegins = 0;
+    driverDisconnects = 0;
+    stateChangeCount = 0;
+}
+
+void tearDown()
+{
+}
+
+void event(WifiConnectionEvent connectionEvent, uint32_t now)
+{
+    processWifiConnectionEvent(connectionEvent, now);
+}
+
+void tick(uint32_t now)
+{
+    event(WifiConnectionEvent::TICK, now);
+}
+
+// begin takes millis() itself, the test clock starts there
+uint32_t begin(const char *ssid, const char *pwd)
+{
+    uint32_t now = millis();
+
+    beginWifiConnection(ssid, pwd, onStateChange, &scriptedDriver);
+
+    return now;
+}
+
+void expectState(WifiConnectionState state)
+{
+    TEST_ASSERT_EQUAL_STRING(wifiConnectionStateString[(uint8_t)state], wifiConnectionStateString[(uint8_t)getWifiConnectionState()]);
+}
+
+// retry comes only once the whole backoff is over, returns when it came
+uint32_t expectRetryAfter(uint32_t from, uint32_t backoffMs)
+{
+    uint32_t begins = driverBegins;
+
+    tick(from + backoffMs);
+    expectState(WifiConnectionState::WAITING_FOR_RETRY);
+    TEST_ASSERT_EQUAL_UINT32(begins, driverBegins);
+
+    tick(from + backoffMs + 1);
+    expectState(WifiConnectionState::CONNECTING);
+    TEST_ASSERT_EQUAL_UINT32(begins + 1, driverBegins);
+
+    return from + backoffMs + 1;
+}
+
+void test_no_credentials()
+{
+    begin(INVALID_WIFI_SSID, INVALID_WIFI_PWD);
+
+    expectState(WifiConnectionState::NO_CREDENTIALS);
+    TEST_ASSERT_EQUAL_UINT32(0, driverBegins);
+
+    tick(1000000);
+    event(WifiConnectionEvent::GOT_IP, 1000001);
+    expectState(WifiConnectionState::NO_CREDENTIALS); // final
+}
+
+void test_first_connection()
+{
+    uint32_t start = begin("home", "password");
+
+    expectState(WifiConnectionState::CONNECTING);
+    TEST_ASSERT_EQUAL_UINT32(1, driverBegins);
+
+    event(WifiConnectionEvent::GOT_IP, start + 3000);
+    expectState(WifiConnectionState::CONNECTED);
+    TEST_ASSERT_EQUAL_UINT8(2, stateChangeCount);
+    TEST_ASSERT_TRUE(stateChanges[0] == WifiConnectionState::CONNECTING && stateChanges[1] == WifiConnectionState::CONNECTED);
+
+    tick(start + 3600000); // ticks alone do not touch a connected station
+    expectState(WifiConnectionState::CONNECTED);
+    TEST_ASSERT_EQUAL_UINT32(1, driverBegins);
+    TEST_ASSERT_EQUAL_UINT32(0, driverDisconnects);
+}
+
+/* Router never answers: attempt times out after WIFI_CONNECT_ATTEMPT_TIMEOUT_MS, one retry fits,
+ * then WIFI_CONNECT_TIMEOUT_MS of the initial connection is over and device gives up (soft AP).
+ */
+void test_initial_timeout()
+{
+    uint32_t start = begin("home", "password");
+
+    tick(start + WIFI_CONNECT_ATTEMPT_TIMEOUT_MS);
+    expectState(WifiConnectionState::CONNECTING);
+
+    tick(start + WIFI_CONNECT_ATTEMPT_TIMEOUT_MS + 1);
+    expectState(WifiConnectionState::WAITING_FOR_RETRY);
+    TEST_ASSERT_EQUAL_UINT32(1, driverDisconnects);
+
+    event(WifiConnectionEvent::DISCONNECTED, start + WIFI_CONNECT_ATTEMPT_TIMEOUT_MS + 2); // of the disconnect above
+    expectState(WifiConnectionState::WAITING_FOR_RETRY);
+
+    uint32_t retry = expectRetryAfter(start + WIFI_CONNECT_ATTEMPT_TIMEOUT_MS + 1, WIFI_RECONNECT_BACKOFF_MIN_MS);
+
+    tick(retry + WIFI_CONNECT_ATTEMPT_TIMEOUT_MS + 1);
+    expectState(WifiConnectionState::FAILED);
+    TEST_ASSERT_EQUAL_UINT32(3, driverDisconnects); // timed out attempt and giving up both disconnect
+    TEST_ASSERT_EQUAL_UINT32(2, driverBegins);
+
+    tick(retry + 3600000);
+    event(WifiConnectionEvent::GOT_IP, retry + 3600001);
+    expectState(WifiConnectionState::FAILED); // final, soft AP takes over
+    TEST_ASSERT_EQUAL_UINT32(2, driverBegins);
+}
+
+// wrong password: every attempt ends with DISCONNECTED right away, retries until the overall timeout
+void test_initial_rejected()
+{
+    uint32_t start = begin("home", "wrong");
+    uint32_t now = start;
+    uint32_t backoffMs = WIFI_RECONNECT_BACKOFF_MIN_MS;
+
+    while(now - start <= WIFI_CONNECT_TIMEOUT_MS)
+    {
+        event(WifiConnectionEvent::DISCONNECTED, now + 100);
+        expectState(WifiConnectionState::WAITING_FOR_RETRY);
+        now = expectRetryAfter(now + 100, backoffMs);
+        backoffMs *= 2;
+    }
+
+    event(WifiConnectionEvent::DISCONNECTED, now + 100);
+    expectState(WifiConnectionState::FAILED);
+    TEST_ASSERT_EQUAL_UINT32(6, driverBegins); // retries after 1, 2, 4, 8 and 16 s, the last one was armed before 20 s were over
+}
+
+// after the first connection it never gives up, backoff doubles up to its cap
+void test_backoff_doubles_to_cap()
+{
+    uint32_t now = begin("home", "password");
+    uint32_t backoffMs = WIFI_RECONNECT_BACKOFF_MIN_MS;
+    uint8_t atCap = 0;
+
+    event(WifiConnectionEvent::GOT_IP, now + 2000);
+    event(WifiConnectionEvent::DISCONNECTED, now + 60000);
+    now += 60000;
+    expectState(WifiConnectionState::WAITING_FOR_RETRY);
+
+    // attempts time out (router gone), that is the slowest way through
+    while(atCap < 3)
+    {
+        now = expectRetryAfter(now, backoffMs);
+
+        tick(now + WIFI_CONNECT_ATTEMPT_TIMEOUT_MS + 1);
+        now += WIFI_CONNECT_ATTEMPT_TIMEOUT_MS + 1;
+        expectState(WifiConnectionState::WAITING_FOR_RETRY);
+
+        atCap += (backoffMs == WIFI_RECONNECT_BACKOFF_MAX_MS) ? 1 : 0;
+        backoffMs = min(backoffMs * 2, (uint32_t)WIFI_RECONNECT_BACKOFF_MAX_MS);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(WIFI_RECONNECT_BACKOFF_MAX_MS, backoffMs);
+    TEST_ASSERT_EQUAL_UINT32(driverBegins - 1, driverDisconnects); // every timed out attempt is disconnected
+}
+
+// once connected again, the next outage starts from the shortest backoff
+void test_reconnect_resets_backoff()
+{
+    uint32_t now = begin("home", "password");
+
+    event(WifiConnectionEvent::GOT_IP, now + 2000);
+    event(WifiConnectionEvent::DISCONNECTED, now + 10000);
+    now += 10000;
+
+    for(uint32_t backoffMs = WIFI_RECONNECT_BACKOFF_MIN_MS; backoffMs <= 8000; backoffMs *= 2)
+    {
+        now = expectRetryAfter(now, backoffMs);
+        event(WifiConnectionEvent::DISCONNECTED, now + 50);
+        now += 50;
+    }
+
+    event(WifiConnectionEvent::GOT_IP, now + 500); // station came back on its own while waiting
+    now += 500;
+    expectState(WifiConnectionState::CONNECTED);
+
+    event(WifiConnectionEvent::DISCONNECTED, now + 600000);
+    now += 600000;
+    expectState(WifiConnectionState::WAITING_FOR_RETRY);
+    now = expectRetryAfter(now, WIFI_RECONNECT_BACKOFF_MIN_MS);
+
+    event(WifiConnectionEvent::GOT_IP, now + 1500);
+    expectState(WifiConnectionState::CONNECTED);
+    TEST_ASSERT_TRUE(stateChanges[stateChangeCount - 1] == WifiConnectionState::CONNECTED);
+}
+
+// counters around 0xFFFFFFFF, timeouts are differences
+void test_timeout_across_overflow()
+{
+    uint32_t start = begin("home", "password");
+    uint32_t now = 0xFFFFF000;
+
+    event(WifiConnectionEvent::GOT_IP, start + 1000);
+    event(WifiConnectionEvent::DISCONNECTED, now);
+    now = expectRetryAfter(now, WIFI_RECONNECT_BACKOFF_MIN_MS); // retry at 0xFFFFF3E9
+    tick(now + WIFI_CONNECT_ATTEMPT_TIMEOUT_MS); // past the wrap
+    expectState(WifiConnectionState::CONNECTING);
+    tick(now + WIFI_CONNECT_ATTEMPT_TIMEOUT_MS + 1);
+    expectState(WifiConnectionState::WAITING_FOR_RETRY);
+    expectRetryAfter(now + WIFI_CONNECT_ATTEMPT_TIMEOUT_MS + 1, 2 * WIFI_RECONNECT_BACKOFF_MIN_MS);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_no_credentials);
+    RUN_TEST(test_first_connection);
+    RUN_TEST(test_initial_timeout);
+    RUN_TEST(test_initial_rejected);
+    RUN_TEST(test_backoff_doubles_to_cap);
+    RUN_TEST(test_reconnect_resets_backoff);
+    RUN_TEST(test_timeout_across_overflow);
+
+    return UNITY_END();
+}
@@ -0,0 +1,191 @@
+// core includes
+#include <Arduino.h>
+#include <fstream>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// project includes
+#include "zoneTable.h"
+
+// lib includes
+#include <unity.h>
+
+/* Committed zone table (src/zoneTableData.cpp) inflated as firmware does it, simulator inflates with zlib.
+ * Table is walked in the layout scripts/generateZoneTable.py describes and compared with the JSON files it was built from,
+ * so layout read by zoneTableContains() is the one buildTable() writes.
+ * Test runs from project folder (pio test), so JSON files are found relative to it.
+ */
+
+#define COUNTRIES_FILE "web/countries.json"
+#define ZONES_FILE "web/zones.json"
+#define ZONE_TABLE_HEADER_SIZE 6
+
+uint8_t* inflateZoneTable(); // zoneTable.cpp
+
+std::map<std::string, std::string> countries; // code: name
+std::map<std::string, std::string> zones; // name: POSIX TZ
+
+// only \" and \\ escapes are used in the files
+std::string unescape(const std::string &text)
+{
+    std::string result;
+
+    for(size_t i = 0; i < text.size(); i++)
+    {
+        i += (text[i] == '\\') ? 1 : 0;
+        result += text[i];
+    }
+
+    return result;
+}
+
+// flat object of strings, as both files are
+void loadJsonObject(const char *fileName, std::map<std::string, std::string> *object)
+{
+    std::ifstream file(fileName);
+    std::stringstream content;
+    std::regex pair("\"((?:[^\"\\\\]|\\\\.)*)\"\\s*:\\s*\"((?:[^\"\\\\]|\\\\.)*)\"");
+
+    content << file.rdbuf();
+    std::string text = content.str();
+
+    for(std::sregex_iterator i(text.begin(), text.end(), pair); i != std::sregex_iterator(); i++)
+    {
+        (*object)[unescape((*i)[1].str())] = unescape((*i)[2].str());
+    }
+}
+
+const uint8_t* readString(const uint8_t *position, std::string *text)
+{
+    *text = (const char*)position;
+
+    return position + text->size() + 1;
+}
+
+void setUp()
+{
+    TEST_ASSERT_TRUE_MESSAGE(!countries.empty() && !zones.empty(), "JSON files not found in " COUNTRIES_FILE " or " ZONES_FILE);
+}
+
+void tearDown()
+{
+}
+
+void test_inflates()
+{
+    uint8_t *table = inflateZoneTable();
+
+    TEST_ASSERT_NOT_NULL(table);
+    free(table);
+}
+
+// every byte of the table is where generator put it, nothing left over
+void test_layout_matches_generator()
+{
+    uint8_t *table = inflateZoneTable();
+    const uint8_t *position = table + ZONE_TABLE_HEADER_SIZE;
+    std::vector<std::string> regions;
+    std::vector<std::string> posixTzs;
+    std::string text;
+
+    TEST_ASSERT_NOT_NULL(table);
+
+    uint16_t countryCount = table[0] | (table[1] << 8);
+    uint8_t regionCount = table[2];
+    uint8_t posixTzCount = table[3];
+    uint16_t zoneCount = table[4] | (table[5] << 8);
+
+    TEST_ASSERT_EQUAL_UINT32(countries.size(), countryCount);
+    TEST_ASSERT_EQUAL_UINT32(zones.size(), zoneCount);
+
+    for(uint16_t i = 0; i < countryCount; i++)
+    {
+        std::string code((const char*)position, 2);
+
+        position = readString(position + 2, &text);
+        TEST_ASSERT_TRUE_MESSAGE(countries.count(code) == 1, code.c_str());
+        TEST_ASSERT_EQUAL_STRING(countries[code].c_str(), text.c_str());
+    }
+
+    for(uint8_t i = 0; i < regionCount; i++)
+    {
+        position = readString(position, &text);
+        regions.push_back(text);
+    }
+
+    for(uint8_t i = 0; i < posixTzCount; i++)
+    {
+        position = readString(position, &text);
+        posixTzs.push_back(text);
+    }
+
+    for(uint16_t i = 0; i < zoneCount; i++)
+    {
+        uint8_t region = position[0];
+        uint8_t posixTz = position[1];
+
+        position = readString(position + 2, &text);
+
+        TEST_ASSERT_LESS_THAN(regionCount, region);
+        TEST_ASSERT_LESS_THAN(posixTzCount, posixTz);
+
+        std::string name = regions[region].empty() ? text : regions[region] + "/" + text;
+
+        TEST_ASSERT_TRUE_MESSAGE(zones.count(name) == 1, name.c_str());
+        TEST_ASSERT_EQUAL_STRING(zones[name].c_str(), posixTzs[posixTz].c_str());
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(zoneTableLength, (uint32_t)(position - table));
+    free(table);
+}
+
+void test_known_accepted()
+{
+    TEST_ASSERT_TRUE(zoneTableContains("CET-1CEST,M3.5.0,M10.5.0/3", "SK"));
+    TEST_ASSERT_TRUE(zoneTableContains("GMT0", "GH"));
+    TEST_ASSERT_TRUE(zoneTableContains("CET-1CEST,M3.5.0,M10.5.0/3", NULL)); // country not checked
+}
+
+// every zone setup page offers passes, with every country
+void test_every_zone_accepted()
+{
+    for(const auto &zone : zones)
+    {
+        TEST_ASSERT_TRUE_MESSAGE(zoneTableContains(zone.second.c_str(), NULL), zone.first.c_str());
+    }
+
+    for(const auto &country : countries)
+    {
+        TEST_ASSERT_TRUE_MESSAGE(zoneTableContains("GMT0", country.first.c_str()), country.first.c_str());
+    }
+}
+
+void test_bogus_rejected()
+{
+    TEST_ASSERT_FALSE(zoneTableContains("CET-1CEST,M3.5.0,M10.5.0/3", "XX"));
+    TEST_ASSERT_FALSE(zoneTableContains("CET-1CEST,M3.5.0,M10.5.0/3", "SKK")); // only 2 letter codes
+    TEST_ASSERT_FALSE(zoneTableContains("CET-1CEST,M3.5.0,M10.5.0/3", "S"));
+    TEST_ASSERT_FALSE(zoneTableContains("CET-1CEST,M3.5.0,M10.5.0/3", "sk")); // codes are upper case
+    TEST_ASSERT_FALSE(zoneTableContains("CET-1CEST", "SK")); // prefix of a valid one
+    TEST_ASSERT_FALSE(zoneTableContains("XYZ-5", "SK"));
+    TEST_ASSERT_FALSE(zoneTableContains("", "SK"));
+    TEST_ASSERT_FALSE(zoneTableContains("Europe/Bratislava", "SK")); // zone name, not its POSIX TZ
+}
+
+int main(int argc, char **argv)
+{
+    loadJsonObject(COUNTRIES_FILE, &countries);
+    loadJsonObject(ZONES_FILE, &zones);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_inflates);
+    RUN_TEST(test_layout_matches_generator);
+    RUN_TEST(test_known_accepted);
+    RUN_TEST(test_every_zone_accepted);
+    RUN_TEST(test_bogus_rejected);
+
+    return UNITY_END();
+}
@@ -0,0 +1,146 @@
+import base64
+import colorsys
+import os
+import socket
+import struct
+import threading
+import time
+
+# begin conf
+host = "192.168.1.50" # IP address of the light (station mode, same network)
+port = 80
+messagesPerSecond = 30 # firmware applies at most one per LED frame (50 fps), the rest is coalesced
+durationS = 10
+transitionMs = 0 # 0 = jump to the new color, so every state push can be matched to the message that caused it
+brightness = 128
+# end conf
+
+MESSAGE_CONTROL = 0x01
+MESSAGE_STATE = 0x02
+OPCODE_BINARY = 0x2
+OPCODE_CLOSE = 0x8
+OPCODE_PING = 0x9
+OPCODE_PONG = 0xA
+
+def receiveExactly(connection, length):
+    data = b""
+
+    while len(data) < length:
+        chunk = connection.recv(length - len(data))
+
+        if not chunk:
+            raise ConnectionError("connection closed by light")
+
+        data += chunk
+
+    return data
+
+def sendFrame(connection, opcode, payload):
+    # client frames have to be masked
+    mask = os.urandom(4)
+    header = bytes([0x80 | opcode])
+
+    if len(payload) < 126:
+        header += bytes([0x80 | len(payload)])
+    else:
+        header += bytes([0x80 | 126]) + struct.pack(">H", len(payload))
+
+    connection.sendall(header + mask + bytes(b ^ mask[i % 4] for i, b in enumerate(payload)))
+
+def receiveFrame(connection):
+    first, second = receiveExactly(connection, 2)
+    length = second & 0x7F
+
+    if length == 126:
+        length = struct.unpack(">H", receiveExactly(connection, 2))[0]
+    elif length == 127:
+        length = struct.unpack(">Q", receiveExactly(connection, 8))[0]
+
+    return first & 0x0F, receiveExactly(connection, length)
+
+def connect():
+    connection = socket.create_connection((host, port), timeout=5)
+    key = base64.b64encode(os.urandom(16)).decode()
+
+    connection.sendall(("GET /api/live HTTP/1.1\r\nHost: " + host + "\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+        "Sec-WebSocket-Key: " + key + "\r\nSec-WebSocket-Version: 13\r\n\r\n").encode())
+
+    response = b""
+
+    while b"\r\n\r\n" not in response:
+        response += receiveExactly(connection, 1)
+
+    if not response.startswith(b"HTTP/1.1 101"):
+        raise ConnectionError("handshake failed: " + response.split(b"\r\n")[0].decode())
+
+    connection.settimeout(None)
+
+    return connection
+
+def controlMessage(red, green, blue):
+    return struct.pack("<BBBBBH", MESSAGE_CONTROL, brightness, red, green, blue, transitionMs)
+
+connection = connect()
+sent = {} # (r, g, b) -> time it was sent, only the latest time for each color
+sentCount = 0
+stateCount = 0
+latencies = []
+running = True
+lock = threading.Lock()
+
+def receiver():
+    global stateCount
+
+    while running:
+        try:
+            opcode, payload = receiveFrame(connection)
+        except (ConnectionError, OSError):
+            return
+
+        if opcode == OPCODE_PING:
+            sendFrame(connection, OPCODE_PONG, payload)
+        elif opcode == OPCODE_CLOSE:
+            print("closed by light, code " + str(struct.unpack(">H", payload[:2])[0] if len(payload) >= 2 else "none"))
+            return
+        elif opcode == OPCODE_BINARY and len(payload) == 5 and payload[0] == MESSAGE_STATE:
+            with lock:
+                stateCount += 1
+                sentTime = sent.pop(tuple(payload[2:5]), None)
+
+            # latency from message sent to light state pushed back, only for states caused by this script
+            if sentTime is not None:
+                latencies.append((time.monotonic() - sentTime) * 1000)
+
+receiverThread = threading.Thread(target=receiver, daemon=True)
+receiverThread.start()
+
+# hue sweep, every message is a different color
+startTime = time.monotonic()
+period = 1.0 / messagesPerSecond
+
+while time.monotonic() - startTime < durationS:
+    hue = (sentCount % 360) / 360.0
+    red, green, blue = (int(c * 255) for c in colorsys.hsv_to_rgb(hue, 1.0, 1.0))
+
+    with lock:
+        sent[(red, green, blue)] = time.monotonic()
+
+    sendFrame(connection, OPCODE_BINARY, controlMessage(red, green, blue))
+    sentCount += 1
+
+    time.sleep(max(0.0, startTime + sentCount * period - time.monotonic()))
+
+elapsedS = time.monotonic() - startTime
+time.sleep(0.5) # last state pushes
+running = False
+sendFrame(connection, OPCODE_CLOSE, struct.pack(">H", 1000))
+connection.close()
+
+print("sent: " + str(sentCount) + " messages (" + str(round(sentCount / elapsedS, 1)) + " per s)")
+print("state pushes: " + str(stateCount) + " (" + str(round(stateCount / elapsedS, 1)) + " per s)")
+print("coalesced: " + str(sentCount - len(latencies)) + " messages never showed up as state")
+
+if latencies:
+    latencies.sort()
+    print("latency: min " + str(round(latencies[0], 1)) + " ms, median " + str(round(latencies[len(latencies) // 2], 1)) + " ms, p95 " +
+        str(round(latencies[int(len(latencies) * 0.95)], 1)) + " ms, max " + str(round(latencies[-1], 1)) + " ms")
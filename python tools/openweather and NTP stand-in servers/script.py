@@ -0,0 +1,199 @@
+import json
+import math
+import os
+import random
+import socket
+import struct
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+# begin conf
+httpPort = 8080
+ntpPort = 123 # SNTP client on ESP32 always asks port 123, binding it needs root (or CAP_NET_BIND_SERVICE)
+scenario = "cycle" # one of scenarios below, "cycle" rotates through all of them, one per request
+recordedWeatherFileName = "weather.json"
+recordedForecastFileName = "forecast.json"
+slowChunkSize = 64 # bytes
+slowChunkDelayS = 0.25 # 16 kB forecast takes about a minute
+chunkedMaxChunkSize = 1024 # bytes, chunks are of random size up to this
+keepAliveTimeoutS = 15 # idle connection is closed after this, real server does about the same
+oversizedPayloadSize = 65536 # bytes, real responses are about 0.5 kB (weather) and 16 kB (forecast)
+ntpOffsetS = 0.0 # added to served time, to see how firmware copes with a step in time
+ntpDropEvery = 0 # drop every n-th NTP request, 0 = never
+# end conf
+
+scenarios = ["recorded", "synthetic", "slow", "chunked", "truncated", "oversized", "error"]
+scenarioIndex = 0
+scenarioLock = threading.Lock()
+
+NTP_EPOCH_OFFSET = 2208988800 # 1900-01-01 to 1970-01-01
+FORECAST_SAMPLE_PERIOD_S = 10800
+
+scriptDirectory = os.path.dirname(os.path.abspath(__file__))
+
+def loadJson(fileName):
+    with open(os.path.join(scriptDirectory, fileName), "r") as inputFile:
+        return json.load(inputFile)
+
+def nextScenario():
+    global scenarioIndex
+
+    if scenario != "cycle":
+        return scenario
+
+    with scenarioLock:
+        current = scenarios[scenarioIndex]
+        scenarioIndex = (scenarioIndex + 1) % len(scenarios)
+
+    return current
+
+# recorded forecast is moved to the future, so firmware does not throw it away as already over
+def shiftForecast(forecast):
+    firstSampleEpoch = (int(time.time()) // FORECAST_SAMPLE_PERIOD_S + 1) * FORECAST_SAMPLE_PERIOD_S
+    shift = firstSampleEpoch - forecast["list"][0]["dt"]
+
+    for sample in forecast["list"]:
+        sample["dt"] += shift
+        sample["dt_txt"] = time.strftime("%Y-%m-%d %H:%M:%S", time.gmtime(sample["dt"]))
+
+    return forecast
+
+def syntheticWeather():
+    weather = loadJson(recordedWeatherFileName)
+    weather["main"]["temp"] = round(random.uniform(-25.0, 40.0), 2)
+    weather["main"]["humidity"] = random.randint(0, 100)
+    weather["wind"]["speed"] = round(random.uniform(0.0, 30.0), 2)
+    weather["weather"][0]["icon"] = random.choice(["01d", "01n", "02d", "03n", "04d", "09n", "10d", "11n", "13d", "50n"])
+    weather["dt"] = int(time.time())
+
+    return weather
+
+def syntheticForecast():
+    forecast = shiftForecast(loadJson(recordedForecastFileName))
+    base = random.uniform(-10.0, 25.0)
+
+    for i, sample in enumerate(forecast["list"]):
+        sample["main"]["temp"] = round(base + 6.0 * math.sin(i / 8.0 * 2.0 * math.pi) + random.uniform(-1.0, 1.0), 2)
+        sample["main"]["humidity"] = random.randint(20, 100)
+        sample["wind"]["speed"] = round(random.uniform(0.0, 20.0), 2)
+
+    return forecast
+
+# junk goes first, so firmware has to skip it before anything it keeps
+def oversized(payload):
+    padding = "x" * max(0, oversizedPayloadSize - len(json.dumps(payload)))
+    return dict([("padding", padding)] + list(payload.items()))
+
+class StandInHandler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1" # keep-alive, firmware reuses connection for the next request
+    timeout = keepAliveTimeoutS
+
+    def setup(self):
+        super().setup()
+        self.requestsOnConnection = 0
+
+    def do_GET(self):
+        timer = time.time()
+        currentScenario = nextScenario()
+        self.requestsOnConnection += 1
+
+        if self.path.startswith("/data/2.5/weather"):
+            payload = loadJson(recordedWeatherFileName)
+        elif self.path.startswith("/data/2.5/forecast"):
+            payload = shiftForecast(loadJson(recordedForecastFileName))
+        else:
+            self.send_error(404)
+            return
+
+        status = 200
+
+        if currentScenario == "synthetic":
+            payload = syntheticWeather() if self.path.startswith("/data/2.5/weather") else syntheticForecast()
+        elif currentScenario == "oversized":
+            payload = oversized(payload)
+        elif currentScenario == "error":
+            status = 401
+            payload = {"cod": 401, "message": "Invalid API key. Please see https://openweathermap.org/faq#error401 for more info."}
+
+        body = json.dumps(payload, separators=(",", ":")).encode("utf-8")
+
+        self.send_response(status)
+        self.send_header("Content-Type", "application/json; charset=utf-8")
+
+        if currentScenario == "chunked":
+            self.send_header("Transfer-Encoding", "chunked")
+        else:
+            self.send_header("Content-Length", str(len(body)))
+
+        self.end_headers()
+
+        sent = 0
+
+        try:
+            if currentScenario == "slow":
+                while sent < len(body):
+                    self.wfile.write(body[sent:sent + slowChunkSize])
+                    self.wfile.flush()
+                    sent += len(body[sent:sent + slowChunkSize])
+                    time.sleep(slowChunkDelayS)
+            elif currentScenario == "chunked":
+                while sent < len(body):
+                    chunk = body[sent:sent + random.randint(1, chunkedMaxChunkSize)]
+                    self.wfile.write(("%x\r\n" % len(chunk)).encode("ascii") + chunk + b"\r\n")
+                    sent += len(chunk)
+
+                self.wfile.write(b"0\r\n\r\n")
+            elif currentScenario == "truncated":
+                # Content-Length promises the whole body, connection is closed in the middle of it
+                self.wfile.write(body[:len(body) // 2])
+                sent = len(body) // 2
+                self.close_connection = True
+            else:
+                self.wfile.write(body)
+                sent = len(body)
+        except (BrokenPipeError, ConnectionResetError):
+            pass
+
+        print("HTTP " + self.client_address[0] + " " + self.path.split("?")[0] + " [" + currentScenario + "] " + str(status) + ", " + str(sent) + "/" + str(len(body)) + " B in " + str(round((time.time() - timer) * 1000)) + " ms, request #" + str(self.requestsOnConnection) + " on connection")
+
+    def log_message(self, format, *args):
+        pass # own log line in do_GET()
+
+def ntpServer():
+    ntpSocket = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    ntpSocket.bind(("0.0.0.0", ntpPort))
+    requests = 0
+
+    print("NTP server on UDP port " + str(ntpPort))
+
+    while True:
+        request, address = ntpSocket.recvfrom(512)
+        receiveTime = time.time() + ntpOffsetS
+        requests += 1
+
+        if len(request) < 48:
+            continue
+
+        if ntpDropEvery != 0 and requests % ntpDropEvery == 0:
+            print("NTP " + address[0] + " dropped")
+            continue
+
+        # server reply: LI 0, version from request, mode 4, stratum 2, client transmit time echoed as originate time
+        version = (request[0] >> 3) & 0x07
+        transmitTime = time.time() + ntpOffsetS
+        response = struct.pack("!BBbb11I",
+            (version << 3) | 4, 2, 6, -20,
+            0, 0, 0x4c4f434c, # root delay, root dispersion, reference id "LOCL"
+            int(receiveTime + NTP_EPOCH_OFFSET), 0,
+            struct.unpack("!I", request[40:44])[0], struct.unpack("!I", request[44:48])[0],
+            int(receiveTime + NTP_EPOCH_OFFSET), int((receiveTime % 1) * 2**32),
+            int(transmitTime + NTP_EPOCH_OFFSET), int((transmitTime % 1) * 2**32))
+
+        ntpSocket.sendto(response, address)
+        print("NTP " + address[0] + " " + time.strftime("%Y-%m-%d %H:%M:%S", time.gmtime(transmitTime)) + " UTC")
+
+threading.Thread(target=ntpServer, daemon=True).start()
+
+print("OpenWeather stand-in on TCP port " + str(httpPort) + ", scenario: " + scenario)
+ThreadingHTTPServer(("0.0.0.0", httpPort), StandInHandler).serve_forever()